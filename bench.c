@@ -0,0 +1,585 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "bench.h"
+#include "synth.h"
+#include "fault.h"
+#include "input.h"
+#include "packed.h"
+#include "schedule.h"
+#include "output.h"
+#include "osal.h"
+#include "prof.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 단계별 측정 블록 크기 (행) */
+#ifndef BENCH_BLOCK
+#define BENCH_BLOCK 65536
+#endif
+
+static const char* const stageNames[BENCH_STAGE_COUNT] =
+{
+    "generate", "parse", "diagnose", "write", "end_to_end", "replay", "replay_packed", "replay_changed",
+    "replay_sched"
+};
+
+/* 측정 작업 버퍼 */
+typedef struct
+{
+    InputSnapshot* in;          // 블록 파싱 결과
+    uint32_t* packed;           // 블록 진단 결과 (Fault_PackStatus)
+    char* text;                 // 블록 결과 CSV 텍스트
+    FILE* sink;                 // 결과 CSV 파일 (NULL : 메모리에만 포맷)
+    uint64_t hash;
+    uint64_t out_bytes;
+} BenchWork;
+
+const char* Bench_StageName(BenchStageId id)
+{
+    return ((unsigned)id < BENCH_STAGE_COUNT) ? stageNames[id] : "?";
+}
+
+/* FNV-1a 64bit */
+static uint64_t Hash_Update(uint64_t h, const char* p, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* Input_ReadLine(fgets) 과 동일한 줄 단위 : '\n' 까지 또는 최대 INPUT_LINE_MAX-1 byte */
+static const char* Line_Next(const char* p, const char* end)
+{
+    size_t max = INPUT_LINE_MAX - 1;
+    const char* limit = ((size_t)(end - p) > max) ? p + max : end;
+    const char* nl = (const char*)memchr(p, '\n', (size_t)(limit - p));
+
+    return nl ? nl + 1 : limit;
+}
+
+static int Line_Parse(const char** p, const char* end, InputSnapshot* in)
+{
+    char line[INPUT_LINE_MAX];
+    const char* next = Line_Next(*p, end);
+    size_t len = (size_t)(next - *p);
+
+    memcpy(line, *p, len);
+    line[len] = '\0';
+    *p = next;
+
+    return Input_ParseLine(line, in);
+}
+
+static int Work_Open(BenchWork* w, const char* out)
+{
+    w->hash = 14695981039346656037ull;
+    w->out_bytes = 0;
+    w->sink = NULL;
+
+    if (!out)
+        return 1;
+
+    w->sink = fopen(out, "w");
+    if (!w->sink)
+        return 0;
+
+    Output_WriteHeader(w->sink);
+    return 1;
+}
+
+static int Work_Close(BenchWork* w)
+{
+    int ok = 1;
+
+    if (w->sink)
+        ok = (fclose(w->sink) == 0);
+    w->sink = NULL;
+    return ok;
+}
+
+/* 결과 블록 기록 (측정 구간) */
+static void Work_Flush(BenchWork* w, size_t len)
+{
+    if (w->sink)
+        fwrite(w->text, 1, len, w->sink);
+}
+
+/* 결과 블록 확인값 누적 (측정 구간 밖) */
+static void Work_Account(BenchWork* w, size_t len)
+{
+    w->hash = Hash_Update(w->hash, w->text, len);
+    w->out_bytes += len;
+}
+
+/* 단계별 측정 : 블록마다 파싱 → 진단 → 출력을 나누어 실행 */
+static int Bench_Staged(const char* text, size_t len, BenchWork* w, uint64_t ns[BENCH_STAGE_COUNT],
+    uint64_t ticks[BENCH_STAGE_COUNT])
+{
+    const char* p = text;
+    const char* end = text + len;
+    FaultContext ctx;
+
+    Fault_InitContext(&ctx);
+
+    while (p < end)
+    {
+        size_t rows = 0;
+        size_t out_len = 0;
+        uint64_t t0, t1, t2, t3;
+        uint64_t k0, k1, k2, k3;
+
+        t0 = Osal_NowNs();
+        k0 = Prof_Ticks();
+        while (p < end && rows < BENCH_BLOCK)
+        {
+            if (!Line_Parse(&p, end, &w->in[rows]))
+                return 0;
+            rows++;
+        }
+        t1 = Osal_NowNs();
+        k1 = Prof_Ticks();
+
+        for (size_t i = 0; i < rows; i++)
+        {
+            Fault_DiagnoseContext(&ctx, &w->in[i]);
+            w->packed[i] = Fault_PackStatus(&ctx);
+        }
+        t2 = Osal_NowNs();
+        k2 = Prof_Ticks();
+
+        for (size_t i = 0; i < rows; i++)
+            out_len += (size_t)Output_FormatRow(w->text + out_len, w->in[i].Cycle, w->packed[i]);
+        Work_Flush(w, out_len);
+        t3 = Osal_NowNs();
+        k3 = Prof_Ticks();
+
+        ns[BENCH_PARSE] += t1 - t0;
+        ns[BENCH_DIAGNOSE] += t2 - t1;
+        ns[BENCH_WRITE] += t3 - t2;
+        ticks[BENCH_PARSE] += k1 - k0;
+        ticks[BENCH_DIAGNOSE] += k2 - k1;
+        ticks[BENCH_WRITE] += k3 - k2;
+        Work_Account(w, out_len);
+    }
+    return 1;
+}
+
+/* 전체 측정 : 직렬 진단 루프와 같은 행 단위 처리 */
+static int Bench_EndToEnd(const char* text, size_t len, BenchWork* w, uint64_t* ns, uint64_t* ticks)
+{
+    const char* p = text;
+    const char* end = text + len;
+    FaultContext ctx;
+
+    Fault_InitContext(&ctx);
+
+    while (p < end)
+    {
+        size_t rows = 0;
+        size_t out_len = 0;
+        uint64_t t0 = Osal_NowNs();
+        uint64_t k0 = Prof_Ticks();
+
+        while (p < end && rows < BENCH_BLOCK)
+        {
+            InputSnapshot in;
+
+            if (!Line_Parse(&p, end, &in))
+                return 0;
+
+            Fault_DiagnoseContext(&ctx, &in);
+            out_len += (size_t)Output_FormatRow(w->text + out_len, in.Cycle, Fault_PackStatus(&ctx));
+            rows++;
+        }
+        Work_Flush(w, out_len);
+
+        *ns += Osal_NowNs() - t0;
+        *ticks += Prof_Ticks() - k0;
+        Work_Account(w, out_len);
+    }
+    return 1;
+}
+
+/* 재생 입력 구성 : 전체 입력을 InputSnapshot 배열과 PackedLog 에 (측정 구간 밖) */
+static int Replay_Load(const char* text, size_t len, InputSnapshot* rows, size_t count, PackedLog* log)
+{
+    const char* p = text;
+    const char* end = text + len;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (p >= end || !Line_Parse(&p, end, &rows[i]) || !PackedLog_Append(log, &rows[i]))
+            return 0;
+    }
+    return 1;
+}
+
+/* 재생 진단 결과 확인값 (결과 CSV 텍스트 FNV-1a, 측정 구간 밖) */
+static uint64_t Replay_Hash(const InputSnapshot* rows, const uint32_t* status, size_t count, BenchWork* w)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for (size_t i = 0; i < count; i += BENCH_BLOCK)
+    {
+        size_t n = (count - i < BENCH_BLOCK) ? count - i : BENCH_BLOCK;
+        size_t out_len = 0;
+
+        for (size_t k = 0; k < n; k++)
+            out_len += (size_t)Output_FormatRow(w->text + out_len, rows[i + k].Cycle, status[i + k]);
+        h = Hash_Update(h, w->text, out_len);
+    }
+    return h;
+}
+
+static void Stage_Keep(BenchStage* st, uint64_t ns, uint64_t ticks)
+{
+    if (st->ns == 0 || ns < st->ns)
+    {
+        st->ns = ns;
+        st->ticks = ticks;
+    }
+}
+
+int Bench_Run(const BenchOptions* opt, BenchResult* r)
+{
+    SynthSession session;
+    BenchWork w;
+    size_t cap;
+    size_t len;
+    char* text;
+    uint64_t t0, k0;
+    int ok = 1;
+
+    memset(r, 0, sizeof(*r));
+    memset(&w, 0, sizeof(w));
+
+    if (opt->size_mb == 0 || opt->size_mb > (uint64_t)(SIZE_MAX >> 21))
+    {
+        printf("ERROR: Invalid benchmark size : %llu MB\n", (unsigned long long)opt->size_mb);
+        return 1;
+    }
+
+    cap = (size_t)opt->size_mb << 20;
+    text = (char*)malloc(cap);
+    w.in = (InputSnapshot*)malloc(BENCH_BLOCK * sizeof(*w.in));
+    w.packed = (uint32_t*)malloc(BENCH_BLOCK * sizeof(*w.packed));
+    w.text = (char*)malloc((size_t)BENCH_BLOCK * OUTPUT_ROW_MAX);
+
+    if (!text || !w.in || !w.packed || !w.text)
+    {
+        printf("ERROR: Benchmark out of memory (%llu MB input)\n", (unsigned long long)opt->size_mb);
+        ok = 0;
+        goto cleanup;
+    }
+
+    /* ------------------------------
+     * 합성 입력 생성
+     * ------------------------------ */
+    Synth_Init(&session, opt->seed);
+    t0 = Osal_NowNs();
+    k0 = Prof_Ticks();
+    len = Synth_Fill(&session, text, cap);
+    r->stage[BENCH_GENERATE].ticks = Prof_Ticks() - k0;
+    r->stage[BENCH_GENERATE].ns = Osal_NowNs() - t0;
+
+    r->input_bytes = len;
+    r->rows = session.rows;
+    r->sessions = session.sessions;
+    r->events = session.events;
+
+    for (int i = BENCH_GENERATE; i < BENCH_STAGE_COUNT; i++)
+    {
+        r->stage[i].rows = r->rows;
+        r->stage[i].bytes = len;
+    }
+
+    /* ------------------------------
+     * 단계별 / 전체 측정 반복 (최소값)
+     * ------------------------------ */
+    for (int rep = 0; rep < opt->reps && ok; rep++)
+    {
+        uint64_t ns[BENCH_STAGE_COUNT] = { 0 };
+        uint64_t ticks[BENCH_STAGE_COUNT] = { 0 };
+        uint64_t staged_hash;
+
+        ok = Work_Open(&w, opt->out) && Bench_Staged(text, len, &w, ns, ticks);
+        ok = Work_Close(&w) && ok;
+        staged_hash = w.hash;
+        r->output_bytes = w.out_bytes;
+
+        ok = ok && Work_Open(&w, opt->out) && Bench_EndToEnd(text, len, &w, &ns[BENCH_END_TO_END], &ticks[BENCH_END_TO_END]);
+        ok = Work_Close(&w) && ok;
+
+        if (!ok)
+        {
+            printf("ERROR: Benchmark run failed%s%s\n", opt->out ? " : " : "", opt->out ? opt->out : "");
+            break;
+        }
+
+        if (w.hash != staged_hash || (rep > 0 && w.hash != r->checksum))
+        {
+            printf("ERROR: Benchmark result mismatch (staged 0x%016llx, end-to-end 0x%016llx)\n",
+                (unsigned long long)staged_hash, (unsigned long long)w.hash);
+            ok = 0;
+            break;
+        }
+        r->checksum = w.hash;
+
+        for (int i = BENCH_PARSE; i < BENCH_STAGE_COUNT; i++)
+            Stage_Keep(&r->stage[i], ns[i], ticks[i]);
+    }
+
+    r->stage[BENCH_WRITE].bytes = r->output_bytes;
+
+    /* ------------------------------
+     * 재생 측정 : InputSnapshot 배열 / PackedLog (진단만, 결과는 확인값으로 비교)
+     * ------------------------------ */
+    if (ok)
+    {
+        size_t count = (size_t)r->rows;
+        InputSnapshot* rows = (InputSnapshot*)malloc(count * sizeof(*rows));
+        uint32_t* status = (uint32_t*)malloc(count * sizeof(*status));
+        PackedLog log;
+
+        PackedLog_Init(&log);
+        if (!rows || !status || !Replay_Load(text, len, rows, count, &log))
+        {
+            printf("ERROR: Benchmark replay buffer failed (%llu rows)\n", (unsigned long long)r->rows);
+            ok = 0;
+        }
+
+        r->stage[BENCH_REPLAY].bytes = (uint64_t)count * sizeof(InputSnapshot);
+        r->stage[BENCH_REPLAY_PACKED].bytes = (uint64_t)log.count * sizeof(PackedSnapshot) +
+            (uint64_t)log.wide_count * sizeof(InputSnapshot);
+        r->stage[BENCH_REPLAY_CHANGED].bytes = r->stage[BENCH_REPLAY].bytes;
+        r->stage[BENCH_REPLAY_SCHEDULED].bytes = r->stage[BENCH_REPLAY].bytes;
+
+        for (int rep = 0; rep < opt->reps && ok; rep++)
+        {
+            for (int i = BENCH_REPLAY; i <= BENCH_REPLAY_SCHEDULED && ok; i++)
+            {
+                FaultContext ctx;
+                FaultIdle idle;
+                uint64_t t0, k0;
+
+                if (i == BENCH_REPLAY_SCHEDULED)
+                    Schedule_InitContext(&ctx);
+                else
+                    Fault_InitContext(&ctx);
+                Fault_IdleInit(&idle);
+                t0 = Osal_NowNs();
+                k0 = Prof_Ticks();
+                if (i == BENCH_REPLAY)
+                {
+                    for (size_t k = 0; k < count; k++)
+                    {
+                        Fault_DiagnoseContext(&ctx, &rows[k]);
+                        status[k] = Fault_PackStatus(&ctx);
+                    }
+                }
+                else if (i == BENCH_REPLAY_PACKED)
+                {
+                    PackedLog_Diagnose(&ctx, &log, 0, count, status);
+                }
+                else if (i == BENCH_REPLAY_SCHEDULED)
+                {
+                    uint64_t runs = 0;
+
+                    for (size_t k = 0; k < count; k++)
+                    {
+                        runs += (uint64_t)Schedule_Diagnose(&ctx, k, &rows[k]);
+                        status[k] = Fault_PackStatus(&ctx);
+                    }
+                    r->scheduled = runs;
+                }
+                else
+                {
+                    for (size_t k = 0; k < count; k++)
+                    {
+                        Fault_DiagnoseChanged(&ctx, &idle, &rows[k]);
+                        status[k] = Fault_PackStatus(&ctx);
+                    }
+                    r->skipped = idle.skipped;
+                    r->evaluated = idle.evaluated;
+                }
+                Stage_Keep(&r->stage[i], Osal_NowNs() - t0, Prof_Ticks() - k0);
+
+                /* 다중 주기 재생은 검출 / 회복 시점이 주기 단위로 달라지므로 비교 제외 */
+                if (i != BENCH_REPLAY_SCHEDULED && Replay_Hash(rows, status, count, &w) != r->checksum)
+                {
+                    printf("ERROR: Benchmark replay result mismatch (%s)\n", stageNames[i]);
+                    ok = 0;
+                }
+            }
+        }
+
+        r->replay_wide = log.wide_count;
+        PackedLog_Free(&log);
+        free(rows);
+        free(status);
+    }
+
+cleanup:
+    free(text);
+    free(w.in);
+    free(w.packed);
+    free(w.text);
+    return ok ? 0 : 1;
+}
+
+static double Rate(uint64_t amount, uint64_t ns)
+{
+    return ns ? (double)amount * 1e9 / (double)ns : 0.0;
+}
+
+static double Percent(uint64_t part, uint64_t total)
+{
+    return total ? (double)part * 100.0 / (double)total : 0.0;
+}
+
+static double PerRow(const BenchStage* st)
+{
+    return st->rows ? (double)st->ticks / (double)st->rows : 0.0;
+}
+
+#ifdef OBC_FIXED_POINT
+#define BENCH_CURRENT   "fixed"
+#else
+#define BENCH_CURRENT   "float"
+#endif
+#define BENCH_TICK_UNIT (PROF_TSC ? "tsc" : "ns")
+
+void Bench_PrintSummary(FILE* out, const BenchOptions* opt, const BenchResult* r)
+{
+    fprintf(out, "Benchmark : %llu MB synthetic input (%llu rows, %llu sessions, %llu fault events), seed %llu, best of %d\n",
+        (unsigned long long)opt->size_mb, (unsigned long long)r->rows, (unsigned long long)r->sessions,
+        (unsigned long long)r->events, (unsigned long long)opt->seed, opt->reps);
+    fprintf(out, "  current     : %s, ticks %s\n", BENCH_CURRENT, BENCH_TICK_UNIT);
+    fprintf(out, "  %-12s %12s %12s %12s %12s\n", "stage", "time ms", "Mrows/s", "MB/s", "ticks/row");
+
+    for (int i = 0; i < BENCH_STAGE_COUNT; i++)
+    {
+        const BenchStage* st = &r->stage[i];
+
+        fprintf(out, "  %-12s %12.1f %12.2f %12.1f %12.1f\n", stageNames[i], st->ns / 1e6,
+            Rate(st->rows, st->ns) / 1e6, Rate(st->bytes, st->ns) / 1e6, PerRow(st));
+    }
+
+    fprintf(out, "  result      : %llu bytes, checksum 0x%016llx%s\n",
+        (unsigned long long)r->output_bytes, (unsigned long long)r->checksum,
+        opt->out ? "" : " (memory only)");
+    fprintf(out, "  replay      : %u -> %u bytes/row packed, %llu wide rows\n",
+        (unsigned)sizeof(InputSnapshot), (unsigned)sizeof(PackedSnapshot), (unsigned long long)r->replay_wide);
+    fprintf(out, "  skip idle   : %llu of %llu diagnoser evaluations skipped (%.1f %%)\n",
+        (unsigned long long)r->skipped, (unsigned long long)(r->skipped + r->evaluated),
+        Percent(r->skipped, r->skipped + r->evaluated));
+    fprintf(out, "  schedule    : %llu of %llu diagnoser runs (%.1f %%)\n",
+        (unsigned long long)r->scheduled, (unsigned long long)(r->rows * (FAULT_MAX - 1)),
+        Percent(r->scheduled, r->rows * (FAULT_MAX - 1)));
+}
+
+void Bench_WriteJson(FILE* out, const BenchOptions* opt, const BenchResult* r)
+{
+    fprintf(out, "{\n");
+    fprintf(out, "  \"engine_version\": \"0x%08X\",\n", (unsigned)FAULT_ENGINE_VERSION);
+    fprintf(out, "  \"seed\": %llu,\n", (unsigned long long)opt->seed);
+    fprintf(out, "  \"size_mb\": %llu,\n", (unsigned long long)opt->size_mb);
+    fprintf(out, "  \"reps\": %d,\n", opt->reps);
+    fprintf(out, "  \"block_rows\": %d,\n", BENCH_BLOCK);
+    fprintf(out, "  \"current\": \"%s\",\n", BENCH_CURRENT);
+    fprintf(out, "  \"tick_unit\": \"%s\",\n", BENCH_TICK_UNIT);
+    fprintf(out, "  \"sink\": \"%s\",\n", opt->out ? "file" : "memory");
+    fprintf(out, "  \"input_bytes\": %llu,\n", (unsigned long long)r->input_bytes);
+    fprintf(out, "  \"output_bytes\": %llu,\n", (unsigned long long)r->output_bytes);
+    fprintf(out, "  \"rows\": %llu,\n", (unsigned long long)r->rows);
+    fprintf(out, "  \"sessions\": %llu,\n", (unsigned long long)r->sessions);
+    fprintf(out, "  \"fault_events\": %llu,\n", (unsigned long long)r->events);
+    fprintf(out, "  \"checksum\": \"0x%016llx\",\n", (unsigned long long)r->checksum);
+    fprintf(out, "  \"replay_wide_rows\": %llu,\n", (unsigned long long)r->replay_wide);
+    fprintf(out, "  \"skipped_evaluations\": %llu,\n", (unsigned long long)r->skipped);
+    fprintf(out, "  \"evaluated_evaluations\": %llu,\n", (unsigned long long)r->evaluated);
+    fprintf(out, "  \"scheduled_runs\": %llu,\n", (unsigned long long)r->scheduled);
+    fprintf(out, "  \"stages\": {\n");
+
+    for (int i = 0; i < BENCH_STAGE_COUNT; i++)
+    {
+        const BenchStage* st = &r->stage[i];
+
+        fprintf(out, "    \"%s\": { \"ns\": %llu, \"ticks\": %llu, \"rows\": %llu, \"bytes\": %llu, \"rows_per_sec\": %.0f, \"mb_per_sec\": %.1f, \"ticks_per_row\": %.1f }%s\n",
+            stageNames[i], (unsigned long long)st->ns, (unsigned long long)st->ticks, (unsigned long long)st->rows,
+            (unsigned long long)st->bytes, Rate(st->rows, st->ns), Rate(st->bytes, st->ns) / 1e6, PerRow(st),
+            i + 1 < BENCH_STAGE_COUNT ? "," : "");
+    }
+
+    fprintf(out, "  }\n}\n");
+}
+
+int Bench_Main(int argc, char* argv[])
+{
+    BenchOptions opt;
+    BenchResult result;
+    int to_stdout;
+
+    opt.size_mb = 256;
+    opt.seed = 1;
+    opt.reps = 3;
+    opt.json = NULL;
+    opt.out = NULL;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--size=", 7) == 0)
+            opt.size_mb = strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            opt.seed = strtoull(argv[i] + 7, NULL, 0);
+        else if (strncmp(argv[i], "--reps=", 7) == 0)
+            opt.reps = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--json=", 7) == 0)
+            opt.json = argv[i] + 7;
+        else if (strncmp(argv[i], "--out=", 6) == 0)
+            opt.out = argv[i] + 6;
+        else
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (opt.reps < 1)
+    {
+        printf("ERROR: Invalid benchmark option value\n");
+        return 1;
+    }
+
+    if (Bench_Run(&opt, &result) != 0)
+        return 1;
+
+    /* --json=- 이면 JSON만 stdout 으로 (다른 도구 파이프 입력용) */
+    to_stdout = opt.json && strcmp(opt.json, "-") == 0;
+    if (!to_stdout)
+        Bench_PrintSummary(stdout, &opt, &result);
+
+    if (to_stdout)
+    {
+        Bench_WriteJson(stdout, &opt, &result);
+    }
+    else if (opt.json)
+    {
+        FILE* fp = fopen(opt.json, "w");
+        if (!fp)
+        {
+            printf("ERROR: Failed to open benchmark JSON : %s\n", opt.json);
+            return 1;
+        }
+        Bench_WriteJson(fp, &opt, &result);
+        if (fclose(fp) != 0)
+        {
+            printf("ERROR: Failed to write benchmark JSON : %s\n", opt.json);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * 엔진 벤치마크 (fault_engine --bench)
+ *  - 합성 충전 세션(synth.h)으로 입력 CSV 텍스트를 메모리에 생성 (기본 256 MB, GB 단위 가능)
+ *  - 단계별 측정 : 파싱(CSV 줄 → InputSnapshot), 진단(Fault_DiagnoseContext), 출력(결과 CSV 포맷/기록)
+ *    → 블록(BENCH_BLOCK 행) 단위로 단계를 나누어 실행하고 단계별 시간 누적
+ *  - 전체 측정 : 직렬 진단 루프와 같은 행 단위 처리 (파싱 → 진단 → 출력)
+ *  - 재생 측정 : 전체 입력을 메모리에 InputSnapshot 배열 / PackedLog(packed.h) 로 쌓아 두고 진단만 (메모리 대역폭 비교),
+ *    같은 배열을 변경 기반 진단(Fault_DiagnoseChanged)으로 재생하여 생략 비율 / 처리량 비교,
+ *    다중 주기 진단(Schedule_Diagnose)으로 재생하여 실행 수 / 처리량 비교 (주기별 양자화로 결과가 달라 checksum 비교 제외)
+ *  - 각 측정은 반복 중 최소값, 결과는 사람이 읽는 표 + JSON (커밋 간 비교용)
+ *  - 단계별 시간과 함께 Prof_Ticks 수(x86 : TSC 사이클)를 기록 → 행당 사이클로 float / 고정소수점(OBC_FIXED_POINT)
+ *    빌드 비교 (같은 seed 면 두 빌드의 checksum 이 같아야 함)
+ */
+
+/* 단계 1개 측정 결과 */
+typedef struct
+{
+    uint64_t ns;                // 반복 중 최소 시간
+    uint64_t ticks;             // 그 반복의 Prof_Ticks 수 (PROF_TSC 0 이면 ns)
+    uint64_t rows;
+    uint64_t bytes;             // 처리량 기준 byte (입력 텍스트, 출력 단계는 결과 텍스트)
+} BenchStage;
+
+typedef enum
+{
+    BENCH_GENERATE = 0,
+    BENCH_PARSE,
+    BENCH_DIAGNOSE,
+    BENCH_WRITE,
+    BENCH_END_TO_END,
+    BENCH_REPLAY,               // InputSnapshot 배열 재생 진단 (bytes : 배열 크기)
+    BENCH_REPLAY_PACKED,        // PackedLog 재생 진단 (bytes : 압축 로그 크기)
+    BENCH_REPLAY_CHANGED,       // InputSnapshot 배열 변경 기반 재생 진단 (Fault_DiagnoseChanged)
+    BENCH_REPLAY_SCHEDULED,     // InputSnapshot 배열 다중 주기 재생 진단 (schedule.h, 결과는 전체 실행과 다름)
+    BENCH_STAGE_COUNT
+} BenchStageId;
+
+typedef struct
+{
+    uint64_t input_bytes;
+    uint64_t output_bytes;
+    uint64_t rows;
+    uint64_t sessions;
+    uint64_t events;
+    uint64_t checksum;          // 결과 텍스트 FNV-1a (단계별 / 전체 / 재생 측정 결과 일치 확인)
+    uint64_t replay_wide;       // PackedLog 범위 밖(원본 보관) 행 수
+    uint64_t skipped;           // 변경 기반 재생 1회의 생략한 진단 함수 수
+    uint64_t evaluated;         // 변경 기반 재생 1회의 실행한 진단 함수 수
+    uint64_t scheduled;         // 다중 주기 재생 1회의 실행한 진단 함수 수
+    BenchStage stage[BENCH_STAGE_COUNT];
+} BenchResult;
+
+typedef struct
+{
+    uint64_t size_mb;           // 생성 입력 크기 (MB)
+    uint64_t seed;
+    int reps;                   // 반복 횟수 (최소값 사용)
+    const char* json;           // JSON 결과 경로 ("-" : stdout, NULL : 출력 안 함)
+    const char* out;            // 결과 CSV 기록 경로 (NULL : 메모리에만 포맷)
+} BenchOptions;
+
+/* ===== 벤치마크 실행 : 성공 0, 실패 1 ===== */
+int Bench_Run(const BenchOptions* opt, BenchResult* result);
+
+/* ===== 단계 이름 (JSON key) ===== */
+const char* Bench_StageName(BenchStageId id);
+
+/* ===== 결과 출력 ===== */
+void Bench_PrintSummary(FILE* out, const BenchOptions* opt, const BenchResult* r);
+void Bench_WriteJson(FILE* out, const BenchOptions* opt, const BenchResult* r);
+
+/* ===== 명령행 진입점 : fault_engine --bench [options] ===== */
+int Bench_Main(int argc, char* argv[]);
+
+#endif /* BENCH_H */
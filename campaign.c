@@ -0,0 +1,440 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "campaign.h"
+#include "osal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CAMPAIGN_ONSET_MIN      26          // 외란 시작 최소 Charg_Cnt (충전 안정 후)
+#define CAMPAIGN_SETTLE         30          // 분리 + INIT 유지 Cycle (회복 판정 후 세션 종료)
+#define CAMPAIGN_MAX_CYCLES     20000       // 세션 최대 Cycle
+
+/* 외란 → 원인 고장 코드 */
+static const int eventFault[SIM_EVENT_COUNT] =
+{
+    0,
+    FAULT_INPUT_OVERCURRENT,
+    FAULT_INPUT_UNDERCURRENT,
+    FAULT_PLUG,
+    FAULT_RELAY,
+    FAULT_BMS_STATE,
+    FAULT_OVER_TEMP,
+    FAULT_CAN,
+    FAULT_ISO,
+    FAULT_TEMP_SENSOR,
+    FAULT_WDT
+};
+
+/* splitmix64 (세션 seed stream) */
+static uint64_t Campaign_Rand(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void Campaign_DefaultOptions(CampaignOptions* opt)
+{
+    memset(opt, 0, sizeof(*opt));
+    opt->sessions = 20000;
+    opt->seed = 1;
+
+    Sim_DefaultConfig(&opt->cfg);
+    opt->cfg.event_rate = 0.0;          // 세션당 외란 1개만 직접 주입
+    opt->cfg.unpaid_rate = 0.0;
+    opt->cfg.service_limit = 0;
+    opt->cfg.demand_min = 100;
+    opt->cfg.demand_max = 600;
+    opt->cfg.sessions_max = 1;
+}
+
+void Campaign_StatsInit(CampaignStats* st)
+{
+    memset(st, 0, sizeof(*st));
+    for (int code = 0; code < FAULT_MAX; code++)
+    {
+        Hist_Init(&st->detect_latency[code]);
+        Hist_Init(&st->confirm_latency[code]);
+    }
+}
+
+void Campaign_StatsMerge(CampaignStats* dst, const CampaignStats* src)
+{
+    dst->sessions += src->sessions;
+    dst->cycles += src->cycles;
+    dst->control += src->control;
+    dst->skipped += src->skipped;
+    for (int code = 0; code < FAULT_MAX; code++)
+    {
+        dst->injected[code] += src->injected[code];
+        dst->detected[code] += src->detected[code];
+        dst->confirmed[code] += src->confirmed[code];
+        dst->false_confirms[code] += src->false_confirms[code];
+        dst->latched[code] += src->latched[code];
+        Hist_Merge(&dst->detect_latency[code], &src->detect_latency[code]);
+        Hist_Merge(&dst->confirm_latency[code], &src->confirm_latency[code]);
+    }
+}
+
+/* ------------------------------
+ * 세션 1개
+ * ------------------------------ */
+
+void Campaign_Session(const CampaignOptions* opt, uint64_t index, SimWorld* w, CampaignStats* st)
+{
+    uint64_t rng = Sim_DeriveSeed(opt->seed, index);
+    SimEvent event = (SimEvent)(Campaign_Rand(&rng) % SIM_EVENT_COUNT);
+    int expected = eventFault[event];
+    int onset = -1;             // 외란 시작 Charg_Cnt (-1 : 충전 시작 전)
+    int onset_cycle = -1;       // 외란 시작 Cycle (-1 : 미주입)
+    int detected = 0;
+    int confirmed = 0;
+    int idle = 0;
+    FaultStatus prev[FAULT_MAX];
+    InputSnapshot in;
+
+    Sim_Init(w, &opt->cfg, Campaign_Rand(&rng));
+    memset(prev, 0, sizeof(prev));
+
+    for (int step = 0; step < CAMPAIGN_MAX_CYCLES && idle < CAMPAIGN_SETTLE; step++)
+    {
+        /* 첫 충전 시작 시 세션 만충 Cycle 안에서 외란 시점 결정 */
+        if (event != SIM_EVENT_NONE && onset_cycle < 0 && w->ctrl.seq == SEQ_CHARGING)
+        {
+            if (onset < 0)
+                onset = CAMPAIGN_ONSET_MIN +
+                    (int)(Campaign_Rand(&rng) % (uint64_t)(w->plant.demand - CAMPAIGN_ONSET_MIN));
+            if (w->ctrl.charging_time >= onset)
+            {
+                Sim_StartEvent(w, event);
+                onset_cycle = w->cycle + 1;
+            }
+        }
+
+        Sim_Step(w, &in);
+
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        {
+            FaultStatus now = w->engine.state[code];
+
+            if (now == prev[code])
+                continue;
+
+            if (code == expected && onset_cycle >= 0)
+            {
+                if (!detected && now != FAULT_NORMAL)
+                {
+                    detected = 1;
+                    Hist_Record(&st->detect_latency[code], (uint64_t)(in.Cycle - onset_cycle));
+                }
+                if (!confirmed && now == FAULT_CONFIRM)
+                {
+                    confirmed = 1;
+                    Hist_Record(&st->confirm_latency[code], (uint64_t)(in.Cycle - onset_cycle));
+                }
+            }
+            else if (now == FAULT_CONFIRM)
+            {
+                st->false_confirms[code]++;
+            }
+            prev[code] = now;
+        }
+
+        /* 사용자 분리 후 INIT 유지 → 회복 판정 기간이 지나면 종료 */
+        idle = (w->stats.sessions > 0 && in.PlugInfo == PLUG_UNPLUGGED && in.SeqState == SEQ_INIT) ? idle + 1 : 0;
+    }
+
+    st->sessions++;
+    st->cycles += w->stats.cycles;
+
+    if (event == SIM_EVENT_NONE)
+        st->control++;
+    else if (onset_cycle < 0)
+        st->skipped++;
+    else
+    {
+        st->injected[expected]++;
+        st->detected[expected] += (uint64_t)detected;
+        st->confirmed[expected] += (uint64_t)confirmed;
+    }
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if (w->engine.state[code] == FAULT_CONFIRM)
+            st->latched[code]++;
+    }
+}
+
+/* ------------------------------
+ * 병렬 실행 : 세션 번호 i % 워커 수 분배
+ * ------------------------------ */
+
+typedef struct
+{
+    const CampaignOptions* opt;
+    int index;
+    int count;
+    int error;
+    CampaignStats* stats;
+} CampaignWorker;
+
+static void Campaign_Worker(void* arg)
+{
+    CampaignWorker* wk = (CampaignWorker*)arg;
+    SimWorld* w = (SimWorld*)malloc(sizeof(*w));
+
+    if (!w)
+    {
+        wk->error = 1;
+        return;
+    }
+
+    for (uint64_t i = (uint64_t)wk->index; i < wk->opt->sessions; i += (uint64_t)wk->count)
+        Campaign_Session(wk->opt, i, w, wk->stats);
+
+    free(w);
+}
+
+int Campaign_Run(const CampaignOptions* opt, CampaignStats* st, uint64_t* elapsed_ns)
+{
+    int count = opt->workers > 0 ? opt->workers : Osal_CpuCount();
+    CampaignWorker* workers;
+    OsalThread* threads;
+    int* started;
+    int rc = 0;
+
+    Campaign_StatsInit(st);
+    *elapsed_ns = 0;
+
+    if (count < 1)
+        count = 1;
+    if ((uint64_t)count > opt->sessions)
+        count = opt->sessions > 0 ? (int)opt->sessions : 1;
+
+    workers = (CampaignWorker*)calloc((size_t)count, sizeof(*workers));
+    threads = (OsalThread*)calloc((size_t)count, sizeof(*threads));
+    started = (int*)calloc((size_t)count, sizeof(*started));
+    if (!workers || !threads || !started)
+    {
+        printf("ERROR: Out of memory while starting campaign\n");
+        rc = 1;
+        goto done;
+    }
+
+    for (int k = 0; k < count; k++)
+    {
+        workers[k].opt = opt;
+        workers[k].index = k;
+        workers[k].count = count;
+        workers[k].stats = (CampaignStats*)malloc(sizeof(CampaignStats));
+        if (!workers[k].stats)
+        {
+            printf("ERROR: Out of memory while starting campaign\n");
+            rc = 1;
+            goto done;
+        }
+        Campaign_StatsInit(workers[k].stats);
+    }
+
+    uint64_t t0 = Osal_NowNs();
+    for (int k = 1; k < count; k++)
+        started[k] = Osal_ThreadCreate(&threads[k], Campaign_Worker, &workers[k]);
+
+    Campaign_Worker(&workers[0]);
+
+    for (int k = 1; k < count; k++)
+    {
+        if (started[k])
+            Osal_ThreadJoin(threads[k]);
+        else
+            Campaign_Worker(&workers[k]);
+    }
+    *elapsed_ns = Osal_NowNs() - t0;
+
+    for (int k = 0; k < count; k++)
+    {
+        if (workers[k].error)
+        {
+            printf("ERROR: Out of memory in campaign worker %d\n", k);
+            rc = 1;
+        }
+        Campaign_StatsMerge(st, workers[k].stats);
+    }
+
+done:
+    if (workers)
+    {
+        for (int k = 0; k < count; k++)
+            free(workers[k].stats);
+    }
+    free(started);
+    free(threads);
+    free(workers);
+    return rc;
+}
+
+/* ------------------------------
+ * 결과 출력
+ * ------------------------------ */
+
+static double Campaign_Ratio(uint64_t n, uint64_t d)
+{
+    return d ? (double)n / (double)d : 0.0;
+}
+
+static void Campaign_FormatLatency(char* buf, size_t size, const Histogram* h)
+{
+    if (h->count)
+        snprintf(buf, size, "%llu/%llu/%llu", (unsigned long long)Hist_Percentile(h, 50.0),
+            (unsigned long long)Hist_Percentile(h, 99.0), (unsigned long long)h->max);
+    else
+        snprintf(buf, size, "-");
+}
+
+void Campaign_PrintSummary(FILE* out, const CampaignOptions* opt, const CampaignStats* st, uint64_t elapsed_ns)
+{
+    double sec = elapsed_ns / 1e9;
+
+    fprintf(out, "Campaign : %llu sessions (%llu control, %llu skipped), seed %llu, %llu cycles, %.3f s (%.0f sessions/s, %.2f M cycles/s)\n",
+        (unsigned long long)st->sessions, (unsigned long long)st->control, (unsigned long long)st->skipped,
+        (unsigned long long)opt->seed, (unsigned long long)st->cycles, sec,
+        sec > 0 ? (double)st->sessions / sec : 0.0,
+        sec > 0 ? (double)st->cycles / sec / 1e6 : 0.0);
+
+    fprintf(out, "  %-5s %8s %8s %7s  %-19s %-19s %8s %9s %8s %7s\n",
+        "Fault", "inject", "confirm", "rate %", "detect p50/p99/max", "confirm p50/p99/max",
+        "false", "false/1k", "latched", "latch %");
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        char det[32];
+        char con[32];
+
+        Campaign_FormatLatency(det, sizeof(det), &st->detect_latency[code]);
+        Campaign_FormatLatency(con, sizeof(con), &st->confirm_latency[code]);
+
+        fprintf(out, "  0x%02X  %8llu %8llu %7.1f  %-19s %-19s %8llu %9.2f %8llu %7.2f\n", code,
+            (unsigned long long)st->injected[code], (unsigned long long)st->confirmed[code],
+            Campaign_Ratio(st->confirmed[code], st->injected[code]) * 100.0, det, con,
+            (unsigned long long)st->false_confirms[code],
+            Campaign_Ratio(st->false_confirms[code], st->sessions) * 1000.0,
+            (unsigned long long)st->latched[code],
+            Campaign_Ratio(st->latched[code], st->sessions) * 100.0);
+    }
+}
+
+void Campaign_WriteCsv(FILE* out, const CampaignStats* st)
+{
+    fprintf(out, "Fault,Sessions,Injected,Detected,Confirmed,Detect_P50,Detect_P99,Detect_Max,"
+        "Confirm_P50,Confirm_P99,Confirm_Max,False_Confirms,Latched\n");
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        const Histogram* d = &st->detect_latency[code];
+        const Histogram* c = &st->confirm_latency[code];
+
+        fprintf(out, "0x%02X,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n", code,
+            (unsigned long long)st->sessions, (unsigned long long)st->injected[code],
+            (unsigned long long)st->detected[code], (unsigned long long)st->confirmed[code],
+            (unsigned long long)Hist_Percentile(d, 50.0), (unsigned long long)Hist_Percentile(d, 99.0),
+            (unsigned long long)(d->count ? d->max : 0),
+            (unsigned long long)Hist_Percentile(c, 50.0), (unsigned long long)Hist_Percentile(c, 99.0),
+            (unsigned long long)(c->count ? c->max : 0),
+            (unsigned long long)st->false_confirms[code], (unsigned long long)st->latched[code]);
+    }
+}
+
+void Campaign_WriteHistCsv(FILE* out, const CampaignStats* st)
+{
+    char name[32];
+
+    fprintf(out, "metric,low_cycles,high_cycles,count\n");
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        snprintf(name, sizeof(name), "0x%02X_detect", code);
+        Hist_WriteCsv(out, name, &st->detect_latency[code]);
+        snprintf(name, sizeof(name), "0x%02X_confirm", code);
+        Hist_WriteCsv(out, name, &st->confirm_latency[code]);
+    }
+}
+
+static int Campaign_WriteFile(const char* path, const CampaignStats* st, int hist)
+{
+    FILE* fp = fopen(path, "w");
+
+    if (!fp)
+    {
+        printf("ERROR: Failed to open campaign output : %s\n", path);
+        return 1;
+    }
+    if (hist)
+        Campaign_WriteHistCsv(fp, st);
+    else
+        Campaign_WriteCsv(fp, st);
+
+    if (fclose(fp) != 0)
+    {
+        printf("ERROR: Failed to write campaign output : %s\n", path);
+        return 1;
+    }
+    return 0;
+}
+
+int Campaign_Main(int argc, char* argv[])
+{
+    CampaignOptions opt;
+    CampaignStats* st;
+    const char* out_path = NULL;
+    const char* hist_path = NULL;
+    uint64_t elapsed;
+    int rc = 0;
+
+    Campaign_DefaultOptions(&opt);
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--sessions=", 11) == 0)
+            opt.sessions = strtoull(argv[i] + 11, NULL, 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            opt.seed = strtoull(argv[i] + 7, NULL, 0);
+        else if (strncmp(argv[i], "--workers=", 10) == 0)
+            opt.workers = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--out=", 6) == 0)
+            out_path = argv[i] + 6;
+        else if (strncmp(argv[i], "--hist=", 7) == 0)
+            hist_path = argv[i] + 7;
+        else
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (opt.workers < 0)
+    {
+        printf("ERROR: Invalid campaign option value\n");
+        return 1;
+    }
+
+    st = (CampaignStats*)malloc(sizeof(*st));
+    if (!st)
+    {
+        printf("ERROR: Out of memory while starting campaign\n");
+        return 1;
+    }
+
+    if (Campaign_Run(&opt, st, &elapsed) != 0)
+        rc = 1;
+
+    if (rc == 0)
+    {
+        Campaign_PrintSummary(stdout, &opt, st, elapsed);
+        if (out_path && Campaign_WriteFile(out_path, st, 0) != 0)
+            rc = 1;
+        if (hist_path && Campaign_WriteFile(hist_path, st, 1) != 0)
+            rc = 1;
+    }
+
+    free(st);
+    return rc;
+}
@@ -0,0 +1,61 @@
+#ifndef CAMPAIGN_H
+#define CAMPAIGN_H
+#include <stdio.h>
+#include <stdint.h>
+#include "fault.h"
+#include "hist.h"
+#include "sim.h"
+
+/*
+ * Monte Carlo 고장 캠페인 (fault_engine --campaign)
+ *  - 세션마다 독립 폐루프 시뮬레이터(sim.h, 엔진 상태 포함)를 세션 seed stream(seed, 세션 번호)으로 만들어
+ *    플러그 연결 → 충전 → 분리까지 1 세션 실행
+ *  - 세션마다 외란 1개(또는 없음 : 대조 세션)를 충전 중 임의 시점에 주입하고, 그 외란이 원인인 고장을
+ *    기준으로 검출 / 확정 지연, 미확정, 원인 없는 확정(오확정), 세션 종료 후 남은 확정(래치)을 집계
+ *  - 통계는 합산 / Hist_Merge 로 병합 → 워커 수, 분배 순서와 무관하게 seed 만으로 같은 결과
+ */
+
+/* 고장 코드별 캠페인 통계 (지연 : 외란 시작 Cycle 기준 Cycle 수) */
+typedef struct
+{
+    uint64_t sessions;
+    uint64_t cycles;
+    uint64_t control;                       // 외란 없는 세션
+    uint64_t skipped;                       // 외란 시작 전 충전 종료 (주입 못함)
+    uint64_t injected[FAULT_MAX];           // 원인 고장별 외란 주입 세션
+    uint64_t detected[FAULT_MAX];           // 주입 후 원인 고장 DETECT 이상
+    uint64_t confirmed[FAULT_MAX];          // 주입 후 원인 고장 CONFIRM
+    uint64_t false_confirms[FAULT_MAX];     // 주입한 외란이 원인이 아닌 CONFIRM 진입
+    uint64_t latched[FAULT_MAX];            // 분리 + INIT 안정 후에도 CONFIRM 유지
+    Histogram detect_latency[FAULT_MAX];
+    Histogram confirm_latency[FAULT_MAX];
+} CampaignStats;
+
+typedef struct
+{
+    uint64_t sessions;
+    uint64_t seed;
+    int workers;                // 0 : CPU 개수
+    SimConfig cfg;              // 세션 시뮬레이터 설정 (외란 랜덤 주입 / 서비스 리셋 / 미결제 없음)
+} CampaignOptions;
+
+void Campaign_DefaultOptions(CampaignOptions* opt);
+
+void Campaign_StatsInit(CampaignStats* st);
+void Campaign_StatsMerge(CampaignStats* dst, const CampaignStats* src);
+
+/* ===== 세션 1개 실행 후 st 에 누적 (index : 세션 번호) ===== */
+void Campaign_Session(const CampaignOptions* opt, uint64_t index, SimWorld* w, CampaignStats* st);
+
+/* ===== 병렬 캠페인 실행 : 성공 0, 실패 1 ===== */
+int Campaign_Run(const CampaignOptions* opt, CampaignStats* st, uint64_t* elapsed_ns);
+
+/* ===== 결과 출력 : 고장별 표 / CSV / 지연 히스토그램 CSV ===== */
+void Campaign_PrintSummary(FILE* out, const CampaignOptions* opt, const CampaignStats* st, uint64_t elapsed_ns);
+void Campaign_WriteCsv(FILE* out, const CampaignStats* st);
+void Campaign_WriteHistCsv(FILE* out, const CampaignStats* st);
+
+/* ===== 명령행 진입점 : fault_engine --campaign [options] ===== */
+int Campaign_Main(int argc, char* argv[]);
+
+#endif /* CAMPAIGN_H */
@@ -0,0 +1,507 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "can_dbc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 기본 OBC 신호 정의 (028 고정 배치와 동일) */
+const char CanDbc_DefaultText[] =
+    "VERSION \"\"\n"
+    "BU_: OBC BMS IMD\n"
+    "\n"
+    "BO_ 256 OBC_Status: 8 OBC\n"
+    " SG_ Cycle : 0|32@1+ (1,0) [0|4294967295] \"\" Vector__XXX\n"
+    " SG_ SeqState : 32|3@1+ (1,0) [0|7] \"\" Vector__XXX\n"
+    " SG_ PlugInfo : 35|2@1+ (1,0) [0|3] \"\" Vector__XXX\n"
+    " SG_ FLAG_Stop : 37|1@1+ (1,0) [0|1] \"\" Vector__XXX\n"
+    " SG_ FLAG_Relay : 38|1@1+ (1,0) [0|1] \"\" Vector__XXX\n"
+    " SG_ FaultState : 40|8@1+ (1,0) [0|255] \"\" Vector__XXX\n"
+    " SG_ Charg_Cnt : 48|16@1+ (1,0) [0|65535] \"\" Vector__XXX\n"
+    "\n"
+    "BO_ 257 OBC_Current: 6 OBC\n"
+    " SG_ Ia : 0|16@1- (0.1,0) [-3276.8|3276.7] \"A\" Vector__XXX\n"
+    " SG_ Ib : 16|16@1- (0.1,0) [-3276.8|3276.7] \"A\" Vector__XXX\n"
+    " SG_ Ic : 32|16@1- (0.1,0) [-3276.8|3276.7] \"A\" Vector__XXX\n"
+    "\n"
+    "BO_ 258 BMS_Status: 7 BMS\n"
+    " SG_ Real_V : 0|16@1+ (1,0) [0|65535] \"V\" OBC\n"
+    " SG_ Exp_V : 16|16@1+ (1,0) [0|65535] \"V\" OBC\n"
+    " SG_ H : 32|16@1- (1,0) [-32768|32767] \"degC\" OBC\n"
+    " SG_ CanMsg : 48|1@1+ (1,0) [0|1] \"\" OBC\n"
+    "\n"
+    "BO_ 259 ISO_Status: 4 IMD\n"
+    " SG_ IsoR : 0|32@1+ (1,0) [0|4294967295] \"kOhm\" OBC\n";
+
+#define DBC_STD_IDS         2048u
+#define DBC_EXT_FLAG        0x80000000u
+#define DBC_INDEPENDENT_ID  0xC0000000u     // VECTOR__INDEPENDENT_SIG_MSG
+
+/* 신호 → 필드 저장 방식 */
+enum
+{
+    SIG_INT_RAW,        // int 필드, scale 1 / offset 0
+    SIG_INT_SCALED,     // int 필드, 물리값 반올림
+    SIG_CURRENT,        // 전류 필드, 고정소수점 빌드에서 scale / offset 이 LSB 정수배 : 정수 연산
+    SIG_FLOAT           // 전류 필드, 실수 변환
+};
+
+typedef struct
+{
+    uint64_t mask;
+    uint64_t sign;              // 부호 bit (unsigned : 0)
+    double scale;
+    double offset;
+    int64_t lsb_scale;          // SIG_CURRENT : scale / offset 의 InputCurrent LSB 수
+    int64_t lsb_offset;
+    uint16_t field;             // offsetof(InputSnapshot, 필드)
+    uint8_t shift;              // 64bit 워드 내 LSB 위치
+    uint8_t motorola;           // 1 : Big Endian 워드 기준
+    uint8_t kind;
+} DbcSignal;
+
+typedef struct
+{
+    uint32_t id;
+    uint16_t first;             // sigs[first .. first+count)
+    uint16_t count;
+    uint8_t min_dlc;            // 모든 신호를 담는 최소 DLC
+    uint8_t closes_cycle;       // Cycle 신호 포함
+} DbcMessage;
+
+struct CanDecodeTable
+{
+    uint16_t std_index[DBC_STD_IDS];   // 11bit ID → 메시지 번호 + 1 (0 : 미정의)
+
+    uint32_t* ext_ids;          // 29bit ID open addressing (ext_mask + 1 칸)
+    uint16_t* ext_index;
+    uint32_t ext_mask;
+
+    DbcMessage* msgs;
+    int msg_count;
+    int msg_cap;
+
+    DbcSignal* sigs;
+    int sig_count;
+    int sig_cap;
+};
+
+static uint32_t Ext_Slot(uint32_t id, uint32_t mask)
+{
+    return (id * 2654435761u) & mask;
+}
+
+static int Table_Grow(void** p, int* cap, int need, size_t elem)
+{
+    if (need <= *cap)
+        return 1;
+
+    int n = *cap ? *cap * 2 : 16;
+    while (n < need)
+        n *= 2;
+
+    void* q = realloc(*p, (size_t)n * elem);
+    if (!q)
+        return 0;
+    *p = q;
+    *cap = n;
+    return 1;
+}
+
+/* 메시지 마감 : 반영할 신호가 없는 메시지는 제외 */
+static void Message_Close(CanDecodeTable* t)
+{
+    if (t->msg_count > 0 && t->msgs[t->msg_count - 1].count == 0)
+        t->msg_count--;
+}
+
+static int Message_Find(const CanDecodeTable* t, uint32_t id)
+{
+    for (int i = 0; i < t->msg_count; i++)
+    {
+        if (t->msgs[i].id == id)
+            return i;
+    }
+    return -1;
+}
+
+/* " SG_ <name> : <start>|<len>@<order><sign> (<scale>,<offset>) ..." */
+static int Signal_Parse(CanDecodeTable* t, const char* p, int lineNo)
+{
+    DbcMessage* m = &t->msgs[t->msg_count - 1];
+    DbcSignal s;
+    char name[128];
+    const char* colon = strchr(p, ':');
+    const char* q;
+    int start, len;
+    char order, sign;
+    double scale, offset;
+
+    if (!colon || sscanf(p, "SG_ %127[^: \t]", name) != 1)
+    {
+        printf("ERROR: DBC line %d : invalid SG_ definition\n", lineNo);
+        return 0;
+    }
+
+    /* 이름과 ':' 사이에 멀티플렉서 표시(M / mN)가 있으면 미지원 → 무시 */
+    q = strstr(p, name) + strlen(name);
+    while (q < colon && (*q == ' ' || *q == '\t'))
+        q++;
+    if (q != colon)
+        return 1;
+
+    if (sscanf(colon + 1, " %d|%d@%c%c (%lf,%lf)", &start, &len, &order, &sign, &scale, &offset) != 6 ||
+        (order != '0' && order != '1') || (sign != '+' && sign != '-') ||
+        len < 1 || len > 64 || start < 0 || start > 63)
+    {
+        printf("ERROR: DBC line %d : invalid signal layout (%s)\n", lineNo, name);
+        return 0;
+    }
+
+    const InputField* field = Input_FindField(name);
+    if (!field)
+        return 1;               // 엔진 입력이 아닌 신호
+
+    memset(&s, 0, sizeof(s));
+    s.mask = (len == 64) ? ~0ull : ((1ull << len) - 1);
+    s.sign = (sign == '-') ? (1ull << (len - 1)) : 0;
+    s.scale = scale;
+    s.offset = offset;
+    s.field = (uint16_t)field->offset;
+    s.motorola = (order == '0');
+
+    int min_dlc;
+    if (s.motorola)
+    {
+        /* start = MSB (byte 내 bit 번호 + byte*8), data[0]이 상위 byte인 워드로 변환 */
+        int msb = (7 - start / 8) * 8 + start % 8;
+        int lsb = msb - (len - 1);
+        if (lsb < 0)
+        {
+            printf("ERROR: DBC line %d : signal exceeds 8 bytes (%s)\n", lineNo, name);
+            return 0;
+        }
+        s.shift = (uint8_t)lsb;
+        min_dlc = 8 - lsb / 8;
+    }
+    else
+    {
+        if (start + len > 64)
+        {
+            printf("ERROR: DBC line %d : signal exceeds 8 bytes (%s)\n", lineNo, name);
+            return 0;
+        }
+        s.shift = (uint8_t)start;
+        min_dlc = (start + len - 1) / 8 + 1;
+    }
+
+    if (field->is_float)
+    {
+        s.kind = SIG_FLOAT;
+#ifdef OBC_FIXED_POINT
+        /* 0.5 mA 배수인 scale / offset 은 프레임 디코드를 정수 곱셈 1번으로 */
+        {
+            double ls = scale * INPUT_CURRENT_SCALE;
+            double lo = offset * INPUT_CURRENT_SCALE;
+
+            if (ls == (double)(int64_t)ls && lo == (double)(int64_t)lo &&
+                ls >= -1073741824.0 && ls <= 1073741824.0 && lo >= -1073741824.0 && lo <= 1073741824.0)
+            {
+                s.kind = SIG_CURRENT;
+                s.lsb_scale = (int64_t)ls;
+                s.lsb_offset = (int64_t)lo;
+            }
+        }
+#endif
+    }
+    else if (scale == 1.0 && offset == 0.0)
+        s.kind = SIG_INT_RAW;
+    else
+        s.kind = SIG_INT_SCALED;
+
+    if (!Table_Grow((void**)&t->sigs, &t->sig_cap, t->sig_count + 1, sizeof(*t->sigs)))
+        return 0;
+
+    t->sigs[t->sig_count++] = s;
+    m->count++;
+    if (min_dlc > m->min_dlc)
+        m->min_dlc = (uint8_t)min_dlc;
+    if (strcmp(field->name, "Cycle") == 0)
+        m->closes_cycle = 1;
+    return 1;
+}
+
+/* ID → 메시지 번호 조회 테이블 구성 */
+static int Index_Build(CanDecodeTable* t)
+{
+    int ext = 0;
+
+    for (int i = 0; i < t->msg_count; i++)
+    {
+        if (t->msgs[i].id >= DBC_STD_IDS)
+            ext++;
+    }
+
+    if (ext > 0)
+    {
+        uint32_t size = 4;
+        while (size < (uint32_t)ext * 2)
+            size *= 2;
+
+        t->ext_ids = (uint32_t*)malloc(size * sizeof(*t->ext_ids));
+        t->ext_index = (uint16_t*)calloc(size, sizeof(*t->ext_index));
+        if (!t->ext_ids || !t->ext_index)
+            return 0;
+        t->ext_mask = size - 1;
+    }
+
+    for (int i = 0; i < t->msg_count; i++)
+    {
+        uint32_t id = t->msgs[i].id;
+
+        if (id < DBC_STD_IDS)
+        {
+            t->std_index[id] = (uint16_t)(i + 1);
+            continue;
+        }
+
+        uint32_t slot = Ext_Slot(id, t->ext_mask);
+        while (t->ext_index[slot])
+            slot = (slot + 1) & t->ext_mask;
+        t->ext_ids[slot] = id;
+        t->ext_index[slot] = (uint16_t)(i + 1);
+    }
+    return 1;
+}
+
+CanDecodeTable* CanDbc_Compile(const char* text)
+{
+    CanDecodeTable* t = (CanDecodeTable*)calloc(1, sizeof(*t));
+    const char* p = text;
+    char line[1024];
+    int lineNo = 0;
+    int in_message = 0;
+    int cycle_found = 0;
+
+    if (!t)
+        return NULL;
+
+    while (*p)
+    {
+        const char* nl = strchr(p, '\n');
+        size_t len = nl ? (size_t)(nl - p) : strlen(p);
+        const char* s = line;
+
+        if (len >= sizeof(line))
+            len = sizeof(line) - 1;
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p = nl ? nl + 1 : p + strlen(p);
+        lineNo++;
+
+        while (*s == ' ' || *s == '\t')
+            s++;
+
+        if (strncmp(s, "BO_ ", 4) == 0)
+        {
+            unsigned long raw;
+            int dlc;
+
+            Message_Close(t);
+            in_message = 0;
+
+            if (sscanf(s, "BO_ %lu %*[^:]: %d", &raw, &dlc) != 2 || dlc < 0 || dlc > 8)
+            {
+                printf("ERROR: DBC line %d : invalid BO_ definition\n", lineNo);
+                goto fail;
+            }
+
+            /* 신호 묶음용 가상 메시지는 제외 */
+            if ((uint32_t)raw == DBC_INDEPENDENT_ID)
+                continue;
+
+            uint32_t id = (raw & DBC_EXT_FLAG) ? (uint32_t)(raw & 0x1FFFFFFFu) : (uint32_t)(raw & 0x7FFu);
+            if (Message_Find(t, id) >= 0)
+            {
+                printf("ERROR: DBC line %d : duplicate message ID 0x%X\n", lineNo, (unsigned)id);
+                goto fail;
+            }
+
+            if (t->msg_count >= 0xFFFF ||
+                !Table_Grow((void**)&t->msgs, &t->msg_cap, t->msg_count + 1, sizeof(*t->msgs)))
+                goto nomem;
+
+            DbcMessage* m = &t->msgs[t->msg_count++];
+            memset(m, 0, sizeof(*m));
+            m->id = id;
+            m->first = (uint16_t)t->sig_count;
+            in_message = 1;
+        }
+        else if (strncmp(s, "SG_ ", 4) == 0)
+        {
+            if (in_message && !Signal_Parse(t, s, lineNo))
+                goto fail;
+        }
+        else if (*s != '\0')
+        {
+            /* 그 외 섹션(CM_, BA_, VAL_ 등)은 무시, 메시지 정의 종료 */
+            Message_Close(t);
+            in_message = 0;
+        }
+    }
+    Message_Close(t);
+
+    for (int i = 0; i < t->msg_count; i++)
+        cycle_found |= t->msgs[i].closes_cycle;
+
+    if (!cycle_found)
+    {
+        printf("ERROR: DBC has no message carrying the Cycle signal\n");
+        goto fail;
+    }
+
+    if (!Index_Build(t))
+        goto nomem;
+    return t;
+
+nomem:
+    printf("ERROR: Out of memory while compiling DBC\n");
+fail:
+    CanDbc_Free(t);
+    return NULL;
+}
+
+CanDecodeTable* CanDbc_Load(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    CanDecodeTable* t;
+    char* text;
+    long size;
+
+    if (!fp)
+    {
+        printf("ERROR: Failed to open DBC file : %s\n", path);
+        return NULL;
+    }
+
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0)
+    {
+        printf("ERROR: Failed to read DBC file : %s\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    text = (char*)malloc((size_t)size + 1);
+    if (!text || fread(text, 1, (size_t)size, fp) != (size_t)size)
+    {
+        printf("ERROR: Failed to read DBC file : %s\n", path);
+        free(text);
+        fclose(fp);
+        return NULL;
+    }
+    text[size] = '\0';
+    fclose(fp);
+
+    t = CanDbc_Compile(text);
+    free(text);
+    return t;
+}
+
+void CanDbc_Free(CanDecodeTable* t)
+{
+    if (!t)
+        return;
+    free(t->ext_ids);
+    free(t->ext_index);
+    free(t->msgs);
+    free(t->sigs);
+    free(t);
+}
+
+const CanDecodeTable* CanDbc_Default(void)
+{
+    /* 최초 호출 시 1회 컴파일 (스레드 시작 전 호출) */
+    static CanDecodeTable* table = NULL;
+
+    if (!table)
+        table = CanDbc_Compile(CanDbc_DefaultText);
+    return table;
+}
+
+int CanDbc_Decode(const CanDecodeTable* t, const CanFrame* f, InputSnapshot* out)
+{
+    const DbcMessage* m;
+    unsigned int idx = 0;
+    uint64_t le = 0;
+    uint64_t be = 0;
+    char* base = (char*)out;
+
+    if (f->id < DBC_STD_IDS)
+        idx = t->std_index[f->id];
+    else if (t->ext_index)
+    {
+        for (uint32_t slot = Ext_Slot(f->id, t->ext_mask); t->ext_index[slot]; slot = (slot + 1) & t->ext_mask)
+        {
+            if (t->ext_ids[slot] == f->id)
+            {
+                idx = t->ext_index[slot];
+                break;
+            }
+        }
+    }
+
+    if (idx == 0)
+        return CAN_DECODE_UNKNOWN;
+
+    m = &t->msgs[idx - 1];
+    if (f->dlc < m->min_dlc)
+        return CAN_DECODE_UNKNOWN;
+
+    for (int i = 0; i < 8; i++)
+    {
+        le |= (uint64_t)f->data[i] << (8 * i);
+        be = (be << 8) | f->data[i];
+    }
+
+    for (const DbcSignal* s = &t->sigs[m->first], *e = s + m->count; s < e; s++)
+    {
+        uint64_t raw = ((s->motorola ? be : le) >> s->shift) & s->mask;
+        int64_t v = (int64_t)((raw ^ s->sign) - s->sign);   // 부호 확장
+
+        switch (s->kind)
+        {
+        case SIG_INT_RAW:
+            *(int*)(base + s->field) = (int)v;
+            break;
+        case SIG_INT_SCALED:
+        {
+            double phys = (double)v * s->scale + s->offset;
+            *(int*)(base + s->field) = (int)(phys < 0 ? phys - 0.5 : phys + 0.5);
+            break;
+        }
+        case SIG_CURRENT:
+        {
+            /* |v| 2^32 제한 : 넘으면 어차피 포화 */
+            int64_t c = v > 4294967296LL ? 4294967296LL : (v < -4294967296LL ? -4294967296LL : v);
+
+            c = c * s->lsb_scale + s->lsb_offset;
+            *(InputCurrent*)(base + s->field) = (InputCurrent)(c > INT32_MAX ? INT32_MAX : (c < INT32_MIN ? INT32_MIN : c));
+            break;
+        }
+        default:
+            *(InputCurrent*)(base + s->field) = Input_CurrentFromDouble((double)v * s->scale + s->offset);
+            break;
+        }
+    }
+
+    return m->closes_cycle ? CAN_DECODE_CYCLE : CAN_DECODE_SIGNAL;
+}
+
+int CanDbc_MessageCount(const CanDecodeTable* t)
+{
+    return t->msg_count;
+}
+
+int CanDbc_SignalCount(const CanDecodeTable* t)
+{
+    return t->sig_count;
+}
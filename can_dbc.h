@@ -0,0 +1,47 @@
+#ifndef CAN_DBC_H
+#define CAN_DBC_H
+#include <stdint.h>
+#include "input.h"
+
+/*
+ * DBC(부분 집합) 기반 CAN 신호 디코더
+ *  - 지원 : BO_ (메시지 ID / DLC), SG_ (start bit, 길이, byte order, 부호, scale, offset)
+ *  - 신호 이름이 InputSnapshot 필드 이름과 같으면 해당 필드로 디코드 (Input_FindField)
+ *  - Cycle 신호를 포함한 메시지 = Cycle 종료 메시지
+ *  - 로드 시 메시지 ID별 디코드 테이블로 컴파일 (shift/mask/부호확장/scale 사전 계산)
+ *    → 프레임 1개 디코드 = 테이블 조회 1회 + 신호별 ALU 연산
+ *  - 미지원 : 멀티플렉스 신호, 11bit/29bit 동일 ID 구분
+ */
+
+typedef struct
+{
+    uint32_t id;
+    uint8_t dlc;
+    uint8_t data[8];
+    uint64_t rx_ns;             // 수신 시각 (ns)
+} CanFrame;
+
+typedef struct CanDecodeTable CanDecodeTable;
+
+/* CanDbc_Decode 결과 */
+#define CAN_DECODE_UNKNOWN  0   // 정의되지 않은 ID 또는 DLC 부족
+#define CAN_DECODE_SIGNAL   1   // 신호 반영
+#define CAN_DECODE_CYCLE    2   // 신호 반영 + Cycle 종료 메시지
+
+/* DBC 텍스트 / 파일 컴파일 : 실패 시 NULL (오류 내용 출력) */
+CanDecodeTable* CanDbc_Compile(const char* text);
+CanDecodeTable* CanDbc_Load(const char* path);
+void CanDbc_Free(CanDecodeTable* table);
+
+/* 기본 OBC 신호 정의 (CanDbc_DefaultText) 테이블 */
+const CanDecodeTable* CanDbc_Default(void);
+extern const char CanDbc_DefaultText[];
+
+/* 프레임 1개를 out 필드에 디코드 */
+int CanDbc_Decode(const CanDecodeTable* table, const CanFrame* f, InputSnapshot* out);
+
+/* 테이블 정보 */
+int CanDbc_MessageCount(const CanDecodeTable* table);
+int CanDbc_SignalCount(const CanDecodeTable* table);
+
+#endif /* CAN_DBC_H */
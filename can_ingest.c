@@ -0,0 +1,242 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#ifdef __linux__
+#define _GNU_SOURCE     /* SocketCAN / SO_TIMESTAMPNS */
+#endif
+#include "can_ingest.h"
+#include "fault.h"
+#include "output.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#endif
+
+void CanAsm_Init(CanAssembler* a, const CanDecodeTable* dbc)
+{
+    memset(a, 0, sizeof(*a));
+    a->dbc = dbc ? dbc : CanDbc_Default();
+}
+
+int CanAsm_Feed(CanAssembler* a, const CanFrame* f)
+{
+    /* 새 Cycle 시작 : Cycle별 수신 여부 신호만 초기화 */
+    if (a->closed)
+    {
+        a->snapshot.CanMsg = 0;
+        a->closed = 0;
+    }
+
+    a->frames++;
+
+    switch (CanDbc_Decode(a->dbc, f, &a->snapshot))
+    {
+    case CAN_DECODE_CYCLE:
+        /* Cycle 마지막 프레임 → 진단 가능 */
+        a->closed = 1;
+        a->cycles++;
+        return 1;
+
+    case CAN_DECODE_SIGNAL:
+        return 0;
+
+    default:
+        a->unknown++;
+        return 0;
+    }
+}
+
+#ifdef __linux__
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void CanIngest_OnSignal(int sig)
+{
+    (void)sig;
+    stopRequested = 1;
+}
+
+static uint64_t Realtime_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int CanSocket_Open(const char* ifname)
+{
+    struct sockaddr_can addr;
+    struct ifreq ifr;
+    int on = 1;
+    int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+
+    if (s < 0)
+    {
+        printf("ERROR: Failed to open CAN socket (%s)\n", strerror(errno));
+        return -1;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+    if (ioctl(s, SIOCGIFINDEX, &ifr) < 0)
+    {
+        printf("ERROR: CAN interface not found : %s\n", ifname);
+        close(s);
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(s, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        printf("ERROR: Failed to bind CAN interface : %s (%s)\n", ifname, strerror(errno));
+        close(s);
+        return -1;
+    }
+
+    /* 커널 수신 시각 (마지막 프레임 → 진단 완료 지연 측정용) */
+    setsockopt(s, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+    return s;
+}
+
+/* 프레임 1개 수신 : 성공 1, 중단 0, 오류 -1 */
+static int CanSocket_Read(int s, CanFrame* f)
+{
+    struct can_frame cf;
+    char ctrl[CMSG_SPACE(sizeof(struct timespec))];
+    struct iovec iov = { &cf, sizeof(cf) };
+    struct msghdr msg;
+    struct cmsghdr* cmsg;
+
+    for (;;)
+    {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+
+        ssize_t n = recvmsg(s, &msg, 0);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                if (stopRequested)
+                    return 0;
+                continue;
+            }
+            printf("ERROR: CAN receive failed (%s)\n", strerror(errno));
+            return -1;
+        }
+
+        /* 에러/원격 프레임 제외 */
+        if ((size_t)n < sizeof(cf) || (cf.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)))
+            continue;
+
+        f->id = cf.can_id & ((cf.can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+        f->dlc = cf.can_dlc > 8 ? 8 : cf.can_dlc;
+        memcpy(f->data, cf.data, 8);
+        f->rx_ns = 0;
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+            {
+                struct timespec ts;
+                memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                f->rx_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+            }
+        }
+        if (f->rx_ns == 0)
+            f->rx_ns = Realtime_Ns();
+        return 1;
+    }
+}
+
+int CanIngest_RunSocketCan(const char* ifname, FILE* out,
+    const CanIngestOptions* opt, CanIngestStats* stats)
+{
+    struct sigaction sa;
+    CanAssembler a;
+    CanFrame f;
+    int s;
+    int rc;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->latency_min_ns = UINT64_MAX;
+
+    s = CanSocket_Open(ifname);
+    if (s < 0)
+        return 1;
+
+    /* Ctrl+C 로 종료 (recvmsg 재시작 없이 EINTR) */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = CanIngest_OnSignal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    Fault_Init();
+    CanAsm_Init(&a, opt->dbc);
+
+    while ((rc = CanSocket_Read(s, &f)) > 0)
+    {
+        if (!CanAsm_Feed(&a, &f))
+            continue;
+
+        /* Cycle 완성 즉시 진단 */
+        Fault_Diagnose(&a.snapshot);
+
+        uint64_t latency = Realtime_Ns() - f.rx_ns;
+        if (latency < stats->latency_min_ns)
+            stats->latency_min_ns = latency;
+        if (latency > stats->latency_max_ns)
+            stats->latency_max_ns = latency;
+        stats->latency_sum_ns += latency;
+        stats->cycles++;
+
+        if (opt->shm)
+            ShmStatus_Publish(opt->shm, &a.snapshot, Fault_GetContext());
+        if (opt->metrics)
+            Metrics_Row(opt->metrics, Fault_PackStatus(Fault_GetContext()));
+        if (opt->events)
+            EventLog_Step(opt->events, Fault_GetContext(), &a.snapshot);
+
+        Output_WriteRow(out, a.snapshot.Cycle, Fault_GetContext());
+
+        if (opt->cycles && stats->cycles >= opt->cycles)
+            break;
+    }
+
+    stats->frames = a.frames;
+    if (stats->cycles == 0)
+        stats->latency_min_ns = 0;
+
+    close(s);
+    return rc < 0 ? 1 : 0;
+}
+
+#else
+
+int CanIngest_RunSocketCan(const char* ifname, FILE* out,
+    const CanIngestOptions* opt, CanIngestStats* stats)
+{
+    (void)ifname;
+    (void)out;
+    (void)opt;
+    memset(stats, 0, sizeof(*stats));
+    printf("ERROR: SocketCAN is only supported on Linux\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef CAN_INGEST_H
+#define CAN_INGEST_H
+#include <stdio.h>
+#include <stdint.h>
+#include "input.h"
+#include "can_dbc.h"
+#include "shm_status.h"
+#include "metrics.h"
+#include "event_log.h"
+
+/*
+ * CAN 프레임 → InputSnapshot 조립
+ *  - 1 Cycle = 여러 CAN 메시지. Cycle 신호를 담은 메시지(기본 : 0x100 OBC_Status)가
+ *    Cycle의 마지막 프레임으로 송신되며, 이 프레임 수신 시 Cycle 완성
+ *  - 신호 배치는 DBC 디코드 테이블(can_dbc.h)로 정의, 기본값은 CanDbc_DefaultText
+ *  - 신호값은 다음 수신 전까지 유지(sample & hold),
+ *    CanMsg(BMS 메시지 수신 여부)만 Cycle마다 0으로 초기화
+ */
+
+typedef struct
+{
+    const CanDecodeTable* dbc;  // 신호 디코드 테이블
+    InputSnapshot snapshot;     // 조립 중인 Cycle (완성 시 진단 입력)
+    int closed;                 // 직전 Feed에서 Cycle 완성
+    uint64_t frames;            // 수신 프레임 수
+    uint64_t unknown;           // 정의되지 않은 ID / DLC 부족 프레임 수
+    uint64_t cycles;            // 완성된 Cycle 수
+} CanAssembler;
+
+/* Cycle 조립기 초기화 (dbc NULL : 기본 신호 정의) */
+void CanAsm_Init(CanAssembler* a, const CanDecodeTable* dbc);
+
+/* 프레임 1개 반영 : Cycle 완성 시 1 (a->snapshot 사용 후 다음 Feed에서 새 Cycle 시작) */
+int CanAsm_Feed(CanAssembler* a, const CanFrame* f);
+
+typedef struct
+{
+    uint64_t cycles;            // 진단한 Cycle 수 (0 : 무제한)
+    const CanDecodeTable* dbc;  // 신호 정의 (NULL : 기본)
+    ShmPublisher* shm;          // Cycle 마다 상태 게시 (NULL : 안 함)
+    MetricsThread* metrics;     // Cycle 마다 지표 기록 (NULL : 안 함)
+    EventWriter* events;        // 고장 상태 전이 기록 (NULL : 안 함)
+} CanIngestOptions;
+
+typedef struct
+{
+    uint64_t frames;
+    uint64_t cycles;
+    uint64_t latency_min_ns;    // 마지막 프레임 수신 → 고장 상태 확정
+    uint64_t latency_max_ns;
+    uint64_t latency_sum_ns;
+} CanIngestStats;
+
+/* ===== SocketCAN 실시간 수신 진단 (Linux) : 성공 0, 실패 1 ===== */
+int CanIngest_RunSocketCan(const char* ifname, FILE* out,
+    const CanIngestOptions* opt, CanIngestStats* stats);
+
+#endif /* CAN_INGEST_H */
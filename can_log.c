@@ -0,0 +1,333 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "can_log.h"
+#include "can_ingest.h"
+#include "fault.h"
+#include "output.h"
+#include "osal.h"
+#include <ctype.h>
+#include <string.h>
+
+#define CAN_LOG_LINE_MAX    1024
+#define CAN_LOG_IOBUF       (1 << 20)
+
+#define CAN_ERR_FRAME_FLAG  0x20000000u     // candump 에러 프레임 ID bit
+
+static int Hex_Digit(int c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+static const char* Skip_Space(const char* p)
+{
+    while (*p == ' ' || *p == '\t')
+        p++;
+    return p;
+}
+
+static const char* Skip_Token(const char* p)
+{
+    while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+        p++;
+    return p;
+}
+
+static int Is_End(int c)
+{
+    return c == '\0' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/* "초.소수" → ns (소수 9자리까지, 부동소수 변환 없음) */
+static const char* Parse_Time(const char* p, uint64_t* ns)
+{
+    uint64_t sec = 0;
+    uint64_t frac = 0;
+    int digits = 0;
+
+    if (!isdigit((unsigned char)*p))
+        return NULL;
+
+    while (isdigit((unsigned char)*p))
+        sec = sec * 10 + (uint64_t)(*p++ - '0');
+
+    if (*p == '.')
+    {
+        p++;
+        while (isdigit((unsigned char)*p))
+        {
+            if (digits < 9)
+            {
+                frac = frac * 10 + (uint64_t)(*p - '0');
+                digits++;
+            }
+            p++;
+        }
+    }
+
+    while (digits++ < 9)
+        frac *= 10;
+
+    *ns = sec * 1000000000ull + frac;
+    return p;
+}
+
+/* 숫자 토큰 : base 16 / 10, 읽은 자리 수 반환 (0 : 숫자 아님) */
+static int Parse_Number(const char** pp, int base, uint32_t* value)
+{
+    const char* p = *pp;
+    uint32_t v = 0;
+    int n = 0;
+    int d;
+
+    while ((d = (base == 16) ? Hex_Digit(*p) : (isdigit((unsigned char)*p) ? *p - '0' : -1)) >= 0)
+    {
+        v = v * (uint32_t)base + (uint32_t)d;
+        p++;
+        n++;
+    }
+
+    *pp = p;
+    *value = v;
+    return n;
+}
+
+/* (1436509052.249713) can0 100#0011223344556677 */
+static int Candump_Parse(const char* p, CanFrame* f)
+{
+    uint32_t id;
+    int n;
+
+    p = Skip_Space(p);
+    if (*p++ != '(' || !(p = Parse_Time(p, &f->rx_ns)) || *p++ != ')')
+        return 0;
+
+    p = Skip_Token(Skip_Space(p));      // 인터페이스 이름
+    p = Skip_Space(p);
+
+    n = Parse_Number(&p, 16, &id);
+    if (*p++ != '#' || (n != 3 && n != 8))
+        return 0;
+
+    /* CAN FD(##) / 원격(R) / 에러 프레임 제외 */
+    if (*p == '#' || *p == 'R' || (n == 8 && (id & CAN_ERR_FRAME_FLAG)))
+        return 0;
+
+    f->id = id & 0x1FFFFFFFu;
+    f->dlc = 0;
+    memset(f->data, 0, sizeof(f->data));
+
+    while (!Is_End(*p))
+    {
+        int hi = Hex_Digit(p[0]);
+        int lo = (hi >= 0) ? Hex_Digit(p[1]) : -1;
+
+        if (lo < 0 || f->dlc == 8)
+            return 0;
+        f->data[f->dlc++] = (uint8_t)((hi << 4) | lo);
+        p += 2;
+    }
+    return 1;
+}
+
+/* 0.015991 1  100  Rx   d 8 00 11 22 33 44 55 66 77  Length = ... */
+static int Asc_Parse(CanLogReader* r, const char* p, CanFrame* f)
+{
+    int base = r->asc_dec ? 10 : 16;
+    uint32_t channel, id, dlc, byte;
+    uint64_t t;
+
+    p = Skip_Space(p);
+    if (!isdigit((unsigned char)*p))
+    {
+        /* 헤더 : "base hex  timestamps absolute" */
+        if (strncmp(p, "base ", 5) == 0)
+        {
+            r->asc_dec = (strncmp(p + 5, "dec", 3) == 0);
+            r->asc_relative = (strstr(p, "timestamps relative") != NULL);
+        }
+        return 0;
+    }
+
+    if (!(p = Parse_Time(p, &t)))
+        return 0;
+
+    if (r->asc_relative)
+    {
+        r->asc_time_ns += t;
+        t = r->asc_time_ns;
+    }
+
+    /* 채널 번호 (CANFD / 이벤트 줄 제외) */
+    p = Skip_Space(p);
+    if (!Parse_Number(&p, 10, &channel) || !Is_End(*p))
+        return 0;
+
+    p = Skip_Space(p);
+    if (!Parse_Number(&p, base, &id))
+        return 0;
+    if (*p == 'x' || *p == 'X')
+        p++;
+    else
+        id &= 0x7FFu;
+    if (!Is_End(*p))
+        return 0;               // ErrorFrame 등
+
+    p = Skip_Token(Skip_Space(p));      // Rx / Tx
+    p = Skip_Space(p);
+    if (*p != 'd' || !Is_End(p[1]))
+        return 0;               // 원격 프레임(r)
+    p = Skip_Space(p + 1);
+
+    if (!Parse_Number(&p, 16, &dlc) || dlc > 8)
+        return 0;
+
+    f->id = id & 0x1FFFFFFFu;
+    f->dlc = (uint8_t)dlc;
+    f->rx_ns = t;
+    memset(f->data, 0, sizeof(f->data));
+
+    for (uint32_t i = 0; i < dlc; i++)
+    {
+        p = Skip_Space(p);
+        if (!Parse_Number(&p, base, &byte) || byte > 0xFF)
+            return 0;
+        f->data[i] = (uint8_t)byte;
+    }
+    return 1;
+}
+
+CanLogFormat CanLog_DetectFormat(const char* path)
+{
+    const char* ext = strrchr(path, '.');
+    char lower[8];
+    size_t i;
+
+    if (!ext || strlen(ext) >= sizeof(lower))
+        return CAN_LOG_NONE;
+
+    for (i = 0; ext[i]; i++)
+        lower[i] = (char)tolower((unsigned char)ext[i]);
+    lower[i] = '\0';
+
+    if (strcmp(lower, ".log") == 0)
+        return CAN_LOG_CANDUMP;
+    if (strcmp(lower, ".asc") == 0)
+        return CAN_LOG_ASC;
+    return CAN_LOG_NONE;
+}
+
+int CanLog_Open(CanLogReader* r, const char* path, CanLogFormat format)
+{
+    memset(r, 0, sizeof(*r));
+    r->format = format;
+    r->fp = fopen(path, "r");
+    if (!r->fp)
+        return 0;
+
+    setvbuf(r->fp, NULL, _IOFBF, CAN_LOG_IOBUF);
+    return 1;
+}
+
+int CanLog_Next(CanLogReader* r, CanFrame* f)
+{
+    char line[CAN_LOG_LINE_MAX];
+
+    while (fgets(line, sizeof(line), r->fp) != NULL)
+    {
+        size_t len = strlen(line);
+        int ok;
+
+        /* 버퍼보다 긴 줄은 나머지를 버림 */
+        if (len == sizeof(line) - 1 && line[len - 1] != '\n')
+        {
+            int c;
+            while ((c = fgetc(r->fp)) != EOF && c != '\n')
+                ;
+        }
+
+        r->lines++;
+        ok = (r->format == CAN_LOG_ASC) ? Asc_Parse(r, line, f) : Candump_Parse(line, f);
+        if (ok)
+            return 1;
+        r->skipped++;
+    }
+    return 0;
+}
+
+void CanLog_Close(CanLogReader* r)
+{
+    if (r->fp)
+        fclose(r->fp);
+    r->fp = NULL;
+}
+
+int CanLog_Run(const char* path, CanLogFormat format, FILE* out,
+    const CanLogOptions* opt, CanLogStats* stats)
+{
+    CanLogReader r;
+    CanAssembler a;
+    CanFrame f;
+    uint64_t wall0 = 0;
+    uint64_t log0 = 0;
+    int first = 1;
+    int rc = 0;
+
+    memset(stats, 0, sizeof(*stats));
+
+    if (!CanLog_Open(&r, path, format))
+    {
+        printf("ERROR: Failed to open CAN log : %s\n", path);
+        return 1;
+    }
+
+    Fault_Init();
+    CanAsm_Init(&a, opt->dbc);
+
+    while (CanLog_Next(&r, &f))
+    {
+        /* 원래 시각 간격대로 재생 (로그 시각이 뒤로 가면 대기 없이 진행) */
+        if (opt->realtime)
+        {
+            if (first)
+            {
+                wall0 = Osal_NowNs();
+                log0 = f.rx_ns;
+                first = 0;
+            }
+            else if (f.rx_ns > log0)
+            {
+                uint64_t target = wall0 + (f.rx_ns - log0);
+                uint64_t now = Osal_NowNs();
+
+                if (target > now)
+                    Osal_SleepNs(target - now);
+            }
+        }
+
+        if (!CanAsm_Feed(&a, &f))
+            continue;
+
+        Fault_Diagnose(&a.snapshot);
+        Output_WriteRow(out, a.snapshot.Cycle, Fault_GetContext());
+    }
+
+    if (ferror(r.fp))
+    {
+        printf("ERROR: Failed to read CAN log : %s\n", path);
+        rc = 1;
+    }
+
+    stats->lines = r.lines;
+    stats->skipped = r.skipped;
+    stats->frames = a.frames;
+    stats->unknown = a.unknown;
+    stats->cycles = a.cycles;
+
+    CanLog_Close(&r);
+    return rc;
+}
@@ -0,0 +1,63 @@
+#ifndef CAN_LOG_H
+#define CAN_LOG_H
+#include <stdio.h>
+#include <stdint.h>
+#include "can_dbc.h"
+
+/*
+ * CAN 로그 파일 입력 (CSV 변환 없이 직접 진단)
+ *  - candump (.log) : "(1436509052.249713) can0 100#0011223344556677"
+ *  - Vector ASC (.asc) : "   0.015991 1  100  Rx   d 8 00 11 22 33 44 55 66 77 ..."
+ *    (base hex/dec, timestamps absolute/relative 헤더 지원)
+ *  - 에러/원격/CAN FD 프레임 및 이벤트 줄은 건너뜀
+ */
+
+typedef enum
+{
+    CAN_LOG_NONE = 0,
+    CAN_LOG_CANDUMP,
+    CAN_LOG_ASC
+} CanLogFormat;
+
+typedef struct
+{
+    FILE* fp;
+    CanLogFormat format;
+    int asc_dec;                // ASC "base dec"
+    int asc_relative;           // ASC "timestamps relative"
+    uint64_t asc_time_ns;       // relative 누적 시각
+    uint64_t lines;             // 읽은 줄 수
+    uint64_t skipped;           // 프레임이 아닌 줄 수
+} CanLogReader;
+
+/* 파일 확장자로 형식 판별 (.log / .asc) */
+CanLogFormat CanLog_DetectFormat(const char* path);
+
+/* 성공 1, 실패 0 */
+int CanLog_Open(CanLogReader* r, const char* path, CanLogFormat format);
+
+/* 다음 프레임 : 1, 파일 끝 : 0 (rx_ns = 로그 시각) */
+int CanLog_Next(CanLogReader* r, CanFrame* f);
+
+void CanLog_Close(CanLogReader* r);
+
+typedef struct
+{
+    const CanDecodeTable* dbc;  // 신호 정의 (NULL : 기본)
+    int realtime;               // 1 : 로그 시각 간격대로 재생, 0 : 최대 속도
+} CanLogOptions;
+
+typedef struct
+{
+    uint64_t lines;
+    uint64_t frames;
+    uint64_t skipped;
+    uint64_t unknown;           // 신호 정의에 없는 프레임
+    uint64_t cycles;
+} CanLogStats;
+
+/* ===== CAN 로그 재생 진단 : 성공 0, 실패 1 ===== */
+int CanLog_Run(const char* path, CanLogFormat format, FILE* out,
+    const CanLogOptions* opt, CanLogStats* stats);
+
+#endif /* CAN_LOG_H */
@@ -0,0 +1,371 @@
+﻿#include "dtc.h"
+#include <stddef.h>
+#include <string.h>
+
+/* 엔진 래치 카운터 / 래치 위치 (재기동 금지 고장) */
+static const struct { FaultCode code; size_t cnt; size_t latched; } latchFields[] =
+{
+    { FAULT_PLUG,        offsetof(FaultContext, f03.fault_cnt),          offsetof(FaultContext, f03.latched) },
+    { FAULT_OVER_TEMP,   offsetof(FaultContext, f06.fault_cnt),          offsetof(FaultContext, f06.latched) },
+    { FAULT_SEQ_TIMEOUT, offsetof(FaultContext, f0B.timeout_repeat_cnt), offsetof(FaultContext, f0B.latched) }
+};
+
+#define LATCH_COUNT (sizeof(latchFields) / sizeof(latchFields[0]))
+
+/* FNV-1a 32bit */
+static uint32_t Dtc_Hash(const void* data, size_t len)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t h = 2166136261u;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int Dtc_Empty(const DtcEntry* e)
+{
+    return e->occurrences == 0 && e->status == 0 && e->latch_cnt == 0;
+}
+
+static void Dtc_MakeRecord(DtcStore* s, int code, DtcRecord* r)
+{
+    memset(r, 0, sizeof(*r));
+    r->magic = DTC_MAGIC;
+    r->seq = s->seq++;
+    r->code = (uint32_t)code;
+    r->entry = s->entry[code];
+    r->check = Dtc_Hash(r, offsetof(DtcRecord, check));
+}
+
+/* 최신 항목만 새 파일에 기록 후 교체 (기록 중 중단되어도 기존 파일 유지) */
+static int Dtc_Compact(DtcStore* s)
+{
+    char tmp[sizeof(s->path) + 8];
+    DtcRecord rec;
+    FILE* fp;
+    uint64_t bytes = 0;
+    int ok = 1;
+
+    if (s->fp)
+    {
+        fclose(s->fp);
+        s->fp = NULL;
+    }
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", s->path);
+    fp = fopen(tmp, "wb");
+    if (!fp)
+    {
+        printf("ERROR: Failed to write DTC memory : %s\n", tmp);
+        return 0;
+    }
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX && ok; code++)
+    {
+        if (Dtc_Empty(&s->entry[code]))
+            continue;
+        Dtc_MakeRecord(s, code, &rec);
+        ok = fwrite(&rec, sizeof(rec), 1, fp) == 1;
+        bytes += sizeof(rec);
+        s->records++;
+    }
+
+    if (fclose(fp) != 0 || !ok)
+    {
+        printf("ERROR: Failed to write DTC memory : %s\n", tmp);
+        remove(tmp);
+        return 0;
+    }
+
+    remove(s->path);
+    if (rename(tmp, s->path) != 0)
+    {
+        printf("ERROR: Failed to replace DTC memory : %s\n", s->path);
+        return 0;
+    }
+
+    s->fp = fopen(s->path, "ab");
+    if (!s->fp)
+    {
+        printf("ERROR: Failed to open DTC memory : %s\n", s->path);
+        return 0;
+    }
+
+    s->file_bytes = bytes;
+    s->dirty = 0;
+    s->since_flush = 0;
+    s->flushes++;
+    s->compactions++;
+    return 1;
+}
+
+/* NVM 파일 재생 : 유효 레코드 byte 수 반환, 손상 / 잘린 꼬리가 있으면 *torn = 1 */
+static uint64_t Dtc_Load(DtcStore* s, FILE* fp, int* torn)
+{
+    DtcRecord rec;
+    uint64_t bytes = 0;
+    size_t n;
+
+    *torn = 0;
+    while ((n = fread(&rec, 1, sizeof(rec), fp)) == sizeof(rec))
+    {
+        if (rec.magic != DTC_MAGIC || rec.code == 0 || rec.code >= FAULT_MAX ||
+            rec.check != Dtc_Hash(&rec, offsetof(DtcRecord, check)))
+        {
+            *torn = 1;
+            return bytes;
+        }
+
+        s->entry[rec.code] = rec.entry;
+        if (rec.seq >= s->seq)
+            s->seq = rec.seq + 1;
+        s->loaded++;
+        bytes += sizeof(rec);
+    }
+
+    if (n != 0)
+        *torn = 1;
+    return bytes;
+}
+
+int Dtc_Open(DtcStore* s, const char* path)
+{
+    FILE* fp;
+    int torn = 0;
+
+    memset(s, 0, sizeof(*s));
+    snprintf(s->path, sizeof(s->path), "%s", path);
+
+    fp = fopen(path, "rb");
+    if (fp)
+    {
+        s->file_bytes = Dtc_Load(s, fp, &torn);
+        fclose(fp);
+        s->torn = (uint64_t)torn;
+    }
+
+    /* 새 실행(운전 주기) : 지난 실행에서 고장이 없었던 항목 aging, 한도 도달 시 삭제 (래치 제외) */
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        DtcEntry* e = &s->entry[code];
+        DtcEntry before = *e;
+
+        if (Dtc_Empty(e))
+            continue;
+
+        if (!(e->status & DTC_PENDING) && e->aging < 0xFFFFu)
+            e->aging++;
+        e->status &= (uint8_t)~(DTC_PENDING | DTC_TEST_FAILED);
+
+        if (e->aging >= DTC_AGING_RUNS && !(e->status & DTC_LATCHED))
+            memset(e, 0, sizeof(*e));
+        else if ((e->status & DTC_CONFIRMED) && e->healing < DTC_HEAL_CYCLES)
+            s->healing |= 1u << code;
+
+        if (memcmp(&before, e, sizeof(before)) != 0)
+            s->dirty |= 1u << code;
+    }
+
+    /* 손상 꼬리 뒤에 이어 쓰면 다음 재생에서 읽히지 않으므로 먼저 정리 */
+    if (torn)
+        return Dtc_Compact(s);
+
+    s->fp = fopen(path, "ab");
+    if (!s->fp)
+    {
+        printf("ERROR: Failed to open DTC memory : %s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+void Dtc_Restore(DtcStore* s, FaultContext* ctx)
+{
+    for (size_t i = 0; i < LATCH_COUNT; i++)
+    {
+        const DtcEntry* e = &s->entry[latchFields[i].code];
+
+        *((uint8_t*)ctx + latchFields[i].cnt) = e->latch_cnt;
+        *((uint8_t*)ctx + latchFields[i].latched) = (e->status & DTC_LATCHED) ? 1 : 0;
+
+        /* 래치된 고장은 회복 조건이 없으므로 확정 상태로 시작 (이번 실행에서도 고장) */
+        if (e->status & DTC_LATCHED)
+        {
+            ctx->state[latchFields[i].code] = FAULT_CONFIRM;
+            s->entry[latchFields[i].code].status |= DTC_TEST_FAILED | DTC_PENDING;
+        }
+    }
+
+    /* 복원한 확정 상태는 새 발생이 아님 */
+    s->prev_status = Fault_PackStatus(ctx);
+}
+
+/* 고장 상태 전이 반영 */
+static void Dtc_Transition(DtcStore* s, int code, FaultStatus from, FaultStatus to, int32_t cycle)
+{
+    DtcEntry* e = &s->entry[code];
+    uint8_t status = e->status;
+
+    if (to == FAULT_CONFIRM)
+    {
+        if (e->occurrences == 0)
+            e->first_cycle = cycle;
+        if (e->occurrences < 0xFFFFFFFFu)
+            e->occurrences++;
+        e->last_cycle = cycle;
+        e->status |= DTC_TEST_FAILED | DTC_PENDING | DTC_CONFIRMED;
+        e->aging = 0;
+        e->healing = 0;
+        s->healing &= ~(1u << code);
+        s->dirty |= 1u << code;
+        return;
+    }
+
+    if (to == FAULT_DETECT)
+    {
+        e->status |= DTC_PENDING;
+        e->healing = 0;     // 연속 정상 아님
+    }
+
+    if (from == FAULT_CONFIRM)
+    {
+        e->status &= (uint8_t)~DTC_TEST_FAILED;
+        e->healing = 0;
+        s->healing |= 1u << code;
+        s->dirty |= 1u << code;
+    }
+
+    if (e->status != status)
+        s->dirty |= 1u << code;
+}
+
+void Dtc_Update(DtcStore* s, const FaultContext* ctx, int32_t cycle)
+{
+    uint32_t status = Fault_PackStatus(ctx);
+
+    /* 상태가 바뀐 고장만 (고장별 2 bit) */
+    for (uint32_t changed = status ^ s->prev_status; changed; )
+    {
+        int bit = 0;
+        int code;
+
+        while (!(changed & (1u << bit)))
+            bit++;
+        code = bit / 2 + 1;
+        changed &= ~(0x3u << ((code - 1) * 2));
+
+        Dtc_Transition(s, code, (FaultStatus)((s->prev_status >> ((code - 1) * 2)) & 0x3u),
+            ctx->state[code], cycle);
+    }
+    s->prev_status = status;
+
+    /* healing : 확정 해제 후 연속 정상 Cycle */
+    for (uint32_t m = s->healing; m; m &= m - 1)
+    {
+        int code = 0;
+        DtcEntry* e;
+
+        while (!(m & (1u << code)))
+            code++;
+        if (ctx->state[code] != FAULT_NORMAL)
+            continue;
+
+        e = &s->entry[code];
+        if (++e->healing >= DTC_HEAL_CYCLES)
+        {
+            e->status &= (uint8_t)~DTC_CONFIRMED;
+            s->healing &= ~(1u << code);
+            s->dirty |= 1u << code;
+        }
+    }
+
+    /* 엔진 래치 카운터 */
+    for (size_t i = 0; i < LATCH_COUNT; i++)
+    {
+        DtcEntry* e = &s->entry[latchFields[i].code];
+        uint8_t cnt = *((const uint8_t*)ctx + latchFields[i].cnt);
+        uint8_t latched = *((const uint8_t*)ctx + latchFields[i].latched) ? DTC_LATCHED : 0;
+
+        if (e->latch_cnt != cnt || (e->status & DTC_LATCHED) != latched)
+        {
+            e->latch_cnt = cnt;
+            e->status = (uint8_t)((e->status & ~DTC_LATCHED) | latched);
+            s->dirty |= 1u << latchFields[i].code;
+        }
+    }
+
+    /* 첫 변경 이후 DTC_FLUSH_CYCLES Cycle 동안 모아서 기록 */
+    if (s->dirty && ++s->since_flush >= DTC_FLUSH_CYCLES)
+        Dtc_Flush(s);
+}
+
+int Dtc_Flush(DtcStore* s)
+{
+    DtcRecord rec[FAULT_MAX];
+    size_t n = 0;
+
+    if (!s->dirty)
+        return 1;
+    if (!s->fp)
+        return 0;
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if (s->dirty & (1u << code))
+            Dtc_MakeRecord(s, code, &rec[n++]);
+    }
+
+    /* 파일이 커지면 append 대신 최신 항목만 다시 기록 */
+    if (s->file_bytes + n * sizeof(DtcRecord) > DTC_NVM_COMPACT)
+        return Dtc_Compact(s);
+
+    if (fwrite(rec, sizeof(DtcRecord), n, s->fp) != n || fflush(s->fp) != 0)
+    {
+        printf("ERROR: Failed to write DTC memory : %s\n", s->path);
+        return 0;
+    }
+
+    s->file_bytes += n * sizeof(DtcRecord);
+    s->records += n;
+    s->flushes++;
+    s->dirty = 0;
+    s->since_flush = 0;
+    return 1;
+}
+
+int Dtc_Close(DtcStore* s)
+{
+    int ok;
+
+    /* 진행 중 healing 카운터 보존 */
+    s->dirty |= s->healing;
+    ok = Dtc_Flush(s);
+
+    if (s->fp && fclose(s->fp) != 0)
+        ok = 0;
+    s->fp = NULL;
+    return ok;
+}
+
+void Dtc_Print(FILE* out, const DtcStore* s)
+{
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        const DtcEntry* e = &s->entry[code];
+
+        if (Dtc_Empty(e))
+            continue;
+
+        fprintf(out, "  0x%02X : %u occurrences, first %d, last %d, aging %u, healing %u, latch %u%s%s%s%s\n",
+            code, (unsigned)e->occurrences, e->first_cycle, e->last_cycle, (unsigned)e->aging,
+            (unsigned)e->healing, (unsigned)e->latch_cnt,
+            (e->status & DTC_TEST_FAILED) ? " [failed]" : "",
+            (e->status & DTC_PENDING) ? " [pending]" : "",
+            (e->status & DTC_CONFIRMED) ? " [confirmed]" : "",
+            (e->status & DTC_LATCHED) ? " [latched]" : "");
+    }
+}
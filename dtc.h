@@ -0,0 +1,91 @@
+#ifndef DTC_H
+#define DTC_H
+#include <stdio.h>
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 영구 고장 기억 (DTC, --dtc=<file>)
+ *  - 고장 코드별 발생 횟수 / 최초 · 최근 확정 Cycle / aging / healing 카운터와 엔진 래치 카운터를 RAM 에 유지
+ *  - 파일 기반 NVM 에뮬레이션 : 고정 크기 레코드를 append-only 로 추가, 열 때 순서대로 재생 (같은 코드는 마지막 레코드 우선)
+ *    · 레코드마다 FNV-1a 확인값 → 기록 중 중단된 꼬리 레코드는 무시하고 최신 항목만 다시 기록(compaction)
+ *    · 변경된 항목만 DTC_FLUSH_CYCLES Cycle 마다 한 번에 기록 (Cycle 마다 기록하지 않음), 파일이 DTC_NVM_COMPACT 를
+ *      넘으면 최신 항목만 새 파일에 기록 후 교체 → 기록량 / 지우기 횟수 제한
+ *  - 다음 실행에서 래치(0x03 / 0x06 재기동 금지, 0x0B 반복 타임아웃)와 래치 카운터를 엔진 Context 에 복원
+ *  - 실행(운전 주기) 단위 aging : 고장 없이 끝난 실행이 DTC_AGING_RUNS 회이면 항목 삭제 (래치 항목 제외)
+ *  - Cycle 단위 healing : 확정 해제 후 연속 정상 DTC_HEAL_CYCLES Cycle 이면 DTC_CONFIRMED 해제
+ */
+
+#define DTC_MAGIC           0x31435444u     /* "DTC1" */
+#define DTC_HEAL_CYCLES     100             // 확정 해제 → DTC_CONFIRMED 해제까지 연속 정상 Cycle
+#define DTC_AGING_RUNS      40              // 고장 없이 끝난 실행 수 → 항목 삭제
+#define DTC_FLUSH_CYCLES    1000            // 변경 항목 일괄 기록 간격 (Cycle)
+#define DTC_NVM_COMPACT     (64 * 1024)     // compaction 기준 파일 크기 (byte)
+
+/* DTC 상태 bit */
+#define DTC_TEST_FAILED     0x01u           // 현재 CONFIRM
+#define DTC_PENDING         0x02u           // 이번 실행 중 DETECT / CONFIRM 발생
+#define DTC_CONFIRMED       0x04u           // 확정 이력 (healing 완료 시 해제)
+#define DTC_LATCHED         0x08u           // 엔진 래치 (재기동 금지)
+
+typedef struct
+{
+    uint32_t occurrences;       // CONFIRM 전이 횟수 (누적)
+    int32_t first_cycle;        // 최초 확정 Cycle
+    int32_t last_cycle;         // 최근 확정 Cycle
+    uint16_t aging;             // 마지막 고장 이후 고장 없이 끝난 실행 수
+    uint16_t healing;           // 확정 해제 후 연속 정상 Cycle 수 (DTC_HEAL_CYCLES 에서 멈춤)
+    uint8_t status;             // DTC_* bit
+    uint8_t latch_cnt;          // 엔진 래치 카운터 (f03.fault_cnt / f06.fault_cnt / f0B.timeout_repeat_cnt)
+    uint16_t reserved;
+} DtcEntry;
+
+/* NVM 레코드 (36 byte, 리틀 엔디언) */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;               // 기록 순서
+    uint32_t code;
+    DtcEntry entry;
+    uint32_t check;             // 앞 필드 FNV-1a
+} DtcRecord;
+
+typedef struct
+{
+    FILE* fp;
+    char path[1024];
+    DtcEntry entry[FAULT_MAX];
+    uint32_t dirty;             // 기록 대기 항목 bitmask (bit code)
+    uint32_t healing;           // healing 진행 중 항목 bitmask
+    uint32_t prev_status;       // 직전 Cycle Fault_PackStatus
+    uint32_t seq;
+    uint64_t since_flush;       // 마지막 기록 이후 Cycle 수
+    uint64_t file_bytes;
+
+    /* 기록 통계 (wear) */
+    uint64_t flushes;           // 일괄 기록 횟수
+    uint64_t records;           // 이번 실행에서 기록한 레코드 수
+    uint64_t compactions;
+    uint64_t loaded;            // 열 때 재생한 레코드 수
+    uint64_t torn;              // 열 때 버린 손상 레코드 수
+} DtcStore;
+
+/* ===== NVM 파일 열기 (없으면 새로 생성) + 새 실행 aging : 성공 1, 실패 0 ===== */
+int Dtc_Open(DtcStore* s, const char* path);
+
+/* ===== 래치 / 래치 카운터를 엔진 Context 에 복원 (Fault_Init / Fault_InitContext 직후) ===== */
+void Dtc_Restore(DtcStore* s, FaultContext* ctx);
+
+/* ===== 진단 직후 1 Cycle 반영 (상태 변화 / healing / 래치), DTC_FLUSH_CYCLES 마다 변경 항목 기록 ===== */
+void Dtc_Update(DtcStore* s, const FaultContext* ctx, int32_t cycle);
+
+/* ===== 변경 항목 기록 : 성공 1 ===== */
+int Dtc_Flush(DtcStore* s);
+
+/* ===== 남은 변경 항목 기록 후 닫기 : 성공 1 ===== */
+int Dtc_Close(DtcStore* s);
+
+/* ===== 기록된 DTC 목록 출력 ===== */
+void Dtc_Print(FILE* out, const DtcStore* s);
+
+#endif /* DTC_H */
@@ -0,0 +1,1175 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "equiv.h"
+#include "fault.h"
+#include "input.h"
+#include "output.h"
+#include "fault_parallel.h"
+#include "pipeline.h"
+#include "result_cache.h"
+#include "snap_log.h"
+#include "packed.h"
+#include "inject.h"
+#include "scenario.h"
+#include "sim.h"
+#include "osal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EQUIV_PATH_MAX      512
+#define EQUIV_SHOW_MAX      96      // 불일치 줄 출력 길이
+
+/* 입력 텍스트 (lines[0] : 헤더, 줄 끝 '\n' 제외, '\r' 은 내용에 포함) */
+typedef struct
+{
+    char** lines;
+    int count;
+    int cap;
+    int final_newline;          // 마지막 줄 뒤 개행 여부
+} EquivText;
+
+/* splitmix64 */
+static uint64_t Equiv_Rand(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int Equiv_Below(uint64_t* state, int n)
+{
+    return (int)(Equiv_Rand(state) % (uint64_t)n);
+}
+
+static char* Equiv_Strndup(const char* s, size_t len)
+{
+    char* p = (char*)malloc(len + 1);
+
+    if (p)
+    {
+        memcpy(p, s, len);
+        p[len] = '\0';
+    }
+    return p;
+}
+
+static char* Equiv_ReadFile(const char* path, size_t* size)
+{
+    FILE* fp = fopen(path, "rb");
+    char* buf;
+    long len;
+
+    if (!fp)
+        return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    buf = (char*)malloc(len > 0 ? (size_t)len + 1 : 1);
+    if (buf && len > 0 && fread(buf, 1, (size_t)len, fp) != (size_t)len)
+    {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+
+    if (buf)
+    {
+        buf[len > 0 ? len : 0] = '\0';
+        *size = len > 0 ? (size_t)len : 0;
+    }
+    return buf;
+}
+
+/* ------------------------------
+ * 입력 텍스트
+ * ------------------------------ */
+
+static void Text_Free(EquivText* t)
+{
+    for (int i = 0; i < t->count; i++)
+        free(t->lines[i]);
+    free(t->lines);
+    memset(t, 0, sizeof(*t));
+}
+
+static int Text_Insert(EquivText* t, int at, char* line)
+{
+    if (!line)
+        return 0;
+
+    if (t->count == t->cap)
+    {
+        int cap = t->cap ? t->cap * 2 : 256;
+        char** p = (char**)realloc(t->lines, sizeof(char*) * (size_t)cap);
+
+        if (!p)
+        {
+            free(line);
+            return 0;
+        }
+        t->lines = p;
+        t->cap = cap;
+    }
+
+    memmove(&t->lines[at + 1], &t->lines[at], sizeof(char*) * (size_t)(t->count - at));
+    t->lines[at] = line;
+    t->count++;
+    return 1;
+}
+
+static void Text_Remove(EquivText* t, int at)
+{
+    free(t->lines[at]);
+    memmove(&t->lines[at], &t->lines[at + 1], sizeof(char*) * (size_t)(t->count - at - 1));
+    t->count--;
+}
+
+static int Text_Append(EquivText* t, const char* s, size_t len)
+{
+    return Text_Insert(t, t->count, Equiv_Strndup(s, len));
+}
+
+static int Text_Load(EquivText* t, const char* path)
+{
+    size_t size;
+    char* buf = Equiv_ReadFile(path, &size);
+    size_t start = 0;
+
+    memset(t, 0, sizeof(*t));
+    if (!buf)
+    {
+        printf("ERROR: Failed to read input CSV : %s\n", path);
+        return 0;
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (buf[i] == '\n')
+        {
+            if (!Text_Append(t, buf + start, i - start))
+                goto fail;
+            start = i + 1;
+        }
+    }
+    if (start < size && !Text_Append(t, buf + start, size - start))
+        goto fail;
+
+    t->final_newline = size > 0 && buf[size - 1] == '\n';
+    free(buf);
+    return 1;
+
+fail:
+    printf("ERROR: Out of memory while reading : %s\n", path);
+    free(buf);
+    Text_Free(t);
+    return 0;
+}
+
+static int Text_Copy(EquivText* dst, const EquivText* src)
+{
+    memset(dst, 0, sizeof(*dst));
+    for (int i = 0; i < src->count; i++)
+    {
+        if (!Text_Append(dst, src->lines[i], strlen(src->lines[i])))
+        {
+            Text_Free(dst);
+            return 0;
+        }
+    }
+    dst->final_newline = src->final_newline;
+    return 1;
+}
+
+static int Text_Save(const EquivText* t, const char* path)
+{
+    FILE* fp = fopen(path, "wb");
+    int ok;
+
+    if (!fp)
+        return 0;
+
+    for (int i = 0; i < t->count; i++)
+    {
+        fputs(t->lines[i], fp);
+        if (i + 1 < t->count || t->final_newline)
+            fputc('\n', fp);
+    }
+    ok = !ferror(fp);
+    return fclose(fp) == 0 && ok;
+}
+
+/* ------------------------------
+ * 랜덤 / 퍼징 입력
+ * ------------------------------ */
+
+static int Text_FromSnapshots(EquivText* t, uint64_t seed, int rows, int sim)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in;
+    Scenario* sc = NULL;
+    ScenarioGen* g = NULL;
+    SimWorld* w = NULL;
+    int ok = 1;
+
+    memset(t, 0, sizeof(*t));
+    t->final_newline = 1;
+    ok = Text_Append(t, "", 0);
+
+    if (sim)
+    {
+        SimConfig cfg;
+
+        w = (SimWorld*)malloc(sizeof(*w));
+        ok = ok && w;
+        if (ok)
+        {
+            Sim_DefaultConfig(&cfg);
+            cfg.event_rate = 1.0 / 50.0;
+            Sim_Init(w, &cfg, seed);
+        }
+    }
+    else
+    {
+        sc = Scenario_Compile(Scenario_DefaultText);
+        g = (ScenarioGen*)malloc(sizeof(*g));
+        ok = ok && sc && g;
+        if (ok)
+            Scenario_Start(g, sc, seed);
+    }
+
+    for (int i = 0; ok && i < rows; i++)
+    {
+        int len;
+
+        if (sim)
+            Sim_Step(w, &in);
+        else
+            Scenario_Next(g, &in);
+
+        len = Input_FormatLine(line, &in);
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            len--;
+        ok = Text_Append(t, line, (size_t)len);
+    }
+
+    /* 헤더 : Input_WriteHeader 와 같은 형식 */
+    if (ok)
+    {
+        FILE* tmp = tmpfile();
+        char header[INPUT_LINE_MAX] = "";
+
+        if (tmp)
+        {
+            Input_WriteHeader(tmp);
+            rewind(tmp);
+            if (!fgets(header, sizeof(header), tmp))
+                header[0] = '\0';
+            fclose(tmp);
+        }
+        header[strcspn(header, "\r\n")] = '\0';
+        free(t->lines[0]);
+        t->lines[0] = Equiv_Strndup(header, strlen(header));
+        ok = t->lines[0] != NULL;
+    }
+
+    free(w);
+    free(g);
+    Scenario_Free(sc);
+    if (!ok)
+        Text_Free(t);
+    return ok;
+}
+
+/* 경계값 / 비정상 토큰 */
+static const char* const fuzzTokens[] =
+{
+    "0", "-1", "1", "2", "3", "5", "6", "10", "11", "20", "21", "24", "32", "33", "60", "61", "120", "121",
+    "-20", "-21", "500", "501", "600", "3600", "3601",
+    "2147483647", "-2147483648", "2147483648", "99999999999", "-0", "+5",
+    "1e10", "1e-3", "3.5", "-3.5", "32.0001", "nan", "inf", "-inf",
+    "", " ", " 7", "7 ", "0x10", "abc", "1,2", "\t3"
+};
+
+#define FUZZ_TOKEN_COUNT    ((int)(sizeof(fuzzTokens) / sizeof(fuzzTokens[0])))
+
+/* 줄 line 의 k 번째 필드를 token 으로 교체 (필드가 모자라면 끝에 추가) */
+static char* Fuzz_ReplaceField(const char* line, int k, const char* token)
+{
+    size_t len = strlen(line);
+    size_t begin = 0;
+    size_t end;
+    char* out;
+
+    for (int f = 0; f < k; f++)
+    {
+        const char* comma = strchr(line + begin, ',');
+        if (!comma)
+        {
+            begin = len;
+            break;
+        }
+        begin = (size_t)(comma - line) + 1;
+    }
+    end = begin + strcspn(line + begin, ",");
+
+    out = (char*)malloc(len + strlen(token) + 2);
+    if (!out)
+        return NULL;
+
+    memcpy(out, line, begin);
+    strcpy(out + begin, token);
+    strcat(out, line + end);
+    return out;
+}
+
+static void Fuzz_Mutate(EquivText* t, uint64_t* rng)
+{
+    int data = t->count - 1;
+    int at;
+    char* line;
+    size_t len;
+
+    if (data < 1)
+        return;
+
+    at = 1 + Equiv_Below(rng, data);
+    line = t->lines[at];
+    len = strlen(line);
+
+    switch (Equiv_Below(rng, 10))
+    {
+    case 0:
+    case 1:     /* 필드 값 교체 (가장 흔한 변형) */
+        {
+            char* p = Fuzz_ReplaceField(line, Equiv_Below(rng, INPUT_FIELD_COUNT),
+                fuzzTokens[Equiv_Below(rng, FUZZ_TOKEN_COUNT)]);
+            if (p)
+            {
+                free(t->lines[at]);
+                t->lines[at] = p;
+            }
+        }
+        break;
+
+    case 2:     /* 줄 삭제 */
+        if (data > 1)
+            Text_Remove(t, at);
+        break;
+
+    case 3:     /* 줄 중복 */
+        Text_Insert(t, at, Equiv_Strndup(line, len));
+        break;
+
+    case 4:     /* 인접 줄 교환 */
+        if (at + 1 < t->count)
+        {
+            t->lines[at] = t->lines[at + 1];
+            t->lines[at + 1] = line;
+        }
+        break;
+
+    case 5:     /* 줄 자르기 (필드 누락) */
+        line[Equiv_Below(rng, (int)len + 1)] = '\0';
+        break;
+
+    case 6:     /* 필드 추가 */
+        {
+            const char* token = fuzzTokens[Equiv_Below(rng, FUZZ_TOKEN_COUNT)];
+            char* p = (char*)malloc(len + strlen(token) + 2);
+            if (p)
+            {
+                sprintf(p, "%s,%s", line, token);
+                free(t->lines[at]);
+                t->lines[at] = p;
+            }
+        }
+        break;
+
+    case 7:     /* 긴 줄 (읽기 버퍼 INPUT_LINE_MAX 초과) */
+        {
+            int extra = INPUT_LINE_MAX - 16 + Equiv_Below(rng, INPUT_LINE_MAX);
+            char* p = (char*)malloc(len + (size_t)extra + 1);
+            if (p)
+            {
+                memcpy(p, line, len);
+                for (int i = 0; i < extra; i++)
+                    p[len + (size_t)i] = (i % 8 == 0) ? ',' : (char)('0' + i % 10);
+                p[len + (size_t)extra] = '\0';
+                free(t->lines[at]);
+                t->lines[at] = p;
+            }
+        }
+        break;
+
+    case 8:     /* CRLF */
+        {
+            char* p = (char*)malloc(len + 2);
+            if (p)
+            {
+                memcpy(p, line, len);
+                p[len] = '\r';
+                p[len + 1] = '\0';
+                free(t->lines[at]);
+                t->lines[at] = p;
+            }
+        }
+        break;
+
+    default:    /* byte 변경 */
+        if (len > 0)
+        {
+            static const char bytes[] = "0123456789,.-+ eE\tx";
+            line[Equiv_Below(rng, (int)len)] = bytes[Equiv_Below(rng, (int)sizeof(bytes) - 1)];
+        }
+        break;
+    }
+}
+
+/* ------------------------------
+ * 기준 경로
+ * ------------------------------ */
+
+int Equiv_Reference(const char* input_file, const char* result_file)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in = { 0 };
+    FILE* fp = fopen(input_file, "r");
+    FILE* out = fopen(result_file, "w");
+    int ok;
+
+    if (!fp || !out)
+    {
+        printf("ERROR: Failed to open reference files : %s / %s\n", input_file, result_file);
+        if (fp)
+            fclose(fp);
+        if (out)
+            fclose(out);
+        return 1;
+    }
+
+    Output_WriteHeader(out);
+    Fault_Init();
+
+    /* Input_ReadLine : 헤더 1줄 생략 후 fgets 줄 단위 + Input_ParseLine */
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (fgets(line, sizeof(line), fp) != NULL && Input_ParseLine(line, &in))
+        {
+            Fault_Diagnose(&in);
+            Output_WriteRow(out, in.Cycle, Fault_GetContext());
+        }
+    }
+
+    ok = !ferror(out);
+    fclose(fp);
+    return fclose(out) == 0 && ok ? 0 : 1;
+}
+
+/* ------------------------------
+ * 후보 엔진
+ * ------------------------------ */
+
+/* Context 기반 엔진 (같은 줄 단위 읽기, 전역 상태 없음) */
+static int Engine_Context(const char* input_file, const char* result_file, const char* work)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in = { 0 };
+    FaultContext ctx;
+    FILE* fp = fopen(input_file, "r");
+    FILE* out = fopen(result_file, "w");
+    int ok;
+
+    (void)work;
+
+    if (!fp || !out)
+    {
+        if (fp)
+            fclose(fp);
+        if (out)
+            fclose(out);
+        return 1;
+    }
+
+    Output_WriteHeader(out);
+    Fault_InitContext(&ctx);
+
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (fgets(line, sizeof(line), fp) != NULL && Input_ParseLine(line, &in))
+        {
+            Fault_DiagnoseContext(&ctx, &in);
+            Output_WriteRowPacked(out, in.Cycle, Fault_PackStatus(&ctx));
+        }
+    }
+
+    ok = !ferror(out);
+    fclose(fp);
+    return fclose(out) == 0 && ok ? 0 : 1;
+}
+
+/* 변경 기반 엔진 (Fault_DiagnoseChanged, 같은 줄 단위 읽기) */
+static int Engine_Changed(const char* input_file, const char* result_file, const char* work)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in = { 0 };
+    FaultContext ctx;
+    FaultIdle idle;
+    FILE* fp = fopen(input_file, "r");
+    FILE* out = fopen(result_file, "w");
+    int ok;
+
+    (void)work;
+
+    if (!fp || !out)
+    {
+        if (fp)
+            fclose(fp);
+        if (out)
+            fclose(out);
+        return 1;
+    }
+
+    Output_WriteHeader(out);
+    Fault_InitContext(&ctx);
+    Fault_IdleInit(&idle);
+
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (fgets(line, sizeof(line), fp) != NULL && Input_ParseLine(line, &in))
+        {
+            Fault_DiagnoseChanged(&ctx, &idle, &in);
+            Output_WriteRowPacked(out, in.Cycle, Fault_PackStatus(&ctx));
+        }
+    }
+
+    ok = !ferror(out);
+    fclose(fp);
+    return fclose(out) == 0 && ok ? 0 : 1;
+}
+
+/* 압축 로그 엔진 : 전체 입력을 PackedLog 로 쌓은 뒤 블록 단위 진단 */
+static int Engine_Packed(const char* input_file, const char* result_file, const char* work)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in = { 0 };
+    PackedLog log;
+    FaultContext ctx;
+    uint32_t status[256];
+    FILE* fp = fopen(input_file, "r");
+    FILE* out = fopen(result_file, "w");
+    int ok = 1;
+
+    (void)work;
+
+    if (!fp || !out)
+    {
+        if (fp)
+            fclose(fp);
+        if (out)
+            fclose(out);
+        return 1;
+    }
+
+    PackedLog_Init(&log);
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (ok && fgets(line, sizeof(line), fp) != NULL && Input_ParseLine(line, &in))
+            ok = PackedLog_Append(&log, &in);
+    }
+    fclose(fp);
+
+    Output_WriteHeader(out);
+    Fault_InitContext(&ctx);
+
+    for (size_t i = 0; ok && i < log.count; i += 256)
+    {
+        size_t n = (log.count - i < 256) ? log.count - i : 256;
+
+        PackedLog_Diagnose(&ctx, &log, i, n, status);
+        for (size_t k = 0; k < n; k++)
+        {
+            PackedLog_Get(&log, i + k, &in);
+            Output_WriteRowPacked(out, in.Cycle, status[k]);
+        }
+    }
+
+    PackedLog_Free(&log);
+    ok = ok && !ferror(out);
+    return fclose(out) == 0 && ok ? 0 : 1;
+}
+
+static int Engine_Parallel(const char* input_file, const char* result_file, const char* work)
+{
+    ParallelStats stats;
+
+    (void)work;
+
+    /* 구간 경계 보정 경로를 타도록 CPU 개수와 무관하게 4 구간 */
+    return Parallel_Run(input_file, result_file, 4, &stats);
+}
+
+static int Engine_Pipeline(const char* input_file, const char* result_file, const char* work)
+{
+    PipelineStats stats;
+
+    (void)work;
+
+    return Pipeline_Run(input_file, result_file, &stats, NULL);
+}
+
+/* 증분 캐시 : 입력 앞 절반(줄 경계) 진단 후 나머지를 덧붙여 캐시로 이어서 진단 */
+static int Engine_Cache(const char* input_file, const char* result_file, const char* work)
+{
+    char in_path[EQUIV_PATH_MAX];
+    char cache_path[EQUIV_PATH_MAX];
+    ResultCacheStats stats;
+    size_t size;
+    size_t half;
+    char* buf = Equiv_ReadFile(input_file, &size);
+    FILE* fp;
+    int rc = 1;
+
+    if (!buf)
+        return 1;
+
+    snprintf(in_path, sizeof(in_path), "%scache_input.csv", work);
+    snprintf(cache_path, sizeof(cache_path), "%scache.bin", work);
+    remove(cache_path);
+
+    for (half = size / 2; half < size && buf[half] != '\n'; half++)
+        ;
+    if (half < size)
+        half++;
+
+    fp = fopen(in_path, "wb");
+    if (fp && fwrite(buf, 1, half, fp) == half && fclose(fp) == 0)
+    {
+        fp = NULL;
+        if (ResultCache_Run(in_path, result_file, cache_path, &stats) == 0)
+        {
+            fp = fopen(in_path, "ab");
+            if (fp && fwrite(buf + half, 1, size - half, fp) == size - half && fclose(fp) == 0)
+            {
+                fp = NULL;
+                rc = ResultCache_Run(in_path, result_file, cache_path, &stats);
+            }
+        }
+    }
+
+    if (fp)
+        fclose(fp);
+    free(buf);
+    remove(in_path);
+    remove(cache_path);
+    return rc;
+}
+
+/* 이진 Snapshot 로그 : 기준 경로와 같은 줄 단위 읽기로 .snap 변환 후 SnapLog_Run */
+static int Engine_Snap(const char* input_file, const char* result_file, const char* work)
+{
+    char snap_path[EQUIV_PATH_MAX];
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in = { 0 };
+    SnapLog log;
+    uint64_t cycles;
+    FILE* fp;
+    FILE* out;
+    int ok = 1;
+    int rc = 1;
+
+    snprintf(snap_path, sizeof(snap_path), "%sinput.snap", work);
+
+    fp = fopen(input_file, "r");
+    if (!fp)
+        return 1;
+    if (!SnapLog_Create(&log, snap_path))
+    {
+        fclose(fp);
+        return 1;
+    }
+
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (ok && fgets(line, sizeof(line), fp) != NULL && Input_ParseLine(line, &in))
+            ok = SnapLog_Write(&log, &in, 1);
+    }
+    fclose(fp);
+    ok = SnapLog_Close(&log) && ok;
+
+    out = ok ? fopen(result_file, "w") : NULL;
+    if (out)
+    {
+        Output_WriteHeader(out);
+        rc = SnapLog_Run(snap_path, out, &cycles);
+        if (fclose(out) != 0)
+            rc = 1;
+    }
+
+    remove(snap_path);
+    return rc;
+}
+
+/* 고장 주입 단계의 원본(baseline) 결과 (동작 없는 변형 1개) */
+static int Engine_Inject(const char* input_file, const char* result_file, const char* work)
+{
+    char prefix[EQUIV_PATH_MAX];
+    char baseline[EQUIV_PATH_MAX + 16];
+    InjectScript* script = Inject_Compile("variant none\nend\n");
+    InjectResult results[2];    // 원본 + 변형 1개
+    int rc = 1;
+
+    if (!script)
+        return 1;
+
+    snprintf(prefix, sizeof(prefix), "%sinject_", work);
+    snprintf(baseline, sizeof(baseline), "%sbaseline.csv", prefix);
+
+    if (Inject_Run(input_file, script, prefix, results) == 0)
+    {
+        remove(result_file);
+        rc = rename(baseline, result_file) == 0 ? 0 : 1;
+    }
+    snprintf(baseline, sizeof(baseline), "%snone.csv", prefix);
+    remove(baseline);
+    Inject_Free(script);
+    return rc;
+}
+
+const EquivEngine Equiv_Engines[] =
+{
+    { "context",  "Fault_DiagnoseContext + Fault_PackStatus", Engine_Context },
+    { "changed",  "Fault_DiagnoseChanged (skip idle)",        Engine_Changed },
+    { "packed",   "PackedLog buffer + PackedLog_Diagnose",    Engine_Packed },
+    { "parallel", "Parallel_Run, 4 segments",                 Engine_Parallel },
+    { "pipeline", "Pipeline_Run",                             Engine_Pipeline },
+    { "cache",    "ResultCache_Run, half then resume",        Engine_Cache },
+    { "snap",     "CSV -> .snap -> SnapLog_Run",              Engine_Snap },
+    { "inject",   "Inject_Run baseline",                      Engine_Inject },
+};
+
+const int Equiv_EngineCount = (int)(sizeof(Equiv_Engines) / sizeof(Equiv_Engines[0]));
+
+/* ------------------------------
+ * 비교 / 최소화
+ * ------------------------------ */
+
+typedef struct
+{
+    const char* work;
+    char input[EQUIV_PATH_MAX];
+    char ref[EQUIV_PATH_MAX];
+    char cand[EQUIV_PATH_MAX];
+} EquivPaths;
+
+typedef struct
+{
+    int row;                    // 첫 불일치 결과 행 (1 : 첫 데이터 행, -1 : 후보 실행 실패)
+    char ref_line[EQUIV_SHOW_MAX];
+    char cand_line[EQUIV_SHOW_MAX];
+} EquivDiverge;
+
+static void Equiv_CopyLine(char* dst, const char* src, const char* end)
+{
+    size_t n = 0;
+
+    while (src && src < end && *src != '\n' && n + 1 < EQUIV_SHOW_MAX)
+        dst[n++] = *src++;
+    dst[n] = '\0';
+    if (!src)
+        strcpy(dst, "<missing>");
+}
+
+/* 결과 CSV 비교 : 같으면 0, 다르면 1 (d 에 첫 불일치 행) */
+static int Equiv_Compare(const char* ref_path, const char* cand_path, EquivDiverge* d)
+{
+    size_t rn, cn;
+    char* r = Equiv_ReadFile(ref_path, &rn);
+    char* c = Equiv_ReadFile(cand_path, &cn);
+    size_t ri = 0, ci = 0;
+    int line = 0;
+    int diff = 0;
+
+    if (!r || !c)
+    {
+        d->row = -1;
+        strcpy(d->ref_line, r ? "" : "<no result>");
+        strcpy(d->cand_line, c ? "" : "<no result>");
+        free(r);
+        free(c);
+        return 1;
+    }
+
+    while (ri < rn || ci < cn)
+    {
+        size_t re = ri, ce = ci;
+
+        while (re < rn && r[re] != '\n')
+            re++;
+        while (ce < cn && c[ce] != '\n')
+            ce++;
+
+        if (ri >= rn || ci >= cn || re - ri != ce - ci || memcmp(r + ri, c + ci, re - ri) != 0 ||
+            (re < rn) != (ce < cn))
+        {
+            d->row = line;
+            Equiv_CopyLine(d->ref_line, ri < rn ? r + ri : NULL, r + rn);
+            Equiv_CopyLine(d->cand_line, ci < cn ? c + ci : NULL, c + cn);
+            diff = 1;
+            break;
+        }
+        ri = re + 1;
+        ci = ce + 1;
+        line++;
+    }
+
+    free(r);
+    free(c);
+    return diff;
+}
+
+/* 기준 결과가 준비된 상태에서 후보 실행 후 비교 : 같으면 0 */
+static int Equiv_RunEngine(const EquivEngine* e, const EquivPaths* p, EquivDiverge* d)
+{
+    remove(p->cand);
+    if (e->run(p->input, p->cand, p->work) != 0)
+    {
+        d->row = -1;
+        strcpy(d->ref_line, "");
+        strcpy(d->cand_line, "<engine failed>");
+        return 1;
+    }
+    return Equiv_Compare(p->ref, p->cand, d);
+}
+
+/* 입력 기록 + 기준 진단 + 후보 비교 : 불일치 1, 일치 0, 입력 / 기준 실패 -1 */
+static int Equiv_Check(const EquivEngine* e, const EquivText* t, const EquivPaths* p, EquivDiverge* d)
+{
+    if (!Text_Save(t, p->input) || Equiv_Reference(p->input, p->ref) != 0)
+        return -1;
+    return Equiv_RunEngine(e, p, d);
+}
+
+/* 데이터 줄 [from, from + n) 제외한 텍스트 */
+static int Text_Without(EquivText* dst, const EquivText* src, int from, int n)
+{
+    memset(dst, 0, sizeof(*dst));
+    dst->final_newline = src->final_newline;
+    for (int i = 0; i < src->count; i++)
+    {
+        if (i >= from && i < from + n)
+            continue;
+        if (!Text_Append(dst, src->lines[i], strlen(src->lines[i])))
+        {
+            Text_Free(dst);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* 불일치를 유지하는 최소 데이터 줄 집합 (앞부분 자르기 후 ddmin) */
+static int Equiv_Minimize(const EquivEngine* e, EquivText* t, const EquivPaths* p, EquivDiverge* d, int row)
+{
+    EquivText cand;
+    EquivDiverge cd;
+    int tests = 0;
+    int n = 2;
+
+    /* 1. 불일치 행 이후 줄 제거 (결과 행은 그 이전 입력에만 의존) */
+    for (int keep = row > 0 ? row : 1; keep < t->count - 1; keep *= 2)
+    {
+        if (!Text_Without(&cand, t, 1 + keep, t->count - 1 - keep))
+            return tests;
+        tests++;
+        if (Equiv_Check(e, &cand, p, &cd) == 1)
+        {
+            Text_Free(t);
+            *t = cand;
+            *d = cd;
+            break;
+        }
+        Text_Free(&cand);
+    }
+
+    /* 2. ddmin : 데이터 줄을 n 조각으로 나누어 한 조각씩 제거 */
+    while (t->count - 1 >= 2)
+    {
+        int data = t->count - 1;
+        int chunk = data / n;
+        int reduced = 0;
+
+        if (chunk < 1)
+            chunk = 1;
+
+        for (int from = 1; from < t->count; from += chunk)
+        {
+            int len = from + chunk <= t->count ? chunk : t->count - from;
+
+            if (len >= data)
+                continue;
+            if (!Text_Without(&cand, t, from, len))
+                return tests;
+            tests++;
+            if (Equiv_Check(e, &cand, p, &cd) == 1)
+            {
+                Text_Free(t);
+                *t = cand;
+                *d = cd;
+                reduced = 1;
+                break;
+            }
+            Text_Free(&cand);
+        }
+
+        if (reduced)
+        {
+            if (n > 2)
+                n--;
+        }
+        else if (n >= data)
+        {
+            break;
+        }
+        else
+        {
+            n = n * 2 < data ? n * 2 : data;
+        }
+    }
+    return tests;
+}
+
+/* ------------------------------
+ * 명령행
+ * ------------------------------ */
+
+typedef struct
+{
+    uint64_t cases;
+    uint64_t checks;
+    uint64_t rows;
+    uint64_t divergences;
+} EquivTotals;
+
+static void Equiv_Report(const EquivEngine* e, const char* case_name, const EquivDiverge* d)
+{
+    if (d->row < 0)
+        printf("DIVERGE %-8s %s : %s\n", e->name, case_name, d->cand_line);
+    else
+        printf("DIVERGE %-8s %s : row %d\n  reference : %s\n  %-9s : %s\n",
+            e->name, case_name, d->row, d->ref_line, e->name, d->cand_line);
+}
+
+/* 입력 1개를 선택한 모든 엔진과 비교 : 실패 -1 */
+static int Equiv_Case(const EquivText* t, const char* case_name, const int* enabled,
+    const EquivPaths* p, const char* out_prefix, EquivTotals* tot)
+{
+    EquivDiverge d;
+
+    if (!Text_Save(t, p->input) || Equiv_Reference(p->input, p->ref) != 0)
+    {
+        printf("ERROR: Failed to run reference : %s\n", case_name);
+        return -1;
+    }
+    tot->cases++;
+    tot->rows += (uint64_t)(t->count > 0 ? t->count - 1 : 0);
+
+    for (int k = 0; k < Equiv_EngineCount; k++)
+    {
+        const EquivEngine* e = &Equiv_Engines[k];
+        EquivText min;
+        char path[EQUIV_PATH_MAX];
+        int tests;
+
+        if (!enabled[k])
+            continue;
+
+        tot->checks++;
+        if (Equiv_RunEngine(e, p, &d) == 0)
+            continue;
+
+        tot->divergences++;
+        Equiv_Report(e, case_name, &d);
+        if (d.row < 0)
+            continue;           // 실행 실패는 입력을 줄여도 의미 없음
+
+        if (!Text_Copy(&min, t))
+            return -1;
+        tests = Equiv_Minimize(e, &min, p, &d, d.row);
+
+        snprintf(path, sizeof(path), "%s%s_%s.csv", out_prefix, e->name, case_name);
+        if (Text_Save(&min, path))
+            printf("  minimized : %d rows (%d runs, first divergence row %d) -> %s\n",
+                min.count - 1, tests, d.row, path);
+        else
+            printf("ERROR: Failed to write minimized input : %s\n", path);
+        Text_Free(&min);
+
+        /* 다음 엔진 비교용 기준 결과 복원 */
+        if (!Text_Save(t, p->input) || Equiv_Reference(p->input, p->ref) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+int Equiv_Main(int argc, char* argv[])
+{
+    const char* files[256];
+    int file_count = 0;
+    int enabled[16];
+    int random_cases = 20;
+    int fuzz_cases = 200;
+    int rows = 2000;
+    uint64_t seed = 1;
+    const char* work = "equiv_tmp_";
+    const char* out_prefix = "equiv_min_";
+    const char* engines = NULL;
+    EquivPaths p;
+    EquivTotals tot;
+    char name[64];
+    int rc = 0;
+
+    for (int k = 0; k < Equiv_EngineCount; k++)
+        enabled[k] = 1;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--random=", 9) == 0)
+            random_cases = atoi(argv[i] + 9);
+        else if (strncmp(argv[i], "--fuzz=", 7) == 0)
+            fuzz_cases = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--rows=", 7) == 0)
+            rows = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            seed = strtoull(argv[i] + 7, NULL, 0);
+        else if (strncmp(argv[i], "--engine=", 9) == 0)
+            engines = argv[i] + 9;
+        else if (strncmp(argv[i], "--work=", 7) == 0)
+            work = argv[i] + 7;
+        else if (strncmp(argv[i], "--out=", 6) == 0)
+            out_prefix = argv[i] + 6;
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+        else if (file_count < (int)(sizeof(files) / sizeof(files[0])))
+            files[file_count++] = argv[i];
+        else
+        {
+            printf("ERROR: Too many input files (max %d)\n", (int)(sizeof(files) / sizeof(files[0])));
+            return 1;
+        }
+    }
+
+    if (random_cases < 0 || fuzz_cases < 0 || rows < 1)
+    {
+        printf("ERROR: Invalid equivalence option value\n");
+        return 1;
+    }
+
+    /* --engine=a,b : 선택한 엔진만 */
+    if (engines)
+    {
+        char list[256];
+        char* tok;
+
+        for (int k = 0; k < Equiv_EngineCount; k++)
+            enabled[k] = 0;
+
+        snprintf(list, sizeof(list), "%s", engines);
+        for (tok = strtok(list, ","); tok; tok = strtok(NULL, ","))
+        {
+            int found = 0;
+
+            for (int k = 0; k < Equiv_EngineCount; k++)
+            {
+                if (strcmp(tok, Equiv_Engines[k].name) == 0)
+                    enabled[k] = found = 1;
+            }
+            if (!found)
+            {
+                printf("ERROR: Unknown engine : %s\n", tok);
+                return 1;
+            }
+        }
+    }
+
+    memset(&tot, 0, sizeof(tot));
+    p.work = work;
+    snprintf(p.input, sizeof(p.input), "%sinput.csv", work);
+    snprintf(p.ref, sizeof(p.ref), "%sreference.csv", work);
+    snprintf(p.cand, sizeof(p.cand), "%scandidate.csv", work);
+
+    uint64_t t0 = Osal_NowNs();
+
+    /* 1. 코퍼스 파일 */
+    for (int i = 0; i < file_count && rc == 0; i++)
+    {
+        EquivText t;
+
+        if (!Text_Load(&t, files[i]))
+        {
+            rc = 1;
+            break;
+        }
+        snprintf(name, sizeof(name), "file%d", i);
+        if (Equiv_Case(&t, name, enabled, &p, out_prefix, &tot) != 0)
+            rc = 1;
+        Text_Free(&t);
+    }
+
+    /* 2. 랜덤 입력 (짝수 : 시나리오 생성기, 홀수 : 폐루프 시뮬레이터) */
+    for (int i = 0; i < random_cases && rc == 0; i++)
+    {
+        EquivText t;
+
+        if (!Text_FromSnapshots(&t, Sim_DeriveSeed(seed, (uint64_t)i), rows, i & 1))
+        {
+            printf("ERROR: Failed to generate random input %d\n", i);
+            rc = 1;
+            break;
+        }
+        snprintf(name, sizeof(name), "rand%d", i);
+        if (Equiv_Case(&t, name, enabled, &p, out_prefix, &tot) != 0)
+            rc = 1;
+        Text_Free(&t);
+    }
+
+    /* 3. 퍼징 입력 (짧은 랜덤 입력에 변형 1 ~ 16개) */
+    for (int i = 0; i < fuzz_cases && rc == 0; i++)
+    {
+        uint64_t rng = Sim_DeriveSeed(seed ^ 0xF0F0F0F0F0F0F0F0ull, (uint64_t)i);
+        int fuzz_rows = rows / 8 > 16 ? rows / 8 : 16;
+        int mutations = 1 + Equiv_Below(&rng, 16);
+        EquivText t;
+
+        if (!Text_FromSnapshots(&t, Equiv_Rand(&rng), fuzz_rows, i & 1))
+        {
+            printf("ERROR: Failed to generate fuzz input %d\n", i);
+            rc = 1;
+            break;
+        }
+        for (int m = 0; m < mutations; m++)
+            Fuzz_Mutate(&t, &rng);
+
+        snprintf(name, sizeof(name), "fuzz%d", i);
+        if (Equiv_Case(&t, name, enabled, &p, out_prefix, &tot) != 0)
+            rc = 1;
+        Text_Free(&t);
+    }
+
+    uint64_t t1 = Osal_NowNs();
+
+    remove(p.input);
+    remove(p.ref);
+    remove(p.cand);
+
+    printf("Equivalence : %llu inputs, %llu rows, %llu engine checks, %llu divergences, %.3f s\n",
+        (unsigned long long)tot.cases, (unsigned long long)tot.rows,
+        (unsigned long long)tot.checks, (unsigned long long)tot.divergences, (double)(t1 - t0) / 1e9);
+
+    return rc != 0 || tot.divergences != 0 ? 1 : 0;
+}
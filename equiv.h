@@ -0,0 +1,36 @@
+#ifndef EQUIV_H
+#define EQUIV_H
+#include <stdint.h>
+
+/*
+ * 차등 동등성 검사 (fault_engine --equiv)
+ *  - 기준 : 현재 직렬 경로 (Input_ReadLine 줄 단위 읽기 + Input_ParseLine + Fault_Init / Fault_Diagnose
+ *    + Output_WriteRow, main.c 기본 진단 루프와 같은 결과 CSV)
+ *  - 후보 엔진 : 같은 입력 파일로 결과 CSV 를 만드는 다른 구현 (Equiv_Engines), 결과 CSV 를 byte 단위로 비교
+ *  - 입력 : 명령행 코퍼스 파일 + 랜덤 입력(시나리오 생성기 / 폐루프 시뮬레이터) + 퍼징 입력(랜덤 입력 변형 :
+ *    필드 경계값 / 숫자가 아닌 값, 줄 삭제 / 중복 / 교환 / 자르기, 필드 추가, 긴 줄, CRLF, byte 변경)
+ *  - 불일치 시 데이터 줄을 delta debugging(ddmin)으로 줄여 같은 불일치를 재현하는 최소 입력 CSV 를 기록
+ *  - Input_ReadLine 은 프로세스당 파일 1개만 읽을 수 있으므로(정적 헤더 상태) 기준 경로는 같은 fgets 줄 단위
+ *    읽기 + 헤더 1줄 생략을 그대로 옮겨 사용
+ */
+
+/* 후보 엔진 : input_file 진단 결과를 result_file 에 기록, 성공 0 (work : 보조 파일 경로 접두사) */
+typedef int (*EquivRunFunc)(const char* input_file, const char* result_file, const char* work);
+
+typedef struct
+{
+    const char* name;
+    const char* desc;
+    EquivRunFunc run;
+} EquivEngine;
+
+extern const EquivEngine Equiv_Engines[];
+extern const int Equiv_EngineCount;
+
+/* ===== 기준 경로 진단 : 성공 0, 실패 1 ===== */
+int Equiv_Reference(const char* input_file, const char* result_file);
+
+/* ===== 명령행 진입점 : fault_engine --equiv [input.csv ...] [options], 불일치 없음 0 ===== */
+int Equiv_Main(int argc, char* argv[]);
+
+#endif /* EQUIV_H */
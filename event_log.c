@@ -0,0 +1,434 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "event_log.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Input_Fields 번호 */
+enum
+{
+    TRIG_CYCLE = 0, TRIG_SEQ = 1, TRIG_PLUG = 2, TRIG_RELAY = 4, TRIG_IA = 5,
+    TRIG_H = 12, TRIG_CAN = 13, TRIG_ISO = 14
+};
+
+/* 고장 코드별 트리거 신호 (0x01 / 0x02 : 전이 Cycle 의 최대 / 최소 상전류 필드로 대체) */
+static const uint8_t triggerTable[FAULT_MAX] =
+{
+    0,
+    TRIG_IA,                /* 0x01 과전류 */
+    TRIG_IA,                /* 0x02 저전류 */
+    TRIG_PLUG,              /* 0x03 플러그 */
+    TRIG_RELAY,             /* 0x04 릴레이 */
+    EVENT_TRIGGER_VDIFF,    /* 0x05 BMS 전압 편차 */
+    TRIG_H,                 /* 0x06 과온 */
+    TRIG_CAN,               /* 0x07 CAN */
+    TRIG_ISO,               /* 0x08 절연 저항 */
+    TRIG_PLUG,              /* 0x09 결제 */
+    TRIG_CYCLE,             /* 0x0A Watchdog */
+    TRIG_SEQ,               /* 0x0B 시퀀스 타임아웃 */
+    TRIG_H                  /* 0x0C 온도 센서 */
+};
+
+/* 고장 코드별 카운터 위치 : 4 byte 읽고 mask (uint8 : 0xFF, int32 : 전체, 없음 : 0)
+ * FaultContext 는 4 byte 정렬 + Fault_InitContext 가 padding 까지 0 → uint8 필드에서 4 byte 읽어도 구조체 안 */
+#define COUNTER(sub, member) \
+    { offsetof(FaultContext, sub.member), \
+      sizeof(((FaultContext*)0)->sub.member) == 1 ? 0xFFu : 0xFFFFFFFFu, #member }
+
+static const struct { uint32_t offset; uint32_t mask; const char* name; } counterTable[FAULT_MAX][EVENT_COUNTERS] =
+{
+    { { 0, 0, NULL } },
+    { COUNTER(f01, over_cnt), COUNTER(f01, rec_cnt) },
+    { COUNTER(f02, under_cnt), COUNTER(f02, rec_cnt) },
+    { COUNTER(f03, fault_cnt), COUNTER(f03, latched) },
+    { { 0, 0, NULL } },
+    { COUNTER(f05, batt_cnt), COUNTER(f05, batt_rec_cnt) },
+    { COUNTER(f06, heat_cnt), COUNTER(f06, heat_rec_cnt), COUNTER(f06, fault_cnt), COUNTER(f06, latched) },
+    { COUNTER(f07, can_to_cnt), COUNTER(f07, can_rec_cnt) },
+    { COUNTER(f08, iso_cnt), COUNTER(f08, iso_rec_cnt) },
+    { COUNTER(f09, pay_err_cnt) },
+    { COUNTER(f0A, prev_cycle), COUNTER(f0A, acc_delay) },
+    { COUNTER(f0B, prev_seq), COUNTER(f0B, seq_timer), COUNTER(f0B, timeout_repeat_cnt), COUNTER(f0B, latched) },
+    { COUNTER(f0C, temp_fault_cnt) }
+};
+
+/* 최하위 1 bit 위치 (x != 0) */
+#ifdef _MSC_VER
+#include <intrin.h>
+static __inline int EventLog_Ctz(uint32_t x)
+{
+    unsigned long i;
+
+    _BitScanForward(&i, x);
+    return (int)i;
+}
+#else
+#define EventLog_Ctz(x)     __builtin_ctz(x)
+#endif
+
+static const char* const stateNames[] = { "NORMAL", "DETECT", "CONFIRM", "?" };
+
+const char* EventLog_CounterName(int code, int k)
+{
+    if (code <= 0 || code >= FAULT_MAX || k < 0 || k >= EVENT_COUNTERS)
+        return NULL;
+    return counterTable[code][k].name;
+}
+
+const char* EventLog_TriggerName(int trigger)
+{
+    if (trigger == (int)EVENT_TRIGGER_VDIFF)
+        return "|Real_V-Exp_V|";
+    if (trigger >= 0 && trigger < INPUT_FIELD_COUNT)
+        return Input_Fields[trigger].name;
+    return "?";
+}
+
+/* 0x01 / 0x02 : 최대 / 최소 상전류 필드 */
+static int EventLog_Trigger(int code, const InputSnapshot* in)
+{
+    int trigger = triggerTable[code];
+
+    if (code == FAULT_INPUT_OVERCURRENT)
+    {
+        if (in->Ib > in->Ia && in->Ib >= in->Ic)
+            trigger = TRIG_IA + 1;
+        else if (in->Ic > in->Ia && in->Ic > in->Ib)
+            trigger = TRIG_IA + 2;
+    }
+    else if (code == FAULT_INPUT_UNDERCURRENT)
+    {
+        if (in->Ib < in->Ia && in->Ib <= in->Ic)
+            trigger = TRIG_IA + 1;
+        else if (in->Ic < in->Ia && in->Ic < in->Ib)
+            trigger = TRIG_IA + 2;
+    }
+    return trigger;
+}
+
+void EventLog_Transitions(EventWriter* w, const FaultContext* ctx, const InputSnapshot* in, uint32_t status)
+{
+    uint32_t changed = status ^ w->prev;
+    uint32_t any = (changed | changed >> 1) & 0x00555555u;     // 바뀐 고장 코드별 하위 bit
+    size_t n = 0;
+    size_t k = 0;
+    EventRecord* r = NULL;
+
+    /* 바뀐 고장 코드만 순회 (12개 전체 분기 없음) */
+    while (any)
+    {
+        int shift = EventLog_Ctz(any);
+        int code = shift / 2 + 1;
+        EventRecord* e;
+
+        any &= any - 1;
+
+        /* 연속 슬롯이 모자라면 지금까지 반영 후 다시 예약 (링 끝 wrap), 가득 차면 버림 */
+        if (k == n)
+        {
+            if (k)
+                Spsc_WriteEnd(&w->ring, k);
+            k = 0;
+            n = FAULT_MAX - code;
+            r = (EventRecord*)Spsc_WriteBegin(&w->ring, &n);
+            if (!r)
+                n = 0;
+        }
+        if (k == n)
+        {
+            w->seq++;
+            w->dropped++;
+            continue;
+        }
+
+        e = &r[k++];
+        e->seq = w->seq++;
+        e->cycle = in->Cycle;
+        e->code = (uint8_t)code;
+        e->states = (uint8_t)(((w->prev >> shift) & 0x3u) << 4 | ((status >> shift) & 0x3u));
+        e->trigger = (uint8_t)EventLog_Trigger(code, in);
+        e->writer = w->id;
+
+        /* 트리거 값 : 필드 32 bit 그대로 (전류 변환은 디코더) */
+        if (e->trigger == EVENT_TRIGGER_VDIFF)
+        {
+            /* 0x05 와 같이 64 bit 로 계산, int32 범위로 포화 */
+            int64_t d = (int64_t)in->Real_V - in->Exp_V;
+
+            d = (d < 0) ? -d : d;
+            e->value = (int32_t)((d > INT32_MAX) ? INT32_MAX : d);
+        }
+        else
+            memcpy(&e->value, (const char*)in + Input_Fields[e->trigger].offset, sizeof(e->value));
+
+        for (int c = 0; c < EVENT_COUNTERS; c++)
+        {
+            uint32_t v;
+
+            memcpy(&v, (const char*)ctx + counterTable[code][c].offset, sizeof(v));
+            e->counter[c] = (int32_t)(v & counterTable[code][c].mask);
+        }
+    }
+
+    if (k)
+        Spsc_WriteEnd(&w->ring, k);
+    w->prev = status;
+}
+
+/* 배출 스레드 : 모든 링이 빌 때까지 파일에 기록, 종료 요청 후에는 마지막 1회 배출 */
+static void EventLog_Drain(void* arg)
+{
+    EventLog* log = (EventLog*)arg;
+
+    for (;;)
+    {
+        /* 종료 요청을 먼저 읽음 : 요청 전에 끝난 기록은 이번 배출에 모두 포함 */
+        int stop = OSAL_LOAD_ACQUIRE(&log->stop) != 0;
+        uint64_t count = OSAL_LOAD_ACQUIRE(&log->count);
+        uint64_t moved = 0;
+
+        for (uint64_t k = 0; k < count; k++)
+        {
+            SpscRing* ring = &log->writer[k].ring;
+
+            for (;;)
+            {
+                size_t n = EVENT_LOG_RING_SIZE;
+                const EventRecord* r = (const EventRecord*)Spsc_ReadBegin(ring, &n);
+
+                if (!r)
+                    break;
+                if (!log->failed && fwrite(r, sizeof(*r), n, log->fp) != n)
+                    log->failed = 1;
+                Spsc_ReadEnd(ring, n);
+                log->records += n;
+                moved += n;
+            }
+        }
+
+        if (stop)
+            break;
+        if (!moved)
+            Osal_SleepNs((uint64_t)EVENT_LOG_IDLE_US * 1000u);
+    }
+}
+
+int EventLog_Open(EventLog* log, const char* path)
+{
+    EventLogHeader h;
+
+    memset(log, 0, sizeof(*log));
+    log->fp = fopen(path, "wb");
+    if (!log->fp)
+    {
+        printf("ERROR: Failed to create event log : %s\n", path);
+        return 0;
+    }
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, EVENT_LOG_MAGIC, sizeof(h.magic));
+    h.version = EVENT_LOG_VERSION;
+    h.record_size = (uint32_t)sizeof(EventRecord);
+    h.engine_version = FAULT_ENGINE_VERSION;
+#ifdef OBC_FIXED_POINT
+    h.flags = EVENT_LOG_FLAG_FIXED_CURRENT;
+#endif
+
+    if (fwrite(&h, sizeof(h), 1, log->fp) != 1 || !Osal_ThreadCreate(&log->drain, EventLog_Drain, log))
+    {
+        printf("ERROR: Failed to start event log : %s\n", path);
+        fclose(log->fp);
+        log->fp = NULL;
+        return 0;
+    }
+    log->started = 1;
+    return 1;
+}
+
+EventWriter* EventLog_AddWriter(EventLog* log, const FaultContext* ctx)
+{
+    EventWriter* w;
+
+    if (!log || log->count >= EVENT_LOG_WRITERS_MAX)
+        return NULL;
+
+    w = &log->writer[log->count];
+    memset(w, 0, sizeof(*w));
+    if (!Spsc_Init(&w->ring, sizeof(EventRecord), EVENT_LOG_RING_SIZE))
+    {
+        printf("ERROR: Out of memory for event log ring\n");
+        return NULL;
+    }
+    w->id = (uint8_t)log->count;
+    w->prev = Fault_PackStatus(ctx);
+
+    /* 링 초기화 후 게시 (배출 스레드는 count 까지만 읽음) */
+    OSAL_STORE_RELEASE(&log->count, log->count + 1);
+    return w;
+}
+
+int EventLog_Close(EventLog* log)
+{
+    EventLogHeader h;
+    int ok;
+
+    if (!log->started)
+        return 0;
+
+    OSAL_STORE_RELEASE(&log->stop, (uint64_t)1);
+    Osal_ThreadJoin(log->drain);
+    log->started = 0;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, EVENT_LOG_MAGIC, sizeof(h.magic));
+    h.version = EVENT_LOG_VERSION;
+    h.record_size = (uint32_t)sizeof(EventRecord);
+    h.engine_version = FAULT_ENGINE_VERSION;
+#ifdef OBC_FIXED_POINT
+    h.flags = EVENT_LOG_FLAG_FIXED_CURRENT;
+#endif
+    h.writers = (uint16_t)log->count;
+
+    for (uint64_t k = 0; k < log->count; k++)
+    {
+        log->dropped += log->writer[k].dropped;
+        Spsc_Free(&log->writer[k].ring);
+    }
+    h.dropped = log->dropped;
+
+    ok = !log->failed && fseek(log->fp, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, log->fp) == 1;
+    ok = (fclose(log->fp) == 0) && ok;
+    log->fp = NULL;
+    if (!ok)
+        printf("ERROR: Failed to write event log\n");
+    return ok;
+}
+
+void EventLog_WriteText(FILE* out, const EventRecord* r, uint32_t flags)
+{
+    int code = r->code < FAULT_MAX ? r->code : 0;
+
+    fprintf(out, "%10u  w%u  cycle %-8d 0x%02X  %-7s -> %-7s  %s=",
+        (unsigned)r->seq, (unsigned)r->writer, r->cycle, (unsigned)r->code,
+        stateNames[(r->states >> 4) & 0x3u], stateNames[r->states & 0x3u], EventLog_TriggerName(r->trigger));
+
+    /* 전류 : 기록한 빌드의 표현 → A */
+    if (r->trigger < INPUT_FIELD_COUNT && Input_Fields[r->trigger].is_float)
+    {
+        if (flags & EVENT_LOG_FLAG_FIXED_CURRENT)
+            fprintf(out, "%.4f A", r->value / 2000.0);
+        else
+        {
+            float a;
+
+            memcpy(&a, &r->value, sizeof(a));
+            fprintf(out, "%.4f A", a);
+        }
+    }
+    else
+        fprintf(out, "%d", r->value);
+
+    for (int c = 0; c < EVENT_COUNTERS; c++)
+    {
+        const char* name = EventLog_CounterName(code, c);
+
+        if (name)
+            fprintf(out, "  %s=%d", name, r->counter[c]);
+    }
+    fputc('\n', out);
+}
+
+int EventLog_Main(int argc, char* argv[])
+{
+    const char* path = NULL;
+    int only = 0;
+    long long limit = -1;
+    EventLogHeader h;
+    EventRecord r;
+    uint32_t next[256] = { 0 };
+    uint8_t seen[256] = { 0 };
+    uint64_t records = 0;
+    uint64_t gaps = 0;
+    uint64_t shown = 0;
+    uint64_t transitions[FAULT_MAX][3] = { { 0 } };
+    FILE* fp;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--code=", 7) == 0)
+            only = (int)strtol(argv[i] + 7, NULL, 0);
+        else if (strncmp(argv[i], "--limit=", 8) == 0)
+            limit = atoll(argv[i] + 8);
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+        else
+            path = argv[i];
+    }
+
+    if (!path || only < 0 || only >= FAULT_MAX)
+    {
+        printf("ERROR: Usage : --events <file> [--code=0xNN] [--limit=N]\n");
+        return 1;
+    }
+
+    fp = fopen(path, "rb");
+    if (!fp)
+    {
+        printf("ERROR: Failed to open event log : %s\n", path);
+        return 1;
+    }
+
+    if (fread(&h, sizeof(h), 1, fp) != 1 || memcmp(h.magic, EVENT_LOG_MAGIC, sizeof(h.magic)) != 0 ||
+        h.version != EVENT_LOG_VERSION || h.record_size != sizeof(EventRecord))
+    {
+        printf("ERROR: Not an event log (or unsupported version) : %s\n", path);
+        fclose(fp);
+        return 1;
+    }
+
+    printf("Event log : %s (engine 0x%08X%s, %u writers, %llu dropped)\n", path, (unsigned)h.engine_version,
+        h.engine_version == FAULT_ENGINE_VERSION ? "" : " : different engine version",
+        (unsigned)h.writers, (unsigned long long)h.dropped);
+
+    /* 불완전한 마지막 레코드(기록 중 중단)는 fread 에서 제외 */
+    while (fread(&r, sizeof(r), 1, fp) == 1)
+    {
+        records++;
+
+        /* 기록 스레드별 seq 불연속 : 링이 가득 차 버린 레코드 */
+        if (seen[r.writer] && r.seq != next[r.writer])
+        {
+            gaps += (uint64_t)(uint32_t)(r.seq - next[r.writer]);
+            if (limit < 0 || (long long)shown < limit)
+                printf("    -- w%u : %u records dropped --\n", (unsigned)r.writer, (unsigned)(r.seq - next[r.writer]));
+        }
+        seen[r.writer] = 1;
+        next[r.writer] = r.seq + 1;
+
+        if (r.code > 0 && r.code < FAULT_MAX && (r.states & 0x3u) < 3)
+            transitions[r.code][r.states & 0x3u]++;
+
+        if (only && r.code != only)
+            continue;
+        if (limit >= 0 && (long long)shown >= limit)
+            continue;
+        EventLog_WriteText(stdout, &r, h.flags);
+        shown++;
+    }
+    fclose(fp);
+
+    printf("Events : %llu records, %llu shown, %llu missing by sequence\n",
+        (unsigned long long)records, (unsigned long long)shown, (unsigned long long)gaps);
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if (transitions[code][0] + transitions[code][1] + transitions[code][2] == 0)
+            continue;
+        printf("  0x%02X : -> NORMAL %llu, -> DETECT %llu, -> CONFIRM %llu\n", code,
+            (unsigned long long)transitions[code][0], (unsigned long long)transitions[code][1],
+            (unsigned long long)transitions[code][2]);
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+#include <stdio.h>
+#include <stdint.h>
+#include "input.h"
+#include "fault.h"
+#include "osal.h"
+#include "spsc_ring.h"
+
+/*
+ * 고장 상태 전이 이진 이벤트 로그 (--events=<file>, 디코더 : fault_engine --events <file>)
+ *  - 진단 스레드 : Cycle 마다 Fault_PackStatus 를 직전 값과 비교, 바뀐 고장마다 32 byte 레코드
+ *    (Cycle, 고장 코드, 이전 / 새 상태, 고장별 카운터 4개, 트리거 신호 번호 / 값)를 자기 SPSC 링에 기록
+ *    → 파일 I/O / 잠금 / 시각 조회 / 값 변환 없음 (바뀐 고장만 순회, 트리거 필드 / 카운터는 그대로 복사),
+ *      링이 가득 차면 대기하지 않고 버린 수만 집계 (seq 로 누락 위치 확인)
+ *  - 배출 스레드 : 등록된 링을 돌며 모은 레코드를 파일에 기록 (비었으면 EVENT_LOG_IDLE_US 대기)
+ *  - 파일 : 헤더 32 byte (magic "OBCEVNT1", version, record_size, engine_version, flags, writers, dropped) + 레코드
+ *    (리틀 엔디언), dropped 는 닫을 때 기록, 기록 중 중단된 파일은 불완전한 마지막 레코드만 무시
+ *  - 전류 트리거 값은 빌드의 InputCurrent 32 bit 그대로 (flags 로 구분, 디코더가 A 로 변환 → 어느 빌드에서도 읽음)
+ *  - 기록 스레드 등록(EventLog_AddWriter)은 제어 스레드 1개가 해당 스레드 시작 전에 수행
+ */
+
+#define EVENT_LOG_MAGIC         "OBCEVNT1"
+#define EVENT_LOG_VERSION       1u
+#define EVENT_LOG_WRITERS_MAX   8
+#define EVENT_LOG_RING_SIZE     8192u   // 기록 스레드별 링 레코드 수
+#define EVENT_LOG_IDLE_US       1000u   // 배출 스레드 : 모든 링이 비었을 때 대기 시간
+#define EVENT_COUNTERS          4
+
+#define EVENT_LOG_FLAG_FIXED_CURRENT    0x1u    // 전류 트리거 값이 고정소수점(OBC_FIXED_POINT, 1 LSB = 0.5 mA)
+
+/* 트리거 신호 번호 : Input_Fields 번호 (0 ~ INPUT_FIELD_COUNT-1) 또는 아래 파생 신호 */
+#define EVENT_TRIGGER_VDIFF     0xF0u   // |Real_V - Exp_V| (0x05)
+
+typedef struct
+{
+    uint32_t seq;               // 기록 스레드별 레코드 순번 (버린 레코드 포함)
+    int32_t cycle;
+    uint8_t code;               // FaultCode
+    uint8_t states;             // 이전 상태 << 4 | 새 상태
+    uint8_t trigger;            // 트리거 신호 번호
+    uint8_t writer;             // 기록 스레드 번호
+    int32_t value;              // 트리거 신호 값 (전류 : InputCurrent bit 그대로, 전압 편차 : int32 포화)
+    int32_t counter[EVENT_COUNTERS];    // 고장별 카운터 (전이 직후 값, EventLog_CounterName)
+} EventRecord;
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;       // sizeof(EventRecord)
+    uint32_t engine_version;    // FAULT_ENGINE_VERSION
+    uint16_t flags;             // EVENT_LOG_FLAG_*
+    uint16_t writers;           // 기록 스레드 수
+    uint64_t dropped;           // 링이 가득 차 버린 레코드 수 (닫을 때 기록)
+} EventLogHeader;
+
+/* 기록 스레드별 링 (소유 스레드만 생산, 배출 스레드만 소비) */
+typedef struct
+{
+    SpscRing ring;              // EventRecord
+
+    /* 소유 스레드 전용 (닫은 뒤 합산) */
+    uint32_t seq;
+    uint32_t prev;              // 직전 Fault_PackStatus
+    uint64_t dropped;
+    uint8_t id;
+    char pad0[OSAL_CACHE_LINE]; // 다음 기록 스레드 링과 캐시 라인 분리
+} EventWriter;
+
+typedef struct
+{
+    FILE* fp;
+    EventWriter writer[EVENT_LOG_WRITERS_MAX];
+    uint64_t count;             // 등록 스레드 수 (release 게시)
+    uint64_t stop;              // 1 : 배출 스레드 종료 요청 (남은 레코드 배출 후 종료)
+    OsalThread drain;
+    int started;
+    int failed;                 // 배출 스레드 기록 실패
+    uint64_t records;           // 기록한 레코드 수 (배출 스레드)
+    uint64_t dropped;           // 닫을 때 합산
+} EventLog;
+
+/* ===== 파일 생성 + 배출 스레드 시작 : 성공 1, 실패 0 ===== */
+int EventLog_Open(EventLog* log, const char* path);
+
+/* ===== 기록 스레드 등록 (ctx : 시작 상태) : 가득 차거나 메모리 부족이면 NULL ===== */
+EventWriter* EventLog_AddWriter(EventLog* log, const FaultContext* ctx);
+
+/* ===== 남은 레코드 배출 후 헤더(writers / dropped) 기록, 링 해제 : 성공 1, 실패 0 ===== */
+int EventLog_Close(EventLog* log);
+
+/* 전이 레코드 기록 (전이가 있는 Cycle 만, 인라인 경로 밖) */
+void EventLog_Transitions(EventWriter* w, const FaultContext* ctx, const InputSnapshot* in, uint32_t status);
+
+/* ===== 진단 직후 1 Cycle : 상태가 바뀐 고장만 기록 ===== */
+static inline void EventLog_Step(EventWriter* w, const FaultContext* ctx, const InputSnapshot* in)
+{
+    uint32_t status = Fault_PackStatus(ctx);
+
+    if (status != w->prev)
+        EventLog_Transitions(w, ctx, in, status);
+}
+
+/* 카운터 이름 (없으면 NULL), 트리거 신호 이름 */
+const char* EventLog_CounterName(int code, int k);
+const char* EventLog_TriggerName(int trigger);
+
+/* ===== 레코드 1개를 텍스트 1줄로 기록 (flags : 파일 헤더 flags) ===== */
+void EventLog_WriteText(FILE* out, const EventRecord* r, uint32_t flags);
+
+/* ===== 명령행 진입점 : fault_engine --events <file> [--code=0xNN] [--limit=N], 성공 0 ===== */
+int EventLog_Main(int argc, char* argv[]);
+
+#endif /* EVENT_LOG_H */
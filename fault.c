@@ -1,177 +1,559 @@
 ﻿#include "fault.h"
+#include "prof.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 변경 기반 진단 입력 비교 (SSE2 : x64 기본) */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FAULT_IDLE_SSE2
+#endif
+
+/* 기본 엔진 Context (Fault_Init / Fault_Diagnose / Fault_GetStatus) */
+static FaultContext defaultCtx;
+
+/* 고장 사양 진단서 기준 임계값 */
+const FaultCalibration Fault_DefaultCalibration =
+{
+    /* 0x01 */ 32, 24, 10,
+    /* 0x02 */ 6, 12, 20, 10,
+    /* 0x03 */ 3,
+    /* 0x05 */ 10, 10, 5, 10, 10,
+    /* 0x06 */ 60, 20, 10, 1, 3,
+    /* 0x07 */ 5, 5,
+    /* 0x08 */ 500, 600, 10, 10,
+    /* 0x09 */ 5,
+    /* 0x0A */ 10, 10,
+    /* 0x0B */ 10, 10, 3600, 3,
+    /* 0x0C */ -20, 120, 3
+};
+
+// 고장 진단 로직 (Context 기반)
+static void Diagnose_0x01(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x02(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x03(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x04(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x05(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x06(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x07(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x08(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x09(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x0A(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x0B(FaultContext* ctx, const InputSnapshot* in);
+static void Diagnose_0x0C(FaultContext* ctx, const InputSnapshot* in);
+
+/* 변경 기반 진단용 : 진단 후 고장 상태 / 내부 상태가 바뀌었으면 1 */
+static int Diagnose_0x01_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x02_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x03_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x04_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x05_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x06_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x07_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x08_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x09_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x0A_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x0B_Changed(FaultContext* ctx, const InputSnapshot* in);
+static int Diagnose_0x0C_Changed(FaultContext* ctx, const InputSnapshot* in);
+
+/* 진단 함수 본문은 강제 인라인하여 전체 진단용 / 변경 기반 진단용 2벌로 만듦 */
+#if defined(_MSC_VER)
+#define FAULT_FORCEINLINE __forceinline
+#elif defined(__GNUC__)
+#define FAULT_FORCEINLINE inline __attribute__((always_inline))
+#else
+#define FAULT_FORCEINLINE inline
+#endif
+
+/* 고장 상태 / 내부 상태 기록 : track 이면 값이 바뀔 때 changed 표시 (track 0 인 전체 진단용은 표시 코드 없음) */
+#define FAULT_SET(lv, v) (changed |= track && (lv) != (v), (lv) = (v))
+#define FAULT_INC(lv)    (changed |= track, (lv)++)
+
+/* 분기 커버리지 (OBC_BRANCH_COVERAGE) : 진단 함수별 분기 번호 기록, 미정의 시 코드 없음 */
+#ifdef OBC_BRANCH_COVERAGE
+uint64_t Fault_BranchHits[FAULT_MAX][FAULT_BRANCH_MAX];
+uint32_t Fault_BranchPath[FAULT_MAX];
+#define FAULT_BRANCH(code, id) \
+    (Fault_BranchHits[code][id]++, Fault_BranchPath[code] |= 1u << (id))
+#else
+#define FAULT_BRANCH(code, id) ((void)0)
+#endif
+
+/* 고장 코드별 FAULT_BRANCH 분기 수 (카운터 포화 보호 분기 제외) */
+const uint8_t Fault_BranchCount[FAULT_MAX] = { 0, 10, 10, 10, 4, 10, 14, 8, 10, 8, 12, 21, 5 };
+
+typedef void (*DiagnoseFunc)(FaultContext* ctx, const InputSnapshot* in);
+
+/* 고장 코드별 진단 함수 */
+static const DiagnoseFunc diagnoseTable[FAULT_MAX] =
+{
+    NULL,
+    Diagnose_0x01, Diagnose_0x02, Diagnose_0x03, Diagnose_0x04,
+    Diagnose_0x05, Diagnose_0x06, Diagnose_0x07, Diagnose_0x08,
+    Diagnose_0x09, Diagnose_0x0A, Diagnose_0x0B, Diagnose_0x0C
+};
+
+/* 진단 함수별 입력 필드 (Input_Fields 순서 bit) */
+#define IN_CYCLE        (1u << 0)
+#define IN_SEQ          (1u << 1)
+#define IN_PLUG         (1u << 2)
+#define IN_STOP         (1u << 3)
+#define IN_RELAY        (1u << 4)
+#define IN_CURRENT      ((1u << 5) | (1u << 6) | (1u << 7))
+#define IN_CHARG_CNT    (1u << 9)
+#define IN_VOLTAGE      ((1u << 10) | (1u << 11))
+#define IN_TEMP         (1u << 12)
+#define IN_CAN          (1u << 13)
+#define IN_ISO          (1u << 14)
+
+const uint32_t Fault_InputMask[FAULT_MAX] =
+{
+    0,
+    IN_SEQ | IN_CURRENT,                        // 0x01
+    IN_SEQ | IN_CHARG_CNT | IN_CURRENT,         // 0x02
+    IN_SEQ | IN_PLUG | IN_CURRENT,              // 0x03
+    IN_RELAY | IN_STOP,                         // 0x04
+    IN_SEQ | IN_CHARG_CNT | IN_VOLTAGE,         // 0x05
+    IN_SEQ | IN_TEMP,                           // 0x06
+    IN_CAN,                                     // 0x07
+    IN_SEQ | IN_ISO,                            // 0x08
+    IN_SEQ | IN_PLUG,                           // 0x09
+    IN_CYCLE,                                   // 0x0A
+    IN_SEQ,                                     // 0x0B
+    IN_SEQ | IN_TEMP                            // 0x0C
+};
+
+/* 고장 코드별 내부 상태 위치 (0x04는 카운터 없음) */
+#define SUBSTATE(member) { offsetof(FaultContext, member), sizeof(((FaultContext*)0)->member) }
+
+static const struct { size_t offset; size_t size; } substateTable[FAULT_MAX] =
+{
+    { 0, 0 },
+    SUBSTATE(f01), SUBSTATE(f02), SUBSTATE(f03), { 0, 0 },
+    SUBSTATE(f05), SUBSTATE(f06), SUBSTATE(f07), SUBSTATE(f08),
+    SUBSTATE(f09), SUBSTATE(f0A), SUBSTATE(f0B), SUBSTATE(f0C)
+};
+
+
+// Context 초기화 (모든 카운터/래치 리셋, 기본 Calibration 적용)
+void Fault_InitContext(FaultContext* ctx)
+{
+    /* padding 까지 0으로 채워 상태 비교(memcmp)/저장이 가능하도록 함 */
+    memset(ctx, 0, sizeof(*ctx));
+
+    for (int i = 0; i < FAULT_MAX; i++) {
+        ctx->state[i] = FAULT_NORMAL;
+    }
+
+    ctx->cal = Fault_DefaultCalibration;
+
+    ctx->f0A.prev_cycle = -1;
+    ctx->f0B.prev_seq = -1;
+}
+
+// 종합 고장 진단 코드 (Context 기반)
+/* 진단 함수 1개 실행 (OBC_PROFILE : 고장별 실행 시간 기록) */
+#define DIAGNOSE(code, func) \
+    do { PROF_BEGIN(t_); func(ctx, snapshot); PROF_END(PROF_POINT_FAULT(code), t_); } while (0)
+
+void Fault_DiagnoseContext(FaultContext* ctx, const InputSnapshot* snapshot)
+{
+    DIAGNOSE(0x01, Diagnose_0x01);
+    DIAGNOSE(0x02, Diagnose_0x02);
+    DIAGNOSE(0x03, Diagnose_0x03);
+    DIAGNOSE(0x04, Diagnose_0x04);
+    DIAGNOSE(0x05, Diagnose_0x05);
+    DIAGNOSE(0x06, Diagnose_0x06);
+    DIAGNOSE(0x07, Diagnose_0x07);
+    DIAGNOSE(0x08, Diagnose_0x08);
+    DIAGNOSE(0x09, Diagnose_0x09);
+    DIAGNOSE(0x0A, Diagnose_0x0A);
+    DIAGNOSE(0x0B, Diagnose_0x0B);
+    DIAGNOSE(0x0C, Diagnose_0x0C);
+}
+
+void Fault_IdleInit(FaultIdle* idle)
+{
+    memset(idle, 0, sizeof(*idle));
+}
+
+/* 대부분의 bit 가 켜져 있으므로 실행 쪽을 직선 경로로 배치 (GCC : 분기 밖 call 배치 방지) */
+#if defined(__GNUC__)
+#define FAULT_LIKELY(x) __builtin_expect(!!(x), 1)
+#else
+#define FAULT_LIKELY(x) (x)
+#endif
+
+#define FAULT_IDLE_ALL  0x1FFEu     // bit 0x01 ~ 0x0C
+
+/* 켜진 bit 수 (SWAR) */
+static int Fault_PopCount(uint32_t x)
+{
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    return (int)((x * 0x01010101u) >> 24);
+}
+
+/* 입력 변경 bitmask 는 필드 word 비교로 계산 (Input_Fields 순서 = InputSnapshot 필드 순서, 모두 4 byte) */
+typedef char FaultIdle_LayoutCheck[sizeof(InputSnapshot) == INPUT_FIELD_COUNT * sizeof(uint32_t) ? 1 : -1];
+
+/* 진단 함수 1개 변경 기반 실행 : run 이면 실행하고, 고장 상태 / 내부 상태가 바뀌었으면(반환 1) moved 에 표시 */
+#define DIAGNOSE_CHANGED(code, func) \
+    do { \
+        if (FAULT_LIKELY(run & (1u << (code)))) { \
+            PROF_BEGIN(t_); \
+            moved |= (uint32_t)func(ctx, snapshot) << (code); \
+            PROF_END(PROF_POINT_FAULT(code), t_); \
+        } \
+    } while (0)
+
+/* 직전 Cycle 대비 바뀐 필드 bitmask (bit 비교 : -0 / 0, NaN 도 변경으로 취급), 분기 / 반복 없음
+ * SSE2 : 16 byte 비교 4회 (마지막은 필드 11 ~ 14 겹쳐 읽기) */
+static inline uint32_t Fault_ChangedFields(const InputSnapshot* cur, const InputSnapshot* old)
+{
+#ifdef FAULT_IDLE_SSE2
+    const char* a = (const char*)cur;
+    const char* b = (const char*)old;
+    uint32_t same = 0;
+
+#define SAME4(offset, shift) \
+    same |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32( \
+        _mm_loadu_si128((const __m128i*)(a + (offset))), _mm_loadu_si128((const __m128i*)(b + (offset)))))) << (shift)
+    SAME4(0, 0);
+    SAME4(16, 4);
+    SAME4(32, 8);
+    SAME4(44, 11);
+#undef SAME4
+    return ~same & ((1u << INPUT_FIELD_COUNT) - 1);
+#else
+    uint32_t x[INPUT_FIELD_COUNT], y[INPUT_FIELD_COUNT];
+
+    memcpy(x, cur, sizeof(x));
+    memcpy(y, old, sizeof(y));
+#define FIELD_CHANGED(i) ((uint32_t)(x[i] != y[i]) << (i))
+    return FIELD_CHANGED(0) | FIELD_CHANGED(1) | FIELD_CHANGED(2) | FIELD_CHANGED(3) | FIELD_CHANGED(4) |
+        FIELD_CHANGED(5) | FIELD_CHANGED(6) | FIELD_CHANGED(7) | FIELD_CHANGED(8) | FIELD_CHANGED(9) |
+        FIELD_CHANGED(10) | FIELD_CHANGED(11) | FIELD_CHANGED(12) | FIELD_CHANGED(13) | FIELD_CHANGED(14);
+#undef FIELD_CHANGED
+#endif
+}
+
+#define INPUT_CHANGED(code) ((uint32_t)((changed & Fault_InputMask[code]) != 0) << (code))
 
-/* 고장 상태 테이블 */
-static FaultStatus faultState[FAULT_MAX];
+void Fault_DiagnoseChanged(FaultContext* ctx, FaultIdle* idle, const InputSnapshot* snapshot)
+{
+    uint32_t changed;
+    uint32_t run;
+    uint32_t moved = 0;
+
+    changed = Fault_ChangedFields(snapshot, &idle->prev);
+    idle->prev = *snapshot;
+
+    /* 실행 : idle 이 아니거나 읽는 필드가 바뀐 진단 함수 (Fault_InputMask 는 상수로 접힘) */
+    run = INPUT_CHANGED(0x01) | INPUT_CHANGED(0x02) | INPUT_CHANGED(0x03) | INPUT_CHANGED(0x04) |
+        INPUT_CHANGED(0x05) | INPUT_CHANGED(0x06) | INPUT_CHANGED(0x07) | INPUT_CHANGED(0x08) |
+        INPUT_CHANGED(0x09) | INPUT_CHANGED(0x0A) | INPUT_CHANGED(0x0B) | INPUT_CHANGED(0x0C);
+    run |= ~idle->idle & FAULT_IDLE_ALL;
+
+    DIAGNOSE_CHANGED(0x01, Diagnose_0x01_Changed);
+    DIAGNOSE_CHANGED(0x02, Diagnose_0x02_Changed);
+    DIAGNOSE_CHANGED(0x03, Diagnose_0x03_Changed);
+    DIAGNOSE_CHANGED(0x04, Diagnose_0x04_Changed);
+    DIAGNOSE_CHANGED(0x05, Diagnose_0x05_Changed);
+    DIAGNOSE_CHANGED(0x06, Diagnose_0x06_Changed);
+    DIAGNOSE_CHANGED(0x07, Diagnose_0x07_Changed);
+    DIAGNOSE_CHANGED(0x08, Diagnose_0x08_Changed);
+    DIAGNOSE_CHANGED(0x09, Diagnose_0x09_Changed);
+    DIAGNOSE_CHANGED(0x0A, Diagnose_0x0A_Changed);
+    DIAGNOSE_CHANGED(0x0B, Diagnose_0x0B_Changed);
+    DIAGNOSE_CHANGED(0x0C, Diagnose_0x0C_Changed);
+
+    /* 실행한 진단 함수는 상태 변화가 없을 때만 idle, 생략한 진단 함수는 idle 유지 */
+    idle->idle = (idle->idle & ~run) | (run & ~moved);
+    idle->evaluated += (uint64_t)Fault_PopCount(run);
+    idle->skipped += (uint64_t)Fault_PopCount(~run & FAULT_IDLE_ALL);
+}
 
-// 고장 진단 로직
-void Diagnose_Fault_0x01(const InputSnapshot* in);
-void Diagnose_Fault_0x02(const InputSnapshot* in);
-void Diagnose_Fault_0x03(const InputSnapshot* in);
-void Diagnose_Fault_0x04(const InputSnapshot* in);
-void Diagnose_Fault_0x05(const InputSnapshot* in);
-void Diagnose_Fault_0x06(const InputSnapshot* in);
-void Diagnose_Fault_0x07(const InputSnapshot* in);
-void Diagnose_Fault_0x08(const InputSnapshot* in);
-void Diagnose_Fault_0x09(const InputSnapshot* in);
-void Diagnose_Fault_0x0A(const InputSnapshot* in);
-void Diagnose_Fault_0x0B(const InputSnapshot* in);
-void Diagnose_Fault_0x0C(const InputSnapshot* in);
+void Fault_DiagnoseMask(FaultContext* ctx, uint32_t mask, const InputSnapshot* snapshot)
+{
+    if (FAULT_LIKELY(mask & (1u << 0x01))) DIAGNOSE(0x01, Diagnose_0x01);
+    if (FAULT_LIKELY(mask & (1u << 0x02))) DIAGNOSE(0x02, Diagnose_0x02);
+    if (FAULT_LIKELY(mask & (1u << 0x03))) DIAGNOSE(0x03, Diagnose_0x03);
+    if (FAULT_LIKELY(mask & (1u << 0x04))) DIAGNOSE(0x04, Diagnose_0x04);
+    if (FAULT_LIKELY(mask & (1u << 0x05))) DIAGNOSE(0x05, Diagnose_0x05);
+    if (FAULT_LIKELY(mask & (1u << 0x06))) DIAGNOSE(0x06, Diagnose_0x06);
+    if (FAULT_LIKELY(mask & (1u << 0x07))) DIAGNOSE(0x07, Diagnose_0x07);
+    if (FAULT_LIKELY(mask & (1u << 0x08))) DIAGNOSE(0x08, Diagnose_0x08);
+    if (FAULT_LIKELY(mask & (1u << 0x09))) DIAGNOSE(0x09, Diagnose_0x09);
+    if (FAULT_LIKELY(mask & (1u << 0x0A))) DIAGNOSE(0x0A, Diagnose_0x0A);
+    if (FAULT_LIKELY(mask & (1u << 0x0B))) DIAGNOSE(0x0B, Diagnose_0x0B);
+    if (FAULT_LIKELY(mask & (1u << 0x0C))) DIAGNOSE(0x0C, Diagnose_0x0C);
+}
+
+FaultStatus Fault_GetContextStatus(const FaultContext* ctx, FaultCode code)
+{
+    return ctx->state[code];
+}
+
+FaultContext* Fault_GetContext(void)
+{
+    return &defaultCtx;
+}
+
+void Fault_DiagnoseOne(FaultContext* ctx, FaultCode code, const InputSnapshot* in)
+{
+    diagnoseTable[code](ctx, in);
+}
+
+int Fault_SubstateEqual(const FaultContext* a, const FaultContext* b, FaultCode code)
+{
+    size_t offset = substateTable[code].offset;
+
+    return a->state[code] == b->state[code] &&
+        memcmp((const char*)a + offset, (const char*)b + offset, substateTable[code].size) == 0;
+}
+
+void Fault_CopySubstate(FaultContext* dst, const FaultContext* src, FaultCode code)
+{
+    size_t offset = substateTable[code].offset;
+
+    dst->state[code] = src->state[code];
+    memcpy((char*)dst + offset, (const char*)src + offset, substateTable[code].size);
+}
+
+uint32_t Fault_PackStatus(const FaultContext* ctx)
+{
+    uint32_t packed = 0;
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++) {
+        packed |= ((uint32_t)ctx->state[code] & 0x3u) << ((code - 1) * 2);
+    }
+    return packed;
+}
+
+uint32_t Fault_CalibrationId(const FaultCalibration* cal)
+{
+    const uint8_t* p = (const uint8_t*)cal;
+    uint32_t h = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(*cal); i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
 
 
 // 고장 상태 초기화 함수
 void Fault_Init(void)
 {
-    for (int i = 0; i < FAULT_MAX; i++) {
-        faultState[i] = FAULT_NORMAL;
-    }
+    Fault_InitContext(&defaultCtx);
 }
 
 // 종합 고장 진단 코드
 void Fault_Diagnose(const InputSnapshot* snapshot)
 {
-    Diagnose_Fault_0x01(snapshot);
-    Diagnose_Fault_0x02(snapshot);
-    Diagnose_Fault_0x03(snapshot);
-    Diagnose_Fault_0x04(snapshot);
-    Diagnose_Fault_0x05(snapshot);
-    Diagnose_Fault_0x06(snapshot);
-    Diagnose_Fault_0x07(snapshot);
-    Diagnose_Fault_0x08(snapshot);
-    Diagnose_Fault_0x09(snapshot);
-    Diagnose_Fault_0x0A(snapshot);
-    Diagnose_Fault_0x0B(snapshot);
-    Diagnose_Fault_0x0C(snapshot);
+    Fault_DiagnoseContext(&defaultCtx, snapshot);
 }
 
 // 고장 상태 조회 함수
 FaultStatus Fault_GetStatus(FaultCode code)
 {
-    return faultState[code];
+    return defaultCtx.state[code];
 }
 
-void Diagnose_Fault_0x01(const InputSnapshot* in)
+// 개별 고장 진단 (기본 Context)
+void Diagnose_Fault_0x01(const InputSnapshot* in) { Diagnose_0x01(&defaultCtx, in); }
+void Diagnose_Fault_0x02(const InputSnapshot* in) { Diagnose_0x02(&defaultCtx, in); }
+void Diagnose_Fault_0x03(const InputSnapshot* in) { Diagnose_0x03(&defaultCtx, in); }
+void Diagnose_Fault_0x04(const InputSnapshot* in) { Diagnose_0x04(&defaultCtx, in); }
+void Diagnose_Fault_0x05(const InputSnapshot* in) { Diagnose_0x05(&defaultCtx, in); }
+void Diagnose_Fault_0x06(const InputSnapshot* in) { Diagnose_0x06(&defaultCtx, in); }
+void Diagnose_Fault_0x07(const InputSnapshot* in) { Diagnose_0x07(&defaultCtx, in); }
+void Diagnose_Fault_0x08(const InputSnapshot* in) { Diagnose_0x08(&defaultCtx, in); }
+void Diagnose_Fault_0x09(const InputSnapshot* in) { Diagnose_0x09(&defaultCtx, in); }
+void Diagnose_Fault_0x0A(const InputSnapshot* in) { Diagnose_0x0A(&defaultCtx, in); }
+void Diagnose_Fault_0x0B(const InputSnapshot* in) { Diagnose_0x0B(&defaultCtx, in); }
+void Diagnose_Fault_0x0C(const InputSnapshot* in) { Diagnose_0x0C(&defaultCtx, in); }
+
+
+static FAULT_FORCEINLINE int Diagnose_0x01_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
     /* 고장 검출 및 회복 시간 카운터 */
-    static uint8_t over_cnt = 0;
-    static uint8_t rec_cnt = 0;
+    uint8_t* over_cnt = &ctx->f01.over_cnt;
+    uint8_t* rec_cnt = &ctx->f01.rec_cnt;
 
     /* 임계값 정의 */
-    int Imax = 32;            // 고장 검출 전류 임계값
-    int I_normal_max = 24;    // 회복 판단 전류 임계값
-    int Time_Threshold = 10;  // Detect/Confirm 및 Recovery 시간 기준
+    InputCurrent Imax = INPUT_CURRENT(ctx->cal.OC_Imax);            // 고장 검출 전류 임계값
+    InputCurrent I_normal_max = INPUT_CURRENT(ctx->cal.OC_Inormal); // 회복 판단 전류 임계값
+    int Time_Threshold = ctx->cal.OC_Time;                          // Detect/Confirm 및 Recovery 시간 기준
 
     /* ================= 고장 진단 영역 ================= */
     if (in->SeqState == SEQ_CHARGING &&
         (in->Ia > Imax || in->Ib > Imax || in->Ic > Imax))
     {
+        FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 0);
+
         /* 과전류 지속 시간 카운트 */
-        if (over_cnt < 255)
-            over_cnt++;
+        if (*over_cnt < 255)
+            FAULT_INC(*over_cnt);
 
         /* Recovery 카운터 초기화 */
-        rec_cnt = 0;
+        FAULT_SET(*rec_cnt, 0);
 
         /* Detect / Confirm 상태 판단 */
-        if (over_cnt < Time_Threshold)
+        if (*over_cnt < Time_Threshold)
         {
-            faultState[FAULT_INPUT_OVERCURRENT] = FAULT_DETECT;
+            FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 2);
+            FAULT_SET(faultState[FAULT_INPUT_OVERCURRENT], FAULT_DETECT);
         }
         else
         {
-            faultState[FAULT_INPUT_OVERCURRENT] = FAULT_CONFIRM;
+            FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 3);
+            FAULT_SET(faultState[FAULT_INPUT_OVERCURRENT], FAULT_CONFIRM);
         }
     }
     else
     {
+        FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 1);
+
         /* 과전류 조건 해제 시 Detect Counter 리셋 */
-        over_cnt = 0;
+        FAULT_SET(*over_cnt, 0);
 
         /* ================= 고장 회복 영역 ================= */
         if (faultState[FAULT_INPUT_OVERCURRENT] == FAULT_CONFIRM &&
             (in->Ia < I_normal_max && in->Ib < I_normal_max && in->Ic < I_normal_max))
         {
+            FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 4);
+
             /* 정상 상태 지속 시간 카운트 */
-            if (rec_cnt < 255)
-                rec_cnt++;
+            if (*rec_cnt < 255)
+                FAULT_INC(*rec_cnt);
 
             /* 일정 시간 정상 유지 시 Fault 해제 */
-            if (rec_cnt >= Time_Threshold)
+            if (*rec_cnt >= Time_Threshold)
             {
-                faultState[FAULT_INPUT_OVERCURRENT] = FAULT_NORMAL;
-                rec_cnt = 0;
-                over_cnt = 0;
+                FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 6);
+                FAULT_SET(faultState[FAULT_INPUT_OVERCURRENT], FAULT_NORMAL);
+                FAULT_SET(*rec_cnt, 0);
+                FAULT_SET(*over_cnt, 0);
             }
+            else
+                FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 7);
         }
         else
         {
+            FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 5);
+
             /* Recovery 조건 미충족 시 Recovery Counter 리셋 */
-            rec_cnt = 0;
+            FAULT_SET(*rec_cnt, 0);
 
             /* Confirm 상태가 아니라면 NORMAL 상태 유지 */
             if (faultState[FAULT_INPUT_OVERCURRENT] != FAULT_CONFIRM)
             {
-                faultState[FAULT_INPUT_OVERCURRENT] = FAULT_NORMAL;
+                FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 8);
+                FAULT_SET(faultState[FAULT_INPUT_OVERCURRENT], FAULT_NORMAL);
             }
+            else
+                FAULT_BRANCH(FAULT_INPUT_OVERCURRENT, 9);
         }
     }
+
+    return changed;
 }
 
 
-void Diagnose_Fault_0x02(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x02_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t under_cnt = 0;
-    static uint8_t rec_cnt = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* under_cnt = &ctx->f02.under_cnt;
+    uint8_t* rec_cnt = &ctx->f02.rec_cnt;
 
-    int Imin = 6;
-	int I_normal_min = 12;
-    int Time_Threshold = 10;  // Detect/Confirm 및 Recovery 시간 기준
+    InputCurrent Imin = INPUT_CURRENT(ctx->cal.UC_Imin);
+	InputCurrent I_normal_min = INPUT_CURRENT(ctx->cal.UC_Inormal);
+    int Time_Threshold = ctx->cal.UC_Time;  // Detect/Confirm 및 Recovery 시간 기준
 
     if (in->SeqState == SEQ_CHARGING &&
-        in->Charg_Cnt > 20 &&
+        in->Charg_Cnt > ctx->cal.UC_ChargCnt &&
         (in->Ia < Imin && in->Ib < Imin && in->Ic < Imin))
     {
-        if (under_cnt < 255)
-            under_cnt++;
+        FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 0);
 
-        rec_cnt = 0;
+        if (*under_cnt < 255)
+            FAULT_INC(*under_cnt);
 
-        if (under_cnt < Time_Threshold)
-            faultState[FAULT_INPUT_UNDERCURRENT] = FAULT_DETECT;
+        FAULT_SET(*rec_cnt, 0);
+
+        if (*under_cnt < Time_Threshold)
+        {
+            FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 2);
+            FAULT_SET(faultState[FAULT_INPUT_UNDERCURRENT], FAULT_DETECT);
+        }
         else
-            faultState[FAULT_INPUT_UNDERCURRENT] = FAULT_CONFIRM;
+        {
+            FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 3);
+            FAULT_SET(faultState[FAULT_INPUT_UNDERCURRENT], FAULT_CONFIRM);
+        }
     }
     else
     {
-        under_cnt = 0;
+        FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 1);
+
+        FAULT_SET(*under_cnt, 0);
 
         if (faultState[FAULT_INPUT_UNDERCURRENT] == FAULT_CONFIRM &&
             (in->Ia > I_normal_min && in->Ib > I_normal_min && in->Ic > I_normal_min))
         {
-            if (rec_cnt < 255)
-                rec_cnt++;
+            FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 4);
 
-            if (rec_cnt >= Time_Threshold)
+            if (*rec_cnt < 255)
+                FAULT_INC(*rec_cnt);
+
+            if (*rec_cnt >= Time_Threshold)
             {
-                faultState[FAULT_INPUT_UNDERCURRENT] = FAULT_NORMAL;
-                under_cnt = 0;
-                rec_cnt = 0;
+                FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 6);
+                FAULT_SET(faultState[FAULT_INPUT_UNDERCURRENT], FAULT_NORMAL);
+                FAULT_SET(*under_cnt, 0);
+                FAULT_SET(*rec_cnt, 0);
             }
+            else
+                FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 7);
         }
         else
         {
-            rec_cnt = 0;
+            FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 5);
+
+            FAULT_SET(*rec_cnt, 0);
 
             if (faultState[FAULT_INPUT_UNDERCURRENT] != FAULT_CONFIRM)
-                faultState[FAULT_INPUT_UNDERCURRENT] = FAULT_NORMAL;
+            {
+                FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 8);
+                FAULT_SET(faultState[FAULT_INPUT_UNDERCURRENT], FAULT_NORMAL);
+            }
+            else
+                FAULT_BRANCH(FAULT_INPUT_UNDERCURRENT, 9);
+
         }
     }
+
+    return changed;
 }
 
 
-void Diagnose_Fault_0x03(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x03_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t fault_cnt = 0;
-    static uint8_t latched = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* fault_cnt = &ctx->f03.fault_cnt;
+    uint8_t* latched = &ctx->f03.latched;
 
     /* ================= 진단 조건 : 즉시 ================= */
     if (in->SeqState == SEQ_CHARGING &&
@@ -181,274 +563,415 @@ void Diagnose_Fault_0x03(const InputSnapshot* in)
                 in->Ia <= 0 && in->Ib <= 0 && in->Ic <= 0)
             ))
     {
+        FAULT_BRANCH(FAULT_PLUG, 0);
+
         /* 처음 CONFIRM으로 들어갈 때만 카운트 */
         if (faultState[FAULT_PLUG] != FAULT_CONFIRM)
         {
-            if (fault_cnt < 255)
-                fault_cnt++;
+            FAULT_BRANCH(FAULT_PLUG, 2);
+            if (*fault_cnt < 255)
+                FAULT_INC(*fault_cnt);
         }
+        else
+            FAULT_BRANCH(FAULT_PLUG, 3);
 
-        faultState[FAULT_PLUG] = FAULT_CONFIRM;
+        FAULT_SET(faultState[FAULT_PLUG], FAULT_CONFIRM);
 
         /* 3회 이상 → 재기동 금지 */
-        if (fault_cnt >= 3)
+        if (*fault_cnt >= ctx->cal.PLUG_LatchCnt)
         {
-            latched = 1;
+            FAULT_BRANCH(FAULT_PLUG, 4);
+            FAULT_SET(*latched, 1);
         }
+        else
+            FAULT_BRANCH(FAULT_PLUG, 5);
     }
     else
     {
+        FAULT_BRANCH(FAULT_PLUG, 1);
+
         /* ================= 회복 조건 ================= */
-        if (!latched &&
+        if (!*latched &&
             in->SeqState != SEQ_CHARGING &&
             in->PlugInfo == PLUG_CONNECTED_PAID)
         {
-            faultState[FAULT_PLUG] = FAULT_NORMAL;
+            FAULT_BRANCH(FAULT_PLUG, 6);
+            FAULT_SET(faultState[FAULT_PLUG], FAULT_NORMAL);
         }
         else
         {
+            FAULT_BRANCH(FAULT_PLUG, 7);
+
             /* latched 상태이거나 회복 조건 미충족 → 유지 */
             if (faultState[FAULT_PLUG] != FAULT_CONFIRM)
             {
-                faultState[FAULT_PLUG] = FAULT_NORMAL;
+                FAULT_BRANCH(FAULT_PLUG, 8);
+                FAULT_SET(faultState[FAULT_PLUG], FAULT_NORMAL);
             }
+            else
+                FAULT_BRANCH(FAULT_PLUG, 9);
         }
     }
+
+    return changed;
 }
 
-void Diagnose_Fault_0x04(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x04_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
     /* ================= 진단 조건 : 즉시 ================= */
     if (
         (in->FLAG_Relay == 1 && in->FLAG_Stop == 1) ||
         (in->FLAG_Relay == 0 && in->FLAG_Stop == 0)
         )
     {
-        faultState[FAULT_RELAY] = FAULT_CONFIRM;
+        FAULT_BRANCH(FAULT_RELAY, 0);
+        FAULT_SET(faultState[FAULT_RELAY], FAULT_CONFIRM);
     }
     else
     {
+        FAULT_BRANCH(FAULT_RELAY, 1);
+
         /* ================= 회복 조건 : 즉시 ================= */
         if (
             (in->FLAG_Relay == 1 && in->FLAG_Stop == 0) ||
             (in->FLAG_Relay == 0 && in->FLAG_Stop == 1)
             )
         {
-            faultState[FAULT_RELAY] = FAULT_NORMAL;
+            FAULT_BRANCH(FAULT_RELAY, 2);
+            FAULT_SET(faultState[FAULT_RELAY], FAULT_NORMAL);
         }
+        else
+            FAULT_BRANCH(FAULT_RELAY, 3);
     }
+
+    return changed;
 }
 
-void Diagnose_Fault_0x05(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x05_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t batt_cnt = 0;
-    static uint8_t batt_rec_cnt = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* batt_cnt = &ctx->f05.batt_cnt;
+    uint8_t* batt_rec_cnt = &ctx->f05.batt_rec_cnt;
+
+    /* 전압 편차 : int 끝 값(-2147483648 등)에서도 넘치지 않도록 64 bit 로 계산 */
+    int64_t diff = (int64_t)in->Real_V - in->Exp_V;
 
-    int diff = abs(in->Real_V - in->Exp_V);
+    if (diff < 0)
+        diff = -diff;
 
     /* ================= 진단 조건 ================= */
     if (in->SeqState == SEQ_CHARGING &&
-        in->Charg_Cnt > 10 &&
-        diff > 10.0f)
+        in->Charg_Cnt > ctx->cal.BMS_ChargCnt &&
+        diff > ctx->cal.BMS_DiffMax)
     {
-        if (batt_cnt < 255)
-            batt_cnt++;
+        FAULT_BRANCH(FAULT_BMS_STATE, 0);
 
-        batt_rec_cnt = 0;
+        if (*batt_cnt < 255)
+            FAULT_INC(*batt_cnt);
 
-        if (batt_cnt >= 10)
-            faultState[FAULT_BMS_STATE] = FAULT_CONFIRM;
+        FAULT_SET(*batt_rec_cnt, 0);
+
+        if (*batt_cnt >= ctx->cal.BMS_Time)
+        {
+            FAULT_BRANCH(FAULT_BMS_STATE, 2);
+            FAULT_SET(faultState[FAULT_BMS_STATE], FAULT_CONFIRM);
+        }
         else
-            faultState[FAULT_BMS_STATE] = FAULT_DETECT;
+        {
+            FAULT_BRANCH(FAULT_BMS_STATE, 3);
+            FAULT_SET(faultState[FAULT_BMS_STATE], FAULT_DETECT);
+        }
     }
     else
     {
-        batt_cnt = 0;
+        FAULT_BRANCH(FAULT_BMS_STATE, 1);
+
+        FAULT_SET(*batt_cnt, 0);
 
         /* ================= 회복 조건 ================= */
         if (faultState[FAULT_BMS_STATE] == FAULT_CONFIRM &&
-            diff <= 5.0f)
+            diff <= ctx->cal.BMS_DiffNormal)
         {
-            if (batt_rec_cnt < 255)
-                batt_rec_cnt++;
+            FAULT_BRANCH(FAULT_BMS_STATE, 4);
 
-            if (batt_rec_cnt >= 10)
+            if (*batt_rec_cnt < 255)
+                FAULT_INC(*batt_rec_cnt);
+
+            if (*batt_rec_cnt >= ctx->cal.BMS_RecTime)
             {
-                faultState[FAULT_BMS_STATE] = FAULT_NORMAL;
-                batt_cnt = 0;
-                batt_rec_cnt = 0;
+                FAULT_BRANCH(FAULT_BMS_STATE, 6);
+                FAULT_SET(faultState[FAULT_BMS_STATE], FAULT_NORMAL);
+                FAULT_SET(*batt_cnt, 0);
+                FAULT_SET(*batt_rec_cnt, 0);
             }
+            else
+                FAULT_BRANCH(FAULT_BMS_STATE, 7);
         }
         else
         {
-            batt_rec_cnt = 0;
+            FAULT_BRANCH(FAULT_BMS_STATE, 5);
+
+            FAULT_SET(*batt_rec_cnt, 0);
 
             if (faultState[FAULT_BMS_STATE] != FAULT_CONFIRM)
-                faultState[FAULT_BMS_STATE] = FAULT_NORMAL;
+            {
+                FAULT_BRANCH(FAULT_BMS_STATE, 8);
+                FAULT_SET(faultState[FAULT_BMS_STATE], FAULT_NORMAL);
+            }
+            else
+                FAULT_BRANCH(FAULT_BMS_STATE, 9);
+
         }
     }
+
+    return changed;
 }
 
-void Diagnose_Fault_0x06(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x06_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t heat_cnt = 0;
-    static uint8_t heat_rec_cnt = 0;
-    static uint8_t fault_cnt = 0;
-    static uint8_t latched = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* heat_cnt = &ctx->f06.heat_cnt;
+    uint8_t* heat_rec_cnt = &ctx->f06.heat_rec_cnt;
+    uint8_t* fault_cnt = &ctx->f06.fault_cnt;
+    uint8_t* latched = &ctx->f06.latched;
 
     /* ================= 진단 조건 ================= */
     if (in->SeqState == SEQ_CHARGING &&
-        in->H > 60)
+        in->H > ctx->cal.OT_Hmax)
     {
-        if (heat_cnt < 255)
-            heat_cnt++;
+        FAULT_BRANCH(FAULT_OVER_TEMP, 0);
+
+        if (*heat_cnt < 255)
+            FAULT_INC(*heat_cnt);
 
-        heat_rec_cnt = 0;
+        FAULT_SET(*heat_rec_cnt, 0);
 
-        if (heat_cnt >= 10)
+        if (*heat_cnt >= ctx->cal.OT_Time)
         {
+            FAULT_BRANCH(FAULT_OVER_TEMP, 2);
+
             /* CONFIRM 진입 시 1회만 카운트 */
             if (faultState[FAULT_OVER_TEMP] != FAULT_CONFIRM)
             {
-                if (fault_cnt < 255)
-                    fault_cnt++;
+                FAULT_BRANCH(FAULT_OVER_TEMP, 4);
+                if (*fault_cnt < 255)
+                    FAULT_INC(*fault_cnt);
             }
+            else
+                FAULT_BRANCH(FAULT_OVER_TEMP, 5);
 
-            faultState[FAULT_OVER_TEMP] = FAULT_CONFIRM;
+            FAULT_SET(faultState[FAULT_OVER_TEMP], FAULT_CONFIRM);
 
             /* 3회 이상 반복 → 재기동 금지 */
-            if (fault_cnt >= 3)
+            if (*fault_cnt >= ctx->cal.OT_LatchCnt)
             {
-                latched = 1;
+                FAULT_BRANCH(FAULT_OVER_TEMP, 6);
+                FAULT_SET(*latched, 1);
             }
+            else
+                FAULT_BRANCH(FAULT_OVER_TEMP, 7);
         }
         else
         {
-            faultState[FAULT_OVER_TEMP] = FAULT_DETECT;
+            FAULT_BRANCH(FAULT_OVER_TEMP, 3);
+            FAULT_SET(faultState[FAULT_OVER_TEMP], FAULT_DETECT);
         }
     }
     else
     {
-        heat_cnt = 0;
+        FAULT_BRANCH(FAULT_OVER_TEMP, 1);
+
+        FAULT_SET(*heat_cnt, 0);
 
         /* ================= 회복 조건 ================= */
-        if (!latched &&
+        if (!*latched &&
             in->SeqState == SEQ_INIT &&
-            in->H < 20)
+            in->H < ctx->cal.OT_Hnormal)
         {
-            if (heat_rec_cnt < 255)
-                heat_rec_cnt++;
+            FAULT_BRANCH(FAULT_OVER_TEMP, 8);
+
+            if (*heat_rec_cnt < 255)
+                FAULT_INC(*heat_rec_cnt);
 
-            if (heat_rec_cnt >= 1)   /* 즉시 회복 허용 */
+            if (*heat_rec_cnt >= ctx->cal.OT_RecTime)   /* 즉시 회복 허용 */
             {
-                faultState[FAULT_OVER_TEMP] = FAULT_NORMAL;
-                heat_rec_cnt = 0;
+                FAULT_BRANCH(FAULT_OVER_TEMP, 10);
+                FAULT_SET(faultState[FAULT_OVER_TEMP], FAULT_NORMAL);
+                FAULT_SET(*heat_rec_cnt, 0);
             }
+            else
+                FAULT_BRANCH(FAULT_OVER_TEMP, 11);
         }
         else
         {
-            heat_rec_cnt = 0;
+            FAULT_BRANCH(FAULT_OVER_TEMP, 9);
+
+            FAULT_SET(*heat_rec_cnt, 0);
 
             if (faultState[FAULT_OVER_TEMP] != FAULT_CONFIRM)
             {
-                faultState[FAULT_OVER_TEMP] = FAULT_NORMAL;
+                FAULT_BRANCH(FAULT_OVER_TEMP, 12);
+                FAULT_SET(faultState[FAULT_OVER_TEMP], FAULT_NORMAL);
             }
+            else
+                FAULT_BRANCH(FAULT_OVER_TEMP, 13);
         }
     }
+
+    return changed;
 }
 
-void Diagnose_Fault_0x07(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x07_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t can_to_cnt = 0;
-    static uint8_t can_rec_cnt = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* can_to_cnt = &ctx->f07.can_to_cnt;
+    uint8_t* can_rec_cnt = &ctx->f07.can_rec_cnt;
 
     /* ================= 진단 조건 ================= */
     if (in->CanMsg == 0)   /* CanMsg_Received == 0 */
     {
-        if (can_to_cnt < 255)
-            can_to_cnt++;
+        FAULT_BRANCH(FAULT_CAN, 0);
 
-        can_rec_cnt = 0;
+        if (*can_to_cnt < 255)
+            FAULT_INC(*can_to_cnt);
 
-        if (can_to_cnt >= 5)
-            faultState[FAULT_CAN] = FAULT_CONFIRM;
+        FAULT_SET(*can_rec_cnt, 0);
+
+        if (*can_to_cnt >= ctx->cal.CAN_Time)
+        {
+            FAULT_BRANCH(FAULT_CAN, 2);
+            FAULT_SET(faultState[FAULT_CAN], FAULT_CONFIRM);
+        }
         else
-            faultState[FAULT_CAN] = FAULT_DETECT;
+        {
+            FAULT_BRANCH(FAULT_CAN, 3);
+            FAULT_SET(faultState[FAULT_CAN], FAULT_DETECT);
+        }
     }
     else   /* CanMsg_Received == 1 */
     {
-        can_to_cnt = 0;
+        FAULT_BRANCH(FAULT_CAN, 1);
+
+        FAULT_SET(*can_to_cnt, 0);
 
         /* ================= 회복 조건 ================= */
         if (faultState[FAULT_CAN] == FAULT_CONFIRM)
         {
-            if (can_rec_cnt < 255)
-                can_rec_cnt++;
+            FAULT_BRANCH(FAULT_CAN, 4);
 
-            if (can_rec_cnt >= 5)
+            if (*can_rec_cnt < 255)
+                FAULT_INC(*can_rec_cnt);
+
+            if (*can_rec_cnt >= ctx->cal.CAN_RecTime)
             {
-                faultState[FAULT_CAN] = FAULT_NORMAL;
-                can_rec_cnt = 0;
+                FAULT_BRANCH(FAULT_CAN, 6);
+                FAULT_SET(faultState[FAULT_CAN], FAULT_NORMAL);
+                FAULT_SET(*can_rec_cnt, 0);
             }
+            else
+                FAULT_BRANCH(FAULT_CAN, 7);
         }
         else
         {
-            can_rec_cnt = 0;
-            faultState[FAULT_CAN] = FAULT_NORMAL;
+            FAULT_BRANCH(FAULT_CAN, 5);
+            FAULT_SET(*can_rec_cnt, 0);
+            FAULT_SET(faultState[FAULT_CAN], FAULT_NORMAL);
         }
     }
+
+    return changed;
 }
 
-void Diagnose_Fault_0x08(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x08_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t iso_cnt = 0;
-    static uint8_t iso_rec_cnt = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* iso_cnt = &ctx->f08.iso_cnt;
+    uint8_t* iso_rec_cnt = &ctx->f08.iso_rec_cnt;
 
     /* ================= 진단 조건 ================= */
     if (in->SeqState == SEQ_CHARGING &&
-        in->IsoR < 500)   /* IsoRmin */
+        in->IsoR < ctx->cal.ISO_Rmin)   /* IsoRmin */
     {
-        if (iso_cnt < 255)
-            iso_cnt++;
+        FAULT_BRANCH(FAULT_ISO, 0);
 
-        iso_rec_cnt = 0;
+        if (*iso_cnt < 255)
+            FAULT_INC(*iso_cnt);
 
-        if (iso_cnt >= 10)
-            faultState[FAULT_ISO] = FAULT_CONFIRM;
+        FAULT_SET(*iso_rec_cnt, 0);
+
+        if (*iso_cnt >= ctx->cal.ISO_Time)
+        {
+            FAULT_BRANCH(FAULT_ISO, 2);
+            FAULT_SET(faultState[FAULT_ISO], FAULT_CONFIRM);
+        }
         else
-            faultState[FAULT_ISO] = FAULT_DETECT;
+        {
+            FAULT_BRANCH(FAULT_ISO, 3);
+            FAULT_SET(faultState[FAULT_ISO], FAULT_DETECT);
+        }
     }
     else
     {
-        iso_cnt = 0;
+        FAULT_BRANCH(FAULT_ISO, 1);
+
+        FAULT_SET(*iso_cnt, 0);
 
         /* ================= 회복 조건 ================= */
         if (faultState[FAULT_ISO] == FAULT_CONFIRM &&
             in->SeqState != SEQ_CHARGING &&
-            in->IsoR > 600)   /* IsoRnormal */
+            in->IsoR > ctx->cal.ISO_Rnormal)   /* IsoRnormal */
         {
-            if (iso_rec_cnt < 255)
-                iso_rec_cnt++;
+            FAULT_BRANCH(FAULT_ISO, 4);
 
-            if (iso_rec_cnt >= 10)
+            if (*iso_rec_cnt < 255)
+                FAULT_INC(*iso_rec_cnt);
+
+            if (*iso_rec_cnt >= ctx->cal.ISO_RecTime)
             {
-                faultState[FAULT_ISO] = FAULT_NORMAL;
-                iso_rec_cnt = 0;
+                FAULT_BRANCH(FAULT_ISO, 6);
+                FAULT_SET(faultState[FAULT_ISO], FAULT_NORMAL);
+                FAULT_SET(*iso_rec_cnt, 0);
             }
+            else
+                FAULT_BRANCH(FAULT_ISO, 7);
         }
         else
         {
-            iso_rec_cnt = 0;
+            FAULT_BRANCH(FAULT_ISO, 5);
+
+            FAULT_SET(*iso_rec_cnt, 0);
 
             if (faultState[FAULT_ISO] != FAULT_CONFIRM)
-                faultState[FAULT_ISO] = FAULT_NORMAL;
+            {
+                FAULT_BRANCH(FAULT_ISO, 8);
+                FAULT_SET(faultState[FAULT_ISO], FAULT_NORMAL);
+            }
+            else
+                FAULT_BRANCH(FAULT_ISO, 9);
+
         }
     }
+
+    return changed;
 }
 
-void Diagnose_Fault_0x09(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x09_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t pay_err_cnt = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* pay_err_cnt = &ctx->f09.pay_err_cnt;
 
     /* ================= 회복 조건 (우선 처리) ================= */
     /* 결제 완료 후 충전 시작 또는 세션 종료 시 NORMAL 복귀 */
@@ -456,112 +979,161 @@ void Diagnose_Fault_0x09(const InputSnapshot* in)
         (in->PlugInfo == PLUG_CONNECTED_PAID ||
         in->PlugInfo == PLUG_UNPLUGGED))
     {
-        faultState[FAULT_PAYMENT] = FAULT_NORMAL;
-        pay_err_cnt = 0;
-        return;
+        FAULT_BRANCH(FAULT_PAYMENT, 0);
+        FAULT_SET(faultState[FAULT_PAYMENT], FAULT_NORMAL);
+        FAULT_SET(*pay_err_cnt, 0);
+        return changed;
     }
 
+    FAULT_BRANCH(FAULT_PAYMENT, 1);
+
     /* ================= 진단 조건 ================= */
     /* 충전 상태가 아니고, 플러그는 연결됐지만 결제 안 된 상태 */
     if (in->SeqState != SEQ_CHARGING &&
         in->PlugInfo == PLUG_CONNECTED_NO_PAY)
     {
-        if (pay_err_cnt < 255)
-            pay_err_cnt++;
+        FAULT_BRANCH(FAULT_PAYMENT, 2);
 
-        if (pay_err_cnt >= 5)
-            faultState[FAULT_PAYMENT] = FAULT_CONFIRM;
+        if (*pay_err_cnt < 255)
+            FAULT_INC(*pay_err_cnt);
+
+        if (*pay_err_cnt >= ctx->cal.PAY_Time)
+        {
+            FAULT_BRANCH(FAULT_PAYMENT, 4);
+            FAULT_SET(faultState[FAULT_PAYMENT], FAULT_CONFIRM);
+        }
         else
-            faultState[FAULT_PAYMENT] = FAULT_DETECT;
+        {
+            FAULT_BRANCH(FAULT_PAYMENT, 5);
+            FAULT_SET(faultState[FAULT_PAYMENT], FAULT_DETECT);
+        }
     }
     else
     {
+        FAULT_BRANCH(FAULT_PAYMENT, 3);
+
         /* 그 외 상태에서는 카운터 유지/초기화 정책 */
         if (faultState[FAULT_PAYMENT] != FAULT_CONFIRM)
         {
-            pay_err_cnt = 0;
-            faultState[FAULT_PAYMENT] = FAULT_NORMAL;
+            FAULT_BRANCH(FAULT_PAYMENT, 6);
+            FAULT_SET(*pay_err_cnt, 0);
+            FAULT_SET(faultState[FAULT_PAYMENT], FAULT_NORMAL);
         }
+        else
+            FAULT_BRANCH(FAULT_PAYMENT, 7);
     }
+
+    return changed;
 }
 
 
-void Diagnose_Fault_0x0A(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x0A_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static int prev_cycle = -1;
-    static int acc_delay = 0;   // 누적 지연 시간
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    int32_t* prev_cycle = &ctx->f0A.prev_cycle;
+    int32_t* acc_delay = &ctx->f0A.acc_delay;   // 누적 지연 시간
 
     /* Latch fault */
     if (faultState[FAULT_WDT] == FAULT_CONFIRM)
-        return;
+    {
+        FAULT_BRANCH(FAULT_WDT, 0);
+        return changed;
+    }
+    FAULT_BRANCH(FAULT_WDT, 1);
 
     /* 첫 호출 */
-    if (prev_cycle < 0)
+    if (*prev_cycle < 0)
     {
-        prev_cycle = in->Cycle;
-        return;
+        FAULT_BRANCH(FAULT_WDT, 2);
+        FAULT_SET(*prev_cycle, in->Cycle);
+        return changed;
     }
 
-    int diff = in->Cycle - prev_cycle;
+    FAULT_BRANCH(FAULT_WDT, 3);
+
+    /* Cycle 간격 : int 끝 값에서도 넘치지 않도록 64 bit 로 계산 */
+    int64_t diff = (int64_t)in->Cycle - *prev_cycle;
 
     if (diff == 1)
     {
         /* 정상 heartbeat */
-        acc_delay = 0;
+        FAULT_BRANCH(FAULT_WDT, 4);
+        FAULT_SET(*acc_delay, 0);
     }
-    else if (diff > 10)
+    else if (diff > ctx->cal.WDT_MaxGap)
     {
         /* 단발성 치명적 지연 */
-        faultState[FAULT_WDT] = FAULT_CONFIRM;
-        return;
+        FAULT_BRANCH(FAULT_WDT, 5);
+        FAULT_SET(faultState[FAULT_WDT], FAULT_CONFIRM);
+        return changed;
     }
     else if (diff > 1)
     {
         /* 지연 누적 */
-        acc_delay += diff;
+        FAULT_BRANCH(FAULT_WDT, 6);
+        FAULT_SET(*acc_delay, *acc_delay + (int32_t)diff);
 
-        if (acc_delay >= 10)
+        if (*acc_delay >= ctx->cal.WDT_AccMax)
         {
-            faultState[FAULT_WDT] = FAULT_CONFIRM;
-            return;
+            FAULT_BRANCH(FAULT_WDT, 8);
+            FAULT_SET(faultState[FAULT_WDT], FAULT_CONFIRM);
+            return changed;
         }
+        FAULT_BRANCH(FAULT_WDT, 9);
     }
     else
     {
         /* diff <= 0 : 정지 / 역행 */
-        acc_delay++;
+        FAULT_BRANCH(FAULT_WDT, 7);
+        FAULT_INC(*acc_delay);
 
-        if (acc_delay >= 10)
+        if (*acc_delay >= ctx->cal.WDT_AccMax)
         {
-            faultState[FAULT_WDT] = FAULT_CONFIRM;
-            return;
+            FAULT_BRANCH(FAULT_WDT, 10);
+            FAULT_SET(faultState[FAULT_WDT], FAULT_CONFIRM);
+            return changed;
         }
+        FAULT_BRANCH(FAULT_WDT, 11);
     }
 
-    prev_cycle = in->Cycle;
+    FAULT_SET(*prev_cycle, in->Cycle);
+
+    return changed;
 }
 
-void Diagnose_Fault_0x0B(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x0B_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static int prev_seq = -1;
-    static int seq_timer = 0;
-    static uint8_t timeout_repeat_cnt = 0;
-    static uint8_t latched = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    int32_t* prev_seq = &ctx->f0B.prev_seq;
+    int32_t* seq_timer = &ctx->f0B.seq_timer;
+    uint8_t* timeout_repeat_cnt = &ctx->f0B.timeout_repeat_cnt;
+    uint8_t* latched = &ctx->f0B.latched;
 
     /* 재기동 중지 (Latched) */
-    if (latched)
+    if (*latched)
     {
-        faultState[FAULT_SEQ_TIMEOUT] = FAULT_CONFIRM;
-        return;
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 0);
+        FAULT_SET(faultState[FAULT_SEQ_TIMEOUT], FAULT_CONFIRM);
+        return changed;
     }
 
+    FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 1);
+
     /* 시퀀스 체류 시간 계산 */
-    if (in->SeqState == prev_seq)
-        seq_timer++;
+    if (in->SeqState == *prev_seq)
+    {
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 2);
+        FAULT_INC(*seq_timer);
+    }
     else
     {
-        prev_seq = in->SeqState;
-        seq_timer = 1;
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 3);
+        FAULT_SET(*prev_seq, in->SeqState);
+        FAULT_SET(*seq_timer, 1);
     }
 
     int timeout = 0;
@@ -570,91 +1142,141 @@ void Diagnose_Fault_0x0B(const InputSnapshot* in)
     switch (in->SeqState)
     {
     case SEQ_WAIT:
-        if (seq_timer >= 10)
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 4);
+        if (*seq_timer >= ctx->cal.SEQ_WaitTime)
+        {
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 8);
             timeout = 1;
+        }
+        else
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 9);
         break;
 
     case SEQ_FAULT:
     case SEQ_RESET:
-        if (seq_timer >= 10)
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 5);
+        if (*seq_timer >= ctx->cal.SEQ_FaultTime)
+        {
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 10);
             timeout = 1;
+        }
+        else
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 11);
         break;
 
     case SEQ_CHARGING:
-        if (seq_timer > 3600)
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 6);
+        if (*seq_timer > ctx->cal.SEQ_ChargTime)
+        {
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 12);
             timeout = 1;
+        }
+        else
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 13);
         break;
 
     default:
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 7);
         break;
     }
 
     /* ===== 진단 즉시 ===== */
     if (timeout)
     {
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 14);
+
         if (faultState[FAULT_SEQ_TIMEOUT] != FAULT_CONFIRM)
         {
-            timeout_repeat_cnt++;
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 15);
+            FAULT_INC(*timeout_repeat_cnt);
 
-            if (timeout_repeat_cnt >= 3)
-                latched = 1;
+            if (*timeout_repeat_cnt >= ctx->cal.SEQ_LatchCnt)
+            {
+                FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 17);
+                FAULT_SET(*latched, 1);
+            }
+            else
+                FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 18);
         }
+        else
+            FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 16);
 
-        faultState[FAULT_SEQ_TIMEOUT] = FAULT_CONFIRM;
+        FAULT_SET(faultState[FAULT_SEQ_TIMEOUT], FAULT_CONFIRM);
     }
     /* ===== 회복 조건 ===== */
     else if (faultState[FAULT_SEQ_TIMEOUT] == FAULT_CONFIRM &&
         in->SeqState == SEQ_INIT &&
-        !latched)
+        !*latched)
     {
-        faultState[FAULT_SEQ_TIMEOUT] = FAULT_NORMAL;
-        seq_timer = 1;
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 19);
+        FAULT_SET(faultState[FAULT_SEQ_TIMEOUT], FAULT_NORMAL);
+        FAULT_SET(*seq_timer, 1);
     }
+    else
+        FAULT_BRANCH(FAULT_SEQ_TIMEOUT, 20);
+
+    return changed;
 }
 
 
-void Diagnose_Fault_0x0C(const InputSnapshot* in)
+static FAULT_FORCEINLINE int Diagnose_0x0C_Body(FaultContext* ctx, const InputSnapshot* in, int track)
 {
-    static uint8_t temp_fault_cnt = 0;
+    FaultStatus* faultState = ctx->state;
+    int changed = 0;
+
+    uint8_t* temp_fault_cnt = &ctx->f0C.temp_fault_cnt;
 
     /* 진단 조건 */
     if (in->SeqState == SEQ_CHARGING &&
-        (in->H < -20 || in->H > 120))
+        (in->H < ctx->cal.TS_Hmin || in->H > ctx->cal.TS_Hmax))
     {
-        temp_fault_cnt++;
+        FAULT_BRANCH(FAULT_TEMP_SENSOR, 0);
+        FAULT_INC(*temp_fault_cnt);
 
-        if (temp_fault_cnt >= 3)
+        if (*temp_fault_cnt >= ctx->cal.TS_Time)
         {
-            faultState[FAULT_TEMP_SENSOR] = FAULT_CONFIRM;
+            FAULT_BRANCH(FAULT_TEMP_SENSOR, 1);
+            FAULT_SET(faultState[FAULT_TEMP_SENSOR], FAULT_CONFIRM);
         }
         else
         {
-            faultState[FAULT_TEMP_SENSOR] = FAULT_DETECT;
+            FAULT_BRANCH(FAULT_TEMP_SENSOR, 2);
+            FAULT_SET(faultState[FAULT_TEMP_SENSOR], FAULT_DETECT);
         }
     }
     /* 회복 조건 */
     else if (faultState[FAULT_TEMP_SENSOR] == FAULT_CONFIRM &&
         in->SeqState == SEQ_INIT &&
-        (in->H >= -20 && in->H <= 120))
+        (in->H >= ctx->cal.TS_Hmin && in->H <= ctx->cal.TS_Hmax))
     {
-        faultState[FAULT_TEMP_SENSOR] = FAULT_NORMAL;
-        temp_fault_cnt = 0;
+        FAULT_BRANCH(FAULT_TEMP_SENSOR, 3);
+        FAULT_SET(faultState[FAULT_TEMP_SENSOR], FAULT_NORMAL);
+        FAULT_SET(*temp_fault_cnt, 0);
     }
     /* 그 외 */
     else
     {
         /* 유지 */
+        FAULT_BRANCH(FAULT_TEMP_SENSOR, 4);
     }
-}
-
-
-
-
-
-
-
-
-
-
 
+    return changed;
+}
 
+/* 진단 함수 2벌 : 전체 진단(변화 표시 없음) / 변경 기반 진단(변화 반환) */
+#define DIAGNOSE_VARIANTS(code) \
+    static void Diagnose_##code(FaultContext* ctx, const InputSnapshot* in) { (void)Diagnose_##code##_Body(ctx, in, 0); } \
+    static int Diagnose_##code##_Changed(FaultContext* ctx, const InputSnapshot* in) { return Diagnose_##code##_Body(ctx, in, 1); }
+
+DIAGNOSE_VARIANTS(0x01)
+DIAGNOSE_VARIANTS(0x02)
+DIAGNOSE_VARIANTS(0x03)
+DIAGNOSE_VARIANTS(0x04)
+DIAGNOSE_VARIANTS(0x05)
+DIAGNOSE_VARIANTS(0x06)
+DIAGNOSE_VARIANTS(0x07)
+DIAGNOSE_VARIANTS(0x08)
+DIAGNOSE_VARIANTS(0x09)
+DIAGNOSE_VARIANTS(0x0A)
+DIAGNOSE_VARIANTS(0x0B)
+DIAGNOSE_VARIANTS(0x0C)
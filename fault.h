@@ -1,7 +1,7 @@
 #ifndef FAULT_H
 #define FAULT_H
 
-//   
+// 시퀀스 상태 정의
 typedef enum {
     SEQ_INIT = 0,
     SEQ_WAIT = 1,
@@ -11,21 +11,21 @@ typedef enum {
     SEQ_SHUTDOWN = 5
 } SeqState;
 
-// ÷  
+// 플러그 상태 정의
 typedef enum {
     PLUG_UNPLUGGED = 0,
     PLUG_CONNECTED_NO_PAY = 1,
     PLUG_CONNECTED_PAID = 2
 } PlugInfo;
 
-//   
+// 고장 상태 정의
 typedef enum {
     FAULT_NORMAL = 0,
     FAULT_DETECT = 1,
     FAULT_CONFIRM = 2
 } FaultStatus;
 
-//  ڵ ID 
+// 고장 코드 ID 정의
 typedef enum {
     FAULT_INPUT_OVERCURRENT = 0x01,
     FAULT_INPUT_UNDERCURRENT = 0x02,
@@ -46,13 +46,98 @@ typedef enum {
 #include <math.h>
 #include "input.h"
 
-//  ڵ ʱȭ
+/* 진단 엔진 버전 (로직 변경 시 증가 → 결과 캐시 무효화) */
+#define FAULT_ENGINE_VERSION 0x00010100u
+
+/* ===== 고장 진단 임계값 (Calibration) ===== */
+typedef struct
+{
+    /* 0x01 입력 과전류 */
+    int32_t OC_Imax;            // 고장 검출 전류 임계값
+    int32_t OC_Inormal;         // 회복 판단 전류 임계값
+    int32_t OC_Time;            // Detect/Confirm 및 Recovery 시간 기준
+
+    /* 0x02 입력 저전류 */
+    int32_t UC_Imin;
+    int32_t UC_Inormal;
+    int32_t UC_ChargCnt;        // 충전 시작 후 진단 유예 Cycle
+    int32_t UC_Time;
+
+    /* 0x03 플러그 */
+    int32_t PLUG_LatchCnt;      // 재기동 금지 반복 횟수
+
+    /* 0x05 BMS 전압 */
+    int32_t BMS_ChargCnt;
+    int32_t BMS_DiffMax;        // 고장 판단 전압 편차
+    int32_t BMS_DiffNormal;     // 회복 판단 전압 편차
+    int32_t BMS_Time;
+    int32_t BMS_RecTime;
+
+    /* 0x06 과온 */
+    int32_t OT_Hmax;
+    int32_t OT_Hnormal;
+    int32_t OT_Time;
+    int32_t OT_RecTime;
+    int32_t OT_LatchCnt;
+
+    /* 0x07 CAN 통신 */
+    int32_t CAN_Time;
+    int32_t CAN_RecTime;
+
+    /* 0x08 절연 저항 */
+    int32_t ISO_Rmin;
+    int32_t ISO_Rnormal;
+    int32_t ISO_Time;
+    int32_t ISO_RecTime;
+
+    /* 0x09 결제 */
+    int32_t PAY_Time;
+
+    /* 0x0A Watchdog */
+    int32_t WDT_MaxGap;         // 단발성 치명적 지연 Cycle
+    int32_t WDT_AccMax;         // 누적 지연 허용 Cycle
+
+    /* 0x0B 시퀀스 타임아웃 */
+    int32_t SEQ_WaitTime;
+    int32_t SEQ_FaultTime;      // FAULT / RESET 체류 한계
+    int32_t SEQ_ChargTime;
+    int32_t SEQ_LatchCnt;
+
+    /* 0x0C 온도 센서 */
+    int32_t TS_Hmin;
+    int32_t TS_Hmax;
+    int32_t TS_Time;
+} FaultCalibration;
+
+/* ===== 고장 진단 엔진 상태 (고장별 카운터 / 래치 / 이전값) ===== */
+typedef struct
+{
+    FaultStatus state[FAULT_MAX];       // 고장 상태 테이블
+    FaultCalibration cal;
+
+    struct { uint8_t over_cnt; uint8_t rec_cnt; } f01;
+    struct { uint8_t under_cnt; uint8_t rec_cnt; } f02;
+    struct { uint8_t fault_cnt; uint8_t latched; } f03;
+    struct { uint8_t batt_cnt; uint8_t batt_rec_cnt; } f05;
+    struct { uint8_t heat_cnt; uint8_t heat_rec_cnt; uint8_t fault_cnt; uint8_t latched; } f06;
+    struct { uint8_t can_to_cnt; uint8_t can_rec_cnt; } f07;
+    struct { uint8_t iso_cnt; uint8_t iso_rec_cnt; } f08;
+    struct { uint8_t pay_err_cnt; } f09;
+    struct { int32_t prev_cycle; int32_t acc_delay; } f0A;
+    struct { int32_t prev_seq; int32_t seq_timer; uint8_t timeout_repeat_cnt; uint8_t latched; } f0B;
+    struct { uint8_t temp_fault_cnt; } f0C;
+} FaultContext;
+
+/* 기본 Calibration 값 (고장 사양 진단서 기준) */
+extern const FaultCalibration Fault_DefaultCalibration;
+
+// 고장 코드 초기화
 void Fault_Init(void);
 
-//   Լ(0x01 ~ 0x0C)
+// 종합 고장진단 함수(0x01 ~ 0x0C)
 void Fault_Diagnose(const InputSnapshot* snapshot);
 
-//   
+// 고장 진단 로직
 void Diagnose_Fault_0x01(const InputSnapshot* in);
 void Diagnose_Fault_0x02(const InputSnapshot* in);
 void Diagnose_Fault_0x03(const InputSnapshot* in);
@@ -66,23 +151,62 @@ void Diagnose_Fault_0x0A(const InputSnapshot* in);
 void Diagnose_Fault_0x0B(const InputSnapshot* in);
 void Diagnose_Fault_0x0C(const InputSnapshot* in);
 
-//     ׽Ʈ
-void Test_Fault_0x01(const char* csv_path);
-void Test_Fault_0x02(const char* csv_path);
-void Test_Fault_0x03(const char* csv_path);
-void Test_Fault_0x04(const char* csv_path);
-void Test_Fault_0x05(const char* csv_path);
-void Test_Fault_0x06(const char* csv_path);
-void Test_Fault_0x07(const char* csv_path);
-void Test_Fault_0x08(const char* csv_path);
-void Test_Fault_0x09(const char* csv_path);
-void Test_Fault_0x0A(const char* csv_path);
-void Test_Fault_0x0B(const char* csv_path);
-void Test_Fault_0x0C(const char* csv_path);
-
-/*   ȸ */
+/* 고장 상태 조회 */
 FaultStatus Fault_GetStatus(FaultCode code);
 
+/* ===== Context 기반 진단 (다중 엔진 / 상태 저장·복원용) ===== */
+void Fault_InitContext(FaultContext* ctx);
+void Fault_DiagnoseContext(FaultContext* ctx, const InputSnapshot* snapshot);
+FaultStatus Fault_GetContextStatus(const FaultContext* ctx, FaultCode code);
+
+/* 기본 엔진(Fault_Init/Fault_Diagnose)이 사용하는 Context */
+FaultContext* Fault_GetContext(void);
+
+/* mask 의 bit code 인 진단 함수만 실행 (다중 주기 스케줄용) */
+void Fault_DiagnoseMask(FaultContext* ctx, uint32_t mask, const InputSnapshot* snapshot);
+
+/* 고장 1개만 진단 (고장별 상태는 서로 독립) */
+void Fault_DiagnoseOne(FaultContext* ctx, FaultCode code, const InputSnapshot* in);
+
+/* 고장별 내부 상태(고장 상태 + 카운터/래치/이전값) 비교 / 복사 */
+int Fault_SubstateEqual(const FaultContext* a, const FaultContext* b, FaultCode code);
+void Fault_CopySubstate(FaultContext* dst, const FaultContext* src, FaultCode code);
+
+/* ===== 변경 기반 진단 : 생략해도 결과가 같은 진단 함수는 실행하지 않음 =====
+ * 진단 함수는 자기 고장 상태 / 내부 상태, Calibration, 입력 필드 일부만 읽으므로
+ * 읽는 입력 필드가 직전 Cycle 과 같고 직전 평가에서 상태가 변하지 않았으면(고정점) 다시 실행해도 같은 상태
+ * (상태 변화는 진단 함수가 기록하면서 표시, 바뀐 입력 필드는 Cycle 당 1회 word 비교 → 생략 판단 비용이 진단 함수 1개보다 작음)
+ * ctx 를 진단 외 경로로 바꾼 경우(Fault_InitContext, 상태 복원, Calibration 변경) Fault_IdleInit 으로 다시 초기화 */
+typedef struct
+{
+    InputSnapshot prev;         // 직전 Cycle 입력
+    uint32_t idle;              // bit code : 직전 평가에서 고장 상태 / 내부 상태 변화 없음
+    uint64_t evaluated;         // 실행한 진단 함수 수
+    uint64_t skipped;           // 생략한 진단 함수 수
+} FaultIdle;
+
+void Fault_IdleInit(FaultIdle* idle);
+void Fault_DiagnoseChanged(FaultContext* ctx, FaultIdle* idle, const InputSnapshot* snapshot);
+
+/* 진단 함수별 입력 필드 bitmask (bit i : Input_Fields[i]) */
+extern const uint32_t Fault_InputMask[FAULT_MAX];
+
+/* 12개 고장 상태를 2bit 씩 묶은 값 (0x01 : bit0~1, ..., 0x0C : bit22~23) */
+uint32_t Fault_PackStatus(const FaultContext* ctx);
+#define FAULT_PACKED_STATUS(packed, code) ((FaultStatus)(((packed) >> (((code) - 1) * 2)) & 0x3u))
+
+/* Calibration 식별값 (FNV-1a) */
+uint32_t Fault_CalibrationId(const FaultCalibration* cal);
+
+/* 분기 커버리지 : 고장별 분기 번호 0 ~ Fault_BranchCount[code]-1 (WCET 하네스용) */
+#define FAULT_BRANCH_MAX 24
+extern const uint8_t Fault_BranchCount[FAULT_MAX];
+
+#ifdef OBC_BRANCH_COVERAGE
+extern uint64_t Fault_BranchHits[FAULT_MAX][FAULT_BRANCH_MAX];  // 분기별 누적 실행 횟수
+extern uint32_t Fault_BranchPath[FAULT_MAX];                    // 실행 분기 bitmask (호출 측에서 0으로 초기화)
+#endif
+
 
 
 #endif
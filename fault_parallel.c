@@ -0,0 +1,387 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "fault_parallel.h"
+#include "input.h"
+#include "output.h"
+#include "osal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 구간 1개의 작업 데이터 */
+typedef struct
+{
+    const char* begin;          // 구간 텍스트 [begin, end)
+    const char* end;
+
+    InputSnapshot* in;          // 파싱 결과
+    uint32_t* packed;           // Cycle별 고장 상태 (Fault_PackStatus)
+    size_t rows;
+    size_t cap;
+    int failed;                 // 파싱 실패 줄에서 종료 (직렬 루프와 동일하게 이후 무시)
+    int nomem;
+
+    FaultContext spec_end;      // 추측(초기) 상태에서 시작한 진단의 종료 상태
+
+    char* text;                 // 포맷된 결과 CSV
+    size_t text_len;
+    size_t text_cap;
+} Segment;
+
+/* Input_ReadLine(fgets) 과 동일한 줄 단위 : '\n' 까지 또는 최대 INPUT_LINE_MAX-1 byte */
+static const char* Chunk_Next(const char* p, const char* end)
+{
+    size_t max = INPUT_LINE_MAX - 1;
+    const char* limit = ((size_t)(end - p) > max) ? p + max : end;
+    const char* nl = (const char*)memchr(p, '\n', (size_t)(limit - p));
+
+    return nl ? nl + 1 : limit;
+}
+
+static int Segment_Reserve(Segment* seg, size_t rows)
+{
+    if (rows <= seg->cap)
+        return 1;
+
+    size_t cap = seg->cap ? seg->cap : 1024;
+    while (cap < rows)
+        cap *= 2;
+
+    InputSnapshot* in = (InputSnapshot*)realloc(seg->in, cap * sizeof(*in));
+    if (!in)
+        return 0;
+    seg->in = in;
+
+    uint32_t* packed = (uint32_t*)realloc(seg->packed, cap * sizeof(*packed));
+    if (!packed)
+        return 0;
+    seg->packed = packed;
+
+    seg->cap = cap;
+    return 1;
+}
+
+/* 1단계 : 파싱 + 초기 상태에서 추측 진단 */
+static void Segment_ParseDiagnose(void* arg)
+{
+    Segment* seg = (Segment*)arg;
+    char line[INPUT_LINE_MAX];
+    const char* p = seg->begin;
+    FaultContext spec;
+
+    seg->rows = 0;
+    seg->failed = 0;
+    seg->nomem = 0;
+
+    if (!Segment_Reserve(seg, (size_t)(seg->end - seg->begin) / 32 + 16))
+    {
+        seg->nomem = 1;
+        return;
+    }
+
+    while (p < seg->end)
+    {
+        const char* next = Chunk_Next(p, seg->end);
+        size_t len = (size_t)(next - p);
+
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p = next;
+
+        if (seg->rows == seg->cap && !Segment_Reserve(seg, seg->cap + 1))
+        {
+            seg->nomem = 1;
+            return;
+        }
+
+        if (!Input_ParseLine(line, &seg->in[seg->rows]))
+        {
+            seg->failed = 1;
+            break;
+        }
+        seg->rows++;
+    }
+
+    Fault_InitContext(&spec);
+    for (size_t i = 0; i < seg->rows; i++)
+    {
+        Fault_DiagnoseContext(&spec, &seg->in[i]);
+        seg->packed[i] = Fault_PackStatus(&spec);
+    }
+    seg->spec_end = spec;
+}
+
+/* 2단계 : 실제 시작 상태(truth)로 구간 앞부분 재진단, 고장별로 추측 진단과 수렴하면 중단 */
+static void Segment_Reconcile(Segment* seg, const FaultContext* truth, ParallelStats* stats)
+{
+    FaultContext spec_start;
+
+    Fault_InitContext(&spec_start);
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        FaultContext t = *truth;
+        FaultContext s = spec_start;
+        uint32_t shift = (uint32_t)(code - 1) * 2u;
+        int converged = Fault_SubstateEqual(&t, &s, (FaultCode)code);
+
+        for (size_t i = 0; i < seg->rows && !converged; i++)
+        {
+            Fault_DiagnoseOne(&t, (FaultCode)code, &seg->in[i]);
+            Fault_DiagnoseOne(&s, (FaultCode)code, &seg->in[i]);
+
+            seg->packed[i] = (seg->packed[i] & ~(0x3u << shift)) |
+                (((uint32_t)t.state[code] & 0x3u) << shift);
+            stats->reconciled[code]++;
+
+            converged = Fault_SubstateEqual(&t, &s, (FaultCode)code);
+        }
+
+        /* 끝까지 수렴하지 않으면 구간 종료 상태도 실제 진단 결과로 교체 */
+        if (!converged)
+            Fault_CopySubstate(&seg->spec_end, &t, (FaultCode)code);
+    }
+}
+
+/* 3단계 : 결과 CSV 텍스트 포맷 */
+static void Segment_Format(void* arg)
+{
+    Segment* seg = (Segment*)arg;
+    size_t need = seg->rows * OUTPUT_ROW_MAX;
+
+    seg->text_len = 0;
+
+    if (need > seg->text_cap)
+    {
+        char* text = (char*)realloc(seg->text, need);
+        if (!text)
+        {
+            seg->nomem = 1;
+            return;
+        }
+        seg->text = text;
+        seg->text_cap = need;
+    }
+
+    for (size_t i = 0; i < seg->rows; i++)
+        seg->text_len += (size_t)Output_FormatRow(seg->text + seg->text_len, seg->in[i].Cycle, seg->packed[i]);
+}
+
+/* 모든 구간에 대해 func 병렬 실행 */
+static void Segment_RunAll(Segment* segs, int count, OsalThreadFunc func)
+{
+    OsalThread threads[256];
+    int started[256];
+
+    for (int k = 1; k < count; k++)
+        started[k] = Osal_ThreadCreate(&threads[k], func, &segs[k]);
+
+    func(&segs[0]);
+
+    for (int k = 1; k < count; k++)
+    {
+        if (started[k])
+            Osal_ThreadJoin(threads[k]);
+        else
+            func(&segs[k]);
+    }
+}
+
+/* Window 1개 처리 : 구간 분할 → 병렬 진단 → 경계 보정 → 출력. 파싱 실패로 종료 시 1 반환 */
+static int Window_Process(Segment* segs, int count, const char* begin, const char* end,
+    FaultContext* truth, FILE* out, ParallelStats* stats, int* error)
+{
+    size_t size = (size_t)(end - begin);
+    const char* p = begin;
+    int stop = 0;
+    int used = count;
+    uint64_t t0, t1, t2, t3;
+
+    /* 줄 경계에서 구간 분할 */
+    for (int k = 0; k < count; k++)
+    {
+        const char* target = (k == count - 1) ? end : begin + size / (size_t)count * (size_t)(k + 1);
+        const char* cut = target;
+
+        if (cut < p)
+            cut = p;
+        if (cut < end)
+        {
+            const char* nl = (const char*)memchr(cut, '\n', (size_t)(end - cut));
+            cut = nl ? nl + 1 : end;
+        }
+
+        segs[k].begin = p;
+        segs[k].end = cut;
+        p = cut;
+    }
+
+    t0 = Osal_NowNs();
+    Segment_RunAll(segs, count, Segment_ParseDiagnose);
+    t1 = Osal_NowNs();
+
+    /* 경계 보정은 앞 구간의 실제 종료 상태가 필요하므로 순서대로 */
+    for (int k = 0; k < count; k++)
+    {
+        if (segs[k].nomem)
+        {
+            *error = 1;
+            return 1;
+        }
+
+        Segment_Reconcile(&segs[k], truth, stats);
+        *truth = segs[k].spec_end;
+        stats->rows += segs[k].rows;
+
+        if (segs[k].failed)
+        {
+            stop = 1;
+            used = k + 1;
+            break;
+        }
+    }
+    t2 = Osal_NowNs();
+
+    Segment_RunAll(segs, used, Segment_Format);
+    for (int k = 0; k < used; k++)
+    {
+        if (segs[k].nomem)
+        {
+            *error = 1;
+            return 1;
+        }
+        if (segs[k].text_len)       // 빈 구간 : text == NULL
+            fwrite(segs[k].text, 1, segs[k].text_len, out);
+    }
+    t3 = Osal_NowNs();
+
+    stats->windows++;
+    stats->parse_diag_ns += t1 - t0;
+    stats->reconcile_ns += t2 - t1;
+    stats->write_ns += t3 - t2;
+    return stop;
+}
+
+int Parallel_Run(const char* input_file, const char* result_file, int threads, ParallelStats* stats)
+{
+    Segment* segs;
+    FaultContext truth;
+    char* buf;
+    size_t cap;
+    size_t carry = 0;
+    int header_done = 0;
+    int error = 0;
+    FILE* fp;
+    FILE* out;
+
+    memset(stats, 0, sizeof(*stats));
+
+    if (threads < 1)
+        threads = Osal_CpuCount();
+    if (threads > 256)
+        threads = 256;
+    stats->threads = threads;
+
+    fp = fopen(input_file, "rb");
+    if (!fp)
+    {
+        printf("ERROR: Failed to open input CSV : %s\n", input_file);
+        return 1;
+    }
+
+    out = fopen(result_file, "w");
+    if (!out)
+    {
+        printf("ERROR: Failed to open result CSV : %s\n", result_file);
+        fclose(fp);
+        return 1;
+    }
+
+    cap = (size_t)threads * PARALLEL_WINDOW_PER_THREAD;
+    buf = (char*)malloc(cap);
+    segs = (Segment*)calloc((size_t)threads, sizeof(*segs));
+
+    if (!buf || !segs)
+    {
+        error = 1;
+        goto cleanup;
+    }
+
+    Output_WriteHeader(out);
+    Fault_InitContext(&truth);
+
+    for (;;)
+    {
+        size_t n = fread(buf + carry, 1, cap - carry, fp);
+        size_t len = carry + n;
+        int eof = (n < cap - carry);
+        const char* data = buf;
+        const char* cut;
+
+        if (len == 0)
+            break;
+
+        /* 헤더 1줄 스킵 */
+        if (!header_done)
+        {
+            data = Chunk_Next(buf, buf + len);
+            header_done = 1;
+        }
+
+        /* 마지막 완결된 줄까지만 처리, 나머지는 다음 Window로 이월 */
+        cut = buf + len;
+        if (!eof)
+        {
+            const char* q = buf + len;
+            while (q > data && q[-1] != '\n')
+                q--;
+
+            if (q == data)
+            {
+                /* Window 보다 긴 구간에 줄바꿈 없음 → 버퍼 확장 후 다시 읽기 */
+                size_t skip = (size_t)(data - buf);
+                char* bigger = (char*)realloc(buf, cap * 2);
+                if (!bigger)
+                {
+                    error = 1;
+                    break;
+                }
+                carry = len - skip;
+                memmove(bigger, bigger + skip, carry);
+                buf = bigger;
+                cap *= 2;
+                continue;
+            }
+            cut = q;
+        }
+
+        if (Window_Process(segs, threads, data, cut, &truth, out, stats, &error))
+            break;
+
+        if (eof)
+            break;
+
+        carry = len - (size_t)(cut - buf);
+        memmove(buf, cut, carry);
+    }
+
+cleanup:
+    if (segs)
+    {
+        for (int k = 0; k < threads; k++)
+        {
+            free(segs[k].in);
+            free(segs[k].packed);
+            free(segs[k].text);
+        }
+    }
+    free(segs);
+    free(buf);
+    fclose(fp);
+
+    if (fclose(out) != 0 || error)
+    {
+        printf("ERROR: Parallel diagnosis failed (out of memory or write error)\n");
+        return 1;
+    }
+    return 0;
+}
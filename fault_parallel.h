@@ -0,0 +1,35 @@
+#ifndef FAULT_PARALLEL_H
+#define FAULT_PARALLEL_H
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 긴 로그 1개를 구간(Segment)으로 나누어 병렬 진단
+ *  1. 각 구간을 초기 상태(추측 상태)에서 병렬로 파싱/진단
+ *  2. 구간 경계마다 이전 구간의 실제 종료 상태로 다시 진단하여,
+ *     고장별 내부 상태가 추측 진단과 같아지는(수렴) 지점까지만 결과를 보정
+ *  3. 결과는 직렬 Fault_Diagnose 루프와 동일
+ *
+ *  - 고장별 상태(카운터/래치)는 서로 독립이므로 경계 보정은 고장 단위로 수행
+ *  - 메모리 사용량은 Window 단위(스레드당 PARALLEL_WINDOW_PER_THREAD)로 제한
+ */
+
+#ifndef PARALLEL_WINDOW_PER_THREAD
+#define PARALLEL_WINDOW_PER_THREAD (16u * 1024u * 1024u)
+#endif
+
+typedef struct
+{
+    int threads;
+    uint64_t rows;                          // 진단한 Cycle 수
+    uint64_t windows;                       // 처리한 Window 수
+    uint64_t reconciled[FAULT_MAX];         // 경계 보정 시 다시 진단한 Cycle 수 (고장별)
+    uint64_t parse_diag_ns;                 // 병렬 파싱 + 추측 진단
+    uint64_t reconcile_ns;                  // 경계 보정
+    uint64_t write_ns;                      // 결과 포맷/출력
+} ParallelStats;
+
+/* ===== 병렬 구간 진단 실행 : 성공 0, 실패 1 ===== */
+int Parallel_Run(const char* input_file, const char* result_file, int threads, ParallelStats* stats);
+
+#endif /* FAULT_PARALLEL_H */
@@ -0,0 +1,128 @@
+﻿#include "freeze.h"
+#include <string.h>
+
+/* Fault_PackStatus 의 고장별 CONFIRM bit (2 bit 중 상위) */
+#define FREEZE_CONFIRM_BITS 0x00AAAAAAu
+
+int Freeze_Init(FreezeRecorder* r, int pre, int post, FreezeSink sink, void* arg)
+{
+    if (pre < 0 || pre > FREEZE_PRE_MAX || post < 0 || post > FREEZE_POST_MAX)
+        return 0;
+
+    memset(r, 0, sizeof(*r));
+    r->pre = pre;
+    r->post = post;
+    r->sink = sink;
+    r->arg = arg;
+    return 1;
+}
+
+/* 행 1개 추가 (frame 이 다 차면 전달하고 진행 중 해제) */
+static void Freeze_Append(FreezeRecorder* r, FreezeFrame* f, const InputSnapshot* in, const FaultContext* ctx)
+{
+    f->in[f->rows] = *in;
+    f->state[f->rows] = (uint8_t)ctx->state[f->code];
+    f->rows++;
+
+    if (f->rows == f->pre + 1 + r->post)
+    {
+        if (r->sink)
+            r->sink(f, r->arg);
+        r->active &= ~(1u << f->code);
+    }
+}
+
+void Freeze_Step(FreezeRecorder* r, const InputSnapshot* in, const FaultContext* ctx)
+{
+    uint32_t status = Fault_PackStatus(ctx);
+    uint32_t confirm = status & FREEZE_CONFIRM_BITS;
+    uint32_t rising = confirm & ~r->prev_confirm;
+
+    /* 진행 중 frame 에 이번 행 추가 (이번 Cycle 에 시작하는 frame 보다 먼저) */
+    for (uint32_t m = r->active; m; m &= m - 1)
+    {
+        int code = 0;
+
+        while (!(m & (1u << code)))
+            code++;
+        Freeze_Append(r, &r->frame[code], in, ctx);
+    }
+
+    /* NORMAL / DETECT → CONFIRM 전이 : 링의 이전 행 + 이번 행으로 frame 시작 */
+    for (; rising; rising &= rising - 1)
+    {
+        int bit = 0;
+        int code;
+        FreezeFrame* f;
+
+        while (!(rising & (1u << bit)))
+            bit++;
+        code = bit / 2 + 1;
+
+        if (r->active & (1u << code))
+        {
+            r->overlapped++;
+            continue;
+        }
+
+        f = &r->frame[code];
+        f->id = r->frames++;
+        f->code = (FaultCode)code;
+        f->trigger_cycle = in->Cycle;
+        f->trigger_status = status;
+        f->pre = (uint16_t)(r->seen < (uint64_t)r->pre ? r->seen : (uint64_t)r->pre);
+        f->rows = 0;
+
+        for (uint64_t k = r->seen - f->pre; k < r->seen; k++)
+        {
+            f->in[f->rows] = r->ring[k & (FREEZE_PRE_MAX - 1)];
+            f->state[f->rows] = (uint8_t)((r->status[k & (FREEZE_PRE_MAX - 1)] >> (bit - 1)) & 0x3u);
+            f->rows++;
+        }
+
+        r->active |= 1u << code;
+        Freeze_Append(r, f, in, ctx);
+    }
+
+    r->ring[r->seen & (FREEZE_PRE_MAX - 1)] = *in;
+    r->status[r->seen & (FREEZE_PRE_MAX - 1)] = status;
+    r->seen++;
+    r->prev_confirm = confirm;
+}
+
+void Freeze_Flush(FreezeRecorder* r)
+{
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if ((r->active & (1u << code)) && r->sink)
+            r->sink(&r->frame[code], r->arg);
+    }
+    r->active = 0;
+}
+
+void Freeze_WriteHeader(FILE* out)
+{
+    fprintf(out, "frame,code,trigger_cycle,offset,");
+    for (int i = 0; i < INPUT_FIELD_COUNT; i++)
+        fprintf(out, "%s,", Input_Fields[i].name);
+    fprintf(out, "state\n");
+}
+
+void Freeze_WriteFrame(FILE* out, const FreezeFrame* frame)
+{
+    char line[INPUT_LINE_MAX];
+
+    for (int i = 0; i < frame->rows; i++)
+    {
+        int len = Input_FormatLine(line, &frame->in[i]);
+
+        line[len - 1] = '\0';       // 개행 제거
+        fprintf(out, "%llu,0x%02X,%d,%d,%s,%u\n", (unsigned long long)frame->id, (unsigned)frame->code,
+            frame->trigger_cycle, i - frame->pre, line, (unsigned)frame->state[i]);
+    }
+}
+
+void Freeze_CsvSink(const FreezeFrame* frame, void* arg)
+{
+    Freeze_WriteFrame((FILE*)arg, frame);
+}
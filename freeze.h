@@ -0,0 +1,71 @@
+#ifndef FREEZE_H
+#define FREEZE_H
+#include <stdio.h>
+#include <stdint.h>
+#include "input.h"
+#include "fault.h"
+
+/*
+ * 고장 확정 전후 Freeze-frame 기록 (--freeze)
+ *  - 최근 입력 InputSnapshot 과 고장 상태(Fault_PackStatus)를 고정 크기 링에 보관 (행마다 64 byte 복사, 동적 할당 없음)
+ *  - 진단 후 고장 상태가 FAULT_CONFIRM 으로 바뀐 고장 코드마다 frame 시작 : 확정 이전 pre Cycle + 확정 Cycle
+ *    + 이후 post Cycle 입력과 해당 고장 상태를 기록하고, post 가 다 차면 sink 로 전달
+ *  - 확정 판정은 Fault_PackStatus 의 고장별 2 bit 중 상위 bit(CONFIRM) 비교 → Cycle 당 비교 1회
+ *  - 고장 코드별 진행 중 frame 은 1개 : post 기록 중 같은 고장이 다시 확정되면 새 frame 없이 overlapped 로 집계
+ *  - 정상 세션은 기록할 것이 없으므로 전체 입력 로그 대신 frame 파일만 보관 가능
+ */
+
+#define FREEZE_PRE_MAX  64      // 확정 이전 최대 Cycle 수 (링 크기, 2의 거듭제곱)
+#define FREEZE_POST_MAX 64      // 확정 이후 최대 Cycle 수
+
+#define FREEZE_ROWS_MAX (FREEZE_PRE_MAX + 1 + FREEZE_POST_MAX)
+
+/* Freeze-frame 1개 */
+typedef struct
+{
+    uint64_t id;                // 기록 순서 번호 (확정 순서)
+    FaultCode code;
+    int32_t trigger_cycle;      // 확정 Cycle
+    uint32_t trigger_status;    // 확정 Cycle 의 Fault_PackStatus (다른 고장 상태)
+    uint16_t pre;               // 기록된 확정 이전 행 수 (입력 시작 직후 확정이면 요청보다 적음)
+    uint16_t rows;              // 기록된 전체 행 수 (pre + 1 + post)
+    InputSnapshot in[FREEZE_ROWS_MAX];
+    uint8_t state[FREEZE_ROWS_MAX];     // 행별 해당 고장 상태
+} FreezeFrame;
+
+/* 완성된 frame 전달 (frame 은 호출 동안만 유효) */
+typedef void (*FreezeSink)(const FreezeFrame* frame, void* arg);
+
+typedef struct
+{
+    int pre;
+    int post;
+    InputSnapshot ring[FREEZE_PRE_MAX];
+    uint32_t status[FREEZE_PRE_MAX];    // 링 행별 Fault_PackStatus
+    uint64_t seen;              // 지나간 행 수
+    uint32_t prev_confirm;      // 직전 Cycle CONFIRM bit (Fault_PackStatus 상위 bit)
+    uint32_t active;            // 진행 중 frame bitmask (bit code)
+    FreezeFrame frame[FAULT_MAX];
+    FreezeSink sink;
+    void* arg;
+    uint64_t frames;            // 시작한 frame 수
+    uint64_t overlapped;        // 진행 중 재확정으로 생략한 frame 수
+} FreezeRecorder;
+
+/* ===== 초기화 : pre 0 ~ FREEZE_PRE_MAX, post 0 ~ FREEZE_POST_MAX, 범위 밖이면 0 ===== */
+int Freeze_Init(FreezeRecorder* r, int pre, int post, FreezeSink sink, void* arg);
+
+/* ===== 진단 직후 1 Cycle 기록 (in : 방금 진단한 입력, ctx : 진단 후 상태) ===== */
+void Freeze_Step(FreezeRecorder* r, const InputSnapshot* in, const FaultContext* ctx);
+
+/* ===== 입력 끝 : 진행 중 frame 을 post 가 모자란 채로 전달 ===== */
+void Freeze_Flush(FreezeRecorder* r);
+
+/* ===== Freeze-frame CSV : frame,code,trigger_cycle,offset,<입력 필드>,state (offset 0 : 확정 Cycle) ===== */
+void Freeze_WriteHeader(FILE* out);
+void Freeze_WriteFrame(FILE* out, const FreezeFrame* frame);
+
+/* FreezeSink 로 사용 (arg : FILE*) */
+void Freeze_CsvSink(const FreezeFrame* frame, void* arg);
+
+#endif /* FREEZE_H */
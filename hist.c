@@ -0,0 +1,140 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "hist.h"
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/* 최상위 1 bit 위치 (value > 0) */
+static int Hist_Msb(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (int)index;
+#elif defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    int msb = 0;
+    while (value >>= 1)
+        msb++;
+    return msb;
+#endif
+}
+
+void Hist_Init(Histogram* h)
+{
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+int Hist_Bucket(uint64_t value)
+{
+    if (value < 2 * HIST_SUB_COUNT)
+        return (int)value;
+
+    /* 상위 HIST_SUB_BITS+1 bit (선두 1 포함)로 구간 결정 */
+    int msb = Hist_Msb(value);
+    int shift = msb - HIST_SUB_BITS;
+    return (shift + 1) * HIST_SUB_COUNT + (int)((value >> shift) & (HIST_SUB_COUNT - 1));
+}
+
+uint64_t Hist_BucketLow(int bucket)
+{
+    if (bucket < 2 * HIST_SUB_COUNT)
+        return (uint64_t)bucket;
+
+    int shift = bucket / HIST_SUB_COUNT - 1;
+    uint64_t mantissa = (uint64_t)(HIST_SUB_COUNT + bucket % HIST_SUB_COUNT);
+    return mantissa << shift;
+}
+
+uint64_t Hist_BucketHigh(int bucket)
+{
+    if (bucket < 2 * HIST_SUB_COUNT)
+        return (uint64_t)bucket;
+
+    int shift = bucket / HIST_SUB_COUNT - 1;
+    return Hist_BucketLow(bucket) + ((1ull << shift) - 1);
+}
+
+void Hist_Record(Histogram* h, uint64_t value)
+{
+    h->bins[Hist_Bucket(value)]++;
+    h->count++;
+    h->sum += value;
+    if (value < h->min)
+        h->min = value;
+    if (value > h->max)
+        h->max = value;
+}
+
+void Hist_Merge(Histogram* dst, const Histogram* src)
+{
+    for (int i = 0; i < HIST_BUCKETS; i++)
+        dst->bins[i] += src->bins[i];
+
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+}
+
+uint64_t Hist_Percentile(const Histogram* h, double p)
+{
+    uint64_t rank;
+    uint64_t seen = 0;
+
+    if (h->count == 0)
+        return 0;
+
+    rank = (uint64_t)(p / 100.0 * (double)h->count + 0.999999);
+    if (rank < 1)
+        rank = 1;
+    if (rank > h->count)
+        rank = h->count;
+
+    for (int i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += h->bins[i];
+        if (seen >= rank)
+        {
+            uint64_t high = Hist_BucketHigh(i);
+            return high < h->max ? high : h->max;
+        }
+    }
+    return h->max;
+}
+
+void Hist_PrintSummary(FILE* out, const char* name, const Histogram* h)
+{
+    if (h->count == 0)
+    {
+        fprintf(out, "  %-10s : n=0\n", name);
+        return;
+    }
+
+    fprintf(out, "  %-10s : n=%llu min %.3f p50 %.3f p99 %.3f p99.9 %.3f max %.3f avg %.3f us\n",
+        name, (unsigned long long)h->count,
+        h->min / 1e3,
+        Hist_Percentile(h, 50.0) / 1e3,
+        Hist_Percentile(h, 99.0) / 1e3,
+        Hist_Percentile(h, 99.9) / 1e3,
+        h->max / 1e3,
+        (double)h->sum / (double)h->count / 1e3);
+}
+
+void Hist_WriteCsv(FILE* out, const char* name, const Histogram* h)
+{
+    for (int i = 0; i < HIST_BUCKETS; i++)
+    {
+        if (h->bins[i])
+            fprintf(out, "%s,%llu,%llu,%llu\n", name,
+                (unsigned long long)Hist_BucketLow(i),
+                (unsigned long long)Hist_BucketHigh(i),
+                (unsigned long long)h->bins[i]);
+    }
+}
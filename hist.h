@@ -0,0 +1,48 @@
+#ifndef HIST_H
+#define HIST_H
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * Log-linear 히스토그램 (시간 측정값 ns 등 uint64_t)
+ *  - 2의 거듭제곱 구간마다 HIST_SUB_COUNT개 균등 분할 → 상대 오차 1/16 이하
+ *  - 0 ~ 31 은 정확한 값 그대로 기록
+ *  - 고정 크기 배열이므로 기록은 할당 없이 O(1), 스레드별로 기록 후 Hist_Merge 로 합산
+ */
+
+#define HIST_SUB_BITS   4
+#define HIST_SUB_COUNT  (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS    ((64 - HIST_SUB_BITS) * HIST_SUB_COUNT + HIST_SUB_COUNT)
+
+typedef struct
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint64_t bins[HIST_BUCKETS];
+} Histogram;
+
+void Hist_Init(Histogram* h);
+
+/* 값 1개 기록 */
+void Hist_Record(Histogram* h, uint64_t value);
+
+/* dst += src */
+void Hist_Merge(Histogram* dst, const Histogram* src);
+
+/* 백분위 값 (p : 0 ~ 100, 구간 상한 기준, max 이하로 제한) */
+uint64_t Hist_Percentile(const Histogram* h, double p);
+
+/* 구간 번호 ↔ 값 범위 */
+int Hist_Bucket(uint64_t value);
+uint64_t Hist_BucketLow(int bucket);
+uint64_t Hist_BucketHigh(int bucket);
+
+/* 요약 1줄 출력 : "<name> : n=.. p50 .. p99 .. p99.9 .. max .. us" */
+void Hist_PrintSummary(FILE* out, const char* name, const Histogram* h);
+
+/* 0이 아닌 구간을 CSV 행으로 출력 : "<name>,<low>,<high>,<count>" */
+void Hist_WriteCsv(FILE* out, const char* name, const Histogram* h);
+
+#endif /* HIST_H */
@@ -0,0 +1,681 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "inject.h"
+#include "input.h"
+#include "output.h"
+#include "snap_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define INJ_NAME_MAX    32
+#define INJ_TOKEN_MAX   8
+#define INJ_BLOCK       4096    // .snap 1회 읽기 행 수
+
+/* 주입 동작 */
+enum
+{
+    INJ_STUCK,
+    INJ_DRIFT,
+    INJ_SPIKE,
+    INJ_DROPOUT,
+    INJ_SAG,
+    INJ_GAP
+};
+
+typedef struct
+{
+    int from;                   // Cycle 구간 (양 끝 포함)
+    int to;
+    double value;               // stuck 값 / drift rate / spike amp / sag 목표값
+    int period;                 // spike 주기
+    uint8_t kind;
+    uint8_t field;              // Input_Fields 번호
+    uint8_t capture;            // stuck : 구간 첫 행 값 사용
+} InjectOp;
+
+typedef struct
+{
+    char name[INJ_NAME_MAX];
+    int op_first;
+    int op_count;
+} InjectVariant;
+
+struct InjectScript
+{
+    InjectOp* ops;
+    int op_count;
+    int op_cap;
+
+    InjectVariant* variants;
+    int variant_count;
+    int variant_cap;
+};
+
+/* 동작별 실행 상태 (구간 첫 행 값) */
+typedef struct
+{
+    double start;
+    int active;
+} InjectOpState;
+
+static int Table_Grow(void** p, int* cap, int need, size_t elem)
+{
+    if (need <= *cap)
+        return 1;
+
+    int n = *cap ? *cap * 2 : 16;
+    while (n < need)
+        n *= 2;
+
+    void* q = realloc(*p, (size_t)n * elem);
+    if (!q)
+        return 0;
+    *p = q;
+    *cap = n;
+    return 1;
+}
+
+/* ------------------------------
+ * 스크립트 컴파일
+ * ------------------------------ */
+
+static int Parse_Number(const char* s, double* out)
+{
+    char* end;
+
+    if (*s == '\0')
+        return 0;
+    *out = strtod(s, &end);
+    return *end == '\0' && isfinite(*out);
+}
+
+/* "N" 또는 "from..to" */
+static int Parse_Range(const char* s, int* from, int* to)
+{
+    char* end;
+    long a = strtol(s, &end, 10);
+    long b = a;
+
+    if (end == s)
+        return 0;
+    if (strncmp(end, "..", 2) == 0)
+    {
+        const char* t = end + 2;
+        b = strtol(t, &end, 10);
+        if (end == t)
+            return 0;
+    }
+    if (*end != '\0' || a < 0 || b < a || b > 0x7FFFFFFF)
+        return 0;
+
+    *from = (int)a;
+    *to = (int)b;
+    return 1;
+}
+
+static int Parse_Field(const char* name)
+{
+    const InputField* f = Input_FindField(name);
+
+    /* Cycle 누락은 gap 으로 지정 */
+    if (!f || f == &Input_Fields[0])
+        return -1;
+    return (int)(f - Input_Fields);
+}
+
+static int Line_Parse(InjectScript* s, char** tok, int count, int lineNo, int* in_variant)
+{
+    static const struct { const char* name; uint8_t kind; int has_field; int min_args; int max_args; } ops[] =
+    {
+        { "stuck",   INJ_STUCK,   1, 0, 1 },
+        { "drift",   INJ_DRIFT,   1, 1, 1 },
+        { "spike",   INJ_SPIKE,   1, 1, 2 },
+        { "dropout", INJ_DROPOUT, 0, 0, 0 },
+        { "sag",     INJ_SAG,     0, 1, 1 },
+        { "gap",     INJ_GAP,     0, 0, 0 },
+    };
+    const char* cmd = tok[0];
+
+    if (strcmp(cmd, "variant") == 0)
+    {
+        InjectVariant* v;
+
+        if (*in_variant)
+        {
+            printf("ERROR: Inject line %d : missing end before variant\n", lineNo);
+            return 0;
+        }
+        if (count != 2 || strlen(tok[1]) >= INJ_NAME_MAX || strcmp(tok[1], "baseline") == 0)
+            goto syntax;
+        for (int i = 0; i < s->variant_count; i++)
+        {
+            if (strcmp(s->variants[i].name, tok[1]) == 0)
+            {
+                printf("ERROR: Inject line %d : duplicate variant name (%s)\n", lineNo, tok[1]);
+                return 0;
+            }
+        }
+        if (!Table_Grow((void**)&s->variants, &s->variant_cap, s->variant_count + 1, sizeof(*s->variants)))
+            goto nomem;
+
+        v = &s->variants[s->variant_count++];
+        memset(v, 0, sizeof(*v));
+        strcpy(v->name, tok[1]);
+        v->op_first = s->op_count;
+        *in_variant = 1;
+        return 1;
+    }
+
+    if (strcmp(cmd, "end") == 0)
+    {
+        if (count != 1 || !*in_variant)
+            goto syntax;
+        *in_variant = 0;
+        return 1;
+    }
+
+    for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); k++)
+    {
+        InjectOp op;
+        int arg;
+        int args;
+
+        if (strcmp(cmd, ops[k].name) != 0)
+            continue;
+
+        if (!*in_variant)
+        {
+            printf("ERROR: Inject line %d : %s outside variant\n", lineNo, cmd);
+            return 0;
+        }
+
+        memset(&op, 0, sizeof(op));
+        op.kind = ops[k].kind;
+        op.period = 1;
+        arg = 1;
+
+        if (ops[k].has_field)
+        {
+            int field;
+
+            if (count < 2)
+                goto syntax;
+            field = Parse_Field(tok[1]);
+            if (field < 0)
+            {
+                printf("ERROR: Inject line %d : unknown field (%s)\n", lineNo, tok[1]);
+                return 0;
+            }
+            op.field = (uint8_t)field;
+            arg = 2;
+        }
+        else if (op.kind == INJ_DROPOUT)
+        {
+            op.field = (uint8_t)(Input_FindField("CanMsg") - Input_Fields);
+        }
+        else if (op.kind == INJ_SAG)
+        {
+            op.field = (uint8_t)(Input_FindField("IsoR") - Input_Fields);
+        }
+
+        if (count <= arg || !Parse_Range(tok[arg], &op.from, &op.to))
+            goto syntax;
+        arg++;
+
+        args = count - arg;
+        if (args < ops[k].min_args || args > ops[k].max_args)
+            goto syntax;
+
+        if (args >= 1 && !Parse_Number(tok[arg], &op.value))
+            goto syntax;
+        if (op.kind == INJ_STUCK && args == 0)
+            op.capture = 1;
+        if (args == 2)
+        {
+            double period;
+            if (!Parse_Number(tok[arg + 1], &period) || period < 1 || period != floor(period) ||
+                period > 0x7FFFFFFF)
+                goto syntax;
+            op.period = (int)period;
+        }
+
+        if (!Table_Grow((void**)&s->ops, &s->op_cap, s->op_count + 1, sizeof(*s->ops)))
+            goto nomem;
+        s->ops[s->op_count++] = op;
+        s->variants[s->variant_count - 1].op_count++;
+        return 1;
+    }
+
+    printf("ERROR: Inject line %d : unknown statement (%s)\n", lineNo, cmd);
+    return 0;
+
+syntax:
+    printf("ERROR: Inject line %d : invalid %s statement\n", lineNo, cmd);
+    return 0;
+
+nomem:
+    printf("ERROR: Out of memory while compiling inject script\n");
+    return 0;
+}
+
+InjectScript* Inject_Compile(const char* text)
+{
+    InjectScript* s = (InjectScript*)calloc(1, sizeof(*s));
+    const char* p = text;
+    char line[1024];
+    char* tok[INJ_TOKEN_MAX];
+    int lineNo = 0;
+    int in_variant = 0;
+
+    if (!s)
+    {
+        printf("ERROR: Out of memory while compiling inject script\n");
+        return NULL;
+    }
+
+    while (*p)
+    {
+        const char* nl = strchr(p, '\n');
+        size_t len = nl ? (size_t)(nl - p) : strlen(p);
+        int count = 0;
+        char* hash;
+
+        if (len >= sizeof(line))
+        {
+            printf("ERROR: Inject line %d : line too long\n", lineNo + 1);
+            goto fail;
+        }
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p = nl ? nl + 1 : p + len;
+        lineNo++;
+
+        hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        for (char* t = strtok(line, " \t\r"); t; t = strtok(NULL, " \t\r"))
+        {
+            if (count == INJ_TOKEN_MAX)
+            {
+                printf("ERROR: Inject line %d : too many items\n", lineNo);
+                goto fail;
+            }
+            tok[count++] = t;
+        }
+
+        if (count > 0 && !Line_Parse(s, tok, count, lineNo, &in_variant))
+            goto fail;
+    }
+
+    if (in_variant)
+    {
+        printf("ERROR: Inject line %d : missing end\n", lineNo);
+        goto fail;
+    }
+    if (s->variant_count == 0)
+    {
+        printf("ERROR: Inject script has no variant\n");
+        goto fail;
+    }
+    return s;
+
+fail:
+    Inject_Free(s);
+    return NULL;
+}
+
+InjectScript* Inject_Load(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    InjectScript* s;
+    char* text;
+    long size;
+
+    if (!fp)
+    {
+        printf("ERROR: Failed to open inject script : %s\n", path);
+        return NULL;
+    }
+
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0)
+    {
+        printf("ERROR: Failed to read inject script : %s\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    text = (char*)malloc((size_t)size + 1);
+    if (!text || fread(text, 1, (size_t)size, fp) != (size_t)size)
+    {
+        printf("ERROR: Failed to read inject script : %s\n", path);
+        free(text);
+        fclose(fp);
+        return NULL;
+    }
+    text[size] = '\0';
+    fclose(fp);
+
+    s = Inject_Compile(text);
+    free(text);
+    return s;
+}
+
+void Inject_Free(InjectScript* s)
+{
+    if (!s)
+        return;
+    free(s->ops);
+    free(s->variants);
+    free(s);
+}
+
+int Inject_VariantCount(const InjectScript* s)
+{
+    return s->variant_count;
+}
+
+const char* Inject_VariantName(const InjectScript* s, int variant)
+{
+    return s->variants[variant].name;
+}
+
+/* ------------------------------
+ * 주입 진단
+ * ------------------------------ */
+
+static double Field_Get(const InputSnapshot* in, int field)
+{
+    const char* p = (const char*)in + Input_Fields[field].offset;
+
+    return Input_Fields[field].is_float ? Input_CurrentToDouble(*(const InputCurrent*)p) : (double)*(const int*)p;
+}
+
+static void Field_Set(InputSnapshot* in, int field, double v)
+{
+    char* p = (char*)in + Input_Fields[field].offset;
+
+    if (Input_Fields[field].is_float)
+        *(InputCurrent*)p = Input_CurrentFromDouble(v);
+    else
+        *(int*)p = (int)floor(v + 0.5);
+}
+
+/* 변형 1개 적용 : 행 제거(gap) 시 0 */
+static int Variant_Apply(const InjectScript* s, const InjectVariant* v, InjectOpState* state, InputSnapshot* in)
+{
+    int cycle = in->Cycle;
+    int keep = 1;
+
+    for (int i = v->op_first; i < v->op_first + v->op_count; i++)
+    {
+        const InjectOp* op = &s->ops[i];
+        InjectOpState* st = &state[i];
+        int k;
+
+        if (cycle < op->from || cycle > op->to)
+        {
+            st->active = 0;
+            continue;
+        }
+
+        /* 구간 첫 행 : 시작 값 기록 */
+        if (!st->active)
+        {
+            st->active = 1;
+            st->start = Field_Get(in, op->field);
+        }
+        k = cycle - op->from;
+
+        switch (op->kind)
+        {
+        case INJ_STUCK:
+            Field_Set(in, op->field, op->capture ? st->start : op->value);
+            break;
+
+        case INJ_DRIFT:
+            Field_Set(in, op->field, Field_Get(in, op->field) + op->value * (k + 1));
+            break;
+
+        case INJ_SPIKE:
+            if (k % op->period == 0)
+                Field_Set(in, op->field, Field_Get(in, op->field) + op->value);
+            break;
+
+        case INJ_DROPOUT:
+            Field_Set(in, op->field, 0);
+            break;
+
+        case INJ_SAG:
+            if (op->to > op->from)
+                Field_Set(in, op->field, st->start + (op->value - st->start) * k / (op->to - op->from));
+            else
+                Field_Set(in, op->field, op->value);
+            break;
+
+        default:
+            keep = 0;
+            break;
+        }
+    }
+    return keep;
+}
+
+static void Result_Init(InjectResult* r)
+{
+    memset(r, 0, sizeof(*r));
+    for (int code = 0; code < FAULT_MAX; code++)
+    {
+        r->first_detect[code] = -1;
+        r->first_confirm[code] = -1;
+    }
+}
+
+static void Result_Record(InjectResult* r, const FaultContext* ctx, int cycle)
+{
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        FaultStatus st = ctx->state[code];
+
+        if (st == FAULT_NORMAL)
+            continue;
+        if (r->first_detect[code] < 0)
+            r->first_detect[code] = cycle;
+        if (st == FAULT_CONFIRM)
+        {
+            if (r->first_confirm[code] < 0)
+                r->first_confirm[code] = cycle;
+            r->confirm_cycles[code]++;
+        }
+    }
+    r->rows++;
+}
+
+/* 입력 1행 : 기준 + 변형별 진단 */
+static void Inject_Row(const InjectScript* s, InjectOpState* state, FaultContext* ctx, FILE** outs,
+    InjectResult* results, const InputSnapshot* in)
+{
+    Fault_DiagnoseContext(&ctx[0], in);
+    Result_Record(&results[0], &ctx[0], in->Cycle);
+    if (outs)
+        Output_WriteRow(outs[0], in->Cycle, &ctx[0]);
+
+    for (int v = 0; v < s->variant_count; v++)
+    {
+        InputSnapshot row = *in;
+
+        if (!Variant_Apply(s, &s->variants[v], state, &row))
+        {
+            results[1 + v].dropped++;
+            continue;
+        }
+
+        Fault_DiagnoseContext(&ctx[1 + v], &row);
+        Result_Record(&results[1 + v], &ctx[1 + v], row.Cycle);
+        if (outs)
+            Output_WriteRow(outs[1 + v], row.Cycle, &ctx[1 + v]);
+    }
+}
+
+static int Outputs_Open(FILE** outs, const InjectScript* s, const char* prefix)
+{
+    char path[1024];
+
+    for (int v = 0; v <= s->variant_count; v++)
+    {
+        snprintf(path, sizeof(path), "%s%s.csv", prefix, v == 0 ? "baseline" : s->variants[v - 1].name);
+        outs[v] = fopen(path, "w");
+        if (!outs[v])
+        {
+            printf("ERROR: Failed to open result CSV : %s\n", path);
+            return 0;
+        }
+        Output_WriteHeader(outs[v]);
+    }
+    return 1;
+}
+
+static int Outputs_Close(FILE** outs, int count)
+{
+    int ok = 1;
+
+    for (int v = 0; v < count; v++)
+    {
+        if (outs[v] && fclose(outs[v]) != 0)
+            ok = 0;
+    }
+    return ok;
+}
+
+int Inject_Run(const char* input_path, const InjectScript* s, const char* results_prefix,
+    InjectResult* results)
+{
+    int count = s->variant_count + 1;
+    FaultContext* ctx = (FaultContext*)malloc((size_t)count * sizeof(*ctx));
+    InjectOpState* state = (InjectOpState*)calloc((size_t)(s->op_count ? s->op_count : 1), sizeof(*state));
+    FILE** outs = results_prefix ? (FILE**)calloc((size_t)count, sizeof(*outs)) : NULL;
+    int rc = 1;
+
+    if (!ctx || !state || (results_prefix && !outs))
+    {
+        printf("ERROR: Out of memory while running injection\n");
+        goto done;
+    }
+
+    for (int v = 0; v < count; v++)
+    {
+        Fault_InitContext(&ctx[v]);
+        Result_Init(&results[v]);
+    }
+
+    if (outs && !Outputs_Open(outs, s, results_prefix))
+        goto done;
+
+    if (SnapLog_Detect(input_path))
+    {
+        static InputSnapshot block[INJ_BLOCK];
+        SnapLog log;
+        size_t n;
+
+        if (!SnapLog_Open(&log, input_path))
+            goto done;
+        while ((n = SnapLog_Read(&log, block, INJ_BLOCK)) > 0)
+        {
+            for (size_t i = 0; i < n; i++)
+                Inject_Row(s, state, ctx, outs, results, &block[i]);
+        }
+        rc = ferror(log.fp) ? 1 : 0;
+        SnapLog_Close(&log);
+    }
+    else
+    {
+        FILE* fp = fopen(input_path, "r");
+        char line[INPUT_LINE_MAX];
+        InputSnapshot in;
+
+        if (!fp)
+        {
+            printf("ERROR: Failed to open input CSV : %s\n", input_path);
+            goto done;
+        }
+
+        /* 헤더 1줄 제외, 직렬 진단과 같이 파싱 실패 줄에서 종료 */
+        if (fgets(line, sizeof(line), fp))
+        {
+            while (fgets(line, sizeof(line), fp) && Input_ParseLine(line, &in))
+                Inject_Row(s, state, ctx, outs, results, &in);
+        }
+        rc = ferror(fp) ? 1 : 0;
+        fclose(fp);
+    }
+
+    if (rc != 0)
+        printf("ERROR: Failed to read input : %s\n", input_path);
+
+done:
+    if (outs && !Outputs_Close(outs, count) && rc == 0)
+    {
+        printf("ERROR: Failed to write injection result CSV\n");
+        rc = 1;
+    }
+    free(outs);
+    free(state);
+    free(ctx);
+    return rc;
+}
+
+/* ------------------------------
+ * 요약
+ * ------------------------------ */
+
+void Inject_WriteSummary(FILE* out, const InjectScript* s, const InjectResult* results)
+{
+    const InjectResult* base = &results[0];
+
+    fprintf(out, "Variant,Fault,First_Detect,First_Confirm,Confirm_Cycles,"
+        "Baseline_First_Detect,Baseline_First_Confirm,Baseline_Confirm_Cycles,Rows,Dropped\n");
+
+    for (int v = 0; v < s->variant_count; v++)
+    {
+        const InjectResult* r = &results[1 + v];
+
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        {
+            fprintf(out, "%s,0x%02X,%d,%d,%llu,%d,%d,%llu,%llu,%llu\n", s->variants[v].name, code,
+                r->first_detect[code], r->first_confirm[code], (unsigned long long)r->confirm_cycles[code],
+                base->first_detect[code], base->first_confirm[code],
+                (unsigned long long)base->confirm_cycles[code],
+                (unsigned long long)r->rows, (unsigned long long)r->dropped);
+        }
+    }
+}
+
+void Inject_PrintSummary(FILE* out, const InjectScript* s, const InjectResult* results)
+{
+    const InjectResult* base = &results[0];
+
+    for (int v = 0; v < s->variant_count; v++)
+    {
+        const InjectResult* r = &results[1 + v];
+        int changed = 0;
+
+        fprintf(out, "  %-16s :", s->variants[v].name);
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        {
+            if (r->first_detect[code] == base->first_detect[code] &&
+                r->first_confirm[code] == base->first_confirm[code] &&
+                r->confirm_cycles[code] == base->confirm_cycles[code])
+                continue;
+
+            fprintf(out, " 0x%02X detect %d confirm %d (baseline %d / %d)", code,
+                r->first_detect[code], r->first_confirm[code],
+                base->first_detect[code], base->first_confirm[code]);
+            changed++;
+        }
+        if (!changed)
+            fprintf(out, " no change");
+        if (r->dropped)
+            fprintf(out, " [%llu rows dropped]", (unsigned long long)r->dropped);
+        fputc('\n', out);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef INJECT_H
+#define INJECT_H
+#include <stdio.h>
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 스트리밍 고장 주입 (--inject=<script>)
+ *  - 기록된 입력 로그(CSV / .snap)를 한 번 읽으면서 행마다 변형(variant) N개를 각각 적용하고
+ *    변형별 FaultContext 로 진단 → 중간 파일 없이 변형별 검출 결과를 원본(기준)과 비교
+ *  - 결과 : 변형 × 고장별 최초 검출 / 확정 Cycle, 확정 Cycle 수 (요약 CSV + 기준과 다른 항목 출력)
+ *
+ * 스크립트 형식 (줄 단위, # 뒤는 주석, 구간은 입력 Cycle 번호 기준 양 끝 포함)
+ *   variant <name>                                  변형 정의 시작
+ *     stuck   <field> <from>..<to> [value]          값 고정 (생략 시 구간 첫 행 값)
+ *     drift   <field> <from>..<to> <rate>           구간 시작부터 Cycle 당 rate 씩 누적 편차
+ *     spike   <field> <from>..<to> <amp> [period]   period Cycle 마다 amp 더함 (기본 1 : 구간 전체)
+ *     dropout <from>..<to>                          CanMsg = 0 (수신 끊김 → 0x07)
+ *     sag     <from>..<to> <value>                  IsoR 를 구간 첫 행 값에서 value 까지 직선 하강 (→ 0x08)
+ *     gap     <from>..<to>                          구간 행 제거 (Cycle 누락 → 0x0A)
+ *   end
+ *  - field : InputSnapshot 필드 이름 또는 CSV 헤더 이름 (Cycle 제외), 같은 필드는 정의 순서대로 적용
+ */
+
+typedef struct InjectScript InjectScript;
+
+/* 스크립트 텍스트 / 파일 컴파일 : 실패 시 NULL (오류 내용 출력) */
+InjectScript* Inject_Compile(const char* text);
+InjectScript* Inject_Load(const char* path);
+void Inject_Free(InjectScript* script);
+
+int Inject_VariantCount(const InjectScript* script);
+const char* Inject_VariantName(const InjectScript* script, int variant);
+
+/* 변형 1개 진단 결과 (Cycle -1 : 없음) */
+typedef struct
+{
+    int first_detect[FAULT_MAX];        // 최초 DETECT 이상
+    int first_confirm[FAULT_MAX];       // 최초 CONFIRM
+    uint64_t confirm_cycles[FAULT_MAX];
+    uint64_t rows;                      // 진단 행 수
+    uint64_t dropped;                   // gap 으로 제거한 행 수
+} InjectResult;
+
+/*
+ * ===== 주입 진단 실행 : 성공 0, 실패 1 =====
+ *  results[0] : 원본(기준), results[1 + v] : 변형 v
+ *  results_prefix : NULL 이 아니면 변형별 Cycle 결과 CSV 를 <prefix><name>.csv 로 기록 (기준 : baseline)
+ */
+int Inject_Run(const char* input_path, const InjectScript* script, const char* results_prefix,
+    InjectResult* results);
+
+/* ===== 요약 출력 : CSV (변형 × 고장) / 기준과 다른 항목 ===== */
+void Inject_WriteSummary(FILE* out, const InjectScript* script, const InjectResult* results);
+void Inject_PrintSummary(FILE* out, const InjectScript* script, const InjectResult* results);
+
+#endif /* INJECT_H */
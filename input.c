@@ -1,9 +1,48 @@
 ﻿#include "input.h"
+#include "prof.h"
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <math.h>
 
-int Input_ReadLine(FILE* fp, InputSnapshot* out)
+#define FIELD(name, alias, is_float) { #name, alias, offsetof(InputSnapshot, name), is_float }
+
+const InputField Input_Fields[INPUT_FIELD_COUNT] =
+{
+    FIELD(Cycle, NULL, 0),
+    FIELD(SeqState, NULL, 0),
+    FIELD(PlugInfo, NULL, 0),
+    FIELD(FLAG_Stop, NULL, 0),
+    FIELD(FLAG_Relay, NULL, 0),
+    FIELD(Ia, NULL, 1),
+    FIELD(Ib, NULL, 1),
+    FIELD(Ic, NULL, 1),
+    FIELD(FaultState, NULL, 0),
+    FIELD(Charg_Cnt, NULL, 0),
+    FIELD(Real_V, "Real_Battery_Voltage", 0),
+    FIELD(Exp_V, "Expected_Battery_Voltage", 0),
+    FIELD(H, NULL, 0),
+    FIELD(CanMsg, "CanMsg_Received", 0),
+    FIELD(IsoR, NULL, 0),
+};
+
+const InputField* Input_FindField(const char* name)
+{
+    for (int i = 0; i < INPUT_FIELD_COUNT; i++)
+    {
+        if (strcmp(Input_Fields[i].name, name) == 0 ||
+            (Input_Fields[i].alias && strcmp(Input_Fields[i].alias, name) == 0))
+            return &Input_Fields[i];
+    }
+    return NULL;
+}
+
+static int parseFailed = 0;      // 마지막 Input_ReadLine 이 파싱 실패 줄에서 종료
+
+static int Input_ReadLineBody(FILE* fp, InputSnapshot* out)
 {
-    char line[256];
+    char line[INPUT_LINE_MAX];
     static int first_call = 1;   // 처음 호출 여부
 
     /* 첫 호출이면 헤더 1줄 스킵 */
@@ -19,6 +58,281 @@ int Input_ReadLine(FILE* fp, InputSnapshot* out)
     if (fgets(line, sizeof(line), fp) == NULL)
         return 0;   // EOF
 
+    parseFailed = !Input_ParseLine(line, out);
+    return !parseFailed;
+}
+
+int Input_ReadLine(FILE* fp, InputSnapshot* out)
+{
+    PROF_BEGIN(t);
+    int ok = Input_ReadLineBody(fp, out);
+
+    PROF_END(PROF_POINT_INPUT_READ, t);
+    return ok;
+}
+
+int Input_ParseFailed(void)
+{
+    return parseFailed;
+}
+
+#ifdef OBC_FIXED_POINT
+/*
+ * 정수 필드 : sscanf %d 와 같이 공백 생략 후 10진 변환 (숫자가 없으면 실패)
+ *  - 범위 초과는 glibc sscanf %d 와 같이 64 bit 포화 후 하위 32 bit (long 크기와 무관)
+ */
+static const char* Parse_Int(const char* p, int* out)
+{
+    char* end;
+    long long v = strtoll(p, &end, 10);
+
+    if (end == p)
+        return NULL;
+    *out = (int)(uint32_t)(unsigned long long)v;
+    return end;
+}
+
+/* 대소문자 무시 접두사 비교 */
+static int Match_NoCase(const char* p, const char* word)
+{
+    for (; *word; p++, word++)
+    {
+        if (tolower((unsigned char)*p) != *word)
+            return 0;
+    }
+    return 1;
+}
+
+/* 소수부 자릿수(digits 의 dp 번째부터, dp < 0 이면 앞 0) × 2^k 의 정수부 (k <= 25), 남는 소수부가 있으면 *rest = 1 */
+static int64_t Frac_Shift(const char* digits, int n, long dp, int k, int* rest)
+{
+    int64_t carry = 0;
+
+    *rest = 0;
+    for (long i = n - 1; i >= dp; i--)
+    {
+        int64_t v = ((i >= 0) ? (int64_t)(digits[i] - '0') << k : 0) + carry;
+
+        if (i < 0 && carry == 0)
+            break;
+        if (v % 10 != 0)
+            *rest = 1;
+        carry = v / 10;
+    }
+    return carry;
+}
+
+/* 2^-150 (float 최소 subnormal 의 절반) 10진 유효 숫자, 첫 자리 10^-46 */
+static const char floatHalfMin[] =
+    "700649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625";
+
+/*
+ * float 빌드(sscanf %f : strtof nearest-even 반올림)와 같은 판정
+ *  - 정수 A(0 포함)는 float 로 정확히 표현되고 반올림은 단조 → float 값이 정수 A 가 되는 경우만 대소가 달라짐
+ *  - 정수 A 에서 float 반 ulp 이내(같으면 짝수 쪽 = 정수 A)인 값은 그 정수 A 로 맞춤 (그 외는 정확한 10진 값 유지)
+ *  - ma / sticky : 크기의 mA 정수부 / mA 미만 자릿수 표시, dp : digits 에서 소수점 위치
+ */
+static void Round_LikeFloat(const char* digits, int n, long dp, int64_t* ma, int* sticky)
+{
+    int64_t amps = *ma / 1000;
+    int frac = (int)(*ma % 1000);
+    int rest;
+
+    if (*ma >= 1073741824)
+        return;                 // 포화
+
+    if (*ma == 0)
+    {
+        /* 1 mA 미만 : 2^-150 이하이면 float 0 */
+        int f0 = 0;
+        long lead;
+
+        while (f0 < n && digits[f0] == '0')
+            f0++;
+        if (f0 == n)
+            return;
+        lead = dp - 1 - f0;     // 첫 유효 숫자 자리 (10^lead)
+        if (lead == -46)
+        {
+            size_t j = 0;
+
+            for (; j < sizeof(floatHalfMin) - 1 && f0 < n && digits[f0] == floatHalfMin[j]; j++, f0++)
+                ;
+            if (j < sizeof(floatHalfMin) - 1 && f0 < n && digits[f0] > floatHalfMin[j])
+                return;
+            for (; f0 < n; f0++)
+            {
+                if (j == sizeof(floatHalfMin) - 1 && digits[f0] != '0')
+                    return;
+            }
+        }
+        else if (lead > -46)
+            return;
+        *sticky = 0;
+        return;
+    }
+
+    /* 정수 A 바로 위 : 반 ulp = 2^(e - 24) */
+    if (amps >= 1 && (frac != 0 || *sticky))
+    {
+        int e = 0;
+
+        while ((amps >> (e + 1)) != 0)
+            e++;
+        if (((int64_t)frac << (24 - e)) <= 1000)
+        {
+            int64_t p = Frac_Shift(digits, n, dp, 24 - e, &rest);
+
+            if (p == 0 || (p == 1 && !rest))
+            {
+                *ma = amps * 1000;
+                *sticky = 0;
+                return;
+            }
+        }
+    }
+
+    /* 정수 A + 1 바로 아래 : 반 ulp = 2^(e - 24), 2의 거듭제곱이면 아래 구간 ulp 가 절반이라 2^(e - 25) */
+    {
+        int64_t next = amps + 1;
+        int e = 0;
+        int k;
+
+        while ((next >> (e + 1)) != 0)
+            e++;
+        k = ((next & (next - 1)) == 0) ? 25 - e : 24 - e;
+        if (((int64_t)(999 - frac) << k) < 1000 &&
+            Frac_Shift(digits, n, dp, k, &rest) == ((int64_t)1 << k) - 1)
+        {
+            *ma = next * 1000;
+            *sticky = 0;
+        }
+    }
+}
+
+/*
+ * 전류 필드 : 10진 실수 표기를 정수 연산만으로 0.5 mA 단위 값으로 변환 (mA 미만 자릿수가 남으면 최하위 비트 1)
+ *  - float 로 반올림하면 정수 A 가 되는 값은 그 정수 A 로 (Round_LikeFloat : 정수 A 임계값 판정이 float 빌드와 같음)
+ */
+static const char* Parse_Current(const char* p, InputCurrent* out)
+{
+    char digits[INPUT_LINE_MAX];
+    int n = 0;
+    int point = -1;             // 소수점 앞 자릿수
+    int neg = 0;
+    long exp10 = 0;
+    long pos;
+    int64_t ma = 0;
+    int64_t units;
+    int sticky = 0;
+    int overflow = 0;
+
+    while (isspace((unsigned char)*p))
+        p++;
+    if (*p == '+' || *p == '-')
+        neg = (*p++ == '-');
+
+    if (Match_NoCase(p, "inf"))
+    {
+        p += 3;
+        if (Match_NoCase(p, "inity"))
+            p += 5;
+        *out = neg ? INT32_MIN : INT32_MAX;
+        return p;
+    }
+
+    for (;; p++)
+    {
+        if (isdigit((unsigned char)*p))
+        {
+            if (n < INPUT_LINE_MAX)
+                digits[n++] = *p;
+            else if (point < 0)
+                overflow = 1;   // 정수부 자릿수 초과 → 포화
+            else if (*p != '0')
+                sticky = 1;
+        }
+        else if (*p == '.' && point < 0)
+            point = n;
+        else
+            break;
+    }
+    if (n == 0)
+        return NULL;            // 숫자 없음 ("." 포함)
+    if (point < 0)
+        point = n;
+
+    /* 지수 : sscanf %f 와 같이 숫자가 없어도 'e' 와 부호는 소비 */
+    if (*p == 'e' || *p == 'E')
+    {
+        int eneg = 0;
+
+        p++;
+        if (*p == '+' || *p == '-')
+            eneg = (*p++ == '-');
+        for (; isdigit((unsigned char)*p); p++)
+        {
+            if (exp10 < 100000)
+                exp10 = exp10 * 10 + (*p - '0');
+        }
+        if (eneg)
+            exp10 = -exp10;
+    }
+
+    /* mA 정수부 = 소수점 + 3 자리까지, 그 뒤 자릿수는 sticky */
+    pos = point + exp10 + 3;
+    for (long i = 0; i < pos && ma <= 1073741824; i++)
+        ma = ma * 10 + (i < n ? digits[i] - '0' : 0);
+    for (long i = (pos > 0) ? pos : 0; i < n; i++)
+    {
+        if (digits[i] != '0')
+            sticky = 1;
+    }
+
+    if (!overflow)
+        Round_LikeFloat(digits, n, point + exp10, &ma, &sticky);
+
+    units = overflow ? INT64_MAX / 4 : ma * 2 + sticky;
+    if (neg)
+        units = -units;
+    if (units > INT32_MAX)
+        units = INT32_MAX;
+    else if (units < INT32_MIN)
+        units = INT32_MIN;
+    *out = (InputCurrent)units;
+    return p;
+}
+
+int Input_ParseLine(const char* line, InputSnapshot* out)
+{
+    const char* p = line;
+
+    /* sscanf 형식과 같은 순서 : 필드마다 앞 공백 허용, 필드 사이 ',' 필수, 마지막 필드 뒤는 무시 */
+    for (int i = 0; i < INPUT_FIELD_COUNT; i++)
+    {
+        char* field = (char*)out + Input_Fields[i].offset;
+
+        if (i)
+        {
+            if (*p != ',')
+                return 0;
+            p++;
+        }
+
+        if (Input_Fields[i].is_float)
+            p = Parse_Current(p, (InputCurrent*)field);
+        else
+            p = Parse_Int(p, (int*)field);
+
+        if (p == NULL)
+            return 0;   // 파싱 실패 → 테스트 종료
+    }
+
+    return 1;       // 정상 데이터 1줄
+}
+#else
+int Input_ParseLine(const char* line, InputSnapshot* out)
+{
     /* CSV 파싱 */
     if (sscanf(line,
         "%d,%d,%d,%d,%d,%f,%f,%f,%d,%d,%d,%d,%d,%d,%d",
@@ -44,4 +358,135 @@ int Input_ReadLine(FILE* fp, InputSnapshot* out)
 
     return 1;       // 정상 데이터 1줄
 }
+#endif
+
+/* 정수 1개를 10진수로 기록하고 길이 반환 */
+static int Format_Int(char* buf, int v)
+{
+    char digits[12];
+    unsigned int value = (v < 0) ? 0u - (unsigned int)v : (unsigned int)v;
+    int len = 0;
+    int n = 0;
+
+    if (v < 0)
+        buf[len++] = '-';
+    do {
+        digits[n++] = (char)('0' + value % 10u);
+        value /= 10u;
+    } while (value != 0u);
+    while (n > 0)
+        buf[len++] = digits[--n];
+
+    return len;
+}
+
+#ifdef OBC_FIXED_POINT
+/* 전류 1개 : 정수 A + 소수 mA (끝 0 생략) + 최하위 비트면 "5" (Parse_Current 로 같은 값 복원) */
+static int Format_Current(char* buf, InputCurrent c)
+{
+    int64_t units = c;
+    int len = 0;
+    int amps;
+    int rem;
+
+    if (units < 0)
+    {
+        buf[len++] = '-';
+        units = -units;
+    }
+    amps = (int)(units / INPUT_CURRENT_SCALE);
+    rem = (int)(units % INPUT_CURRENT_SCALE);
+
+    len += Format_Int(buf + len, amps);
+    if (rem != 0)
+    {
+        int ma = rem / 2;
+
+        buf[len++] = '.';
+        buf[len++] = (char)('0' + ma / 100);
+        buf[len++] = (char)('0' + ma / 10 % 10);
+        buf[len++] = (char)('0' + ma % 10);
+        if (rem & 1)
+            buf[len++] = '5';
+        else
+        {
+            while (buf[len - 1] == '0')
+                len--;
+        }
+    }
+
+    return len;
+}
+
+double Input_CurrentToDouble(InputCurrent c)
+{
+    /* 최하위 비트는 mA 미만 값이 있다는 표시 → 0.5 mA 로 근사 */
+    return (double)c / INPUT_CURRENT_SCALE;
+}
+
+InputCurrent Input_CurrentFromDouble(double a)
+{
+    double mag = fabs(a);
+    double ma;
+    int64_t units;
+
+    if (a != a)
+        return 0;
+    if (mag >= 1073741824.0 / 1000.0)
+        return (a < 0) ? INT32_MIN : INT32_MAX;
+
+    ma = floor(mag * 1000.0);
+    units = (int64_t)ma * 2 + (mag * 1000.0 > ma);
+    return (InputCurrent)((a < 0) ? -units : units);
+}
+#else
+static int Format_Current(char* buf, InputCurrent f)
+{
+    /* 정수 값은 정수로, 그 외는 float 왕복 가능한 자릿수로 */
+    if (fabsf(f) < 1e9f && f == (float)(int)f && !(f == 0.0f && signbit(f)))
+        return Format_Int(buf, (int)f);
+    return snprintf(buf, 24, "%.9g", f);
+}
+
+double Input_CurrentToDouble(InputCurrent c)
+{
+    return c;
+}
+
+InputCurrent Input_CurrentFromDouble(double a)
+{
+    return (InputCurrent)a;
+}
+#endif
+
+void Input_WriteHeader(FILE* out)
+{
+    for (int i = 0; i < INPUT_FIELD_COUNT; i++)
+        fprintf(out, "%s%s", i ? "," : "", Input_Fields[i].name);
+    fputc('\n', out);
+}
 
+int Input_FormatLine(char* buf, const InputSnapshot* in)
+{
+    int len = 0;
+
+    for (int i = 0; i < INPUT_FIELD_COUNT; i++)
+    {
+        const char* field = (const char*)in + Input_Fields[i].offset;
+
+        if (i)
+            buf[len++] = ',';
+
+        if (!Input_Fields[i].is_float)
+        {
+            len += Format_Int(buf + len, *(const int*)field);
+        }
+        else
+        {
+            len += Format_Current(buf + len, *(const InputCurrent*)field);
+        }
+    }
+
+    buf[len++] = '\n';
+    return len;
+}
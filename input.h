@@ -2,8 +2,28 @@
 #define INPUT_H
 #define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
+#include <stdint.h>
 
-/* ===== CSV Է 1  ü ===== */
+/*
+ * 상전류(Ia / Ib / Ic) 표현
+ *  - 기본 : float (A)
+ *  - OBC_FIXED_POINT 정의 시 : int32 고정소수점 (1 LSB = 0.5 mA), FPU 없는 타깃에서 파싱 ~ 진단까지 정수 연산만 사용
+ *    · CSV 10진 값을 정확히 변환 : mA 미만 자릿수가 0이 아니면 최하위 비트(0.5 mA)를 1로 두어
+ *      정수 A 임계값과의 비교(>, <, <=)가 10진 값 그대로의 비교와 같음
+ *    · 단 float 로 반올림하면 정수 A(0 포함)가 되는 값(정수 A 에서 float 반 ulp 이내, 2^-150 이하 극소값)은
+ *      그 정수 A 로 맞추어 임계값 판정이 float 빌드(sscanf %f)와 같음
+ *    · 범위 ±1073741.823 A (넘으면 포화), 교정 전류 임계값도 같은 범위
+ */
+#ifdef OBC_FIXED_POINT
+typedef int32_t InputCurrent;
+#define INPUT_CURRENT_SCALE     2000                    // 1 A 당 LSB 수
+#define INPUT_CURRENT(a)        ((InputCurrent)((a) * INPUT_CURRENT_SCALE))
+#else
+typedef float InputCurrent;
+#define INPUT_CURRENT(a)        ((InputCurrent)(a))
+#endif
+
+/* ===== CSV 입력 1줄을 담는 구조체 ===== */
 typedef struct
 {
     int Cycle;
@@ -12,9 +32,9 @@ typedef struct
     int FLAG_Stop;
     int FLAG_Relay;
 
-    float Ia;
-    float Ib;
-    float Ic;
+    InputCurrent Ia;
+    InputCurrent Ib;
+    InputCurrent Ic;
 
     int FaultState;
     int Charg_Cnt;
@@ -26,7 +46,43 @@ typedef struct
     int IsoR;
 } InputSnapshot;
 
-/* ===== CSV   о ü  ===== */
+/* ===== CSV에서 한 줄 읽어서 구조체에 저장 ===== */
 int Input_ReadLine(FILE* fp, InputSnapshot* out);
 
+/* ===== 마지막 Input_ReadLine 의 0 반환이 파싱 실패 줄 때문이면 1 (EOF 는 0) ===== */
+int Input_ParseFailed(void);
+
+/* ===== CSV 데이터 한 줄(헤더 제외) 파싱 : 성공 1, 실패 0 =====
+ * 고정소수점 빌드는 sscanf 대신 정수 전용 파서 (정수 필드 : sscanf %d 와 같은 규칙, 전류 필드 : 부호 / 10진 소수 /
+ * 지수 / inf(포화), nan · 16진 실수는 실패) */
+int Input_ParseLine(const char* line, InputSnapshot* out);
+
+/* Input_ReadLine과 동일한 줄 버퍼 크기 */
+#define INPUT_LINE_MAX 256
+
+/* ===== 입력 CSV 헤더 출력 (Input_Fields 이름) ===== */
+void Input_WriteHeader(FILE* out);
+
+/* 입력 1줄(개행 포함)을 buf에 기록하고 길이를 반환 (buf >= INPUT_LINE_MAX, Input_ParseLine 으로 동일 값 복원) */
+int Input_FormatLine(char* buf, const InputSnapshot* in);
+
+/* ===== 전류 값 <-> A 단위 실수 변환 (호스트 도구용 : 시뮬레이터 / 생성기 / 주입, 진단 경로는 사용하지 않음) ===== */
+double Input_CurrentToDouble(InputCurrent c);
+InputCurrent Input_CurrentFromDouble(double a);     // 고정소수점 빌드 : mA 버림 + mA 미만 최하위 비트 + 포화
+
+/* ===== InputSnapshot 필드 정보 (이름으로 필드 접근) ===== */
+typedef struct
+{
+    const char* name;           // 필드 이름 (예 : "Ia")
+    const char* alias;          // CSV 헤더 이름 (예 : "Real_Battery_Voltage"), 없으면 NULL
+    unsigned int offset;        // offsetof(InputSnapshot, 필드)
+    int is_float;               // 1 : 전류 (InputCurrent), 0 : int
+} InputField;
+
+#define INPUT_FIELD_COUNT 15
+extern const InputField Input_Fields[INPUT_FIELD_COUNT];
+
+/* 이름(또는 alias)으로 필드 검색 : 없으면 NULL */
+const InputField* Input_FindField(const char* name);
+
 #endif /* INPUT_H */
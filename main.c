@@ -5,45 +5,138 @@
  *  System  : OBC Fault Diagnostic Engine
  *
  *  Overview
- *  - OBC   ܼ         
- *  - CAN Raw Data (CSV) Է мϿ  Fault Code(0x01 ~ 0x0C) ¸ Ǵ
+ *  - OBC 고장 사양 진단서를 기반으로 고장 진단 로직을 설계 및 구현한 진단 엔진
+ *  - CAN Raw Data (CSV) 입력을 분석하여 각 Fault Code(0x01 ~ 0x0C)의 상태를 판단
  *
  *  Architecture Design
- *  - Input.c/h   : CSV Parser  InputSnapshot ü ȯ
- *  - fault.c/h   : Diagnose_Fault_0x01 ~ 0x0C   
- *  - fault_test.c :  ׽Ʈ ڵ
- *  - main.c  :  CSV   Fault State 
+ *  - Input.c/h   : CSV Parser → InputSnapshot 구조체 변환
+ *  - fault.c/h   : Diagnose_Fault_0x01 ~ 0x0C 개별 진단 모듈
+ *  - regress.c : 골든 결과 회귀 테스트 (golden/regress.txt)
+ *  - main.c  : 결과 CSV 생성 및 Fault State 기록
  *
  *  Execution Flow
- *  1. Input CSV ε
- *  2. Cycle  Snapshot 
- *  3.  Fault Diagnostic Function 
- *  4. Fault   
+ *  1. Input CSV 로드
+ *  2. Cycle 단위 Snapshot 생성
+ *  3. 각 Fault Diagnostic Function 실행
+ *  4. Fault 상태 결과 기록
  *
  *
  *  Arguments
- *      argv[1] : Input CSV File Path
+ *      argv[1] : Input CSV File Path (.log : candump, .asc : Vector ASC CAN 로그, 이진 Snapshot 로그 자동 판별)
  *      argv[2] : Result CSV File Path
  *
+ *  Options (argv[3] ~)
+ *      --cache[=<path>] : 증분 진단 (기본 캐시 경로 : <Result CSV>.cache)
+ *      --parallel[=N]   : 구간 병렬 진단 (기본 스레드 수 : CPU 개수)
+ *      --pipeline       : 입력/진단/출력 3단계 스레드 파이프라인 진단
+ *      --can            : argv[1]을 SocketCAN 인터페이스(예 : vcan0)로 실시간 수신 진단
+ *      --cycles=N       : --can / --rt 모드에서 N Cycle 진단 후 종료 (기본 : Ctrl+C / 로그 끝까지)
+ *      --dbc=<file>     : CAN 신호 정의 DBC 파일 (기본 : 내장 OBC 신호 정의)
+ *      --realtime       : CAN 로그를 원래 시각 간격대로 재생 (기본 : 최대 속도)
+ *      --rt[=us]        : 주기 타이머로 1 Cycle씩 실행, jitter/실행 시간/deadline 측정 (기본 10000 us, Linux)
+ *      --rt-prio=N      : --rt 모드 SCHED_FIFO 우선순위 (mlockall 포함)
+ *      --rt-cpu=N       : --rt 모드 실행 CPU 고정
+ *      --inject=<file>  : 주입 스크립트 변형별 진단 결과 요약을 Result CSV 에 기록 (입력 1회 읽기)
+ *      --inject-results=<prefix> : --inject 변형별 Cycle 결과 CSV 기록 (<prefix><variant>.csv)
+ *      --skip-idle      : 변경 기반 진단 (입력 필드 변화 없고 상태 고정인 진단 함수 생략, 생략 횟수 출력, 직렬 진단)
+ *      --schedule       : 다중 주기 진단 (schedule.c 고장별 주기 / 위상, 직렬 CSV / --rt 모드)
+ *      --freeze[=N,M]   : 고장 확정 전 N / 후 M Cycle 입력을 <Result CSV>.freeze.csv 에 기록 (기본 32,16, 직렬 진단)
+ *      --dtc=<file>     : 영구 고장 기억(DTC) 파일, 실행 간 래치 / 발생 횟수 / aging · healing 유지 (직렬 진단)
+ *      --shm[=name]     : Cycle 마다 최신 고장 상태 / 주요 신호를 POSIX 공유 메모리에 seqlock 으로 게시 (직렬 / --rt / --can)
+ *      --metrics-port=N : 127.0.0.1:N 에서 Prometheus text 지표 게시 (GET /metrics, 직렬 / --pipeline / --rt / --can)
+ *      --metrics-file=<path> : Prometheus textfile 주기 기록 (tmp 기록 후 rename, 종료 시 마지막 값)
+ *      --metrics-interval=ms : --metrics-file 기록 주기 (기본 1000 ms)
+ *      --events=<file>  : 고장 상태 전이를 이진 이벤트 로그로 비동기 기록 (스레드별 링 + 배출 스레드, 직렬 / --rt / --can)
+ *
+ *      실행 모드(--cache / --parallel / --pipeline / --rt / --can / --inject)는 하나만 지정 가능,
+ *      CAN 로그 / .snap 입력은 자체 재생 경로로 진단 (.snap 은 --inject 지원)
+ *
+ *  Tools (argv[1])
+ *      --wcet [--seqs=N] [--seed=N] [--cold=N] [--evict=MB] [--out=<csv>]
+ *                       : 진단 1 Cycle 최악 실행 시간 탐색 (분기 커버리지 : OBC_BRANCH_COVERAGE 빌드)
+ *      --bench [--size=MB] [--seed=N] [--reps=N] [--json=<path>|-] [--out=<csv>]
+ *                       : 합성 충전 세션 입력으로 파싱/진단/출력/전체/재생(InputSnapshot / PackedLog) 처리량 측정 (행당 tick, float / OBC_FIXED_POINT 빌드 비교)
+ *      --gen <output> [--scenario=<file>] [--rows=N] [--seed=N] [--format=csv|snap]
+ *                       : 시나리오 기반 입력 로그 생성 (CSV / .snap 이진 Snapshot 로그)
+ *      --sim [--cycles=N] [--seed=N] [--workers=N] [--event-rate=P] [--trace=<csv>]
+ *                       : 충전 시퀀스 제어기(example.c OBC_Sequence) + 진단 엔진 폐루프 시뮬레이션
+ *      --campaign [--sessions=N] [--seed=N] [--workers=N] [--out=<csv>] [--hist=<csv>]
+ *                       : 세션별 외란 주입 Monte Carlo 캠페인 (검출 지연 / 오확정 / 래치 통계)
+ *      --equiv [input.csv ...] [--random=N] [--fuzz=N] [--rows=N] [--seed=N] [--engine=a,b] [--work=<prefix>] [--out=<prefix>]
+ *                       : 기준 직렬 경로와 다른 진단 경로(context / changed / packed / parallel / pipeline / cache / snap / inject) 결과 비교
+ *      --regress [manifest] [--workers=N] [--update]
+ *                       : 입력 CSV 별 기대 결과(golden/)와 Cycle 단위 비교, 첫 불일치 행 / 고장 코드 출력
+ *      --status [name] [--watch=ms] [--count=N]
+ *                       : --shm 으로 게시 중인 엔진 상태 읽기 (seqlock 일관 사본)
+ *      --events <file> [--code=0xNN] [--limit=N]
+ *                       : --events 이진 이벤트 로그를 텍스트로 출력 (누락 레코드 / 고장별 전이 요약)
+ *
  *  Design Responsibility
  *  - Fault Diagnostic Logic Design
- *  - Fault State Machine 
- *  - Diagnostic Engine Architecture   
+ *  - Fault State Machine 정의
+ *  - Diagnostic Engine Architecture 설계 및 구현
  *
  * ============================================================================ */
 
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "fault.h"
+#include "output.h"
+#include "result_cache.h"
+#include "fault_parallel.h"
+#include "pipeline.h"
+#include "rt_task.h"
+#include "can_ingest.h"
+#include "can_log.h"
+#include "osal.h"
+#include "wcet.h"
+#include "bench.h"
+#include "scenario.h"
+#include "snap_log.h"
+#include "inject.h"
+#include "sim.h"
+#include "campaign.h"
+#include "equiv.h"
+#include "regress.h"
+#include "schedule.h"
+#include "freeze.h"
+#include "dtc.h"
+#include "shm_status.h"
+#include "metrics.h"
+#include "event_log.h"
 
 int main(int argc, char* argv[])
 {
+    /* ------------------------------
+     * 보조 도구 (argv[1])
+     * ------------------------------ */
+    if (argc >= 2 && strcmp(argv[1], "--wcet") == 0)
+        return Wcet_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--bench") == 0)
+        return Bench_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--gen") == 0)
+        return Scenario_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--sim") == 0)
+        return Sim_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--campaign") == 0)
+        return Campaign_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--equiv") == 0)
+        return Equiv_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--regress") == 0)
+        return Regress_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--status") == 0)
+        return ShmStatus_Main(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "--events") == 0)
+        return EventLog_Main(argc, argv);
+
     /* ------------------------------
      * Argument validation
      * ------------------------------ */
     if (argc < 3)
     {
-        printf("ERROR: Է ϰ   Էµ ʾҽϴ.\n");
+        printf("ERROR: 입력 파일과 결과 파일이 입력되지 않았습니다.\n");
         return 1;
     }
 
@@ -58,6 +151,609 @@ int main(int argc, char* argv[])
 	printf("Input File   : %s\n", input_file);
 	printf("Result File  : %s\n", result_file);
 
+    /* ------------------------------
+     * Options
+     * ------------------------------ */
+    const char* cache_file = NULL;
+    char default_cache[1024];
+    int parallel_threads = -1;      // -1 : 직렬 진단, 0 : CPU 개수
+    int pipelined = 0;
+    int can_live = 0;
+    CanIngestOptions can_opt = { 0 };
+    const char* dbc_file = NULL;
+    CanLogOptions log_opt = { 0 };
+    RtOptions rt_opt = { 0 };
+    int rt_mode = 0;
+    const char* inject_file = NULL;
+    const char* inject_results = NULL;
+    int skip_idle = 0;
+    FaultIdle idle;
+    int schedule = 0;
+    uint64_t tick = 0;
+    uint64_t runs = 0;
+    uint64_t rows = 0;
+    int freeze = 0;
+    int freeze_pre = 32;
+    int freeze_post = 16;
+    FreezeRecorder* recorder = NULL;
+    FILE* freeze_out = NULL;
+    const char* dtc_file = NULL;
+    DtcStore dtc;
+    const char* shm_name = NULL;
+    ShmPublisher shm;
+    int metrics_port = 0;
+    const char* metrics_file = NULL;
+    uint32_t metrics_interval = METRICS_INTERVAL_MS;
+    static Metrics metrics;
+    Metrics* mx = NULL;
+    MetricsThread* mt = NULL;
+    const char* events_file = NULL;
+    static EventLog events;
+    EventWriter* ew = NULL;
+
+    rt_opt.period_us = 10000;
+    rt_opt.cpu = -1;
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--cache") == 0)
+        {
+            snprintf(default_cache, sizeof(default_cache), "%s.cache", result_file);
+            cache_file = default_cache;
+        }
+        else if (strncmp(argv[i], "--cache=", 8) == 0)
+        {
+            cache_file = argv[i] + 8;
+        }
+        else if (strcmp(argv[i], "--parallel") == 0)
+        {
+            parallel_threads = 0;
+        }
+        else if (strncmp(argv[i], "--parallel=", 11) == 0)
+        {
+            parallel_threads = atoi(argv[i] + 11);
+        }
+        else if (strcmp(argv[i], "--pipeline") == 0)
+        {
+            pipelined = 1;
+        }
+        else if (strcmp(argv[i], "--can") == 0)
+        {
+            can_live = 1;
+        }
+        else if (strncmp(argv[i], "--cycles=", 9) == 0)
+        {
+            can_opt.cycles = strtoull(argv[i] + 9, NULL, 10);
+            rt_opt.cycles = can_opt.cycles;
+        }
+        else if (strcmp(argv[i], "--rt") == 0)
+        {
+            rt_mode = 1;
+        }
+        else if (strncmp(argv[i], "--rt=", 5) == 0)
+        {
+            rt_mode = 1;
+            rt_opt.period_us = (uint32_t)strtoul(argv[i] + 5, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--rt-prio=", 10) == 0)
+        {
+            rt_opt.priority = atoi(argv[i] + 10);
+        }
+        else if (strncmp(argv[i], "--rt-cpu=", 9) == 0)
+        {
+            rt_opt.cpu = atoi(argv[i] + 9);
+        }
+        else if (strcmp(argv[i], "--realtime") == 0)
+        {
+            log_opt.realtime = 1;
+        }
+        else if (strncmp(argv[i], "--dbc=", 6) == 0)
+        {
+            dbc_file = argv[i] + 6;
+        }
+        else if (strncmp(argv[i], "--inject=", 9) == 0)
+        {
+            inject_file = argv[i] + 9;
+        }
+        else if (strncmp(argv[i], "--inject-results=", 17) == 0)
+        {
+            inject_results = argv[i] + 17;
+        }
+        else if (strcmp(argv[i], "--skip-idle") == 0)
+        {
+            skip_idle = 1;
+        }
+        else if (strcmp(argv[i], "--schedule") == 0)
+        {
+            schedule = 1;
+            rt_opt.schedule = 1;
+        }
+        else if (strcmp(argv[i], "--freeze") == 0)
+        {
+            freeze = 1;
+        }
+        else if (strcmp(argv[i], "--shm") == 0)
+        {
+            shm_name = SHM_STATUS_DEFAULT;
+        }
+        else if (strncmp(argv[i], "--shm=", 6) == 0)
+        {
+            shm_name = argv[i] + 6;
+        }
+        else if (strncmp(argv[i], "--metrics-port=", 15) == 0)
+        {
+            metrics_port = atoi(argv[i] + 15);
+            if (metrics_port <= 0 || metrics_port > 65535)
+            {
+                printf("ERROR: --metrics-port=N expects 1 <= N <= 65535 : %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--metrics-file=", 15) == 0)
+        {
+            metrics_file = argv[i] + 15;
+        }
+        else if (strncmp(argv[i], "--metrics-interval=", 19) == 0)
+        {
+            metrics_interval = (uint32_t)strtoul(argv[i] + 19, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--events=", 9) == 0)
+        {
+            events_file = argv[i] + 9;
+        }
+        else if (strncmp(argv[i], "--dtc=", 6) == 0)
+        {
+            dtc_file = argv[i] + 6;
+        }
+        else if (strncmp(argv[i], "--freeze=", 9) == 0)
+        {
+            freeze = 1;
+            if (sscanf(argv[i] + 9, "%d,%d", &freeze_pre, &freeze_post) != 2 ||
+                freeze_pre < 0 || freeze_pre > FREEZE_PRE_MAX || freeze_post < 0 || freeze_post > FREEZE_POST_MAX)
+            {
+                printf("ERROR: --freeze=N,M expects 0 <= N <= %d, 0 <= M <= %d : %s\n",
+                    FREEZE_PRE_MAX, FREEZE_POST_MAX, argv[i]);
+                return 1;
+            }
+        }
+        else
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    /* ------------------------------
+     * CAN signal definition (--dbc)
+     * ------------------------------ */
+    CanLogFormat log_format = can_live ? CAN_LOG_NONE : CanLog_DetectFormat(input_file);
+    CanDecodeTable* dbc = NULL;
+    int snap_input = !can_live && SnapLog_Detect(input_file);
+
+    /* 실행 모드는 하나만 지정 (if 순서로 하나를 조용히 고르지 않음) */
+    if ((cache_file != NULL) + (parallel_threads >= 0) + (pipelined != 0) + (rt_mode != 0) +
+        (can_live != 0) + (inject_file != NULL) > 1)
+    {
+        printf("ERROR: --cache, --parallel, --pipeline, --rt, --can and --inject cannot be combined\n");
+        return 1;
+    }
+
+    /* CAN 로그 / .snap 입력은 자체 재생 경로로 진단 (.snap 은 --inject 만 지원) */
+    if ((log_format != CAN_LOG_NONE && (cache_file || parallel_threads >= 0 || pipelined || rt_mode || inject_file)) ||
+        (snap_input && (cache_file || parallel_threads >= 0 || pipelined || rt_mode)))
+    {
+        printf("ERROR: --cache, --parallel, --pipeline and --rt are supported only for CSV input (--inject : CSV / .snap)\n");
+        return 1;
+    }
+
+    if (schedule && (skip_idle || cache_file || parallel_threads >= 0 || pipelined || can_live || inject_file ||
+        log_format != CAN_LOG_NONE || snap_input))
+    {
+        printf("ERROR: --schedule is supported only for serial CSV and --rt diagnosis\n");
+        return 1;
+    }
+
+    if (skip_idle && (cache_file || parallel_threads >= 0 || pipelined || can_live || rt_mode ||
+        inject_file || log_format != CAN_LOG_NONE || snap_input))
+    {
+        printf("ERROR: --skip-idle is supported only for serial CSV diagnosis\n");
+        return 1;
+    }
+
+    if ((freeze || dtc_file) && (cache_file || parallel_threads >= 0 || pipelined || can_live || rt_mode ||
+        inject_file || log_format != CAN_LOG_NONE || SnapLog_Detect(input_file)))
+    {
+        printf("ERROR: --freeze / --dtc are supported only for serial CSV diagnosis\n");
+        return 1;
+    }
+
+    if (shm_name && (cache_file || parallel_threads >= 0 || pipelined || inject_file ||
+        (!can_live && !rt_mode && (log_format != CAN_LOG_NONE || SnapLog_Detect(input_file)))))
+    {
+        printf("ERROR: --shm is supported only for serial CSV, --rt and --can diagnosis\n");
+        return 1;
+    }
+
+    if ((metrics_port || metrics_file) && (cache_file || parallel_threads >= 0 || inject_file ||
+        (!can_live && !rt_mode && (log_format != CAN_LOG_NONE || SnapLog_Detect(input_file)))))
+    {
+        printf("ERROR: --metrics-port / --metrics-file are supported only for serial CSV, --pipeline, --rt and --can diagnosis\n");
+        return 1;
+    }
+
+    if (events_file && (cache_file || parallel_threads >= 0 || pipelined || inject_file ||
+        (!can_live && !rt_mode && (log_format != CAN_LOG_NONE || SnapLog_Detect(input_file)))))
+    {
+        printf("ERROR: --events is supported only for serial CSV, --rt and --can diagnosis\n");
+        return 1;
+    }
+
+    /* ------------------------------
+     * Fault transition event log (--events) : 배출 스레드 시작
+     * ------------------------------ */
+    if (events_file)
+    {
+        if (!EventLog_Open(&events, events_file))
+            return 1;
+        printf("Event Log : %s (%u byte records)\n", events_file, (unsigned)sizeof(EventRecord));
+
+        /* --rt / --can : 진단 스레드 = 현재 스레드, 기본 엔진 초기 상태 */
+        if (rt_mode || can_live)
+        {
+            FaultContext initial;
+
+            Fault_InitContext(&initial);
+            can_opt.events = EventLog_AddWriter(&events, &initial);
+            rt_opt.events = can_opt.events;
+            if (!can_opt.events)
+                return 1;
+        }
+    }
+
+    /* ------------------------------
+     * Metrics exposition (--metrics-port / --metrics-file)
+     * ------------------------------ */
+    if (metrics_port || metrics_file)
+    {
+        if (!Metrics_Start(&metrics, metrics_port, metrics_file, metrics_interval))
+            return 1;
+        mx = &metrics;
+        if (metrics_port)
+            printf("Metrics : http://127.0.0.1:%d/metrics\n", metrics_port);
+        if (metrics_file)
+            printf("Metrics File : %s (every %u ms)\n", metrics_file, (unsigned)metrics.interval_ms);
+
+        /* --rt / --can : 진단 스레드 = 현재 스레드 */
+        if (rt_mode || can_live)
+        {
+            can_opt.metrics = Metrics_AddThread(mx, NULL, 0, 0);
+            rt_opt.metrics = can_opt.metrics;
+        }
+    }
+
+    /* ------------------------------
+     * Shared-memory status (--shm)
+     * ------------------------------ */
+    if (shm_name)
+    {
+        if (!ShmStatus_Create(&shm, shm_name))
+        {
+            CanDbc_Free(dbc);
+            return 1;
+        }
+        printf("Shared memory : %s (%u bytes, seqlock)\n", shm_name, (unsigned)sizeof(ShmStatusSegment));
+        can_opt.shm = &shm;
+        rt_opt.shm = &shm;
+    }
+
+    if (dbc_file && (can_live || log_format != CAN_LOG_NONE))
+    {
+        dbc = CanDbc_Load(dbc_file);
+        if (!dbc)
+            return 1;
+        printf("DBC : %s (%d messages, %d signals)\n", dbc_file,
+            CanDbc_MessageCount(dbc), CanDbc_SignalCount(dbc));
+    }
+
+    /* ------------------------------
+     * Live SocketCAN diagnosis
+     * ------------------------------ */
+    if (can_live)
+    {
+        CanIngestStats stats;
+        FILE* can_out = fopen(result_file, "w");
+
+        if (!can_out)
+        {
+            printf("ERROR: Failed to open result CSV : %s\n", result_file);
+            CanDbc_Free(dbc);
+            return 1;
+        }
+
+        can_opt.dbc = dbc;
+        Output_WriteHeader(can_out);
+        int rc = CanIngest_RunSocketCan(input_file, can_out, &can_opt, &stats);
+        fclose(can_out);
+        if (shm_name)
+            ShmStatus_Close(&shm);
+        if (mx)
+            Metrics_Stop(mx);
+        if (events_file && !EventLog_Close(&events))
+            rc = 1;
+        CanDbc_Free(dbc);
+
+        printf("CAN : %llu frames, %llu cycles\n",
+            (unsigned long long)stats.frames, (unsigned long long)stats.cycles);
+        if (stats.cycles > 0)
+            printf("Latency (last frame -> fault state) : min %.1f us, avg %.1f us, max %.1f us\n",
+                stats.latency_min_ns / 1e3,
+                (double)stats.latency_sum_ns / (double)stats.cycles / 1e3,
+                stats.latency_max_ns / 1e3);
+        if (events_file)
+            printf("Events : %llu records, %llu dropped\n", (unsigned long long)events.records,
+                (unsigned long long)events.dropped);
+
+        if (rc != 0)
+            return 1;
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * CAN log replay (candump .log / Vector .asc)
+     * ------------------------------ */
+    if (log_format != CAN_LOG_NONE)
+    {
+        CanLogStats stats;
+        FILE* log_out = fopen(result_file, "w");
+
+        if (!log_out)
+        {
+            printf("ERROR: Failed to open result CSV : %s\n", result_file);
+            CanDbc_Free(dbc);
+            return 1;
+        }
+
+        log_opt.dbc = dbc;
+        Output_WriteHeader(log_out);
+
+        uint64_t t0 = Osal_NowNs();
+        int rc = CanLog_Run(input_file, log_format, log_out, &log_opt, &stats);
+        uint64_t t1 = Osal_NowNs();
+        fclose(log_out);
+        CanDbc_Free(dbc);
+
+        printf("CAN log : %llu lines, %llu frames (%llu unknown, %llu skipped lines), %llu cycles, %.3f ms\n",
+            (unsigned long long)stats.lines, (unsigned long long)stats.frames,
+            (unsigned long long)stats.unknown, (unsigned long long)stats.skipped,
+            (unsigned long long)stats.cycles, (double)(t1 - t0) / 1e6);
+
+        if (rc != 0)
+            return 1;
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * Streaming fault injection (variants of one log in a single pass)
+     * ------------------------------ */
+    if (inject_file)
+    {
+        InjectScript* script = Inject_Load(inject_file);
+        InjectResult* results;
+        FILE* summary;
+
+        if (!script)
+            return 1;
+
+        results = (InjectResult*)malloc((size_t)(Inject_VariantCount(script) + 1) * sizeof(*results));
+        summary = fopen(result_file, "w");
+        if (!results || !summary)
+        {
+            printf("ERROR: Failed to open result CSV : %s\n", result_file);
+            if (summary)
+                fclose(summary);
+            free(results);
+            Inject_Free(script);
+            return 1;
+        }
+
+        uint64_t t0 = Osal_NowNs();
+        int rc = Inject_Run(input_file, script, inject_results, results);
+        uint64_t t1 = Osal_NowNs();
+
+        if (rc == 0)
+        {
+            Inject_WriteSummary(summary, script, results);
+            printf("Inject : %d variants, %llu cycles, %.3f ms\n", Inject_VariantCount(script),
+                (unsigned long long)results[0].rows, (double)(t1 - t0) / 1e6);
+            Inject_PrintSummary(stdout, script, results);
+        }
+        fclose(summary);
+        free(results);
+        Inject_Free(script);
+
+        if (rc != 0)
+            return 1;
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * Binary snapshot log (.snap, --gen 출력)
+     * ------------------------------ */
+    if (!can_live && !rt_mode && SnapLog_Detect(input_file))
+    {
+        uint64_t cycles;
+        FILE* snap_out = fopen(result_file, "w");
+
+        if (!snap_out)
+        {
+            printf("ERROR: Failed to open result CSV : %s\n", result_file);
+            return 1;
+        }
+
+        Output_WriteHeader(snap_out);
+
+        uint64_t t0 = Osal_NowNs();
+        int rc = SnapLog_Run(input_file, snap_out, &cycles);
+        uint64_t t1 = Osal_NowNs();
+        fclose(snap_out);
+
+        printf("Snapshot log : %llu cycles, %.3f ms\n",
+            (unsigned long long)cycles, (double)(t1 - t0) / 1e6);
+
+        if (rc != 0)
+            return 1;
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * Real-time periodic execution
+     * ------------------------------ */
+    if (rt_mode)
+    {
+        RtStats stats;
+        char hist_file[1024];
+        FILE* hist_out;
+
+        printf("Real-time : period %u us, priority %d, cpu %d\n",
+            (unsigned)rt_opt.period_us, rt_opt.priority, rt_opt.cpu);
+
+        int rc = Rt_Run(input_file, result_file, &rt_opt, &stats);
+
+        if (shm_name)
+            ShmStatus_Close(&shm);
+        if (mx)
+            Metrics_Stop(mx);
+        if (events_file && !EventLog_Close(&events))
+            rc = 1;
+        if (rc != 0)
+            return 1;
+
+        printf("Real-time : %llu cycles, %llu deadline misses, %llu overruns (SCHED_FIFO %s, pinned %s, mlock %s)\n",
+            (unsigned long long)stats.cycles, (unsigned long long)stats.deadline_miss,
+            (unsigned long long)stats.overruns,
+            stats.fifo ? "on" : "off", stats.pinned ? "on" : "off", stats.locked ? "on" : "off");
+        if (rt_opt.schedule)
+            printf("Schedule : %llu diagnoser runs (%.2f per cycle)\n", (unsigned long long)stats.runs,
+                stats.cycles ? (double)stats.runs / (double)stats.cycles : 0.0);
+        if (events_file)
+            printf("Events : %llu records, %llu dropped\n", (unsigned long long)events.records,
+                (unsigned long long)events.dropped);
+        Hist_PrintSummary(stdout, "jitter", &stats.jitter);
+        Hist_PrintSummary(stdout, "exec", &stats.exec);
+        Hist_PrintSummary(stdout, "response", &stats.response);
+
+        /* 실행별 히스토그램 기록 */
+        snprintf(hist_file, sizeof(hist_file), "%s.rt_hist.csv", result_file);
+        hist_out = fopen(hist_file, "w");
+        if (hist_out)
+        {
+            fprintf(hist_out, "metric,low_ns,high_ns,count\n");
+            Hist_WriteCsv(hist_out, "jitter", &stats.jitter);
+            Hist_WriteCsv(hist_out, "exec", &stats.exec);
+            Hist_WriteCsv(hist_out, "response", &stats.response);
+            fclose(hist_out);
+            printf("Histogram File : %s\n", hist_file);
+        }
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * Incremental diagnosis (append-only log)
+     * ------------------------------ */
+    if (cache_file)
+    {
+        ResultCacheStats stats;
+
+        printf("Cache File   : %s\n", cache_file);
+
+        if (ResultCache_Run(input_file, result_file, cache_file, &stats) != 0)
+            return 1;
+
+        if (stats.resumed)
+            printf("Cache resumed : %llu bytes skipped, %llu new cycles (total %llu)\n",
+                (unsigned long long)stats.input_skipped,
+                (unsigned long long)stats.rows_new,
+                (unsigned long long)stats.rows_total);
+        else
+            printf("Cache miss : full diagnosis, %llu cycles\n",
+                (unsigned long long)stats.rows_total);
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * Parallel segmented diagnosis
+     * ------------------------------ */
+    if (parallel_threads >= 0)
+    {
+        ParallelStats stats;
+        uint64_t reconciled = 0;
+
+        if (Parallel_Run(input_file, result_file, parallel_threads, &stats) != 0)
+            return 1;
+
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+            reconciled += stats.reconciled[code];
+
+        printf("Parallel : %d threads, %llu cycles, %llu windows\n", stats.threads,
+            (unsigned long long)stats.rows, (unsigned long long)stats.windows);
+        printf("  parse+diagnose %.3f ms, reconcile %.3f ms (%llu fault-cycles re-run), write %.3f ms\n",
+            stats.parse_diag_ns / 1e6, stats.reconcile_ns / 1e6,
+            (unsigned long long)reconciled, stats.write_ns / 1e6);
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
+
+    /* ------------------------------
+     * Pipelined diagnosis (ingest / diagnose / output threads)
+     * ------------------------------ */
+    if (pipelined)
+    {
+        PipelineStats stats;
+        uint64_t busy_ns[PIPE_STAGE_COUNT];
+        int slowest = PIPE_INGEST;
+
+        int rc = Pipeline_Run(input_file, result_file, &stats, mx);
+
+        if (mx)
+            Metrics_Stop(mx);
+        if (rc != 0)
+            return 1;
+
+        printf("Pipeline : %llu cycles, %.3f ms\n",
+            (unsigned long long)stats.rows, stats.total_ns / 1e6);
+
+        for (int k = 0; k < PIPE_STAGE_COUNT; k++)
+        {
+            const PipelineStageStats* st = &stats.stage[k];
+            double total = st->total_ns ? (double)st->total_ns : 1.0;
+
+            busy_ns[k] = st->total_ns - st->starved_ns - st->blocked_ns;
+            if (busy_ns[k] > busy_ns[slowest])
+                slowest = k;
+
+            printf("  %-8s : busy %5.1f %%, starved %5.1f %% (%llu waits), blocked %5.1f %% (%llu waits)\n",
+                Pipeline_StageName((PipelineStage)k), busy_ns[k] / total * 100.0,
+                st->starved_ns / total * 100.0, (unsigned long long)st->starved_waits,
+                st->blocked_ns / total * 100.0, (unsigned long long)st->blocked_waits);
+        }
+        printf("  bottleneck : %s\n", Pipeline_StageName((PipelineStage)slowest));
+
+        printf("Fault diagnosis completed successfully.\n");
+        return 0;
+    }
 
     /* ------------------------------
      * File open
@@ -83,16 +779,71 @@ int main(int argc, char* argv[])
     /* ------------------------------
      * CSV Header
      * ------------------------------ */
-    fprintf(out,
-        "Cycle,"
-        "F_0x01,F_0x02,F_0x03,F_0x04,F_0x05,F_0x06,"
-        "F_0x07,F_0x08,F_0x09,F_0x0A,F_0x0B,F_0x0C\n"
-    );
+    Output_WriteHeader(out);
 
     /* ------------------------------
      * Fault system initialization
      * ------------------------------ */
     Fault_Init();
+    Fault_IdleInit(&idle);
+    if (schedule)
+        Schedule_ScaleCalibration(&Fault_GetContext()->cal);
+
+    /* ------------------------------
+     * Persistent DTC memory (--dtc) : 이전 실행 래치 복원
+     * ------------------------------ */
+    if (dtc_file)
+    {
+        if (!Dtc_Open(&dtc, dtc_file))
+        {
+            fclose(fp);
+            fclose(out);
+            return 1;
+        }
+        Dtc_Restore(&dtc, Fault_GetContext());
+        printf("DTC : %s (%llu records loaded%s)\n", dtc_file, (unsigned long long)dtc.loaded,
+            dtc.torn ? ", damaged tail discarded" : "");
+    }
+
+    /* ------------------------------
+     * Freeze-frame recorder (--freeze)
+     * ------------------------------ */
+    if (freeze)
+    {
+        char freeze_file[1024];
+
+        snprintf(freeze_file, sizeof(freeze_file), "%s.freeze.csv", result_file);
+        recorder = (FreezeRecorder*)malloc(sizeof(*recorder));
+        freeze_out = fopen(freeze_file, "w");
+        if (!recorder || !freeze_out)
+        {
+            printf("ERROR: Failed to open freeze-frame CSV : %s\n", freeze_file);
+            if (freeze_out)
+                fclose(freeze_out);
+            free(recorder);
+            fclose(fp);
+            fclose(out);
+            return 1;
+        }
+        Freeze_Init(recorder, freeze_pre, freeze_post, Freeze_CsvSink, freeze_out);
+        Freeze_WriteHeader(freeze_out);
+    }
+
+    /* ------------------------------
+     * Metrics (--metrics-port / --metrics-file) : DTC 복원 상태 기준
+     * ------------------------------ */
+    if (mx)
+        mt = Metrics_AddThread(mx, NULL, 0, Fault_PackStatus(Fault_GetContext()));
+    if (events_file)
+    {
+        ew = EventLog_AddWriter(&events, Fault_GetContext());
+        if (!ew)
+        {
+            fclose(fp);
+            fclose(out);
+            return 1;
+        }
+    }
 
     /* ------------------------------
      * Main diagnostic loop
@@ -101,25 +852,46 @@ int main(int argc, char* argv[])
     while (Input_ReadLine(fp, &in))
     {
         /* 1. Fault diagnosis (decision only) */
-        Fault_Diagnose(&in);
+        if (skip_idle)
+            Fault_DiagnoseChanged(Fault_GetContext(), &idle, &in);
+        else if (schedule)
+            runs += (uint64_t)Schedule_Diagnose(Fault_GetContext(), tick++, &in);
+        else
+            Fault_Diagnose(&in);
 
         /* 2. Write result */
-        fprintf(out, "%d", in.Cycle);
+        Output_WriteRow(out, in.Cycle, Fault_GetContext());
+
+        /* 3. Freeze-frame (확정 전후 입력) */
+        if (recorder)
+            Freeze_Step(recorder, &in, Fault_GetContext());
 
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_INPUT_OVERCURRENT));   // 0x01
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_INPUT_UNDERCURRENT));  // 0x02
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_PLUG));                // 0x03
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_RELAY));               // 0x04
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_BMS_STATE));           // 0x05
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_OVER_TEMP));           // 0x06
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_CAN));                 // 0x07
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_ISO));                 // 0x08
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_PAYMENT));             // 0x09
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_WDT));                 // 0x0A
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_SEQ_TIMEOUT));         // 0x0B
-        fprintf(out, ",%d", Fault_GetStatus(FAULT_TEMP_SENSOR));         // 0x0C
+        /* 4. DTC memory (변경 항목은 모아서 기록) */
+        if (dtc_file)
+            Dtc_Update(&dtc, Fault_GetContext(), in.Cycle);
 
-        fprintf(out, "\n");
+        /* 5. Shared-memory status (seqlock, 대기 없음) */
+        if (shm_name)
+            ShmStatus_Publish(&shm, &in, Fault_GetContext());
+
+        /* 6. Metrics (스레드 전용 카운터, 수집 스레드와 잠금 없음) */
+        if (mt)
+            Metrics_Row(mt, Fault_PackStatus(Fault_GetContext()));
+
+        /* 7. Event log (전이만 스레드 링에 기록, 파일 기록은 배출 스레드) */
+        if (ew)
+            EventLog_Step(ew, Fault_GetContext(), &in);
+
+        rows++;
+    }
+
+    /* 파싱 실패 줄에서 종료 (EOF 와 구분) */
+    if (Input_ParseFailed())
+    {
+        printf("WARNING: Input parse failed at data line %llu, diagnosis stopped there\n",
+            (unsigned long long)rows + 1);
+        if (mt)
+            Metrics_ParseError(mt);
     }
 
     /* ------------------------------
@@ -128,21 +900,65 @@ int main(int argc, char* argv[])
     fclose(fp);
     fclose(out);
 
-    printf("Fault diagnosis completed successfully.\n");
+    if (shm_name)
+        ShmStatus_Close(&shm);
+
+    if (mx)
+    {
+        Metrics_Stop(mx);
+        printf("Metrics : %llu scrapes, %llu file writes\n",
+            (unsigned long long)metrics.scrapes, (unsigned long long)metrics.writes);
+    }
+
+    if (events_file)
+    {
+        int ok = EventLog_Close(&events);
+
+        printf("Events : %llu records, %llu dropped\n", (unsigned long long)events.records,
+            (unsigned long long)events.dropped);
+        if (!ok)
+            return 1;
+    }
+
+    if (recorder)
+    {
+        Freeze_Flush(recorder);
+        fclose(freeze_out);
+        printf("Freeze : %llu frames (%d pre / %d post cycles), %llu overlapped confirmations\n",
+            (unsigned long long)recorder->frames, freeze_pre, freeze_post,
+            (unsigned long long)recorder->overlapped);
+        free(recorder);
+    }
+
+    if (dtc_file)
+    {
+        int ok = Dtc_Close(&dtc);
+
+        printf("DTC : %llu records in %llu flushes (%llu compactions)\n", (unsigned long long)dtc.records,
+            (unsigned long long)dtc.flushes, (unsigned long long)dtc.compactions);
+        Dtc_Print(stdout, &dtc);
+        if (!ok)
+            return 1;
+    }
+
+    if (skip_idle)
+    {
+        uint64_t total = idle.evaluated + idle.skipped;
+
+        printf("Skip idle : %llu of %llu diagnoser evaluations skipped (%.1f %%)\n",
+            (unsigned long long)idle.skipped, (unsigned long long)total,
+            total ? (double)idle.skipped * 100.0 / (double)total : 0.0);
+    }
+
+    if (schedule)
+    {
+        uint64_t total = tick * (FAULT_MAX - 1);
 
-    //  ׽Ʈ ڵԴϴ. 
-    // ϳ  Ű,  test_case   µ˴ϴ.
-    /*Test_Fault_0x01("Unit_Test/fault_0x01_test.csv");*/
-    /*Test_Fault_0x02("Unit_Test/fault_0x02_test.csv");*/
-    /*Test_Fault_0x03("Unit_Test/fault_0x03_test.csv");*/
-    /*Test_Fault_0x04("Unit_Test/fault_0x04_test.csv");*/
-    /*Test_Fault_0x05("Unit_Test/fault_0x05_test.csv");*/
-    /*Test_Fault_0x06("Unit_Test/fault_0x06_test.csv");*/
-    /*Test_Fault_0x07("Unit_Test/fault_0x07_test.csv");*/
-    /*Test_Fault_0x08("Unit_Test/fault_0x08_test.csv");*/
-    /*Test_Fault_0x09("Unit_Test/fault_0x09_test.csv");*/
-    /*Test_Fault_0x0A("Unit_Test/fault_0x0A_test.csv");*/
-    /*Test_Fault_0x0B("Unit_Test/fault_0x0B_test.csv");*/
-    /*Test_Fault_0x0C("Unit_Test/fault_0x0C_test.csv");*/
+        printf("Schedule : %llu of %llu diagnoser runs (%.1f %%, table %.2f runs/cycle)\n",
+            (unsigned long long)runs, (unsigned long long)total,
+            total ? (double)runs * 100.0 / (double)total : 0.0, Schedule_RunsPerCycle());
+    }
+
+    printf("Fault diagnosis completed successfully.\n");
     return 0;
 }
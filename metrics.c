@@ -0,0 +1,406 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "metrics.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#endif
+
+#define METRICS_BUF_MAX     16384u
+#define METRICS_POLL_MS     100         // 종료 요청 확인 주기
+#define METRICS_REQUEST_MAX 2048
+
+void Metrics_Confirm(MetricsThread* t, uint32_t rise)
+{
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if (rise & (2u << ((code - 1) * 2)))
+            OSAL_STORE_RELEASE(&t->confirms[code], t->confirms[code] + 1);
+    }
+}
+
+MetricsThread* Metrics_AddThread(Metrics* m, const char* queue, uint64_t queue_capacity, uint32_t status)
+{
+    MetricsThread* t;
+
+    if (!m || m->count >= METRICS_THREADS_MAX)
+        return NULL;
+
+    t = &m->thread[m->count];
+    memset(t, 0, sizeof(*t));
+    t->queue = queue;
+    t->queue_capacity = queue_capacity;
+    t->prev = status;
+    t->status = status;
+
+    /* 블록 초기화 후 게시 (수집 스레드는 count 까지만 읽음) */
+    OSAL_STORE_RELEASE(&m->count, m->count + 1);
+    return t;
+}
+
+/* buf 뒤에 이어 쓰기 (넘치면 잘라 냄) */
+static void Metrics_Append(char* buf, size_t size, size_t* len, const char* fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    if (*len + 1 >= size)
+        return;
+
+    va_start(ap, fmt);
+    n = vsnprintf(buf + *len, size - *len, fmt, ap);
+    va_end(ap);
+
+    if (n > 0)
+        *len += ((size_t)n < size - *len) ? (size_t)n : size - *len - 1;
+}
+
+size_t Metrics_Format(Metrics* m, char* buf, size_t size)
+{
+    uint64_t count = OSAL_LOAD_ACQUIRE(&m->count);
+    uint64_t rows = 0;
+    uint64_t parse_errors = 0;
+    uint64_t confirms[FAULT_MAX] = { 0 };
+    uint64_t status = 0;
+    uint64_t status_rows = 0;
+    uint64_t now = Osal_NowNs();
+    double rate = 0.0;
+    size_t len = 0;
+
+    /* 블록 합산 (상태 : 행을 가장 많이 진단한 블록) */
+    for (uint64_t k = 0; k < count; k++)
+    {
+        MetricsThread* t = &m->thread[k];
+        uint64_t r = OSAL_LOAD_ACQUIRE(&t->rows);
+
+        rows += r;
+        parse_errors += OSAL_LOAD_ACQUIRE(&t->parse_errors);
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+            confirms[code] += OSAL_LOAD_ACQUIRE(&t->confirms[code]);
+        if (r >= status_rows)
+        {
+            status_rows = r;
+            status = OSAL_LOAD_ACQUIRE(&t->status);
+        }
+    }
+
+    if (now > m->prev_ns && rows >= m->prev_rows)
+        rate = (double)(rows - m->prev_rows) * 1e9 / (double)(now - m->prev_ns);
+    m->prev_ns = now;
+    m->prev_rows = rows;
+
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_rows_total Diagnosed input rows (cycles).\n"
+        "# TYPE obc_rows_total counter\n"
+        "obc_rows_total %llu\n", (unsigned long long)rows);
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_rows_per_second Diagnosed rows per second since the previous exposition.\n"
+        "# TYPE obc_rows_per_second gauge\n"
+        "obc_rows_per_second %.1f\n", rate);
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_parse_errors_total Input lines that failed to parse (diagnosis of the log stops there).\n"
+        "# TYPE obc_parse_errors_total counter\n"
+        "obc_parse_errors_total %llu\n", (unsigned long long)parse_errors);
+
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_fault_confirms_total Transitions into CONFIRM per fault code.\n"
+        "# TYPE obc_fault_confirms_total counter\n");
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        Metrics_Append(buf, size, &len, "obc_fault_confirms_total{code=\"0x%02X\"} %llu\n",
+            code, (unsigned long long)confirms[code]);
+
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_fault_state Latest fault state per code (0 normal, 1 detect, 2 confirm).\n"
+        "# TYPE obc_fault_state gauge\n");
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        Metrics_Append(buf, size, &len, "obc_fault_state{code=\"0x%02X\"} %u\n",
+            code, (unsigned)((status >> ((code - 1) * 2)) & 0x3u));
+
+    for (uint64_t k = 0, first = 1; k < count; k++)
+    {
+        MetricsThread* t = &m->thread[k];
+
+        if (!t->queue)
+            continue;
+        if (first)
+        {
+            Metrics_Append(buf, size, &len,
+                "# HELP obc_queue_depth Elements waiting in a pipeline ring.\n"
+                "# TYPE obc_queue_depth gauge\n");
+            first = 0;
+        }
+        Metrics_Append(buf, size, &len, "obc_queue_depth{queue=\"%s\"} %llu\n",
+            t->queue, (unsigned long long)OSAL_LOAD_ACQUIRE(&t->queue_depth));
+    }
+    for (uint64_t k = 0, first = 1; k < count; k++)
+    {
+        const MetricsThread* t = &m->thread[k];
+
+        if (!t->queue)
+            continue;
+        if (first)
+        {
+            Metrics_Append(buf, size, &len,
+                "# HELP obc_queue_capacity Pipeline ring capacity.\n"
+                "# TYPE obc_queue_capacity gauge\n");
+            first = 0;
+        }
+        Metrics_Append(buf, size, &len, "obc_queue_capacity{queue=\"%s\"} %llu\n",
+            t->queue, (unsigned long long)t->queue_capacity);
+    }
+
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_uptime_seconds Seconds since the metrics exposition started.\n"
+        "# TYPE obc_uptime_seconds gauge\n"
+        "obc_uptime_seconds %.3f\n", (double)(now - m->start_ns) / 1e9);
+    Metrics_Append(buf, size, &len,
+        "# HELP obc_running 1 while the engine is diagnosing, 0 in the final textfile.\n"
+        "# TYPE obc_running gauge\n"
+        "obc_running %d\n", OSAL_LOAD_ACQUIRE(&m->stop) ? 0 : 1);
+    return len;
+}
+
+/* textfile 기록 : tmp 파일에 쓴 뒤 rename (수집기가 반쯤 쓴 파일을 읽지 않도록) */
+static int Metrics_WriteFile(Metrics* m, char* buf)
+{
+    char tmp[1024];
+    size_t len = Metrics_Format(m, buf, METRICS_BUF_MAX);
+    FILE* fp;
+    int ok;
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", m->file);
+    fp = fopen(tmp, "w");
+    if (!fp)
+        return 0;
+
+    ok = fwrite(buf, 1, len, fp) == len;
+    ok = (fclose(fp) == 0) && ok;
+#ifdef _WIN32
+    remove(m->file);            // Windows rename 은 기존 파일을 덮어쓰지 않음
+#endif
+    ok = ok && rename(tmp, m->file) == 0;
+    if (!ok)
+    {
+        remove(tmp);
+        return 0;
+    }
+    m->writes++;
+    return 1;
+}
+
+#ifndef _WIN32
+
+/* 요청 1개 처리 : 헤더 끝까지 읽고 GET /metrics (또는 /) 에 응답 */
+static void Metrics_Serve(Metrics* m, int fd, char* buf)
+{
+    char req[METRICS_REQUEST_MAX];
+    char head[256];
+    size_t got = 0;
+    size_t len = 0;
+    int code = 200;
+    struct timeval tv = { 1, 0 };
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    while (got < sizeof(req) - 1)
+    {
+        ssize_t n = recv(fd, req + got, sizeof(req) - 1 - got, 0);
+
+        if (n <= 0)
+            break;
+        got += (size_t)n;
+        req[got] = '\0';
+        if (strstr(req, "\r\n\r\n") || strstr(req, "\n\n"))
+            break;
+    }
+    req[got] = '\0';
+
+    if (strncmp(req, "GET ", 4) != 0)
+        code = 405;
+    else if (strncmp(req + 4, "/metrics", 8) != 0 && strncmp(req + 4, "/ ", 2) != 0)
+        code = 404;
+
+    if (code == 200)
+        len = Metrics_Format(m, buf, METRICS_BUF_MAX);
+
+    snprintf(head, sizeof(head),
+        "HTTP/1.0 %d %s\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: %llu\r\n"
+        "Connection: close\r\n\r\n",
+        code, code == 200 ? "OK" : code == 404 ? "Not Found" : "Method Not Allowed",
+        (unsigned long long)len);
+
+    if (send(fd, head, strlen(head), MSG_NOSIGNAL) > 0 && len > 0)
+    {
+        size_t sent = 0;
+
+        while (sent < len)
+        {
+            ssize_t n = send(fd, buf + sent, len - sent, MSG_NOSIGNAL);
+
+            if (n <= 0)
+                break;
+            sent += (size_t)n;
+        }
+    }
+    if (code == 200)
+        m->scrapes++;
+    close(fd);
+}
+
+static int Metrics_Listen(Metrics* m)
+{
+    struct sockaddr_in addr;
+    int one = 1;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        printf("ERROR: Failed to create metrics socket (%s)\n", strerror(errno));
+        return 0;
+    }
+
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);      // 로컬 전용
+    addr.sin_port = htons((uint16_t)m->port);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 8) != 0)
+    {
+        printf("ERROR: Failed to listen on metrics port 127.0.0.1:%d (%s)\n", m->port, strerror(errno));
+        close(fd);
+        return 0;
+    }
+
+    m->listen_fd = fd;
+    return 1;
+}
+
+static void Metrics_CloseListen(Metrics* m)
+{
+    if (m->listen_fd >= 0)
+        close(m->listen_fd);
+    m->listen_fd = -1;
+}
+
+/* 연결 대기 (최대 ms) : 연결 1개 처리 후 반환 */
+static void Metrics_Poll(Metrics* m, char* buf, int ms)
+{
+    struct pollfd pfd;
+
+    pfd.fd = m->listen_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    if (poll(&pfd, 1, ms) > 0 && (pfd.revents & POLLIN))
+    {
+        int fd = accept(m->listen_fd, NULL, NULL);
+
+        if (fd >= 0)
+            Metrics_Serve(m, fd, buf);
+    }
+}
+
+#else
+
+static int Metrics_Listen(Metrics* m)
+{
+    (void)m;
+    printf("ERROR: Metrics HTTP port is only supported on POSIX systems (use --metrics-file)\n");
+    return 0;
+}
+
+static void Metrics_CloseListen(Metrics* m)
+{
+    m->listen_fd = -1;
+}
+
+static void Metrics_Poll(Metrics* m, char* buf, int ms)
+{
+    (void)m;
+    (void)buf;
+    Osal_SleepNs((uint64_t)ms * 1000000ull);
+}
+
+#endif
+
+/* 수집 스레드 : HTTP 요청 응답 + interval 마다 textfile */
+static void Metrics_Server(void* arg)
+{
+    Metrics* m = (Metrics*)arg;
+    static char buf[METRICS_BUF_MAX];
+    uint64_t interval = (uint64_t)m->interval_ms * 1000000ull;
+    uint64_t next = Osal_NowNs();
+
+    while (!OSAL_LOAD_ACQUIRE(&m->stop))
+    {
+        uint64_t now = Osal_NowNs();
+        int wait_ms = METRICS_POLL_MS;
+
+        if (m->file && now >= next)
+        {
+            Metrics_WriteFile(m, buf);
+            next = now + interval;
+        }
+        if (m->file && next - now < (uint64_t)wait_ms * 1000000ull)
+            wait_ms = (int)((next - now) / 1000000ull) + 1;
+
+        if (m->listen_fd >= 0)
+            Metrics_Poll(m, buf, wait_ms);
+        else
+            Osal_SleepNs((uint64_t)wait_ms * 1000000ull);
+    }
+
+    /* 종료 : 마지막 값 (obc_running 0) */
+    if (m->file && !Metrics_WriteFile(m, buf))
+        printf("ERROR: Failed to write metrics file : %s\n", m->file);
+}
+
+int Metrics_Start(Metrics* m, int port, const char* file, uint32_t interval_ms)
+{
+    memset(m, 0, sizeof(*m));
+    m->port = port;
+    m->file = file;
+    m->interval_ms = interval_ms ? interval_ms : METRICS_INTERVAL_MS;
+    m->listen_fd = -1;
+    m->start_ns = m->prev_ns = Osal_NowNs();
+
+    if (port < 0 || port > 65535)
+    {
+        printf("ERROR: Invalid metrics port : %d\n", port);
+        return 0;
+    }
+    if (port > 0 && !Metrics_Listen(m))
+        return 0;
+
+    if (!Osal_ThreadCreate(&m->server, Metrics_Server, m))
+    {
+        printf("ERROR: Failed to start metrics thread\n");
+        Metrics_CloseListen(m);
+        return 0;
+    }
+    m->started = 1;
+    return 1;
+}
+
+void Metrics_Stop(Metrics* m)
+{
+    if (!m->started)
+        return;
+
+    OSAL_STORE_RELEASE(&m->stop, (uint64_t)1);
+    Osal_ThreadJoin(m->server);
+    Metrics_CloseListen(m);
+    m->started = 0;
+}
@@ -0,0 +1,101 @@
+#ifndef METRICS_H
+#define METRICS_H
+#include <stddef.h>
+#include <stdint.h>
+#include "fault.h"
+#include "osal.h"
+
+/*
+ * 엔진 지표 게시 (--metrics-port=N / --metrics-file=<path>, Prometheus text format 0.0.4)
+ *  - 진단 경로의 스레드마다 카운터 블록(MetricsThread) 1개 : 소유 스레드만 기록 (잠금 / 원자 RMW 없음, store 만)
+ *    → 수집 스레드가 블록을 OSAL_LOAD_ACQUIRE 로 읽어 합산, 수집(scrape) 빈도와 무관하게 진단 루프 비용 일정
+ *  - 지표 : 진단 행 수 / 초당 행 수, 입력 파싱 실패 줄 수, 고장 코드별 CONFIRM 진입 횟수 / 최신 상태,
+ *           파이프라인 링 대기 원소 수 (소비 스레드가 배치마다 기록)
+ *  - 게시 : 127.0.0.1:N HTTP (GET /metrics, POSIX) 및/또는 textfile (interval 마다 tmp 기록 후 rename,
+ *           node_exporter textfile collector), 종료 시 마지막 값으로 textfile 1회 더 기록
+ *  - 블록 등록(Metrics_AddThread)은 제어 스레드 1개가 해당 스레드 시작 전에 수행
+ */
+
+#define METRICS_THREADS_MAX     8
+#define METRICS_INTERVAL_MS     1000u       // textfile 기록 주기 기본값
+#define METRICS_CONFIRM_BITS    0x00AAAAAAu // Fault_PackStatus 의 고장별 CONFIRM bit (2 bit 중 상위)
+
+/* 스레드별 카운터 블록 (게시 값은 소유 스레드만 OSAL_STORE_RELEASE 로 기록) */
+typedef struct
+{
+    char pad0[OSAL_CACHE_LINE];     // 인접 블록과 캐시 라인 분리
+    uint64_t rows;                  // 진단 행 수
+    uint64_t parse_errors;          // 파싱 실패 줄 수
+    uint64_t status;                // 최신 Fault_PackStatus
+    uint64_t queue_depth;           // 입력 링 대기 원소 수 (queue 가 있는 블록)
+    uint64_t confirms[FAULT_MAX];   // 고장 코드별 CONFIRM 진입 횟수
+
+    /* 등록 시 고정 */
+    const char* queue;              // 입력 링 이름 (NULL : 없음)
+    uint64_t queue_capacity;
+
+    /* 소유 스레드 전용 */
+    uint32_t prev;                  // 직전 Fault_PackStatus (CONFIRM 진입 검출)
+} MetricsThread;
+
+typedef struct
+{
+    MetricsThread thread[METRICS_THREADS_MAX];
+    uint64_t count;                 // 등록 블록 수 (release 게시)
+    uint64_t stop;                  // 1 : 수집 스레드 종료 요청
+
+    int port;                       // 0 : HTTP 없음
+    const char* file;               // NULL : textfile 없음
+    uint32_t interval_ms;
+    int listen_fd;
+    int started;
+    OsalThread server;
+
+    /* 수집 스레드 전용 */
+    uint64_t start_ns;
+    uint64_t prev_ns;               // 직전 게시 시각 / 행 수 (초당 행 수)
+    uint64_t prev_rows;
+    uint64_t scrapes;               // HTTP 응답 수
+    uint64_t writes;                // textfile 기록 수
+} Metrics;
+
+/* ===== 게시 시작 (port : 1 ~ 65535 또는 0, file : NULL 가능) : 성공 1, 실패 0 ===== */
+int Metrics_Start(Metrics* m, int port, const char* file, uint32_t interval_ms);
+
+/* ===== 수집 스레드 종료 + 마지막 textfile 기록 + 소켓 닫기 ===== */
+void Metrics_Stop(Metrics* m);
+
+/* ===== 카운터 블록 등록 (status : 시작 시 Fault_PackStatus, queue : 입력 링 이름 / NULL) : 가득 차면 NULL ===== */
+MetricsThread* Metrics_AddThread(Metrics* m, const char* queue, uint64_t queue_capacity, uint32_t status);
+
+/* ===== Prometheus text 형식으로 현재 값 기록 : 길이 반환 (수집 스레드 / 종료 후) ===== */
+size_t Metrics_Format(Metrics* m, char* buf, size_t size);
+
+/* CONFIRM 진입 기록 (드묾, 인라인 경로 밖) */
+void Metrics_Confirm(MetricsThread* t, uint32_t rise);
+
+/* ===== 1 행 진단 후 (status : Fault_PackStatus) ===== */
+static inline void Metrics_Row(MetricsThread* t, uint32_t status)
+{
+    uint32_t rise = status & ~t->prev & METRICS_CONFIRM_BITS;
+
+    if (rise)
+        Metrics_Confirm(t, rise);
+    t->prev = status;
+    OSAL_STORE_RELEASE(&t->status, (uint64_t)status);
+    OSAL_STORE_RELEASE(&t->rows, t->rows + 1);
+}
+
+/* ===== 파싱 실패 줄 ===== */
+static inline void Metrics_ParseError(MetricsThread* t)
+{
+    OSAL_STORE_RELEASE(&t->parse_errors, t->parse_errors + 1);
+}
+
+/* ===== 입력 링 대기 원소 수 ===== */
+static inline void Metrics_QueueDepth(MetricsThread* t, uint64_t depth)
+{
+    OSAL_STORE_RELEASE(&t->queue_depth, depth);
+}
+
+#endif /* METRICS_H */
@@ -0,0 +1,120 @@
+﻿#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "osal.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+    OsalThreadFunc func;
+    void* arg;
+} OsalThreadStart;
+
+#ifdef _WIN32
+static DWORD WINAPI Osal_ThreadEntry(LPVOID p)
+#else
+static void* Osal_ThreadEntry(void* p)
+#endif
+{
+    OsalThreadStart start = *(OsalThreadStart*)p;
+
+    free(p);
+    start.func(start.arg);
+    return 0;
+}
+
+int Osal_ThreadCreate(OsalThread* thread, OsalThreadFunc func, void* arg)
+{
+    OsalThreadStart* start = (OsalThreadStart*)malloc(sizeof(*start));
+
+    if (!start)
+        return 0;
+
+    start->func = func;
+    start->arg = arg;
+
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, Osal_ThreadEntry, start, 0, NULL);
+    if (*thread == NULL)
+#else
+    if (pthread_create(thread, NULL, Osal_ThreadEntry, start) != 0)
+#endif
+    {
+        free(start);
+        return 0;
+    }
+    return 1;
+}
+
+void Osal_ThreadJoin(OsalThread thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+void Osal_Yield(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+int Osal_CpuCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+uint64_t Osal_NowNs(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (freq.QuadPart == 0)
+        QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void Osal_SleepNs(uint64_t ns)
+{
+#ifdef _WIN32
+    Sleep((DWORD)(ns / 1000000ull));
+#else
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(ns / 1000000000ull);
+    ts.tv_nsec = (long)(ns % 1000000000ull);
+    while (nanosleep(&ts, &ts) != 0)
+        ;
+#endif
+}
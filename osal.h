@@ -0,0 +1,95 @@
+#ifndef OSAL_H
+#define OSAL_H
+#include <stdint.h>
+
+/*
+ * OS 추상화 계층 (Windows / POSIX)
+ *  - 진단 엔진 본체(fault.c, input.c)는 OS 의존성이 없어야 하므로
+ *    스레드/시간 등 플랫폼 기능은 이 모듈을 통해서만 사용
+ */
+
+#ifdef _WIN32
+typedef void* OsalThread;
+#else
+#include <pthread.h>
+typedef pthread_t OsalThread;
+#endif
+
+typedef void (*OsalThreadFunc)(void* arg);
+
+/* ===== 원자 연산 (lock-free 자료구조용, uint64_t) ===== */
+#ifdef _MSC_VER
+#include <intrin.h>
+#define OSAL_LOAD_ACQUIRE(p)        ((uint64_t)_InterlockedOr64((volatile long long*)(p), 0))
+#define OSAL_STORE_RELEASE(p, v)    ((void)_InterlockedExchange64((volatile long long*)(p), (long long)(v)))
+#if defined(_M_IX86) || defined(_M_X64)
+#define OSAL_CPU_RELAX()            _mm_pause()
+#else
+#define OSAL_CPU_RELAX()            __yield()
+#endif
+#else
+#define OSAL_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define OSAL_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#if defined(__i386__) || defined(__x86_64__)
+#define OSAL_CPU_RELAX()            __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define OSAL_CPU_RELAX()            __asm__ __volatile__("yield")
+#else
+#define OSAL_CPU_RELAX()            ((void)0)
+#endif
+#endif
+
+/* 메모리 펜스 (seqlock 등 여러 필드를 묶어 게시) : release = 앞의 쓰기 완료 후 뒤의 쓰기, acquire = 앞의 읽기 후 뒤의 읽기 */
+#ifdef _MSC_VER
+#if defined(_M_IX86) || defined(_M_X64)
+#define OSAL_FENCE_ACQUIRE()        _ReadWriteBarrier()
+#define OSAL_FENCE_RELEASE()        _ReadWriteBarrier()
+#else
+#define OSAL_FENCE_ACQUIRE()        __dmb(_ARM64_BARRIER_ISH)
+#define OSAL_FENCE_RELEASE()        __dmb(_ARM64_BARRIER_ISH)
+#endif
+#else
+#define OSAL_FENCE_ACQUIRE()        __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define OSAL_FENCE_RELEASE()        __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+/* 포인터 CAS : *p == expected 이면 desired 저장 후 1, 아니면 expected 에 현재 값을 읽어 두고 0 (재시도 루프용) */
+#ifdef _MSC_VER
+static __inline int Osal_CasPtr(void* volatile* p, void** expected, void* desired)
+{
+    void* seen = _InterlockedCompareExchangePointer(p, desired, *expected);
+
+    if (seen == *expected)
+        return 1;
+    *expected = seen;
+    return 0;
+}
+#define OSAL_CAS_PTR(p, expected, desired) \
+    Osal_CasPtr((void* volatile*)(p), (void**)&(expected), (desired))
+#define OSAL_THREAD_LOCAL           __declspec(thread)
+#else
+#define OSAL_CAS_PTR(p, expected, desired) \
+    __atomic_compare_exchange_n((p), &(expected), (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define OSAL_THREAD_LOCAL           _Thread_local
+#endif
+
+/* false sharing 방지용 캐시 라인 크기 */
+#define OSAL_CACHE_LINE 64
+
+/* 스레드 생성 : 성공 1, 실패 0 */
+int Osal_ThreadCreate(OsalThread* thread, OsalThreadFunc func, void* arg);
+void Osal_ThreadJoin(OsalThread thread);
+
+/* 다른 스레드에 CPU 양보 */
+void Osal_Yield(void);
+
+/* 사용 가능한 CPU 개수 */
+int Osal_CpuCount(void);
+
+/* 단조 증가 시간 (ns) */
+uint64_t Osal_NowNs(void);
+
+/* ns 단위 대기 (Windows는 ms 해상도) */
+void Osal_SleepNs(uint64_t ns);
+
+#endif /* OSAL_H */
@@ -0,0 +1,53 @@
+﻿#include "output.h"
+#include "prof.h"
+
+void Output_WriteHeader(FILE* out)
+{
+    fprintf(out,
+        "Cycle,"
+        "F_0x01,F_0x02,F_0x03,F_0x04,F_0x05,F_0x06,"
+        "F_0x07,F_0x08,F_0x09,F_0x0A,F_0x0B,F_0x0C\n"
+    );
+}
+
+void Output_WriteRow(FILE* out, int cycle, const FaultContext* ctx)
+{
+    Output_WriteRowPacked(out, cycle, Fault_PackStatus(ctx));
+}
+
+void Output_WriteRowPacked(FILE* out, int cycle, uint32_t packed)
+{
+    char buf[OUTPUT_ROW_MAX];
+    PROF_BEGIN(t);
+
+    fwrite(buf, 1, (size_t)Output_FormatRow(buf, cycle, packed), out);
+    PROF_END(PROF_POINT_OUTPUT_WRITE, t);
+}
+
+int Output_FormatRow(char* buf, int cycle, uint32_t packed)
+{
+    char digits[12];
+    unsigned int value = (cycle < 0) ? 0u - (unsigned int)cycle : (unsigned int)cycle;
+    int len = 0;
+    int n = 0;
+
+    /* Cycle (%d) */
+    if (cycle < 0)
+        buf[len++] = '-';
+    do {
+        digits[n++] = (char)('0' + value % 10u);
+        value /= 10u;
+    } while (value != 0u);
+    while (n > 0)
+        buf[len++] = digits[--n];
+
+    /* F_0x01 ~ F_0x0C (,%d) */
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        buf[len++] = ',';
+        buf[len++] = (char)('0' + FAULT_PACKED_STATUS(packed, code));
+    }
+
+    buf[len++] = '\n';
+    return len;
+}
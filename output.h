@@ -0,0 +1,19 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+#include <stdio.h>
+#include "fault.h"
+
+/* ===== 결과 CSV 헤더 출력 ===== */
+void Output_WriteHeader(FILE* out);
+
+/* ===== Cycle 1줄 결과 출력 (Cycle, F_0x01 ~ F_0x0C) ===== */
+void Output_WriteRow(FILE* out, int cycle, const FaultContext* ctx);
+
+/* ===== Fault_PackStatus 값으로 결과 1줄 출력 ===== */
+void Output_WriteRowPacked(FILE* out, int cycle, uint32_t packed);
+
+/* 결과 1줄을 buf에 기록하고 길이를 반환 (buf >= OUTPUT_ROW_MAX) */
+#define OUTPUT_ROW_MAX 64
+int Output_FormatRow(char* buf, int cycle, uint32_t packed);
+
+#endif /* OUTPUT_H */
@@ -0,0 +1,121 @@
+﻿#include "packed.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* 배열 용량 확장 (2배) : 성공 1 */
+static int Packed_Grow(void** p, size_t* cap, size_t need, size_t elem)
+{
+    size_t n = *cap ? *cap : 1024;
+    void* q;
+
+    if (need <= *cap)
+        return 1;
+    while (n < need)
+        n *= 2;
+
+    q = realloc(*p, n * elem);
+    if (!q)
+        return 0;
+    *p = q;
+    *cap = n;
+    return 1;
+}
+
+int Packed_Pack(const InputSnapshot* in, PackedSnapshot* out)
+{
+    /* 모든 필드가 압축 범위 안일 때만 (unsigned 비교 : 음수도 범위 밖) */
+    if ((unsigned)in->IsoR > 0xFFFFFu ||
+        (unsigned)in->SeqState > 7u ||
+        (unsigned)in->PlugInfo > 3u ||
+        (unsigned)in->FLAG_Stop > 1u ||
+        (unsigned)in->FLAG_Relay > 1u ||
+        (unsigned)in->CanMsg > 1u ||
+        (unsigned)in->FaultState > 3u ||
+        (unsigned)in->Charg_Cnt > 0xFFFFu ||
+        in->Real_V < INT16_MIN || in->Real_V > INT16_MAX ||
+        in->Exp_V < INT16_MIN || in->Exp_V > INT16_MAX ||
+        in->H < INT16_MIN || in->H > INT16_MAX)
+        return 0;
+
+    out->Cycle = in->Cycle;
+    out->Ia = in->Ia;
+    out->Ib = in->Ib;
+    out->Ic = in->Ic;
+    out->bits = (uint32_t)in->IsoR |
+        (uint32_t)in->SeqState << 20 |
+        (uint32_t)in->PlugInfo << 23 |
+        (uint32_t)in->FLAG_Stop << 25 |
+        (uint32_t)in->FLAG_Relay << 26 |
+        (uint32_t)in->CanMsg << 27 |
+        (uint32_t)in->FaultState << 28;
+    out->Charg_Cnt = (uint16_t)in->Charg_Cnt;
+    out->Real_V = (int16_t)in->Real_V;
+    out->Exp_V = (int16_t)in->Exp_V;
+    out->H = (int16_t)in->H;
+    return 1;
+}
+
+void PackedLog_Init(PackedLog* log)
+{
+    memset(log, 0, sizeof(*log));
+}
+
+void PackedLog_Free(PackedLog* log)
+{
+    free(log->rows);
+    free(log->wide);
+    memset(log, 0, sizeof(*log));
+}
+
+int PackedLog_Append(PackedLog* log, const InputSnapshot* in)
+{
+    PackedSnapshot* p;
+
+    if (!Packed_Grow((void**)&log->rows, &log->cap, log->count + 1, sizeof(*log->rows)))
+        return 0;
+
+    p = &log->rows[log->count];
+    if (!Packed_Pack(in, p))
+    {
+        /* 범위 밖 행 : 원본 보관 (wide 번호는 int32 범위) */
+        if (log->wide_count >= (size_t)INT32_MAX ||
+            !Packed_Grow((void**)&log->wide, &log->wide_cap, log->wide_count + 1, sizeof(*log->wide)))
+            return 0;
+
+        memset(p, 0, sizeof(*p));
+        p->Cycle = (int32_t)log->wide_count;
+        p->bits = PACKED_WIDE;
+        log->wide[log->wide_count++] = *in;
+    }
+
+    log->count++;
+    return 1;
+}
+
+void PackedLog_Get(const PackedLog* log, size_t i, InputSnapshot* out)
+{
+    const PackedSnapshot* p = &log->rows[i];
+
+    if (p->bits & PACKED_WIDE)
+        *out = log->wide[p->Cycle];
+    else
+        Packed_Unpack(p, out);
+}
+
+void PackedLog_Diagnose(FaultContext* ctx, const PackedLog* log, size_t first, size_t count, uint32_t* status)
+{
+    const PackedSnapshot* p = log->rows + first;
+
+    for (size_t i = 0; i < count; i++, p++)
+    {
+        InputSnapshot in;
+
+        if (p->bits & PACKED_WIDE)
+            in = log->wide[p->Cycle];
+        else
+            Packed_Unpack(p, &in);
+
+        Fault_DiagnoseContext(ctx, &in);
+        status[i] = Fault_PackStatus(ctx);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef PACKED_H
+#define PACKED_H
+#include <stddef.h>
+#include <stdint.h>
+#include "input.h"
+#include "fault.h"
+
+/*
+ * 압축 Snapshot (메모리에 쌓아 두고 재생하는 대용량 로그 / 다수 충전기 배치 입력용)
+ *  - InputSnapshot 60 byte → PackedSnapshot 28 byte
+ *    · Cycle, Ia / Ib / Ic : 그대로 (InputCurrent)
+ *    · bits : IsoR 20bit | SeqState 3 | PlugInfo 2 | FLAG_Stop 1 | FLAG_Relay 1 | CanMsg 1 | FaultState 2 | WIDE 1
+ *    · Charg_Cnt : uint16, Real_V / Exp_V / H : int16
+ *  - 범위를 벗어난 필드가 있는 행은 WIDE 표시 + 원본을 PackedLog 의 wide 표에 보관 (Cycle 자리 : wide 번호) → 손실 없음
+ *  - 진단 : 행마다 스택의 InputSnapshot 으로 풀어서(L1 캐시) 기존 진단 함수 그대로 사용, 메모리에서 읽는 양만 절반 이하
+ */
+
+typedef struct
+{
+    int32_t Cycle;              // WIDE 행 : wide 표 번호
+    InputCurrent Ia;
+    InputCurrent Ib;
+    InputCurrent Ic;
+    uint32_t bits;
+    uint16_t Charg_Cnt;
+    int16_t Real_V;
+    int16_t Exp_V;
+    int16_t H;
+} PackedSnapshot;
+
+#define PACKED_WIDE     0x80000000u     // bits : 원본을 wide 표에 보관한 행
+
+/* 압축 로그 (행 순서 유지) */
+typedef struct
+{
+    PackedSnapshot* rows;
+    size_t count;
+    size_t cap;
+    InputSnapshot* wide;        // 범위 밖 행 원본
+    size_t wide_count;
+    size_t wide_cap;
+} PackedLog;
+
+/* ===== 1행 압축 : 범위 안이면 1, 범위 밖 필드가 있으면 0 (out 은 사용 불가) ===== */
+int Packed_Pack(const InputSnapshot* in, PackedSnapshot* out);
+
+/* ===== 1행 복원 (WIDE 가 아닌 행) ===== */
+static inline void Packed_Unpack(const PackedSnapshot* p, InputSnapshot* out)
+{
+    uint32_t b = p->bits;
+
+    out->Cycle = p->Cycle;
+    out->SeqState = (int)((b >> 20) & 0x7u);
+    out->PlugInfo = (int)((b >> 23) & 0x3u);
+    out->FLAG_Stop = (int)((b >> 25) & 0x1u);
+    out->FLAG_Relay = (int)((b >> 26) & 0x1u);
+    out->Ia = p->Ia;
+    out->Ib = p->Ib;
+    out->Ic = p->Ic;
+    out->FaultState = (int)((b >> 28) & 0x3u);
+    out->Charg_Cnt = p->Charg_Cnt;
+    out->Real_V = p->Real_V;
+    out->Exp_V = p->Exp_V;
+    out->H = p->H;
+    out->CanMsg = (int)((b >> 27) & 0x1u);
+    out->IsoR = (int)(b & 0xFFFFFu);
+}
+
+void PackedLog_Init(PackedLog* log);
+void PackedLog_Free(PackedLog* log);
+
+/* ===== 행 추가 : 성공 1, 메모리 부족 0 ===== */
+int PackedLog_Append(PackedLog* log, const InputSnapshot* in);
+
+/* ===== i 번째 행 복원 ===== */
+void PackedLog_Get(const PackedLog* log, size_t i, InputSnapshot* out);
+
+/* ===== [first, first + count) 행을 ctx 로 이어서 진단, 행마다 Fault_PackStatus 를 status 에 기록 ===== */
+void PackedLog_Diagnose(FaultContext* ctx, const PackedLog* log, size_t first, size_t count, uint32_t* status);
+
+#endif /* PACKED_H */
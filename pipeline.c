@@ -0,0 +1,300 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "pipeline.h"
+#include "spsc_ring.h"
+#include "input.h"
+#include "output.h"
+#include "fault.h"
+#include "osal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PIPELINE_OUT_BUF    (64u * 1024u)
+#define PIPELINE_SPIN       64u     // CPU 양보 전 spin 횟수
+
+/* 진단 → 출력 단계 원소 */
+typedef struct
+{
+    int cycle;
+    uint32_t packed;            // Fault_PackStatus
+} PipelineResult;
+
+typedef struct
+{
+    FILE* fp;
+    FILE* out;
+    SpscRing in_ring;           // InputSnapshot
+    SpscRing out_ring;          // PipelineResult
+    char* out_buf;              // 출력 단계 기록 버퍼 (PIPELINE_OUT_BUF)
+    PipelineStats* stats;
+    MetricsThread* metrics[PIPE_STAGE_COUNT];   // 단계별 지표 (NULL : 없음)
+} Pipeline;
+
+static const char* const stageNames[PIPE_STAGE_COUNT] = { "ingest", "diagnose", "output" };
+
+const char* Pipeline_StageName(PipelineStage stage)
+{
+    return stageNames[stage];
+}
+
+static void Pipe_Backoff(unsigned* spins)
+{
+    if (++*spins < PIPELINE_SPIN)
+        OSAL_CPU_RELAX();
+    else
+        Osal_Yield();
+}
+
+/* 빈 슬롯이 생길 때까지 대기 (backpressure) */
+static void* Ring_WaitWrite(SpscRing* r, size_t* n, PipelineStageStats* st)
+{
+    size_t want = *n;
+    void* slots = Spsc_WriteBegin(r, n);
+    unsigned spins = 0;
+    uint64_t t0;
+
+    if (slots)
+        return slots;
+
+    t0 = Osal_NowNs();
+    st->blocked_waits++;
+    do
+    {
+        Pipe_Backoff(&spins);
+        *n = want;
+        slots = Spsc_WriteBegin(r, n);
+    } while (!slots);
+    st->blocked_ns += Osal_NowNs() - t0;
+    return slots;
+}
+
+/* 원소가 들어올 때까지 대기 : 생산 단계가 종료되고 모두 소비했으면 NULL */
+static const void* Ring_WaitRead(SpscRing* r, size_t* n, PipelineStageStats* st)
+{
+    size_t want = *n;
+    const void* slots = Spsc_ReadBegin(r, n);
+    unsigned spins = 0;
+    uint64_t t0;
+
+    if (slots)
+        return slots;
+
+    t0 = Osal_NowNs();
+    st->starved_waits++;
+    while (!Spsc_Drained(r))
+    {
+        Pipe_Backoff(&spins);
+        *n = want;
+        slots = Spsc_ReadBegin(r, n);
+        if (slots)
+            break;
+    }
+    st->starved_ns += Osal_NowNs() - t0;
+    return slots;
+}
+
+/* 1단계 : CSV 읽기 + 파싱 (Input_ReadLine과 동일한 줄 단위, 파싱 실패 시 종료) */
+static void Stage_Ingest(void* arg)
+{
+    Pipeline* p = (Pipeline*)arg;
+    PipelineStageStats* st = &p->stats->stage[PIPE_INGEST];
+    MetricsThread* mt = p->metrics[PIPE_INGEST];
+    char line[INPUT_LINE_MAX];
+    uint64_t t0 = Osal_NowNs();
+    int eof = 0;
+
+    /* 헤더 1줄 스킵 */
+    if (fgets(line, sizeof(line), p->fp) == NULL)
+        eof = 1;
+
+    while (!eof)
+    {
+        size_t n = PIPELINE_BATCH;
+        size_t k = 0;
+        InputSnapshot* slots = (InputSnapshot*)Ring_WaitWrite(&p->in_ring, &n, st);
+
+        while (k < n)
+        {
+            if (fgets(line, sizeof(line), p->fp) == NULL)
+            {
+                eof = 1;
+                break;
+            }
+            if (!Input_ParseLine(line, &slots[k]))
+            {
+                if (mt)
+                    Metrics_ParseError(mt);
+                eof = 1;
+                break;
+            }
+            k++;
+        }
+
+        Spsc_WriteEnd(&p->in_ring, k);
+        st->items += k;
+    }
+
+    Spsc_Close(&p->in_ring);
+    st->total_ns = Osal_NowNs() - t0;
+}
+
+/* 2단계 : 진단 */
+static void Stage_Diagnose(void* arg)
+{
+    Pipeline* p = (Pipeline*)arg;
+    PipelineStageStats* st = &p->stats->stage[PIPE_DIAGNOSE];
+    MetricsThread* mt = p->metrics[PIPE_DIAGNOSE];
+    FaultContext ctx;
+    uint64_t t0 = Osal_NowNs();
+
+    Fault_InitContext(&ctx);
+
+    for (;;)
+    {
+        size_t n = PIPELINE_BATCH;
+        const InputSnapshot* in = (const InputSnapshot*)Ring_WaitRead(&p->in_ring, &n, st);
+
+        if (!in)
+            break;
+
+        PipelineResult* res = (PipelineResult*)Ring_WaitWrite(&p->out_ring, &n, st);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Fault_DiagnoseContext(&ctx, &in[i]);
+            res[i].cycle = in[i].Cycle;
+            res[i].packed = Fault_PackStatus(&ctx);
+        }
+
+        if (mt)
+        {
+            for (size_t i = 0; i < n; i++)
+                Metrics_Row(mt, res[i].packed);
+        }
+
+        Spsc_WriteEnd(&p->out_ring, n);
+        Spsc_ReadEnd(&p->in_ring, n);
+        st->items += n;
+        if (mt)
+            Metrics_QueueDepth(mt, Spsc_ReadyHint(&p->in_ring));
+    }
+
+    Spsc_Close(&p->out_ring);
+    st->total_ns = Osal_NowNs() - t0;
+}
+
+/* 3단계 : 결과 포맷 + 기록 */
+static void Stage_Output(Pipeline* p)
+{
+    PipelineStageStats* st = &p->stats->stage[PIPE_OUTPUT];
+    MetricsThread* mt = p->metrics[PIPE_OUTPUT];
+    char* buf = p->out_buf;
+    size_t len = 0;
+    uint64_t t0 = Osal_NowNs();
+
+    for (;;)
+    {
+        size_t n = PIPELINE_BATCH;
+        const PipelineResult* res = (const PipelineResult*)Ring_WaitRead(&p->out_ring, &n, st);
+
+        if (!res)
+            break;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (len + OUTPUT_ROW_MAX > PIPELINE_OUT_BUF)
+            {
+                fwrite(buf, 1, len, p->out);
+                len = 0;
+            }
+            len += (size_t)Output_FormatRow(buf + len, res[i].cycle, res[i].packed);
+        }
+
+        Spsc_ReadEnd(&p->out_ring, n);
+        st->items += n;
+        if (mt)
+            Metrics_QueueDepth(mt, Spsc_ReadyHint(&p->out_ring));
+    }
+
+    fwrite(buf, 1, len, p->out);
+    st->total_ns = Osal_NowNs() - t0;
+}
+
+int Pipeline_Run(const char* input_file, const char* result_file, PipelineStats* stats, Metrics* metrics)
+{
+    Pipeline p;
+    OsalThread ingest, diagnose;
+    uint64_t t0;
+    int ok;
+
+    memset(stats, 0, sizeof(*stats));
+    memset(&p, 0, sizeof(p));
+    p.stats = stats;
+
+    p.fp = fopen(input_file, "r");
+    if (!p.fp)
+    {
+        printf("ERROR: Failed to open input CSV : %s\n", input_file);
+        return 1;
+    }
+
+    p.out = fopen(result_file, "w");
+    if (!p.out)
+    {
+        printf("ERROR: Failed to open result CSV : %s\n", result_file);
+        fclose(p.fp);
+        return 1;
+    }
+
+    ok = Spsc_Init(&p.in_ring, sizeof(InputSnapshot), PIPELINE_RING_SIZE);
+    ok = Spsc_Init(&p.out_ring, sizeof(PipelineResult), PIPELINE_RING_SIZE) && ok;
+    p.out_buf = (char*)malloc(PIPELINE_OUT_BUF);
+    ok = (p.out_buf != NULL) && ok;
+
+    Output_WriteHeader(p.out);
+
+    /* 단계 스레드 시작 전 지표 블록 등록 */
+    if (metrics)
+    {
+        p.metrics[PIPE_INGEST] = Metrics_AddThread(metrics, NULL, 0, 0);
+        p.metrics[PIPE_DIAGNOSE] = Metrics_AddThread(metrics, "ingest_diagnose", p.in_ring.capacity, 0);
+        p.metrics[PIPE_OUTPUT] = Metrics_AddThread(metrics, "diagnose_output", p.out_ring.capacity, 0);
+    }
+    t0 = Osal_NowNs();
+
+    /* 진단 → 입력 순서로 시작 (입력 스레드 실패 시 링을 닫아 진단 스레드 종료) */
+    if (ok)
+        ok = Osal_ThreadCreate(&diagnose, Stage_Diagnose, &p);
+
+    if (ok)
+    {
+        if (!Osal_ThreadCreate(&ingest, Stage_Ingest, &p))
+        {
+            Spsc_Close(&p.in_ring);
+            Osal_ThreadJoin(diagnose);
+            ok = 0;
+        }
+    }
+
+    if (ok)
+    {
+        Stage_Output(&p);
+        Osal_ThreadJoin(ingest);
+        Osal_ThreadJoin(diagnose);
+    }
+
+    stats->total_ns = Osal_NowNs() - t0;
+    stats->rows = stats->stage[PIPE_OUTPUT].items;
+
+    Spsc_Free(&p.in_ring);
+    Spsc_Free(&p.out_ring);
+    free(p.out_buf);
+    fclose(p.fp);
+
+    if (fclose(p.out) != 0 || !ok)
+    {
+        printf("ERROR: Pipeline diagnosis failed (out of memory, thread or write error)\n");
+        return 1;
+    }
+    return 0;
+}
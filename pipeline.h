@@ -0,0 +1,56 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+#include <stdint.h>
+#include "metrics.h"
+
+/*
+ * 3단계 파이프라인 진단
+ *  - 입력(CSV 읽기/파싱) → 진단(Fault_DiagnoseContext) → 출력(결과 CSV 포맷/기록)
+ *    각 단계를 별도 스레드로 실행하여 파일 I/O 지연이 진단을 막지 않도록 함
+ *  - 단계 사이는 SPSC 링(spsc_ring.h)으로 연결
+ *      입력 → 진단 : InputSnapshot
+ *      진단 → 출력 : PipelineResult (Cycle + Fault_PackStatus)
+ *  - 링이 가득 차면 생산 단계가 대기(backpressure), 비면 소비 단계가 대기
+ *  - 결과는 직렬 진단 루프와 동일
+ *  - metrics : 단계별 카운터 블록 (입력 : 파싱 실패, 진단 : 행 / 확정 / 입력 링 깊이, 출력 : 입력 링 깊이)
+ */
+
+#ifndef PIPELINE_RING_SIZE
+#define PIPELINE_RING_SIZE  4096u   // 링 원소 수
+#endif
+#ifndef PIPELINE_BATCH
+#define PIPELINE_BATCH      256u    // 단계별 1회 처리 원소 수
+#endif
+
+typedef enum
+{
+    PIPE_INGEST = 0,
+    PIPE_DIAGNOSE,
+    PIPE_OUTPUT,
+    PIPE_STAGE_COUNT
+} PipelineStage;
+
+typedef struct
+{
+    uint64_t items;             // 처리한 원소 수
+    uint64_t total_ns;          // 단계 실행 시간
+    uint64_t starved_ns;        // 입력 링이 비어 대기한 시간
+    uint64_t blocked_ns;        // 출력 링이 가득 차 대기한 시간 (backpressure)
+    uint64_t starved_waits;
+    uint64_t blocked_waits;
+} PipelineStageStats;
+
+typedef struct
+{
+    uint64_t rows;
+    uint64_t total_ns;
+    PipelineStageStats stage[PIPE_STAGE_COUNT];
+} PipelineStats;
+
+/* ===== 파이프라인 진단 실행 (metrics : NULL 가능) : 성공 0, 실패 1 ===== */
+int Pipeline_Run(const char* input_file, const char* result_file, PipelineStats* stats, Metrics* metrics);
+
+/* 단계 이름 ("ingest" / "diagnose" / "output") */
+const char* Pipeline_StageName(PipelineStage stage);
+
+#endif /* PIPELINE_H */
@@ -0,0 +1,127 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "prof.h"
+
+#ifdef OBC_PROFILE
+#include "hist.h"
+#include "osal.h"
+#include <stdlib.h>
+
+/* 스레드별 기록 영역 */
+typedef struct ProfThread
+{
+    Histogram hist[PROF_POINT_COUNT];
+    struct ProfThread* next;
+} ProfThread;
+
+static ProfThread* profThreads = NULL;              // 등록된 스레드 (lock-free push)
+static OSAL_THREAD_LOCAL ProfThread* profLocal = NULL;
+
+/* TSC → ns 환산 기준 (첫 등록 시각) */
+static uint64_t profTicks0;
+static uint64_t profNs0;
+static uint64_t profOverhead = UINT64_MAX;         // 빈 측정 구간 최소값 (결과에 포함됨)
+
+static const char* const pointNames[PROF_POINT_COUNT] =
+{
+    "Fault 0x01", "Fault 0x02", "Fault 0x03", "Fault 0x04",
+    "Fault 0x05", "Fault 0x06", "Fault 0x07", "Fault 0x08",
+    "Fault 0x09", "Fault 0x0A", "Fault 0x0B", "Fault 0x0C",
+    "Input read", "Output row"
+};
+
+static void Prof_AtExit(void)
+{
+    Prof_Dump(stdout);
+}
+
+static ProfThread* Prof_Register(void)
+{
+    ProfThread* t = (ProfThread*)malloc(sizeof(*t));
+    ProfThread* head;
+
+    if (!t)
+        return NULL;
+
+    for (int i = 0; i < PROF_POINT_COUNT; i++)
+        Hist_Init(&t->hist[i]);
+
+    head = profThreads;
+    do
+    {
+        t->next = head;
+    } while (!OSAL_CAS_PTR(&profThreads, head, t));
+
+    /* 최초 등록 스레드 : 환산 기준 시각 + 종료 시 출력 등록 */
+    if (t->next == NULL)
+    {
+        profNs0 = Osal_NowNs();
+        profTicks0 = Prof_Ticks();
+        for (int i = 0; i < 64; i++)
+        {
+            uint64_t t0 = Prof_Ticks();
+            uint64_t d = Prof_Ticks() - t0;
+            if (d < profOverhead)
+                profOverhead = d;
+        }
+        atexit(Prof_AtExit);
+    }
+
+    profLocal = t;
+    return t;
+}
+
+void Prof_Record(int point, uint64_t ticks)
+{
+    ProfThread* t = profLocal;
+
+    if (!t && !(t = Prof_Register()))
+        return;
+
+    Hist_Record(&t->hist[point], ticks);
+}
+
+void Prof_Dump(FILE* out)
+{
+    Histogram total;
+    double ns_per_tick = 1.0;
+    int threads = 0;
+
+    if (!profThreads)
+        return;
+
+#if PROF_TSC
+    {
+        uint64_t ticks = Prof_Ticks() - profTicks0;
+        uint64_t ns = Osal_NowNs() - profNs0;
+
+        if (ticks > 0)
+            ns_per_tick = (double)ns / (double)ticks;
+    }
+#endif
+
+    for (ProfThread* t = profThreads; t; t = t->next)
+        threads++;
+
+    fprintf(out, "Profile (%s, %d threads, timer overhead %.1f ns included)\n",
+        PROF_TSC ? "TSC" : "monotonic clock", threads, profOverhead * ns_per_tick);
+    fprintf(out, "  %-10s %12s %10s %10s %10s %10s\n", "point", "count", "p50 ns", "p99 ns", "max ns", "total ms");
+
+    for (int i = 0; i < PROF_POINT_COUNT; i++)
+    {
+        Hist_Init(&total);
+        for (ProfThread* t = profThreads; t; t = t->next)
+            Hist_Merge(&total, &t->hist[i]);
+
+        if (total.count == 0)
+            continue;
+
+        fprintf(out, "  %-10s %12llu %10.1f %10.1f %10.1f %10.3f\n", pointNames[i],
+            (unsigned long long)total.count,
+            Hist_Percentile(&total, 50.0) * ns_per_tick,
+            Hist_Percentile(&total, 99.0) * ns_per_tick,
+            total.max * ns_per_tick,
+            total.sum * ns_per_tick / 1e6);
+    }
+}
+
+#endif /* OBC_PROFILE */
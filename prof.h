@@ -0,0 +1,53 @@
+#ifndef PROF_H
+#define PROF_H
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * 핫패스 계측 (컴파일 옵션 OBC_PROFILE)
+ *  - 계측 지점 : 고장별 진단 함수 12개, Input_ReadLine, 결과 1줄 출력
+ *  - TSC(x86) 또는 단조 시계로 구간 시간을 측정하여 스레드별 log-linear 히스토그램(hist.h)에 기록
+ *    → 기록 경로에 잠금/원자 연산 없음, 스레드 등록만 lock-free 리스트
+ *  - 프로그램 종료 시(atexit) 모든 스레드 히스토그램을 합산하여 지점별 p50 / p99 / max 출력
+ *  - OBC_PROFILE 미정의 시 PROF_BEGIN / PROF_END 는 빈 문장 (코드 생성 없음)
+ */
+
+#define PROF_POINT_FAULT(code)      ((int)(code) - 1)   // 0x01 ~ 0x0C → 0 ~ 11
+#define PROF_POINT_INPUT_READ       12
+#define PROF_POINT_OUTPUT_WRITE     13
+#define PROF_POINT_COUNT            14
+
+/* 계측 시계 : TSC(x86) 또는 단조 시계 ns (WCET 하네스도 사용) */
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROF_TSC 1
+static inline uint64_t Prof_Ticks(void) { return __rdtsc(); }
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define PROF_TSC 1
+static inline uint64_t Prof_Ticks(void) { return __rdtsc(); }
+#else
+#include "osal.h"
+#define PROF_TSC 0
+static inline uint64_t Prof_Ticks(void) { return Osal_NowNs(); }
+#endif
+
+#ifdef OBC_PROFILE
+
+/* 계측 지점 1회 기록 (ticks : Prof_Ticks 차이) */
+void Prof_Record(int point, uint64_t ticks);
+
+/* 전체 스레드 합산 결과 출력 (종료 시 자동 호출) */
+void Prof_Dump(FILE* out);
+
+#define PROF_BEGIN(t)           uint64_t t = Prof_Ticks()
+#define PROF_END(point, t)      Prof_Record((point), Prof_Ticks() - (t))
+
+#else
+
+#define PROF_BEGIN(t)           ((void)0)
+#define PROF_END(point, t)      ((void)0)
+
+#endif /* OBC_PROFILE */
+
+#endif /* PROF_H */
@@ -148,7 +148,8 @@ class FaultDiagUI(QWidget):
                 lambda: print(self.process.readAllStandardError().data().decode())
             )
 
-            self.process.start(exe_path, [input_path, result_path])
+            # --cache : 이전 실행 이후 추가된 로그 꼬리 부분만 진단
+            self.process.start(exe_path, [input_path, result_path, "--cache"])
             self.process.waitForFinished()
 
             exit_code = self.process.exitCode()
@@ -0,0 +1,519 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "regress.h"
+#include "input.h"
+#include "output.h"
+#include "osal.h"
+#include "schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REGRESS_DEFAULT_MANIFEST    "golden/regress.txt"
+
+/* 결과 1행 (Cycle + 고장 상태) */
+typedef struct
+{
+    int cycle;
+    uint8_t state[FAULT_MAX];
+} RegressRow;
+
+typedef struct
+{
+    RegressRow* rows;
+    size_t count;
+    size_t cap;
+} RegressRows;
+
+static const char* Regress_StateName(int state)
+{
+    switch (state)
+    {
+    case FAULT_NORMAL:  return "NORMAL";
+    case FAULT_DETECT:  return "DETECT";
+    case FAULT_CONFIRM: return "CONFIRM";
+    default:            return "UNKNOWN";
+    }
+}
+
+static int Rows_Push(RegressRows* r, const RegressRow* row)
+{
+    if (r->count == r->cap)
+    {
+        size_t cap = r->cap ? r->cap * 2 : 256;
+        RegressRow* p = (RegressRow*)realloc(r->rows, sizeof(RegressRow) * cap);
+
+        if (!p)
+            return 0;
+        r->rows = p;
+        r->cap = cap;
+    }
+    r->rows[r->count++] = *row;
+    return 1;
+}
+
+/* ------------------------------
+ * manifest
+ * ------------------------------ */
+
+int Regress_Load(const char* manifest, RegressCase** cases, int* count)
+{
+    FILE* fp = fopen(manifest, "r");
+    char line[2 * REGRESS_PATH_MAX];
+    char dir[REGRESS_PATH_MAX];
+    const char* slash;
+    RegressCase* list = NULL;
+    int n = 0;
+    int cap = 0;
+    int line_no = 0;
+
+    *cases = NULL;
+    *count = 0;
+
+    if (!fp)
+    {
+        printf("ERROR: Failed to open regression manifest : %s\n", manifest);
+        return 0;
+    }
+
+    /* manifest 위치 (상대 경로 기준) */
+    slash = strrchr(manifest, '/');
+    if (strrchr(manifest, '\\') > slash)
+        slash = strrchr(manifest, '\\');
+    snprintf(dir, sizeof(dir), "%.*s", slash ? (int)(slash - manifest + 1) : 0, manifest);
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        char* comment = strchr(line, '#');
+        char* input;
+        char* expected;
+        char* mode;
+
+        line_no++;
+        if (comment)
+            *comment = '\0';
+
+        input = strtok(line, " \t\r\n");
+        if (!input)
+            continue;
+        expected = strtok(NULL, " \t\r\n");
+        mode = expected ? strtok(NULL, " \t\r\n") : NULL;
+        if (!expected || (mode && strcmp(mode, "schedule") != 0) || (mode && strtok(NULL, " \t\r\n")))
+        {
+            printf("ERROR: regression manifest line %d : expected \"<input> <expected> [schedule]\"\n", line_no);
+            fclose(fp);
+            free(list);
+            return 0;
+        }
+
+        if (n == cap)
+        {
+            int new_cap = cap ? cap * 2 : 32;
+            RegressCase* p = (RegressCase*)realloc(list, sizeof(RegressCase) * (size_t)new_cap);
+
+            if (!p)
+            {
+                printf("ERROR: Out of memory while reading regression manifest\n");
+                fclose(fp);
+                free(list);
+                return 0;
+            }
+            list = p;
+            cap = new_cap;
+        }
+
+        snprintf(list[n].input, REGRESS_PATH_MAX, "%s%s", dir, input);
+        snprintf(list[n].expected, REGRESS_PATH_MAX, "%s%s", dir, expected);
+        snprintf(list[n].name, REGRESS_PATH_MAX, "%s", expected);
+        list[n].schedule = mode != NULL;
+        n++;
+    }
+
+    fclose(fp);
+    *cases = list;
+    *count = n;
+    return 1;
+}
+
+/* ------------------------------
+ * 진단 / 기대 결과 읽기
+ * ------------------------------ */
+
+/* 직렬 진단 루프와 같은 입력 읽기 (헤더 1줄 생략, 파싱 실패 줄에서 종료, schedule : 다중 주기 진단) */
+static int Regress_Diagnose(const char* path, int schedule, RegressRows* out, char* message)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot in = { 0 };
+    FaultContext ctx;
+    RegressRow row;
+    uint64_t tick = 0;
+    FILE* fp = fopen(path, "r");
+
+    if (!fp)
+    {
+        snprintf(message, 128, "failed to open input");
+        return 0;
+    }
+
+    if (schedule)
+        Schedule_InitContext(&ctx);
+    else
+        Fault_InitContext(&ctx);
+
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (fgets(line, sizeof(line), fp) != NULL && Input_ParseLine(line, &in))
+        {
+            if (schedule)
+                Schedule_Diagnose(&ctx, tick++, &in);
+            else
+                Fault_DiagnoseContext(&ctx, &in);
+
+            row.cycle = in.Cycle;
+            for (int code = 0; code < FAULT_MAX; code++)
+                row.state[code] = (uint8_t)ctx.state[code];
+
+            if (!Rows_Push(out, &row))
+            {
+                fclose(fp);
+                snprintf(message, 128, "out of memory");
+                return 0;
+            }
+        }
+    }
+
+    fclose(fp);
+    return 1;
+}
+
+/* 기대 결과 CSV : 헤더 + "Cycle,F_0x01,...,F_0x0C" (없으면 0, exists = 0) */
+static int Regress_ReadExpected(const char* path, RegressRows* out, int* exists, char* message)
+{
+    char line[256];
+    RegressRow row;
+    FILE* fp = fopen(path, "r");
+    int line_no = 1;
+
+    *exists = fp != NULL;
+    if (!fp)
+    {
+        snprintf(message, 128, "expected result not found");
+        return 0;
+    }
+
+    if (fgets(line, sizeof(line), fp) == NULL || strncmp(line, "Cycle", 5) != 0)
+    {
+        fclose(fp);
+        snprintf(message, 128, "expected result has no header");
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        char* p = line;
+        char* end;
+
+        line_no++;
+        if (line[strspn(line, " \t\r\n")] == '\0')
+            continue;
+
+        row.cycle = (int)strtol(p, &end, 10);
+        for (int code = 0; code < FAULT_MAX; code++)
+            row.state[code] = 0;
+
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX && end != p; code++)
+        {
+            long v;
+
+            if (*end != ',')
+            {
+                end = p;
+                break;
+            }
+            p = end + 1;
+            v = strtol(p, &end, 10);
+            row.state[code] = (uint8_t)v;
+            if (v < FAULT_NORMAL || v > FAULT_CONFIRM)
+                end = p;
+        }
+
+        if (end == p || !Rows_Push(out, &row))
+        {
+            fclose(fp);
+            snprintf(message, 128, "invalid expected result line %d", line_no);
+            return 0;
+        }
+    }
+
+    fclose(fp);
+    return 1;
+}
+
+static int Regress_WriteExpected(const char* path, const RegressRows* rows)
+{
+    FILE* fp = fopen(path, "w");
+    FaultContext ctx;
+    int ok;
+
+    if (!fp)
+        return 0;
+
+    Fault_InitContext(&ctx);
+    Output_WriteHeader(fp);
+    for (size_t i = 0; i < rows->count; i++)
+    {
+        for (int code = 0; code < FAULT_MAX; code++)
+            ctx.state[code] = (FaultStatus)rows->rows[i].state[code];
+        Output_WriteRow(fp, rows->rows[i].cycle, &ctx);
+    }
+
+    ok = !ferror(fp);
+    return fclose(fp) == 0 && ok;
+}
+
+/* ------------------------------
+ * 케이스 실행
+ * ------------------------------ */
+
+void Regress_RunCase(const RegressCase* c, int update, RegressResult* r)
+{
+    RegressRows actual = { 0 };
+    RegressRows expected = { 0 };
+    size_t n;
+    int exists = 0;
+    int loaded;
+
+    memset(r, 0, sizeof(*r));
+    r->cycle = -1;
+    r->expected_cycle = -1;
+
+    if (!Regress_Diagnose(c->input, c->schedule, &actual, r->message))
+    {
+        r->status = REGRESS_ERROR;
+        goto done;
+    }
+    r->rows = actual.count;
+
+    loaded = Regress_ReadExpected(c->expected, &expected, &exists, r->message);
+    if (!loaded && !update)
+    {
+        r->status = REGRESS_ERROR;
+        goto done;
+    }
+    r->expected_rows = expected.count;
+
+    /* 첫 불일치 행 */
+    r->status = REGRESS_PASS;
+    n = actual.count < expected.count ? actual.count : expected.count;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (actual.rows[i].cycle != expected.rows[i].cycle ||
+            memcmp(actual.rows[i].state, expected.rows[i].state, FAULT_MAX) != 0)
+        {
+            r->status = REGRESS_FAIL;
+            r->row = (int)i + 1;
+            r->cycle = actual.rows[i].cycle;
+            r->expected_cycle = expected.rows[i].cycle;
+            memcpy(r->state, actual.rows[i].state, FAULT_MAX);
+            memcpy(r->expected_state, expected.rows[i].state, FAULT_MAX);
+            break;
+        }
+    }
+    if (r->status == REGRESS_PASS && (actual.count != expected.count || !loaded))
+    {
+        r->status = REGRESS_FAIL;
+        r->row = (int)n + 1;
+    }
+
+    if (update && r->status == REGRESS_FAIL)
+    {
+        if (Regress_WriteExpected(c->expected, &actual))
+            r->status = REGRESS_UPDATED;
+        else
+        {
+            r->status = REGRESS_ERROR;
+            snprintf(r->message, sizeof(r->message), "failed to write expected result");
+        }
+    }
+
+done:
+    free(actual.rows);
+    free(expected.rows);
+}
+
+/* ------------------------------
+ * 병렬 실행 : 케이스 번호 i % 워커 수 분배
+ * ------------------------------ */
+
+typedef struct
+{
+    const RegressCase* cases;
+    RegressResult* results;
+    int count;
+    int index;
+    int workers;
+    int update;
+} RegressWorker;
+
+static void Regress_Worker(void* arg)
+{
+    RegressWorker* wk = (RegressWorker*)arg;
+
+    for (int i = wk->index; i < wk->count; i += wk->workers)
+        Regress_RunCase(&wk->cases[i], wk->update, &wk->results[i]);
+}
+
+static void Regress_Report(const RegressCase* c, const RegressResult* r)
+{
+    switch (r->status)
+    {
+    case REGRESS_ERROR:
+        printf("ERROR   %s : %s\n", c->name, r->message);
+        break;
+
+    case REGRESS_UPDATED:
+        printf("UPDATED %s (%llu rows)\n", c->name, (unsigned long long)r->rows);
+        break;
+
+    case REGRESS_FAIL:
+        if (r->cycle < 0 && r->expected_cycle < 0)
+        {
+            printf("FAIL    %s : %llu rows, expected %llu (first missing row %d)\n", c->name,
+                (unsigned long long)r->rows, (unsigned long long)r->expected_rows, r->row);
+            break;
+        }
+
+        printf("FAIL    %s : row %d, Cycle %d", c->name, r->row, r->cycle);
+        if (r->cycle != r->expected_cycle)
+            printf(" (expected Cycle %d)", r->expected_cycle);
+        printf("\n");
+
+        for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        {
+            if (r->state[code] != r->expected_state[code])
+                printf("          0x%02X : expected %s, actual %s\n", code,
+                    Regress_StateName(r->expected_state[code]), Regress_StateName(r->state[code]));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+int Regress_Main(int argc, char* argv[])
+{
+    const char* manifest = REGRESS_DEFAULT_MANIFEST;
+    RegressCase* cases = NULL;
+    RegressResult* results = NULL;
+    RegressWorker* workers = NULL;
+    OsalThread* threads = NULL;
+    int* started = NULL;
+    int count = 0;
+    int worker_count = 0;
+    int update = 0;
+    int passed = 0, failed = 0, errors = 0, updated = 0;
+    uint64_t rows = 0;
+    int rc = 1;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--update") == 0)
+            update = 1;
+        else if (strncmp(argv[i], "--workers=", 10) == 0)
+            worker_count = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+        else
+            manifest = argv[i];
+    }
+
+    if (worker_count < 0)
+    {
+        printf("ERROR: Invalid regression option value\n");
+        return 1;
+    }
+
+    if (!Regress_Load(manifest, &cases, &count))
+        return 1;
+    if (count == 0)
+    {
+        printf("ERROR: No regression case in manifest : %s\n", manifest);
+        free(cases);
+        return 1;
+    }
+
+    if (worker_count == 0)
+        worker_count = Osal_CpuCount();
+    if (worker_count < 1)
+        worker_count = 1;
+    if (worker_count > count)
+        worker_count = count;
+
+    results = (RegressResult*)calloc((size_t)count, sizeof(*results));
+    workers = (RegressWorker*)calloc((size_t)worker_count, sizeof(*workers));
+    threads = (OsalThread*)calloc((size_t)worker_count, sizeof(*threads));
+    started = (int*)calloc((size_t)worker_count, sizeof(*started));
+    if (!results || !workers || !threads || !started)
+    {
+        printf("ERROR: Out of memory while starting regression\n");
+        goto done;
+    }
+
+    uint64_t t0 = Osal_NowNs();
+    for (int k = 0; k < worker_count; k++)
+    {
+        workers[k].cases = cases;
+        workers[k].results = results;
+        workers[k].count = count;
+        workers[k].index = k;
+        workers[k].workers = worker_count;
+        workers[k].update = update;
+        if (k > 0)
+            started[k] = Osal_ThreadCreate(&threads[k], Regress_Worker, &workers[k]);
+    }
+
+    Regress_Worker(&workers[0]);
+
+    for (int k = 1; k < worker_count; k++)
+    {
+        if (started[k])
+            Osal_ThreadJoin(threads[k]);
+        else
+            Regress_Worker(&workers[k]);
+    }
+    uint64_t t1 = Osal_NowNs();
+
+    /* manifest 순서로 보고 */
+    for (int i = 0; i < count; i++)
+    {
+        Regress_Report(&cases[i], &results[i]);
+        rows += results[i].rows;
+
+        switch (results[i].status)
+        {
+        case REGRESS_PASS:    passed++;  break;
+        case REGRESS_FAIL:    failed++;  break;
+        case REGRESS_UPDATED: updated++; break;
+        default:              errors++;  break;
+        }
+    }
+
+    printf("Regression : %d cases, %d passed, %d failed, %d errors", count, passed, failed, errors);
+    if (update)
+        printf(", %d updated", updated);
+    printf(", %llu rows, %d workers, %.3f ms\n",
+        (unsigned long long)rows, worker_count, (double)(t1 - t0) / 1e6);
+
+    rc = (failed == 0 && errors == 0) ? 0 : 1;
+
+done:
+    free(started);
+    free(threads);
+    free(workers);
+    free(results);
+    free(cases);
+    return rc;
+}
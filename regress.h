@@ -0,0 +1,55 @@
+#ifndef REGRESS_H
+#define REGRESS_H
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 골든 결과 회귀 테스트 (fault_engine --regress)
+ *  - manifest(기본 golden/regress.txt) 줄마다 "<입력 CSV> <기대 결과 CSV> [schedule]" (manifest 파일 위치 기준 상대 경로, # 뒤는 주석)
+ *    schedule : 다중 주기 진단(Schedule_Diagnose, --schedule)으로 진단
+ *  - 입력마다 독립 FaultContext 로 진단(직렬 진단과 같은 줄 단위 읽기)하고 기대 결과의 Cycle / 고장 상태와 행 단위 비교
+ *  - 케이스를 워커에 나누어 병렬 실행, 불일치 시 첫 불일치 행 / Cycle / 고장 코드별 기대 · 실제 상태 출력
+ *  - --update : 기대 결과 파일을 현재 엔진 결과로 다시 기록 (내용이 달라진 파일만)
+ */
+
+#define REGRESS_PATH_MAX    512
+
+typedef struct
+{
+    char input[REGRESS_PATH_MAX];
+    char expected[REGRESS_PATH_MAX];
+    char name[REGRESS_PATH_MAX];        // manifest 에 적힌 기대 결과 경로 (출력용)
+    int schedule;                       // 1 : 다중 주기 진단
+} RegressCase;
+
+typedef enum
+{
+    REGRESS_PASS = 0,
+    REGRESS_FAIL,
+    REGRESS_ERROR,
+    REGRESS_UPDATED
+} RegressStatus;
+
+typedef struct
+{
+    RegressStatus status;
+    uint64_t rows;              // 진단 행 수
+    uint64_t expected_rows;
+    int row;                    // 첫 불일치 행 (1 : 첫 데이터 행)
+    int cycle;                  // 그 행의 실제 Cycle (행 수 불일치 시 -1)
+    int expected_cycle;
+    uint8_t state[FAULT_MAX];           // 그 행의 실제 상태
+    uint8_t expected_state[FAULT_MAX];  // 그 행의 기대 상태
+    char message[128];          // 오류 내용
+} RegressResult;
+
+/* ===== manifest 읽기 : 성공 1 (cases 는 free 로 해제) ===== */
+int Regress_Load(const char* manifest, RegressCase** cases, int* count);
+
+/* ===== 케이스 1개 실행 (update : 다르면 기대 결과 다시 기록) ===== */
+void Regress_RunCase(const RegressCase* c, int update, RegressResult* r);
+
+/* ===== 명령행 진입점 : fault_engine --regress [manifest] [--workers=N] [--update], 모두 통과 0 ===== */
+int Regress_Main(int argc, char* argv[]);
+
+#endif /* REGRESS_H */
@@ -0,0 +1,349 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+#endif
+#include "result_cache.h"
+#include "input.h"
+#include "output.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define cache_fseek _fseeki64
+#define cache_ftell _ftelli64
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#define cache_fseek fseeko
+#define cache_ftell ftello
+#endif
+
+/* 결과 CSV 식별용 해시 구간 크기 / 파일 해시 읽기 단위 */
+#define CACHE_HASH_SPAN 4096
+
+#define HASH_INIT   14695981039346656037ull
+
+/* FNV-1a 64bit */
+static uint64_t Hash_Update(uint64_t h, const unsigned char* p, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* 파일의 [from, to) 구간 해시 */
+static int Hash_FileRange(const char* path, uint64_t from, uint64_t to, uint64_t* hash)
+{
+    unsigned char buf[CACHE_HASH_SPAN];
+    uint64_t h = HASH_INIT;
+    FILE* fp = fopen(path, "rb");
+
+    if (!fp)
+        return 0;
+
+    if (cache_fseek(fp, (long long)from, SEEK_SET) != 0)
+    {
+        fclose(fp);
+        return 0;
+    }
+
+    while (from < to)
+    {
+        size_t want = (size_t)((to - from) < sizeof(buf) ? (to - from) : sizeof(buf));
+        size_t got = fread(buf, 1, want, fp);
+
+        if (got != want)
+        {
+            fclose(fp);
+            return 0;
+        }
+        h = Hash_Update(h, buf, got);
+        from += got;
+    }
+
+    fclose(fp);
+    *hash = h;
+    return 1;
+}
+
+static int File_Size(const char* path, uint64_t* size)
+{
+    FILE* fp = fopen(path, "rb");
+    long long pos;
+
+    if (!fp)
+        return 0;
+
+    if (cache_fseek(fp, 0, SEEK_END) != 0 || (pos = cache_ftell(fp)) < 0)
+    {
+        fclose(fp);
+        return 0;
+    }
+
+    fclose(fp);
+    *size = (uint64_t)pos;
+    return 1;
+}
+
+static int File_Truncate(const char* path, uint64_t size)
+{
+#ifdef _WIN32
+    FILE* fp = fopen(path, "r+b");
+    int ok;
+
+    if (!fp)
+        return 0;
+    ok = (_chsize_s(_fileno(fp), (long long)size) == 0);
+    fclose(fp);
+    return ok;
+#else
+    return truncate(path, (off_t)size) == 0;
+#endif
+}
+
+static uint64_t Span_Begin(uint64_t end)
+{
+    return end > CACHE_HASH_SPAN ? end - CACHE_HASH_SPAN : 0;
+}
+
+/* 결과 CSV 커밋 지점 직전 구간 식별값 계산 */
+static int Cache_ResultFingerprint(ResultCacheRecord* rec, const char* result_file)
+{
+    return Hash_FileRange(result_file, Span_Begin(rec->result_offset), rec->result_offset, &rec->result_tail_hash);
+}
+
+static int Cache_Load(const char* cache_file, ResultCacheRecord* rec)
+{
+    FILE* fp = fopen(cache_file, "rb");
+    size_t got;
+
+    if (!fp)
+        return 0;
+
+    got = fread(rec, sizeof(*rec), 1, fp);
+    fclose(fp);
+    return got == 1;
+}
+
+/* 캐시 키(엔진 버전 / Calibration / 파일 식별값) 검증 */
+static int Cache_Validate(const ResultCacheRecord* rec, const char* input_file, const char* result_file)
+{
+    ResultCacheRecord now = *rec;
+    FaultContext init;
+    uint64_t input_size, result_size;
+
+    Fault_InitContext(&init);
+
+    if (rec->magic != RESULT_CACHE_MAGIC ||
+        rec->engine_version != FAULT_ENGINE_VERSION ||
+        rec->ctx_size != sizeof(FaultContext) ||
+        rec->calib_id != Fault_CalibrationId(&init.cal) ||
+        memcmp(&rec->ctx.cal, &init.cal, sizeof(init.cal)) != 0)
+        return 0;
+
+    if (!File_Size(input_file, &input_size) || input_size < rec->input_offset)
+        return 0;
+
+    if (!File_Size(result_file, &result_size) || result_size < rec->result_offset)
+        return 0;
+
+    /* 커밋된 입력 구간 전체 해시 : 같은 길이의 중간 수정도 감지 (진단보다 훨씬 싼 순차 읽기 1회) */
+    if (!Hash_FileRange(input_file, 0, rec->input_offset, &now.input_hash) ||
+        !Cache_ResultFingerprint(&now, result_file))
+        return 0;
+
+    return now.input_hash == rec->input_hash &&
+        now.result_tail_hash == rec->result_tail_hash;
+}
+
+static int Cache_Save(const char* cache_file, const ResultCacheRecord* rec)
+{
+    char tmp_file[1024];
+    FILE* fp;
+    int ok;
+
+    if (snprintf(tmp_file, sizeof(tmp_file), "%s.tmp", cache_file) >= (int)sizeof(tmp_file))
+        return 0;
+
+    fp = fopen(tmp_file, "wb");
+    if (!fp)
+        return 0;
+
+    ok = (fwrite(rec, sizeof(*rec), 1, fp) == 1);
+    ok = (fclose(fp) == 0) && ok;
+
+    /* 이전 캐시를 교체 (Windows rename은 대상이 있으면 실패) */
+    remove(cache_file);
+    return ok && rename(tmp_file, cache_file) == 0;
+}
+
+int ResultCache_Run(const char* input_file, const char* result_file,
+    const char* cache_file, ResultCacheStats* stats)
+{
+    ResultCacheRecord rec;
+    FaultContext* ctx = Fault_GetContext();
+    FaultContext commit_ctx;
+    InputSnapshot in = { 0 };
+    char line[INPUT_LINE_MAX];
+    FILE* fp;
+    FILE* out;
+
+    uint64_t in_pos;            // 현재 입력 byte offset
+    uint64_t in_hash;           // 입력 [0, in_pos) 해시 (읽으면서 이어서 계산)
+    uint64_t commit_in;         // 마지막 완결된 줄 끝 offset
+    uint64_t commit_hash;       // 입력 [0, commit_in) 해시
+    long long commit_out = -1;  // 미완결 줄 처리 직전 결과 offset
+    uint64_t rows;
+    uint64_t commit_rows;
+    int pending = 0;            // 개행 없는 마지막 줄(기록 중인 로그)을 처리한 상태
+    int header_ok = 1;          // 헤더 줄이 완결된 경우에만 캐시 저장
+
+    memset(stats, 0, sizeof(*stats));
+
+    stats->resumed = Cache_Load(cache_file, &rec) &&
+        Cache_Validate(&rec, input_file, result_file);
+
+    fp = fopen(input_file, "rb");
+    if (!fp)
+    {
+        printf("ERROR: Failed to open input CSV : %s\n", input_file);
+        return 1;
+    }
+
+    if (stats->resumed)
+    {
+        /* ------------------------------
+         * 캐시 이어서 실행 : 엔진 상태 복원 + 결과 CSV 커밋 지점으로 정리
+         * ------------------------------ */
+        if (!File_Truncate(result_file, rec.result_offset) ||
+            cache_fseek(fp, (long long)rec.input_offset, SEEK_SET) != 0)
+        {
+            stats->resumed = 0;
+        }
+    }
+
+    if (stats->resumed)
+    {
+        *ctx = rec.ctx;
+        in_pos = rec.input_offset;
+        in_hash = rec.input_hash;
+        rows = rec.rows;
+        stats->input_skipped = rec.input_offset;
+
+        out = fopen(result_file, "a");
+    }
+    else
+    {
+        /* ------------------------------
+         * 전체 재진단 : 헤더 1줄 스킵
+         * ------------------------------ */
+        Fault_Init();
+        in_pos = 0;
+        in_hash = HASH_INIT;
+        rows = 0;
+
+        if (cache_fseek(fp, 0, SEEK_SET) == 0 && fgets(line, sizeof(line), fp) != NULL)
+        {
+            in_pos = strlen(line);
+            in_hash = Hash_Update(in_hash, (const unsigned char*)line, (size_t)in_pos);
+        }
+
+        header_ok = (in_pos > 0 && line[in_pos - 1] == '\n');
+
+        out = fopen(result_file, "w");
+        if (out)
+            Output_WriteHeader(out);
+    }
+
+    if (!out)
+    {
+        printf("ERROR: Failed to open result CSV : %s\n", result_file);
+        fclose(fp);
+        return 1;
+    }
+
+    commit_in = in_pos;
+    commit_hash = in_hash;
+    commit_rows = rows;
+
+    /* ------------------------------
+     * 추가된 꼬리 구간 진단
+     * ------------------------------ */
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        size_t len = strlen(line);
+        int complete = (len > 0 && line[len - 1] == '\n');
+
+        /* 기록 중인 줄은 진단/출력하되 커밋 지점은 그 이전으로 유지 */
+        if (!complete && !pending)
+        {
+            pending = 1;
+            commit_ctx = *ctx;
+            commit_out = cache_ftell(out);
+        }
+
+        if (!Input_ParseLine(line, &in))
+            break;
+
+        Fault_Diagnose(&in);
+        Output_WriteRow(out, in.Cycle, ctx);
+
+        in_pos += len;
+        in_hash = Hash_Update(in_hash, (const unsigned char*)line, len);
+        rows++;
+
+        if (complete)
+        {
+            pending = 0;
+            commit_in = in_pos;
+            commit_hash = in_hash;
+            commit_rows = rows;
+        }
+    }
+
+    if (!pending)
+    {
+        commit_ctx = *ctx;
+        commit_out = cache_ftell(out);
+    }
+
+    fclose(fp);
+
+    if (fclose(out) != 0 || commit_out < 0)
+    {
+        printf("ERROR: Failed to write result CSV : %s\n", result_file);
+        return 1;
+    }
+
+    stats->rows_total = rows;
+    stats->rows_new = rows - (stats->resumed ? rec.rows : 0);
+
+    /* ------------------------------
+     * 커밋 지점 캐시 저장
+     * ------------------------------ */
+    memset(&rec, 0, sizeof(rec));
+    rec.magic = RESULT_CACHE_MAGIC;
+    rec.engine_version = FAULT_ENGINE_VERSION;
+    rec.calib_id = Fault_CalibrationId(&commit_ctx.cal);
+    rec.ctx_size = sizeof(FaultContext);
+    rec.input_offset = commit_in;
+    rec.input_hash = commit_hash;
+    rec.result_offset = (uint64_t)commit_out;
+    rec.rows = commit_rows;
+    rec.ctx = commit_ctx;
+
+    if (!header_ok)
+        remove(cache_file);
+    else if (!Cache_ResultFingerprint(&rec, result_file) || !Cache_Save(cache_file, &rec))
+    {
+        /* 캐시 저장 실패는 다음 실행이 전체 재진단으로 동작할 뿐 결과에는 영향 없음 */
+        printf("WARNING: Failed to update result cache : %s\n", cache_file);
+        remove(cache_file);
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 증분 진단 결과 캐시
+ *  - 입력 로그는 뒤에 추가되는 형태를 가정, 이미 진단한 구간이 바뀌면(같은 길이의 중간 수정 포함) 전체 재진단
+ *  - 캐시 키 : 입력 파일 식별값(커밋 지점까지 전체 해시, 읽으면서 이어서 계산) + Calibration + 엔진 버전
+ *    (재실행마다 커밋 구간을 순차 읽기 1회로 다시 해시 : 파싱 / 진단보다 훨씬 쌈)
+ *  - 캐시 값 : 마지막으로 처리한 입력/결과 offset + 그 시점의 엔진 상태(FaultContext)
+ *  - 재실행 시 추가된 꼬리 부분만 파싱/진단하여 기존 결과 CSV 뒤에 이어붙임
+ */
+
+#define RESULT_CACHE_MAGIC 0x3243424Fu   /* "OBC2" : 입력 전체 해시 형식 */
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t engine_version;    // FAULT_ENGINE_VERSION
+    uint32_t calib_id;          // Fault_CalibrationId()
+    uint32_t ctx_size;          // sizeof(FaultContext)
+
+    uint64_t input_offset;      // 마지막으로 커밋된 입력 byte offset (완결된 줄 기준)
+    uint64_t result_offset;     // 그 시점의 결과 CSV byte offset
+    uint64_t input_hash;        // 입력 [0, input_offset) 전체 해시
+    uint64_t result_tail_hash;  // 결과 CSV 커밋 지점 직전 구간 해시
+    uint64_t rows;              // 커밋된 진단 Cycle 수
+
+    FaultContext ctx;           // 커밋 시점 엔진 상태
+} ResultCacheRecord;
+
+typedef struct
+{
+    int resumed;                // 1 : 캐시 이어서 실행, 0 : 전체 재진단
+    uint64_t rows_new;          // 이번 실행에서 진단한 Cycle 수
+    uint64_t rows_total;        // 결과 CSV 전체 Cycle 수
+    uint64_t input_skipped;     // 캐시로 건너뛴 입력 byte 수
+} ResultCacheStats;
+
+/* ===== 캐시를 이용한 증분 진단 실행 : 성공 0, 실패 1 ===== */
+int ResultCache_Run(const char* input_file, const char* result_file,
+    const char* cache_file, ResultCacheStats* stats);
+
+#endif /* RESULT_CACHE_H */
@@ -0,0 +1,268 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#ifdef __linux__
+#define _GNU_SOURCE     /* timerfd / sched_setaffinity */
+#endif
+#include "rt_task.h"
+#include "fault.h"
+#include "schedule.h"
+#include "input.h"
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+
+static uint64_t Monotonic_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* 입력 로그 전체 적재 (Input_ReadLine과 동일 : 헤더 1줄 스킵, 파싱 실패 줄에서 종료) */
+static InputSnapshot* Rt_LoadLog(const char* input_file, size_t* rows, MetricsThread* metrics)
+{
+    char line[INPUT_LINE_MAX];
+    InputSnapshot* in = NULL;
+    size_t cap = 0;
+    FILE* fp = fopen(input_file, "r");
+
+    *rows = 0;
+    if (!fp)
+    {
+        printf("ERROR: Failed to open input CSV : %s\n", input_file);
+        return NULL;
+    }
+
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        while (fgets(line, sizeof(line), fp) != NULL)
+        {
+            if (*rows == cap)
+            {
+                size_t n = cap ? cap * 2 : 4096;
+                InputSnapshot* bigger = (InputSnapshot*)realloc(in, n * sizeof(*in));
+                if (!bigger)
+                {
+                    printf("ERROR: Out of memory while loading input CSV\n");
+                    free(in);
+                    fclose(fp);
+                    return NULL;
+                }
+                in = bigger;
+                cap = n;
+            }
+
+            if (!Input_ParseLine(line, &in[*rows]))
+            {
+                if (metrics)
+                    Metrics_ParseError(metrics);
+                break;
+            }
+            (*rows)++;
+        }
+    }
+
+    fclose(fp);
+    if (!in)
+        in = (InputSnapshot*)malloc(sizeof(*in));
+    return in;
+}
+
+/* SCHED_FIFO / CPU 고정 / 메모리 잠금 (실패 시 경고 후 계속) */
+static void Rt_Setup(const RtOptions* opt, RtStats* stats)
+{
+    if (opt->cpu >= 0)
+    {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(opt->cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) == 0)
+            stats->pinned = 1;
+        else
+            printf("WARNING: Failed to pin to CPU %d (%s)\n", opt->cpu, strerror(errno));
+    }
+
+    if (opt->priority > 0)
+    {
+        struct sched_param sp;
+
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+            stats->locked = 1;
+        else
+            printf("WARNING: mlockall failed (%s)\n", strerror(errno));
+
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = opt->priority;
+        if (sched_setscheduler(0, SCHED_FIFO, &sp) == 0)
+            stats->fifo = 1;
+        else
+            printf("WARNING: SCHED_FIFO priority %d not applied (%s)\n", opt->priority, strerror(errno));
+    }
+}
+
+static void Rt_Restore(const RtStats* stats)
+{
+    if (stats->fifo)
+    {
+        struct sched_param sp;
+
+        memset(&sp, 0, sizeof(sp));
+        sched_setscheduler(0, SCHED_OTHER, &sp);
+    }
+    if (stats->locked)
+        munlockall();
+}
+
+int Rt_Run(const char* input_file, const char* result_file, const RtOptions* opt, RtStats* stats)
+{
+    FaultContext ctx;
+    InputSnapshot* in;
+    uint32_t* packed;
+    size_t rows;
+    uint64_t period = (uint64_t)(opt->period_us ? opt->period_us : 10000) * 1000ull;
+    uint64_t start, released = 0;
+    struct itimerspec its;
+    int tfd;
+    int rc = 0;
+    FILE* out;
+
+    memset(stats, 0, sizeof(*stats));
+    Hist_Init(&stats->jitter);
+    Hist_Init(&stats->exec);
+    Hist_Init(&stats->response);
+
+    in = Rt_LoadLog(input_file, &rows, opt->metrics);
+    if (!in)
+        return 1;
+    if (opt->cycles && opt->cycles < rows)
+        rows = (size_t)opt->cycles;
+
+    packed = (uint32_t*)malloc((rows ? rows : 1) * sizeof(*packed));
+    tfd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (!packed || tfd < 0)
+    {
+        printf("ERROR: Failed to set up periodic timer (%s)\n", packed ? strerror(errno) : "out of memory");
+        free(packed);
+        free(in);
+        if (tfd >= 0)
+            close(tfd);
+        return 1;
+    }
+
+    Rt_Setup(opt, stats);
+    if (opt->schedule)
+        Schedule_InitContext(&ctx);
+    else
+        Fault_InitContext(&ctx);
+
+    /* 첫 주기 : 1 주기 뒤 (절대 시각) */
+    start = Monotonic_Ns() + period;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = (time_t)(start / 1000000000ull);
+    its.it_value.tv_nsec = (long)(start % 1000000000ull);
+    its.it_interval.tv_sec = (time_t)(period / 1000000000ull);
+    its.it_interval.tv_nsec = (long)(period % 1000000000ull);
+
+    if (timerfd_settime(tfd, TFD_TIMER_ABSTIME, &its, NULL) < 0)
+    {
+        printf("ERROR: Failed to start periodic timer (%s)\n", strerror(errno));
+        rc = 1;
+        rows = 0;
+    }
+
+    for (size_t i = 0; i < rows; )
+    {
+        uint64_t expirations;
+        ssize_t n = read(tfd, &expirations, sizeof(expirations));
+
+        if (n != (ssize_t)sizeof(expirations))
+        {
+            if (n < 0 && errno == EINTR)
+                continue;
+            printf("ERROR: Periodic timer read failed (%s)\n", strerror(errno));
+            rc = 1;
+            break;
+        }
+
+        uint64_t wake = Monotonic_Ns();
+
+        /* 늦게 깨어나 여러 주기가 지났으면 가장 최근 주기 기준, 나머지는 overrun */
+        released += expirations;
+        stats->overruns += expirations - 1;
+        uint64_t release = start + (released - 1) * period;
+
+        if (opt->schedule)
+        {
+            stats->runs += (uint64_t)Schedule_Diagnose(&ctx, i, &in[i]);
+        }
+        else
+        {
+            Fault_DiagnoseContext(&ctx, &in[i]);
+            stats->runs += FAULT_MAX - 1;
+        }
+        packed[i] = Fault_PackStatus(&ctx);
+        if (opt->shm)
+            ShmStatus_Publish(opt->shm, &in[i], &ctx);
+        if (opt->metrics)
+            Metrics_Row(opt->metrics, packed[i]);
+        if (opt->events && packed[i] != opt->events->prev)
+            EventLog_Transitions(opt->events, &ctx, &in[i], packed[i]);
+
+        uint64_t done = Monotonic_Ns();
+
+        Hist_Record(&stats->jitter, wake - release);
+        Hist_Record(&stats->exec, done - wake);
+        Hist_Record(&stats->response, done - release);
+        if (done - release > period || expirations > 1)
+            stats->deadline_miss++;
+        stats->cycles++;
+        i++;
+    }
+
+    Rt_Restore(stats);
+    close(tfd);
+
+    /* 결과 기록 (주기 실행 종료 후) */
+    out = fopen(result_file, "w");
+    if (!out)
+    {
+        printf("ERROR: Failed to open result CSV : %s\n", result_file);
+        rc = 1;
+    }
+    else
+    {
+        Output_WriteHeader(out);
+        for (uint64_t i = 0; i < stats->cycles; i++)
+            Output_WriteRowPacked(out, in[i].Cycle, packed[i]);
+        if (fclose(out) != 0)
+            rc = 1;
+    }
+
+    free(packed);
+    free(in);
+    return rc;
+}
+
+#else
+
+int Rt_Run(const char* input_file, const char* result_file, const RtOptions* opt, RtStats* stats)
+{
+    (void)input_file;
+    (void)result_file;
+    (void)opt;
+    memset(stats, 0, sizeof(*stats));
+    printf("ERROR: Real-time periodic mode is only supported on Linux\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef RT_TASK_H
+#define RT_TASK_H
+#include <stdint.h>
+#include "hist.h"
+#include "shm_status.h"
+#include "metrics.h"
+#include "event_log.h"
+
+/*
+ * 실시간 주기 실행 모드 (Linux)
+ *  - 타겟에서 엔진은 고정 주기 태스크(타이머 인터럽트 / RTOS 태스크)로 동작하므로
+ *    timerfd 주기 타이머로 매 주기 1 Cycle씩 Fault_DiagnoseContext 실행
+ *  - 입력 로그는 미리 메모리에 적재, 결과는 실행 종료 후 기록 (주기 중 파일 I/O 없음)
+ *  - 측정 : 기상 지연(jitter, 예정 시각 → 기상), 실행 시간, 응답 시간(예정 시각 → 완료),
+ *           deadline(= 주기) 초과, 타이머 만료 누락(overrun)
+ */
+
+typedef struct
+{
+    uint32_t period_us;         // 주기 (기본 10 ms)
+    int priority;               // SCHED_FIFO 우선순위 (0 : 일반 스케줄링)
+    int cpu;                    // 고정 CPU 번호 (-1 : 지정 안 함)
+    uint64_t cycles;            // 실행 Cycle 수 (0 : 로그 끝까지)
+    int schedule;               // 1 : 다중 주기 진단 (schedule.h)
+    ShmPublisher* shm;          // Cycle 마다 상태 게시 (NULL : 안 함)
+    MetricsThread* metrics;     // Cycle 마다 지표 기록 (NULL : 안 함)
+    EventWriter* events;        // 고장 상태 전이 기록 (NULL : 안 함)
+} RtOptions;
+
+typedef struct
+{
+    uint64_t cycles;
+    uint64_t deadline_miss;     // 응답 시간 > 주기
+    uint64_t overruns;          // 처리 지연으로 건너뛴 타이머 주기 수
+    uint64_t runs;              // 실행한 진단 함수 수
+    int fifo;                   // SCHED_FIFO 적용 여부
+    int pinned;                 // CPU 고정 적용 여부
+    int locked;                 // mlockall 적용 여부
+    Histogram jitter;           // 예정 시각 → 기상 (ns)
+    Histogram exec;             // 진단 실행 시간 (ns)
+    Histogram response;         // 예정 시각 → 진단 완료 (ns)
+} RtStats;
+
+/* ===== 주기 실행 진단 : 성공 0, 실패 1 ===== */
+int Rt_Run(const char* input_file, const char* result_file, const RtOptions* opt, RtStats* stats);
+
+#endif /* RT_TASK_H */
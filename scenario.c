@@ -0,0 +1,1142 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "scenario.h"
+#include "snap_log.h"
+#include "osal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* 기본 시나리오 : generate_rawdata.py gen_data1 ~ 3 세션 흐름과 값 범위 (synth.c 와 동일한 고장 이벤트 구성) */
+const char Scenario_DefaultText[] =
+    "# 기본 시나리오 : 결제 후 충전(정상 종료 / 고장 주입 → FAULT → RESET) + 미결제 세션\n"
+    "seed 1\n"
+    "rows 1000000\n"
+    "noise IsoR 2000\n"
+    "\n"
+    "session charge 19\n"
+    "  phase init 5 SeqState=0 PlugInfo=0 FLAG_Stop=1 FLAG_Relay=0 Ia=0 Ib=0 Ic=0 FaultState=0 Charg_Cnt=0"
+    " Real_V=rand(398,400) Exp_V=400 H=15 CanMsg=1 IsoR=800000\n"
+    "  phase plug 2 PlugInfo=1\n"
+    "  phase wait 2 SeqState=1\n"
+    "  phase pay 2 PlugInfo=2\n"
+    "  phase relay 1 FLAG_Stop=0 FLAG_Relay=1 Ia=4 Ib=5 Ic=4\n"
+    "  phase charge 200..3399 next=shutdown SeqState=2 Charg_Cnt=step(1)"
+    " Ia=ramp(11,20,10) Ib=ramp(10,19,10) Ic=ramp(12,21,10) Real_V=rand(397,403) H=ramp(15,35,60)\n"
+    "  fault 0.0004 12 after=25 goto=fault Ia=rand(33,36) Ib=rand(32,35) Ic=rand(34,37) FaultState=1   # 0x01\n"
+    "  fault 0.0004 12 after=25 Ia=ramp(4,1) Ib=ramp(5,2) Ic=ramp(4,1)                                 # 0x02\n"
+    "  fault 0.00004 2 after=25 goto=fault PlugInfo=0 Ia=ramp(3,2) Ib=ramp(4,3) Ic=ramp(3,2)           # 0x03\n"
+    "  fault 0.00016 2 after=25 goto=fault FLAG_Relay=0 FaultState=1                                  # 0x04\n"
+    "  fault 0.0004 12 after=25 Real_V=ramp(415,426)                                                    # 0x05\n"
+    "  fault 0.00008 12 after=25 goto=fault H=ramp(62,84)                                               # 0x06\n"
+    "  fault 0.0004 7 after=25 CanMsg=0                                                                 # 0x07\n"
+    "  fault 0.00025 12 after=25 goto=fault IsoR=ramp(450,50)                                           # 0x08\n"
+    "  fault 0.00016 4 after=25 goto=fault H=ramp(122,131)                                              # 0x0C\n"
+    "  fault 0.00016 1 after=25 Gap=1                                                                   # 0x0A\n"
+    "  phase shutdown 2 next=cooldown SeqState=5 FLAG_Stop=1 FLAG_Relay=0 Ia=0 Ib=0 Ic=0 Real_V=rand(398,400)\n"
+    "  phase fault 8 SeqState=3 FLAG_Stop=1 FLAG_Relay=0 Ia=0 Ib=0 Ic=0 FaultState=2 Real_V=ramp(420,413) H=ramp(*,20)\n"
+    "  phase release 1 FLAG_Stop=0 FLAG_Relay=1 FaultState=0 Real_V=rand(398,400)\n"
+    "  phase reset 1 SeqState=4 Charg_Cnt=0\n"
+    "  phase cooldown 9 SeqState=0 PlugInfo=0 FLAG_Stop=1 FLAG_Relay=0 FaultState=0 Charg_Cnt=0"
+    " Ia=0 Ib=0 Ic=0 Real_V=rand(398,400) H=ramp(*,15)\n"
+    "end\n"
+    "\n"
+    "# 미결제 : 결제 오류(0x09) 확정 후 냉각\n"
+    "session unpaid 1\n"
+    "  phase init 5 SeqState=0 PlugInfo=0 FLAG_Stop=1 FLAG_Relay=0 Ia=0 Ib=0 Ic=0 FaultState=0 Charg_Cnt=0"
+    " Real_V=rand(398,400) Exp_V=400 H=15 CanMsg=1 IsoR=800000\n"
+    "  phase plug 2 PlugInfo=1\n"
+    "  phase wait 8 SeqState=1\n"
+    "  phase cooldown 9 SeqState=0 PlugInfo=0\n"
+    "end\n";
+
+#define SCEN_NAME_MAX       32
+#define SCEN_TOKEN_MAX      64
+#define SCEN_DEFAULT_ROWS   1000000ull
+
+#define GEN_CSV_BUFFER      (1u << 20)  // CSV 기록 버퍼 (byte)
+#define GEN_SNAP_BLOCK      4096        // Snapshot 로그 기록 단위 (행)
+
+/* 신호 프로파일 */
+enum
+{
+    PROF_HOLD,
+    PROF_CONST,
+    PROF_STEP,
+    PROF_RAMP,
+    PROF_RAND,
+    PROF_URAND
+};
+
+typedef struct
+{
+    double a;
+    double b;
+    int n;                      // ramp 길이 (0 : 구간 길이)
+    uint8_t slot;               // Input_Fields 번호 / SCENARIO_SLOT_GAP
+    uint8_t kind;
+    uint8_t from_start;         // ramp(*,b) : 구간 시작 값에서 출발
+} ScenSet;
+
+typedef struct
+{
+    double prob;
+    int len_min;
+    int len_max;
+    int after;
+    int go;                     // 종료 후 phase (-1 : 원래 phase 계속)
+    int set_first;
+    int set_count;
+    int line;
+    char go_name[SCEN_NAME_MAX];
+} ScenFault;
+
+typedef struct
+{
+    char name[SCEN_NAME_MAX];
+    int len_min;
+    int len_max;
+    int next;                   // 다음 phase (-1 : 세션 끝)
+    int set_first;
+    int set_count;
+    int fault_first;
+    int fault_count;
+    int line;
+    char next_name[SCEN_NAME_MAX];
+} ScenPhase;
+
+typedef struct
+{
+    char name[SCEN_NAME_MAX];
+    int weight;
+    int phase_first;
+    int phase_count;
+} ScenSession;
+
+typedef struct
+{
+    char name[SCEN_NAME_MAX];
+    int line;
+} ScenName;
+
+struct Scenario
+{
+    uint64_t seed;
+    uint64_t rows;
+    double noise[SCENARIO_SLOTS];
+
+    ScenSet* sets;
+    int set_count;
+    int set_cap;
+
+    ScenFault* faults;
+    int fault_count;
+    int fault_cap;
+
+    ScenPhase* phases;
+    int phase_count;
+    int phase_cap;
+
+    ScenSession* sessions;
+    int session_count;
+    int session_cap;
+    int weight_total;
+
+    int* sequence;              // 세션 번호
+    ScenName* sequence_names;
+    int sequence_count;
+    int sequence_cap;
+};
+
+static int Table_Grow(void** p, int* cap, int need, size_t elem)
+{
+    if (need <= *cap)
+        return 1;
+
+    int n = *cap ? *cap * 2 : 16;
+    while (n < need)
+        n *= 2;
+
+    void* q = realloc(*p, (size_t)n * elem);
+    if (!q)
+        return 0;
+    *p = q;
+    *cap = n;
+    return 1;
+}
+
+/* ------------------------------
+ * 시나리오 컴파일
+ * ------------------------------ */
+
+static int Parse_Number(const char* s, double* out)
+{
+    char* end;
+
+    if (*s == '\0')
+        return 0;
+    *out = strtod(s, &end);
+    return *end == '\0' && isfinite(*out);
+}
+
+/* "N" 또는 "min..max" */
+static int Parse_Length(const char* s, int* min, int* max)
+{
+    char* end;
+    long a = strtol(s, &end, 10);
+    long b = a;
+
+    if (end == s)
+        return 0;
+    if (strncmp(end, "..", 2) == 0)
+    {
+        const char* t = end + 2;
+        b = strtol(t, &end, 10);
+        if (end == t)
+            return 0;
+    }
+    if (*end != '\0' || a < 1 || b < a || b > 0x7FFFFFFF)
+        return 0;
+
+    *min = (int)a;
+    *max = (int)b;
+    return 1;
+}
+
+static int Parse_Name(char* dst, const char* s)
+{
+    size_t len = strlen(s);
+
+    if (len == 0 || len >= SCEN_NAME_MAX)
+        return 0;
+    memcpy(dst, s, len + 1);
+    return 1;
+}
+
+static int Parse_Slot(const char* name)
+{
+    const InputField* f;
+
+    if (strcmp(name, "Gap") == 0)
+        return SCENARIO_SLOT_GAP;
+
+    /* Cycle 은 생성기가 증가 */
+    f = Input_FindField(name);
+    if (!f || f == &Input_Fields[0])
+        return -1;
+    return (int)(f - Input_Fields);
+}
+
+/* <값> | hold | step(d) | ramp(a,b[,n]) | rand(a,b) | urand(a,b) */
+static int Parse_Profile(ScenSet* s, const char* p)
+{
+    static const struct { const char* name; uint8_t kind; int min_args; int max_args; } funcs[] =
+    {
+        { "step",  PROF_STEP,  1, 1 },
+        { "ramp",  PROF_RAMP,  2, 3 },
+        { "rand",  PROF_RAND,  2, 2 },
+        { "urand", PROF_URAND, 2, 2 },
+    };
+    char args[128];
+    char* arg[4];
+    int count = 0;
+    const char* open = strchr(p, '(');
+    size_t len = strlen(p);
+
+    if (strcmp(p, "hold") == 0)
+    {
+        s->kind = PROF_HOLD;
+        return 1;
+    }
+
+    if (!open)
+    {
+        s->kind = PROF_CONST;
+        return Parse_Number(p, &s->a);
+    }
+
+    if (p[len - 1] != ')' || (size_t)(p + len - 1 - open) >= sizeof(args))
+        return 0;
+
+    /* 인자 분리 */
+    memcpy(args, open + 1, (size_t)(p + len - 2 - open));
+    args[p + len - 2 - open] = '\0';
+    for (char* t = args; count < 4; )
+    {
+        char* comma = strchr(t, ',');
+
+        arg[count++] = t;
+        if (!comma)
+            break;
+        *comma = '\0';
+        t = comma + 1;
+    }
+
+    for (size_t k = 0; k < sizeof(funcs) / sizeof(funcs[0]); k++)
+    {
+        if ((size_t)(open - p) != strlen(funcs[k].name) || strncmp(p, funcs[k].name, (size_t)(open - p)) != 0)
+            continue;
+        if (count < funcs[k].min_args || count > funcs[k].max_args)
+            return 0;
+
+        s->kind = funcs[k].kind;
+        if (s->kind == PROF_STEP)
+            return Parse_Number(arg[0], &s->a);
+
+        if (s->kind == PROF_RAMP && strcmp(arg[0], "*") == 0)
+            s->from_start = 1;
+        else if (!Parse_Number(arg[0], &s->a))
+            return 0;
+        if (!Parse_Number(arg[1], &s->b))
+            return 0;
+
+        if (s->kind == PROF_RAMP && count == 3)
+        {
+            double n;
+            if (!Parse_Number(arg[2], &n) || n < 1 || n > 0x7FFFFFFF || n != floor(n))
+                return 0;
+            s->n = (int)n;
+        }
+
+        if (s->kind == PROF_RAND &&
+            (s->a != floor(s->a) || s->b != floor(s->b) || s->b < s->a || s->b - s->a > 4294967295.0))
+            return 0;
+        if (s->kind == PROF_URAND && s->b < s->a)
+            return 0;
+        return 1;
+    }
+    return 0;
+}
+
+/* "<field>=<profile>" */
+static int Parse_Set(Scenario* sc, const char* tok, int lineNo)
+{
+    char name[64];
+    const char* eq = strchr(tok, '=');
+    ScenSet s;
+    int slot;
+
+    memset(&s, 0, sizeof(s));
+    if (!eq || (size_t)(eq - tok) >= sizeof(name))
+    {
+        printf("ERROR: Scenario line %d : expected <field>=<profile> (%s)\n", lineNo, tok);
+        return 0;
+    }
+    memcpy(name, tok, (size_t)(eq - tok));
+    name[eq - tok] = '\0';
+
+    slot = Parse_Slot(name);
+    if (slot < 0)
+    {
+        printf("ERROR: Scenario line %d : unknown field (%s)\n", lineNo, name);
+        return 0;
+    }
+    s.slot = (uint8_t)slot;
+
+    if (!Parse_Profile(&s, eq + 1))
+    {
+        printf("ERROR: Scenario line %d : invalid profile (%s)\n", lineNo, tok);
+        return 0;
+    }
+
+    if (!Table_Grow((void**)&sc->sets, &sc->set_cap, sc->set_count + 1, sizeof(*sc->sets)))
+    {
+        printf("ERROR: Out of memory while compiling scenario\n");
+        return 0;
+    }
+    sc->sets[sc->set_count++] = s;
+    return 1;
+}
+
+static int Find_Phase(const Scenario* sc, const ScenSession* ss, const char* name)
+{
+    for (int i = ss->phase_first; i < ss->phase_first + ss->phase_count; i++)
+    {
+        if (strcmp(sc->phases[i].name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/* session ... end : phase 이름 연결 */
+static int Session_Close(Scenario* sc, int lineNo)
+{
+    ScenSession* ss = &sc->sessions[sc->session_count - 1];
+    int last = ss->phase_first + ss->phase_count;
+
+    if (ss->phase_count == 0)
+    {
+        printf("ERROR: Scenario line %d : session has no phase (%s)\n", lineNo, ss->name);
+        return 0;
+    }
+
+    for (int i = ss->phase_first; i < last; i++)
+    {
+        ScenPhase* p = &sc->phases[i];
+
+        if (Find_Phase(sc, ss, p->name) != i)
+        {
+            printf("ERROR: Scenario line %d : duplicate phase name (%s)\n", p->line, p->name);
+            return 0;
+        }
+
+        if (p->next_name[0] == '\0')
+            p->next = i + 1 < last ? i + 1 : -1;
+        else if (strcmp(p->next_name, "end") == 0)
+            p->next = -1;
+        else if ((p->next = Find_Phase(sc, ss, p->next_name)) < 0)
+        {
+            printf("ERROR: Scenario line %d : unknown phase (%s)\n", p->line, p->next_name);
+            return 0;
+        }
+
+        for (int k = p->fault_first; k < p->fault_first + p->fault_count; k++)
+        {
+            ScenFault* f = &sc->faults[k];
+
+            f->go = -1;
+            if (f->go_name[0] != '\0' && (f->go = Find_Phase(sc, ss, f->go_name)) < 0)
+            {
+                printf("ERROR: Scenario line %d : unknown phase (%s)\n", f->line, f->go_name);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static int Line_Parse(Scenario* sc, char** tok, int count, int lineNo, int* in_session)
+{
+    const char* cmd = tok[0];
+
+    if (strcmp(cmd, "seed") == 0 || strcmp(cmd, "rows") == 0)
+    {
+        char* end;
+        uint64_t v;
+
+        if (count != 2)
+            goto syntax;
+        v = strtoull(tok[1], &end, 0);
+        if (*end != '\0' || tok[1][0] == '-')
+            goto syntax;
+        if (cmd[0] == 's')
+            sc->seed = v;
+        else
+            sc->rows = v;
+        return 1;
+    }
+
+    if (strcmp(cmd, "noise") == 0)
+    {
+        int slot;
+        double amp;
+
+        if (count != 3)
+            goto syntax;
+        slot = Parse_Slot(tok[1]);
+        if (slot < 0 || slot == SCENARIO_SLOT_GAP)
+        {
+            printf("ERROR: Scenario line %d : unknown field (%s)\n", lineNo, tok[1]);
+            return 0;
+        }
+        if (!Parse_Number(tok[2], &amp) || amp < 0)
+            goto syntax;
+        sc->noise[slot] = Input_Fields[slot].is_float ? amp : floor(amp + 0.5);
+        return 1;
+    }
+
+    if (strcmp(cmd, "sequence") == 0)
+    {
+        if (count < 2)
+            goto syntax;
+        for (int i = 1; i < count; i++)
+        {
+            if (!Table_Grow((void**)&sc->sequence_names, &sc->sequence_cap, sc->sequence_count + 1,
+                sizeof(*sc->sequence_names)))
+                goto nomem;
+            if (!Parse_Name(sc->sequence_names[sc->sequence_count].name, tok[i]))
+                goto syntax;
+            sc->sequence_names[sc->sequence_count++].line = lineNo;
+        }
+        return 1;
+    }
+
+    if (strcmp(cmd, "session") == 0)
+    {
+        ScenSession* ss;
+        double weight = 1;
+
+        if (*in_session)
+        {
+            printf("ERROR: Scenario line %d : missing end before session\n", lineNo);
+            return 0;
+        }
+        if (count < 2 || count > 3 || (count == 3 &&
+            (!Parse_Number(tok[2], &weight) || weight < 0 || weight != floor(weight) || weight > 1000000)))
+            goto syntax;
+        if (!Table_Grow((void**)&sc->sessions, &sc->session_cap, sc->session_count + 1, sizeof(*sc->sessions)))
+            goto nomem;
+
+        ss = &sc->sessions[sc->session_count];
+        memset(ss, 0, sizeof(*ss));
+        if (!Parse_Name(ss->name, tok[1]))
+            goto syntax;
+        for (int i = 0; i < sc->session_count; i++)
+        {
+            if (strcmp(sc->sessions[i].name, ss->name) == 0)
+            {
+                printf("ERROR: Scenario line %d : duplicate session name (%s)\n", lineNo, ss->name);
+                return 0;
+            }
+        }
+        ss->weight = (int)weight;
+        ss->phase_first = sc->phase_count;
+        sc->session_count++;
+        *in_session = 1;
+        return 1;
+    }
+
+    if (strcmp(cmd, "end") == 0)
+    {
+        if (count != 1 || !*in_session)
+            goto syntax;
+        *in_session = 0;
+        return Session_Close(sc, lineNo);
+    }
+
+    if (strcmp(cmd, "phase") == 0)
+    {
+        ScenPhase* p;
+
+        if (!*in_session || count < 3)
+            goto syntax;
+        if (!Table_Grow((void**)&sc->phases, &sc->phase_cap, sc->phase_count + 1, sizeof(*sc->phases)))
+            goto nomem;
+
+        p = &sc->phases[sc->phase_count];
+        memset(p, 0, sizeof(*p));
+        p->line = lineNo;
+        p->set_first = sc->set_count;
+        p->fault_first = sc->fault_count;
+        if (!Parse_Name(p->name, tok[1]) || !Parse_Length(tok[2], &p->len_min, &p->len_max))
+            goto syntax;
+
+        for (int i = 3; i < count; i++)
+        {
+            if (strncmp(tok[i], "next=", 5) == 0)
+            {
+                if (!Parse_Name(p->next_name, tok[i] + 5))
+                    goto syntax;
+            }
+            else if (!Parse_Set(sc, tok[i], lineNo))
+            {
+                return 0;
+            }
+        }
+
+        /* Parse_Set 재할당 후 다시 참조 */
+        p = &sc->phases[sc->phase_count++];
+        p->set_count = sc->set_count - p->set_first;
+        sc->sessions[sc->session_count - 1].phase_count++;
+        return 1;
+    }
+
+    if (strcmp(cmd, "fault") == 0)
+    {
+        ScenFault* f;
+        int after = 0;
+
+        if (!*in_session || sc->phase_count == sc->sessions[sc->session_count - 1].phase_first)
+        {
+            printf("ERROR: Scenario line %d : fault must follow a phase\n", lineNo);
+            return 0;
+        }
+        if (count < 3)
+            goto syntax;
+        if (!Table_Grow((void**)&sc->faults, &sc->fault_cap, sc->fault_count + 1, sizeof(*sc->faults)))
+            goto nomem;
+
+        f = &sc->faults[sc->fault_count];
+        memset(f, 0, sizeof(*f));
+        f->line = lineNo;
+        f->set_first = sc->set_count;
+        if (!Parse_Number(tok[1], &f->prob) || f->prob <= 0 || f->prob > 1 ||
+            !Parse_Length(tok[2], &f->len_min, &f->len_max))
+            goto syntax;
+
+        for (int i = 3; i < count; i++)
+        {
+            if (strncmp(tok[i], "after=", 6) == 0)
+            {
+                double v;
+                if (!Parse_Number(tok[i] + 6, &v) || v < 0 || v != floor(v) || v > 0x7FFFFFFF)
+                    goto syntax;
+                after = (int)v;
+            }
+            else if (strncmp(tok[i], "goto=", 5) == 0)
+            {
+                if (!Parse_Name(f->go_name, tok[i] + 5))
+                    goto syntax;
+            }
+            else if (!Parse_Set(sc, tok[i], lineNo))
+            {
+                return 0;
+            }
+        }
+
+        f = &sc->faults[sc->fault_count++];
+        f->after = after;
+        f->set_count = sc->set_count - f->set_first;
+        sc->phases[sc->phase_count - 1].fault_count++;
+        return 1;
+    }
+
+    printf("ERROR: Scenario line %d : unknown statement (%s)\n", lineNo, cmd);
+    return 0;
+
+syntax:
+    printf("ERROR: Scenario line %d : invalid %s statement\n", lineNo, cmd);
+    return 0;
+
+nomem:
+    printf("ERROR: Out of memory while compiling scenario\n");
+    return 0;
+}
+
+Scenario* Scenario_Compile(const char* text)
+{
+    Scenario* sc = (Scenario*)calloc(1, sizeof(*sc));
+    const char* p = text;
+    char line[1024];
+    char* tok[SCEN_TOKEN_MAX];
+    int lineNo = 0;
+    int in_session = 0;
+
+    if (!sc)
+    {
+        printf("ERROR: Out of memory while compiling scenario\n");
+        return NULL;
+    }
+    sc->seed = 1;
+    sc->rows = SCEN_DEFAULT_ROWS;
+
+    while (*p)
+    {
+        const char* nl = strchr(p, '\n');
+        size_t len = nl ? (size_t)(nl - p) : strlen(p);
+        int count = 0;
+        char* hash;
+
+        if (len >= sizeof(line))
+        {
+            printf("ERROR: Scenario line %d : line too long\n", lineNo + 1);
+            goto fail;
+        }
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p = nl ? nl + 1 : p + len;
+        lineNo++;
+
+        hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        for (char* t = strtok(line, " \t\r"); t; t = strtok(NULL, " \t\r"))
+        {
+            if (count == SCEN_TOKEN_MAX)
+            {
+                printf("ERROR: Scenario line %d : too many items\n", lineNo);
+                goto fail;
+            }
+            tok[count++] = t;
+        }
+
+        if (count > 0 && !Line_Parse(sc, tok, count, lineNo, &in_session))
+            goto fail;
+    }
+
+    if (in_session)
+    {
+        printf("ERROR: Scenario line %d : missing end\n", lineNo);
+        goto fail;
+    }
+    if (sc->session_count == 0)
+    {
+        printf("ERROR: Scenario has no session\n");
+        goto fail;
+    }
+
+    /* sequence 이름 → 세션 번호 */
+    if (sc->sequence_count > 0)
+    {
+        sc->sequence = (int*)malloc((size_t)sc->sequence_count * sizeof(*sc->sequence));
+        if (!sc->sequence)
+        {
+            printf("ERROR: Out of memory while compiling scenario\n");
+            goto fail;
+        }
+        for (int i = 0; i < sc->sequence_count; i++)
+        {
+            int s = 0;
+
+            while (s < sc->session_count && strcmp(sc->sessions[s].name, sc->sequence_names[i].name) != 0)
+                s++;
+            if (s == sc->session_count)
+            {
+                printf("ERROR: Scenario line %d : unknown session (%s)\n",
+                    sc->sequence_names[i].line, sc->sequence_names[i].name);
+                goto fail;
+            }
+            sc->sequence[i] = s;
+        }
+    }
+
+    for (int s = 0; s < sc->session_count; s++)
+        sc->weight_total += sc->sessions[s].weight;
+    if (sc->sequence_count == 0 && sc->weight_total == 0)
+    {
+        printf("ERROR: Scenario sessions all have weight 0\n");
+        goto fail;
+    }
+    return sc;
+
+fail:
+    Scenario_Free(sc);
+    return NULL;
+}
+
+Scenario* Scenario_Load(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    Scenario* sc;
+    char* text;
+    long size;
+
+    if (!fp)
+    {
+        printf("ERROR: Failed to open scenario file : %s\n", path);
+        return NULL;
+    }
+
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0)
+    {
+        printf("ERROR: Failed to read scenario file : %s\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    text = (char*)malloc((size_t)size + 1);
+    if (!text || fread(text, 1, (size_t)size, fp) != (size_t)size)
+    {
+        printf("ERROR: Failed to read scenario file : %s\n", path);
+        free(text);
+        fclose(fp);
+        return NULL;
+    }
+    text[size] = '\0';
+    fclose(fp);
+
+    sc = Scenario_Compile(text);
+    free(text);
+    return sc;
+}
+
+void Scenario_Free(Scenario* sc)
+{
+    if (!sc)
+        return;
+    free(sc->sets);
+    free(sc->faults);
+    free(sc->phases);
+    free(sc->sessions);
+    free(sc->sequence);
+    free(sc->sequence_names);
+    free(sc);
+}
+
+uint64_t Scenario_Seed(const Scenario* sc)
+{
+    return sc->seed;
+}
+
+uint64_t Scenario_Rows(const Scenario* sc)
+{
+    return sc->rows;
+}
+
+/* ------------------------------
+ * 생성
+ * ------------------------------ */
+
+/* splitmix64 */
+static uint64_t Gen_Rand(ScenarioGen* g)
+{
+    uint64_t z = (g->rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/* [0, 1) */
+static double Gen_Unit(ScenarioGen* g)
+{
+    return (double)(Gen_Rand(g) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int Gen_Length(ScenarioGen* g, int min, int max)
+{
+    return min == max ? min : min + (int)(Gen_Rand(g) % (uint64_t)(max - min + 1));
+}
+
+static double Set_Eval(ScenarioGen* g, const ScenSet* s, int pos, int len, double cur, double start)
+{
+    switch (s->kind)
+    {
+    case PROF_CONST:
+        return s->a;
+
+    case PROF_STEP:
+        return cur + s->a;
+
+    case PROF_RAMP:
+    {
+        double from = s->from_start ? start : s->a;
+        int n = s->n ? s->n : len;
+
+        if (n <= 1 || pos >= n - 1)
+            return s->b;
+        return from + (s->b - from) * pos / (n - 1);
+    }
+
+    case PROF_RAND:
+        return s->a + (double)(Gen_Rand(g) % ((uint64_t)(s->b - s->a) + 1));
+
+    case PROF_URAND:
+        return s->a + (s->b - s->a) * Gen_Unit(g);
+
+    default:
+        return cur;
+    }
+}
+
+static void Gen_Store(InputSnapshot* out, int slot, double v)
+{
+    char* field = (char*)out + Input_Fields[slot].offset;
+
+    if (Input_Fields[slot].is_float)
+        *(InputCurrent*)field = Input_CurrentFromDouble(v);
+    else
+        *(int*)field = (int)floor(v + 0.5);
+}
+
+static void Gen_EnterPhase(ScenarioGen* g, int phase)
+{
+    const ScenPhase* p = &g->sc->phases[phase];
+
+    g->phase = phase;
+    g->phase_pos = 0;
+    g->phase_len = Gen_Length(g, p->len_min, p->len_max);
+    memcpy(g->start, g->value, sizeof(g->start));
+}
+
+static void Gen_EnterSession(ScenarioGen* g)
+{
+    const Scenario* sc = g->sc;
+    int s;
+
+    if (sc->sequence_count > 0)
+    {
+        s = sc->sequence[g->seq_pos];
+        g->seq_pos = (g->seq_pos + 1) % sc->sequence_count;
+    }
+    else
+    {
+        int pick = (int)(Gen_Rand(g) % (uint64_t)sc->weight_total);
+
+        for (s = 0; pick >= sc->sessions[s].weight; s++)
+            pick -= sc->sessions[s].weight;
+    }
+
+    g->session = s;
+    g->sessions++;
+    Gen_EnterPhase(g, sc->sessions[s].phase_first);
+}
+
+void Scenario_Start(ScenarioGen* g, const Scenario* sc, uint64_t seed)
+{
+    memset(g, 0, sizeof(*g));
+    g->sc = sc;
+    g->rng = seed;
+    g->fault = -1;
+    Gen_EnterSession(g);
+}
+
+void Scenario_Next(ScenarioGen* g, InputSnapshot* out)
+{
+    const Scenario* sc = g->sc;
+    const ScenPhase* p = &sc->phases[g->phase];
+    int gap;
+
+    /* 1. 단계 값 */
+    g->value[SCENARIO_SLOT_GAP] = 0.0;
+    for (int i = p->set_first; i < p->set_first + p->set_count; i++)
+    {
+        const ScenSet* s = &sc->sets[i];
+        g->value[s->slot] = Set_Eval(g, s, g->phase_pos, g->phase_len, g->value[s->slot], g->start[s->slot]);
+    }
+
+    /* 2. 고장 주입 시작 (phase 고장 목록 중 하나, 확률 누적 비교) */
+    if (g->fault < 0 && p->fault_count > 0)
+    {
+        double u = Gen_Unit(g);
+
+        for (int k = p->fault_first; k < p->fault_first + p->fault_count; k++)
+        {
+            const ScenFault* f = &sc->faults[k];
+
+            if (g->phase_pos < f->after)
+                continue;
+            if (u < f->prob)
+            {
+                g->fault = k;
+                g->fault_pos = 0;
+                g->fault_len = Gen_Length(g, f->len_min, f->len_max);
+                memcpy(g->fault_value, g->value, sizeof(g->fault_value));
+                memcpy(g->fault_start, g->value, sizeof(g->fault_start));
+                g->faults++;
+                break;
+            }
+            u -= f->prob;
+        }
+    }
+
+    /* 3. 출력 값 = 단계 값 + 노이즈 */
+    for (int slot = 1; slot < INPUT_FIELD_COUNT; slot++)
+    {
+        double v = g->value[slot];
+        double amp = sc->noise[slot];
+
+        if (amp > 0)
+        {
+            if (Input_Fields[slot].is_float)
+                v += (2.0 * Gen_Unit(g) - 1.0) * amp;
+            else
+                v += (double)(Gen_Rand(g) % ((uint64_t)amp * 2 + 1)) - amp;
+        }
+        Gen_Store(out, slot, v);
+    }
+    gap = (int)g->value[SCENARIO_SLOT_GAP];
+
+    /* 4. 고장 주입 값 덮어쓰기 */
+    if (g->fault >= 0)
+    {
+        const ScenFault* f = &sc->faults[g->fault];
+
+        for (int i = f->set_first; i < f->set_first + f->set_count; i++)
+        {
+            const ScenSet* s = &sc->sets[i];
+            double v = Set_Eval(g, s, g->fault_pos, g->fault_len, g->fault_value[s->slot], g->fault_start[s->slot]);
+
+            g->fault_value[s->slot] = v;
+            if (s->slot == SCENARIO_SLOT_GAP)
+                gap = (int)v;
+            else
+                Gen_Store(out, s->slot, v);
+        }
+    }
+
+    /* 5. Cycle 번호 (Gap : 다음 Cycle 번호 건너뜀) */
+    out->Cycle = ++g->cycle;
+    if (gap > 0)
+        g->cycle += gap;
+    g->rows++;
+
+    /* 6. 다음 행 위치 */
+    g->phase_pos++;
+    if (g->fault >= 0)
+    {
+        const ScenFault* f = &sc->faults[g->fault];
+
+        if (++g->fault_pos < g->fault_len)
+            return;
+
+        g->fault = -1;
+        if (f->go >= 0)
+        {
+            Gen_EnterPhase(g, f->go);
+            return;
+        }
+    }
+
+    if (g->phase_pos >= g->phase_len)
+    {
+        if (p->next >= 0)
+            Gen_EnterPhase(g, p->next);
+        else
+            Gen_EnterSession(g);
+    }
+}
+
+/* ------------------------------
+ * 명령행 진입점
+ * ------------------------------ */
+
+static int Gen_WriteCsv(ScenarioGen* g, const char* path, uint64_t rows, uint64_t* bytes)
+{
+    static char buf[GEN_CSV_BUFFER];
+    FILE* fp = fopen(path, "wb");
+    InputSnapshot in;
+    uint64_t done = 0;
+    long header;
+
+    if (!fp)
+    {
+        printf("ERROR: Failed to open output file : %s\n", path);
+        return 1;
+    }
+
+    Input_WriteHeader(fp);
+    header = ftell(fp);
+    *bytes = header > 0 ? (uint64_t)header : 0;
+
+    while (done < rows)
+    {
+        size_t len = 0;
+
+        while (done < rows && GEN_CSV_BUFFER - len >= INPUT_LINE_MAX)
+        {
+            Scenario_Next(g, &in);
+            len += (size_t)Input_FormatLine(buf + len, &in);
+            done++;
+        }
+
+        if (fwrite(buf, 1, len, fp) != len)
+            break;
+        *bytes += len;
+    }
+
+    if (fclose(fp) != 0 || done < rows)
+    {
+        printf("ERROR: Failed to write output file : %s\n", path);
+        return 1;
+    }
+    return 0;
+}
+
+static int Gen_WriteSnap(ScenarioGen* g, const char* path, uint64_t rows, uint64_t* bytes)
+{
+    static InputSnapshot block[GEN_SNAP_BLOCK];
+    SnapLog s;
+    uint64_t done = 0;
+    int ok = 1;
+
+    if (!SnapLog_Create(&s, path))
+        return 1;
+
+    while (ok && done < rows)
+    {
+        size_t n = 0;
+
+        while (done < rows && n < GEN_SNAP_BLOCK)
+        {
+            Scenario_Next(g, &block[n++]);
+            done++;
+        }
+        ok = SnapLog_Write(&s, block, n);
+    }
+
+    if (!SnapLog_Close(&s) || !ok)
+    {
+        printf("ERROR: Failed to write output file : %s\n", path);
+        return 1;
+    }
+    *bytes = sizeof(SnapLogHeader) + s.rows * sizeof(InputSnapshot);
+    return 0;
+}
+
+int Scenario_Main(int argc, char* argv[])
+{
+    const char* out_path;
+    const char* scenario_file = NULL;
+    Scenario* sc;
+    ScenarioGen g;
+    uint64_t rows = 0;
+    uint64_t seed = 0;
+    uint64_t bytes = 0;
+    int has_rows = 0;
+    int has_seed = 0;
+    int snap = -1;              // -1 : 확장자로 판별
+    int rc;
+
+    if (argc < 3 || strncmp(argv[2], "--", 2) == 0)
+    {
+        printf("ERROR: Output file is not specified\n");
+        return 1;
+    }
+    out_path = argv[2];
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--scenario=", 11) == 0)
+        {
+            scenario_file = argv[i] + 11;
+        }
+        else if (strncmp(argv[i], "--rows=", 7) == 0)
+        {
+            rows = strtoull(argv[i] + 7, NULL, 10);
+            has_rows = 1;
+        }
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+        {
+            seed = strtoull(argv[i] + 7, NULL, 0);
+            has_seed = 1;
+        }
+        else if (strcmp(argv[i], "--format=csv") == 0)
+        {
+            snap = 0;
+        }
+        else if (strcmp(argv[i], "--format=snap") == 0)
+        {
+            snap = 1;
+        }
+        else
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (snap < 0)
+    {
+        const char* dot = strrchr(out_path, '.');
+        snap = dot && strcmp(dot, ".snap") == 0;
+    }
+
+    sc = scenario_file ? Scenario_Load(scenario_file) : Scenario_Compile(Scenario_DefaultText);
+    if (!sc)
+        return 1;
+    if (!has_rows)
+        rows = Scenario_Rows(sc);
+    if (!has_seed)
+        seed = Scenario_Seed(sc);
+
+    printf("Scenario : %s, seed %llu, %llu rows -> %s (%s)\n",
+        scenario_file ? scenario_file : "built-in", (unsigned long long)seed,
+        (unsigned long long)rows, out_path, snap ? "snapshot log" : "CSV");
+
+    Scenario_Start(&g, sc, seed);
+
+    uint64_t t0 = Osal_NowNs();
+    rc = snap ? Gen_WriteSnap(&g, out_path, rows, &bytes) : Gen_WriteCsv(&g, out_path, rows, &bytes);
+    uint64_t t1 = Osal_NowNs();
+    Scenario_Free(sc);
+
+    if (rc != 0)
+        return 1;
+
+    double sec = (double)(t1 - t0) / 1e9;
+    printf("Generated : %llu rows, %llu sessions, %llu faults injected, %.1f MB, %.3f s (%.2f M rows/s)\n",
+        (unsigned long long)g.rows, (unsigned long long)g.sessions, (unsigned long long)g.faults,
+        (double)bytes / (1024.0 * 1024.0), sec, sec > 0 ? (double)g.rows / sec / 1e6 : 0.0);
+    return 0;
+}
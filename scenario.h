@@ -0,0 +1,89 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+#include <stdint.h>
+#include "input.h"
+
+/*
+ * 시나리오 기반 입력 로그 생성기 (fault_engine --gen)
+ *  - 시나리오 텍스트(세션 / 단계 / 신호 프로파일 / 고장 주입 / 노이즈)를 컴파일 후
+ *    1 Cycle씩 InputSnapshot 생성 → 입력 CSV 또는 이진 Snapshot 로그(snap_log.h)로 기록
+ *  - 같은 시나리오 + 같은 seed → 같은 입력 (부하 시험 / 재현용)
+ *
+ * 시나리오 형식 (줄 단위, # 뒤는 주석)
+ *   seed <N>                               기본 seed (--seed 로 변경)
+ *   rows <N>                               생성 행 수 (--rows 로 변경)
+ *   noise <field> <amp>                    단계 값에 균등 노이즈 ±amp (int 필드는 정수)
+ *   sequence <session> ...                 세션 순서 반복 (없으면 가중치 랜덤 선택)
+ *   session <name> [weight]                세션 정의 시작 (기본 weight 1)
+ *     phase <name> <len|min..max> [next=<phase|end>] <field>=<profile> ...
+ *     fault <prob> <len|min..max> [after=N] [goto=<phase>] <field>=<profile> ...
+ *   end                                    세션 정의 끝
+ *
+ *  - phase : 지정 필드만 갱신, 나머지 필드는 이전 값 유지 (세션 간에도 유지)
+ *    next 생략 시 다음 phase, 마지막 phase 후 다음 세션
+ *  - fault : 직전 phase 에 속함, phase 시작 후 after 행 이후부터 행마다 prob 확률로 시작
+ *    → len 행 동안 필드 덮어쓰기 (노이즈 미적용), 끝나면 goto phase 로 이동 (생략 시 원래 phase 계속)
+ *    고장 주입 중에는 phase 가 끝나지 않음
+ *  - profile : <값>          상수
+ *              hold          이전 값 유지
+ *              step(d)       행마다 d 증가
+ *              ramp(a,b[,n]) n 행(생략 시 구간 길이) 동안 a → b 직선 후 b 유지 (a = * : 구간 시작 값)
+ *              rand(a,b)     정수 균등 분포 [a, b]
+ *              urand(a,b)    실수 균등 분포 [a, b)
+ *  - field : InputSnapshot 필드 이름 또는 CSV 헤더 이름 (Cycle 제외)
+ *            Gap : 해당 행 다음 Cycle 번호를 추가로 건너뜀 (Watchdog 지연 / 행 누락)
+ */
+
+/* InputSnapshot 필드 + Gap */
+#define SCENARIO_SLOTS      (INPUT_FIELD_COUNT + 1)
+#define SCENARIO_SLOT_GAP   INPUT_FIELD_COUNT
+
+typedef struct Scenario Scenario;
+
+/* 시나리오 텍스트 / 파일 컴파일 : 실패 시 NULL (오류 내용 출력) */
+Scenario* Scenario_Compile(const char* text);
+Scenario* Scenario_Load(const char* path);
+void Scenario_Free(Scenario* sc);
+
+/* 기본 시나리오 (generate_rawdata.py gen_data1 ~ 3 세션 흐름) */
+extern const char Scenario_DefaultText[];
+
+/* 시나리오 기본 seed / 행 수 */
+uint64_t Scenario_Seed(const Scenario* sc);
+uint64_t Scenario_Rows(const Scenario* sc);
+
+/* 생성 상태 */
+typedef struct
+{
+    const Scenario* sc;
+    uint64_t rng;               // splitmix64 상태
+    int cycle;                  // 마지막 생성 Cycle 번호
+    int seq_pos;                // sequence 위치
+    int session;
+    int phase;                  // 전체 phase 번호
+    int phase_pos;
+    int phase_len;
+    int fault;                  // 진행 중인 고장 주입 (-1 : 없음)
+    int fault_pos;
+    int fault_len;
+
+    double value[SCENARIO_SLOTS];       // 단계 값 (노이즈 / 고장 주입 전)
+    double start[SCENARIO_SLOTS];       // phase 시작 시 값
+    double fault_value[SCENARIO_SLOTS];
+    double fault_start[SCENARIO_SLOTS];
+
+    uint64_t rows;              // 생성한 행 수
+    uint64_t sessions;          // 시작한 세션 수
+    uint64_t faults;            // 주입한 고장 수
+} ScenarioGen;
+
+/* ===== seed 로 생성 시작 (sc 는 생성이 끝날 때까지 유지) ===== */
+void Scenario_Start(ScenarioGen* g, const Scenario* sc, uint64_t seed);
+
+/* ===== 다음 Cycle 입력 1행 생성 ===== */
+void Scenario_Next(ScenarioGen* g, InputSnapshot* out);
+
+/* ===== 명령행 진입점 : fault_engine --gen <output> [options] ===== */
+int Scenario_Main(int argc, char* argv[]);
+
+#endif /* SCENARIO_H */
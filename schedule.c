@@ -0,0 +1,106 @@
+﻿#include "schedule.h"
+#include <stddef.h>
+
+/*
+ * 고장 코드별 태스크 (code, period, phase)
+ *  - 주기는 2의 거듭제곱이고 SCHEDULE_FRAMES 의 약수, 위상 < 주기
+ *  - 같은 표로 공개 표(Schedule_Table)와 프레임별 실행 bitmask(frameMask)를 컴파일 시점에 만듦
+ */
+#define SCHEDULE_TASKS(TASK, f) \
+    TASK(0x01, 1, 0, f)     /* 입력 과전류 */ \
+    TASK(0x02, 1, 0, f)     /* 입력 저전류 */ \
+    TASK(0x03, 1, 0, f)     /* 플러그 (즉시) */ \
+    TASK(0x04, 1, 0, f)     /* 릴레이 (즉시) */ \
+    TASK(0x05, 1, 0, f)     /* BMS 전압 */ \
+    TASK(0x06, 4, 1, f)     /* 과온 */ \
+    TASK(0x07, 1, 0, f)     /* CAN 통신 */ \
+    TASK(0x08, 4, 2, f)     /* 절연 저항 */ \
+    TASK(0x09, 1, 0, f)     /* 결제 */ \
+    TASK(0x0A, 1, 0, f)     /* Watchdog (주기 1 고정) */ \
+    TASK(0x0B, 1, 0, f)     /* 시퀀스 타임아웃 */ \
+    TASK(0x0C, 1, 0, f)     /* 온도 센서 (누적 이상 횟수 기준 : 주기 1 고정) */
+
+#define TASK_ENTRY(code, period, phase, f)  , { period, phase }
+#define TASK_BIT(code, period, phase, f)    | ((((f) & ((period) - 1)) == (phase)) ? 1u << (code) : 0u)
+#define TASK_RUN(code, period, phase, f)    + ((((f) & ((period) - 1)) == (phase)) ? 1 : 0)
+
+#define FRAME_MASK(f)   (0u SCHEDULE_TASKS(TASK_BIT, f))
+#define FRAME_RUNS(f)   (0 SCHEDULE_TASKS(TASK_RUN, f))
+
+const FaultTask Schedule_Table[FAULT_MAX] =
+{
+    { 1, 0 } SCHEDULE_TASKS(TASK_ENTRY, 0)
+};
+
+/* 프레임(tick % SCHEDULE_FRAMES)별 실행 진단 함수 bitmask / 수 */
+static const uint32_t frameMask[SCHEDULE_FRAMES] = { FRAME_MASK(0), FRAME_MASK(1), FRAME_MASK(2), FRAME_MASK(3) };
+static const uint8_t frameRuns[SCHEDULE_FRAMES] = { FRAME_RUNS(0), FRAME_RUNS(1), FRAME_RUNS(2), FRAME_RUNS(3) };
+
+/*
+ * 실행 횟수로 비교하는 시간 기준 Calibration (횟수 / 입력 값 기준 항목은 제외)
+ *  - 연속 지속 Cycle 기준 항목만 변환 (0x0C TS_Time 은 누적 이상 횟수라 주기로 나눌 수 없어 0x0C 는 주기 1)
+ */
+static const struct { FaultCode code; size_t offset; } timeFields[] =
+{
+    { FAULT_INPUT_OVERCURRENT,  offsetof(FaultCalibration, OC_Time) },
+    { FAULT_INPUT_UNDERCURRENT, offsetof(FaultCalibration, UC_Time) },
+    { FAULT_BMS_STATE,          offsetof(FaultCalibration, BMS_Time) },
+    { FAULT_BMS_STATE,          offsetof(FaultCalibration, BMS_RecTime) },
+    { FAULT_OVER_TEMP,          offsetof(FaultCalibration, OT_Time) },
+    { FAULT_OVER_TEMP,          offsetof(FaultCalibration, OT_RecTime) },
+    { FAULT_CAN,                offsetof(FaultCalibration, CAN_Time) },
+    { FAULT_CAN,                offsetof(FaultCalibration, CAN_RecTime) },
+    { FAULT_ISO,                offsetof(FaultCalibration, ISO_Time) },
+    { FAULT_ISO,                offsetof(FaultCalibration, ISO_RecTime) },
+    { FAULT_PAYMENT,            offsetof(FaultCalibration, PAY_Time) },
+    { FAULT_SEQ_TIMEOUT,        offsetof(FaultCalibration, SEQ_WaitTime) },
+    { FAULT_SEQ_TIMEOUT,        offsetof(FaultCalibration, SEQ_FaultTime) },
+    { FAULT_SEQ_TIMEOUT,        offsetof(FaultCalibration, SEQ_ChargTime) },
+    { FAULT_TEMP_SENSOR,        offsetof(FaultCalibration, TS_Time) }
+};
+
+void Schedule_ScaleCalibration(FaultCalibration* cal)
+{
+    for (size_t i = 0; i < sizeof(timeFields) / sizeof(timeFields[0]); i++)
+    {
+        int32_t period = Schedule_Table[timeFields[i].code].period;
+        int32_t* t = (int32_t*)((char*)cal + timeFields[i].offset);
+
+        /*
+         * 연속 N Cycle 동안 실행 횟수는 최대 ceil(N / period)
+         *  → ceil(N / period) >= T' 이면 N >= T 가 되도록 T' = ceil((T - 1) / period) + 1 (T >= 2 이면 T' >= 2)
+         *  → 전체 실행보다 먼저 확정 / 회복하지 않고 1회 실행만으로 확정하지 않음
+         */
+        if (period > 1 && *t > 1)
+            *t = (*t + period - 2) / period + 1;
+    }
+}
+
+void Schedule_InitContext(FaultContext* ctx)
+{
+    Fault_InitContext(ctx);
+    Schedule_ScaleCalibration(&ctx->cal);
+}
+
+uint32_t Schedule_Mask(uint64_t tick)
+{
+    /* 초주기가 2의 거듭제곱 : 나눗셈 없이 하위 bit 로 프레임 선택 */
+    return frameMask[tick & (SCHEDULE_FRAMES - 1)];
+}
+
+int Schedule_Diagnose(FaultContext* ctx, uint64_t tick, const InputSnapshot* in)
+{
+    size_t f = (size_t)(tick & (SCHEDULE_FRAMES - 1));
+
+    Fault_DiagnoseMask(ctx, frameMask[f], in);
+    return frameRuns[f];
+}
+
+double Schedule_RunsPerCycle(void)
+{
+    int runs = 0;
+
+    for (int f = 0; f < SCHEDULE_FRAMES; f++)
+        runs += frameRuns[f];
+    return (double)runs / SCHEDULE_FRAMES;
+}
@@ -0,0 +1,43 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 다중 주기 진단 스케줄 (--schedule)
+ *  - 고장 코드별 정적 태스크 표 : 주기(기본 Cycle 배수) / 위상, tick % period == phase 인 Cycle 에만 진단 함수 실행
+ *    (표에서 초주기 프레임별 실행 bitmask 를 컴파일 시점에 만들어 Cycle 당 표 조회 1회 + Fault_DiagnoseMask)
+ *    → 느리게 변하는 과온(0x06) / 절연 저항(0x08)은 4 Cycle 마다, 위상을 나누어 Cycle 당 실행 수를 고르게
+ *  - 연속 지속 Cycle 기준 Calibration(Detect/Confirm/Recovery)은 T' = ceil((T - 1) / period) + 1 회 실행으로 변환
+ *    → 연속 고장은 전체 실행보다 먼저 확정 / 회복하지 않고(T >= 2 이면 T' >= 2), 늦어질 수 있음 (T = 10, period 4 : 연속 13 ~ 16 Cycle)
+ *    → 실행하지 않는 Cycle 에만 나타난 짧은 이상(glitch)은 보지 못함 (전체 실행의 DETECT 가 생략될 수 있음)
+ *  - 0x0C 온도 센서는 누적 이상 횟수(TS_Time)로 확정하므로 주기로 나누면 의미가 달라져 주기 1 고정
+ *  - 0x0A Watchdog 은 입력 Cycle 간격을 직접 보므로 주기 1 고정, 실행하지 않는 Cycle 의 고장 상태는 직전 값 유지
+ */
+
+#define SCHEDULE_FRAMES 4       // 초주기 (Cycle) : 모든 태스크 주기의 최소공배수, 2의 거듭제곱
+
+typedef struct
+{
+    uint8_t period;             // 실행 주기 (Cycle, SCHEDULE_FRAMES 의 약수, 1 : 매 Cycle)
+    uint8_t phase;              // 실행 위상 (0 ~ period - 1)
+} FaultTask;
+
+extern const FaultTask Schedule_Table[FAULT_MAX];
+
+/* ===== 시간 기준 Calibration 을 태스크 주기에 맞게 변환 (실행 횟수 = ceil((Cycle - 1) / period) + 1, 1 이하 유지) ===== */
+void Schedule_ScaleCalibration(FaultCalibration* cal);
+
+/* ===== Context 초기화 + Calibration 변환 ===== */
+void Schedule_InitContext(FaultContext* ctx);
+
+/* ===== tick 에 실행할 진단 함수 bitmask (bit code) ===== */
+uint32_t Schedule_Mask(uint64_t tick);
+
+/* ===== tick(0 부터 1씩 증가하는 실행 번호)에 해당하는 진단 함수만 실행, 실행한 진단 함수 수 반환 ===== */
+int Schedule_Diagnose(FaultContext* ctx, uint64_t tick, const InputSnapshot* in);
+
+/* ===== 태스크 표 평균 Cycle 당 실행 수 ===== */
+double Schedule_RunsPerCycle(void);
+
+#endif /* SCHEDULE_H */
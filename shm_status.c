@@ -0,0 +1,302 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "shm_status.h"
+#include "osal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* 읽기 재시도 한도 (기록 중 구간은 Cycle 당 수십 ns, 64회마다 CPU 양보) */
+#define SHM_READ_RETRY_MAX  100000u
+
+/*
+ * 상전류 → mA (빌드별 표현과 무관한 게시 형식)
+ *  - 두 빌드 모두 CSV 10진 값의 mA 미만 버림(0 방향), ±1073741823 mA 포화
+ *  - float 빌드 : float 반 ulp 이내(최대 0.5 mA)로 다음 mA 에 가까우면 표현 오차로 보고 그 mA
+ *    (|I| < 8192 A, 유효숫자 7자리 이하 값은 고정소수점 빌드와 같은 값)
+ */
+#define SHM_MA_MAX  1073741823
+
+static int32_t Shm_CurrentMa(InputCurrent c)
+{
+#ifdef OBC_FIXED_POINT
+    int32_t ma = c / (INPUT_CURRENT_SCALE / 1000);
+
+    return (ma < -SHM_MA_MAX) ? -SHM_MA_MAX : ma;
+#else
+    double a = fabs((double)c);
+    double ma = a * 1000.0;
+    double whole;
+    double tol;
+    int e;
+
+    if (!(ma < (double)SHM_MA_MAX))     // nan 포함
+        return ma != ma ? 0 : (c < 0 ? -SHM_MA_MAX : SHM_MA_MAX);
+
+    whole = floor(ma);
+    frexp(a, &e);                       // a : [2^(e-1), 2^e), 반 ulp = 2^(e-25)
+    tol = ldexp(1000.0, e - 25);
+    if (tol > 0.5)
+        tol = 0.5;
+    if (whole + 1.0 - ma <= tol)
+        whole += 1.0;
+    return (int32_t)(c < 0 ? -whole : whole);
+#endif
+}
+
+void ShmStatus_Publish(ShmPublisher* p, const InputSnapshot* in, const FaultContext* ctx)
+{
+    ShmStatusData* d = &p->data;
+
+    d->cycle = in->Cycle;
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        d->state[code] = (uint8_t)ctx->state[code];
+    d->running = 1;
+    d->seq_state = in->SeqState;
+    d->plug_info = in->PlugInfo;
+    d->flag_stop = in->FLAG_Stop;
+    d->flag_relay = in->FLAG_Relay;
+    d->ia_ma = Shm_CurrentMa(in->Ia);
+    d->ib_ma = Shm_CurrentMa(in->Ib);
+    d->ic_ma = Shm_CurrentMa(in->Ic);
+    d->fault_state = in->FaultState;
+    d->charg_cnt = in->Charg_Cnt;
+    d->real_v = in->Real_V;
+    d->exp_v = in->Exp_V;
+    d->h = in->H;
+    d->can_msg = in->CanMsg;
+    d->iso_r = in->IsoR;
+    d->rows++;
+    d->updated_ns = Osal_NowNs();
+
+    /* seqlock 기록 : 홀수 → 내용 → 짝수 (읽는 쪽을 기다리지 않음) */
+    OSAL_STORE_RELEASE(&p->seg->seq, p->seq + 1);
+    OSAL_FENCE_RELEASE();
+    memcpy(&p->seg->data, d, sizeof(*d));
+    p->seq += 2;
+    OSAL_STORE_RELEASE(&p->seg->seq, p->seq);
+}
+
+#ifndef _WIN32
+
+int ShmStatus_Create(ShmPublisher* p, const char* name)
+{
+    int fd;
+    void* map;
+
+    memset(p, 0, sizeof(*p));
+
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        printf("ERROR: Failed to create shared memory : %s\n", name);
+        return 0;
+    }
+    if (ftruncate(fd, (off_t)sizeof(ShmStatusSegment)) != 0)
+    {
+        printf("ERROR: Failed to size shared memory : %s\n", name);
+        close(fd);
+        return 0;
+    }
+
+    map = mmap(NULL, sizeof(ShmStatusSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        printf("ERROR: Failed to map shared memory : %s\n", name);
+        return 0;
+    }
+
+    p->seg = (ShmStatusSegment*)map;
+
+    /* 이전 실행의 세그먼트 재사용 : seq 는 이어서 증가 (읽는 중인 프로세스가 변경을 감지하도록) */
+    p->seq = OSAL_LOAD_ACQUIRE(&p->seg->seq) & ~(uint64_t)1;
+    OSAL_STORE_RELEASE(&p->seg->seq, p->seq + 1);
+    OSAL_FENCE_RELEASE();
+    memset(&p->seg->data, 0, sizeof(p->seg->data));
+    p->seg->magic = SHM_STATUS_MAGIC;
+    p->seg->version = SHM_STATUS_VERSION;
+    p->seg->size = (uint32_t)sizeof(ShmStatusSegment);
+    p->seg->pid = (uint32_t)getpid();
+    p->seq += 2;
+    OSAL_STORE_RELEASE(&p->seg->seq, p->seq);
+    return 1;
+}
+
+void ShmStatus_Close(ShmPublisher* p)
+{
+    if (!p->seg)
+        return;
+
+    p->data.running = 0;
+    p->data.updated_ns = Osal_NowNs();
+    OSAL_STORE_RELEASE(&p->seg->seq, p->seq + 1);
+    OSAL_FENCE_RELEASE();
+    memcpy(&p->seg->data, &p->data, sizeof(p->data));
+    p->seq += 2;
+    OSAL_STORE_RELEASE(&p->seg->seq, p->seq);
+
+    munmap(p->seg, sizeof(ShmStatusSegment));
+    p->seg = NULL;
+}
+
+int ShmStatus_Read(const char* name, ShmStatusData* out, uint32_t* retries)
+{
+    const ShmStatusSegment* seg;
+    struct stat st;
+    void* map;
+    uint32_t n = 0;
+    int ok = 0;
+    int fd = shm_open(name, O_RDONLY, 0);
+
+    if (retries)
+        *retries = 0;
+    if (fd < 0)
+        return 0;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ShmStatusSegment))
+    {
+        close(fd);
+        return 0;
+    }
+
+    map = mmap(NULL, sizeof(ShmStatusSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return 0;
+    seg = (const ShmStatusSegment*)map;
+
+    /* seqlock 읽기 : 짝수 seq 에서 복사하고 복사 후 seq 가 같으면 일관된 사본 */
+    for (; n < SHM_READ_RETRY_MAX; n++)
+    {
+        uint64_t s1 = OSAL_LOAD_ACQUIRE(&seg->seq);
+
+        if (s1 & 1u)
+        {
+            /* 게시 측이 기록 중 선점되었을 수 있으므로 가끔 CPU 양보 */
+            if ((n & 63u) == 63u)
+                Osal_Yield();
+            else
+                OSAL_CPU_RELAX();
+            continue;
+        }
+
+        memcpy(out, &seg->data, sizeof(*out));
+        OSAL_FENCE_ACQUIRE();
+
+        if (OSAL_LOAD_ACQUIRE(&seg->seq) == s1)
+        {
+            ok = seg->magic == SHM_STATUS_MAGIC && seg->version == SHM_STATUS_VERSION &&
+                seg->size == sizeof(ShmStatusSegment);
+            break;
+        }
+    }
+
+    if (retries)
+        *retries = n;
+    munmap(map, sizeof(ShmStatusSegment));
+    return ok;
+}
+
+#else
+
+int ShmStatus_Create(ShmPublisher* p, const char* name)
+{
+    (void)name;
+    memset(p, 0, sizeof(*p));
+    printf("ERROR: Shared memory status is only supported on POSIX systems\n");
+    return 0;
+}
+
+void ShmStatus_Close(ShmPublisher* p)
+{
+    p->seg = NULL;
+}
+
+int ShmStatus_Read(const char* name, ShmStatusData* out, uint32_t* retries)
+{
+    (void)name;
+    memset(out, 0, sizeof(*out));
+    if (retries)
+        *retries = 0;
+    return 0;
+}
+
+#endif
+
+static void ShmStatus_Print(const ShmStatusData* d, uint32_t retries)
+{
+    uint64_t now = Osal_NowNs();
+    double age_ms = now > d->updated_ns ? (double)(now - d->updated_ns) / 1e6 : 0.0;
+
+    printf("Cycle %d (%s, %llu rows, updated %.1f ms ago, %u retries)\n", d->cycle,
+        d->running ? "running" : "stopped", (unsigned long long)d->rows, age_ms, (unsigned)retries);
+
+    printf("  fault :");
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        printf(" %02X=%u", code, (unsigned)d->state[code]);
+    printf("\n");
+
+    printf("  input : Seq %d, Plug %d, Stop %d, Relay %d, Ia %.3f A, Ib %.3f A, Ic %.3f A, Charg_Cnt %d, "
+        "Real_V %d, Exp_V %d, H %d, CanMsg %d, IsoR %d\n",
+        d->seq_state, d->plug_info, d->flag_stop, d->flag_relay,
+        d->ia_ma / 1000.0, d->ib_ma / 1000.0, d->ic_ma / 1000.0, d->charg_cnt,
+        d->real_v, d->exp_v, d->h, d->can_msg, d->iso_r);
+}
+
+int ShmStatus_Main(int argc, char* argv[])
+{
+    const char* name = SHM_STATUS_DEFAULT;
+    int watch_ms = 0;
+    long count = 1;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--watch=", 8) == 0)
+        {
+            watch_ms = atoi(argv[i] + 8);
+            count = 0;
+        }
+        else if (strncmp(argv[i], "--count=", 8) == 0)
+            count = atol(argv[i] + 8);
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+        else
+            name = argv[i];
+    }
+
+    if (watch_ms < 0 || count < 0)
+    {
+        printf("ERROR: Invalid status option value\n");
+        return 1;
+    }
+
+    for (long n = 0; count == 0 || n < count; n++)
+    {
+        ShmStatusData d;
+        uint32_t retries;
+
+        if (n > 0)
+            Osal_SleepNs((uint64_t)(watch_ms > 0 ? watch_ms : 1000) * 1000000u);
+
+        if (!ShmStatus_Read(name, &d, &retries))
+        {
+            printf("ERROR: No engine status in shared memory : %s\n", name);
+            return 1;
+        }
+        ShmStatus_Print(&d, retries);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#ifndef SHM_STATUS_H
+#define SHM_STATUS_H
+#include <stdint.h>
+#include "input.h"
+#include "fault.h"
+
+/*
+ * 공유 메모리 실시간 상태 게시 (--shm, POSIX shm_open)
+ *  - 진단 Cycle 마다 최신 Cycle / 고장 상태 12개 / 주요 입력 신호를 공유 메모리 세그먼트에 게시
+ *  - seqlock : 기록 전후 seq 증가 (홀수 : 기록 중), 읽는 쪽은 seq 가 짝수이고 복사 전후 같을 때까지 재시도
+ *    → 진단 루프는 잠금 / 대기 없이 기록만 하고, 읽는 프로세스 수에 제한 없음
+ *  - 전류는 빌드와 무관하게 mA 정수로 게시 (mA 미만 버림, float / OBC_FIXED_POINT 빌드 공통 배치)
+ *  - 엔진 종료 시 running = 0 으로 마지막 상태를 남기고 세그먼트는 유지 (다음 실행이 다시 사용)
+ */
+
+#define SHM_STATUS_MAGIC    0x5453424Fu     /* "OBST" */
+#define SHM_STATUS_VERSION  1u
+#define SHM_STATUS_DEFAULT  "/obc_fault_status"
+
+/* 게시 내용 (seqlock 으로 보호) */
+typedef struct
+{
+    int32_t cycle;
+    uint8_t state[FAULT_MAX];   // FaultStatus (0 번 미사용)
+    uint8_t running;            // 1 : 엔진 실행 중, 0 : 종료 (마지막 상태)
+    uint8_t reserved[2];
+    int32_t seq_state;
+    int32_t plug_info;
+    int32_t flag_stop;
+    int32_t flag_relay;
+    int32_t ia_ma;              // 상전류 (mA, 0 방향 버림)
+    int32_t ib_ma;
+    int32_t ic_ma;
+    int32_t fault_state;
+    int32_t charg_cnt;
+    int32_t real_v;
+    int32_t exp_v;
+    int32_t h;
+    int32_t can_msg;
+    int32_t iso_r;
+    uint64_t rows;              // 게시한 Cycle 수
+    uint64_t updated_ns;        // 게시 시각 (Osal_NowNs, 같은 호스트 기준)
+} ShmStatusData;
+
+/* 세그먼트 배치 */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;              // sizeof(ShmStatusSegment)
+    uint32_t pid;               // 게시 프로세스
+    uint64_t seq;               // seqlock (홀수 : 기록 중)
+    ShmStatusData data;
+} ShmStatusSegment;
+
+typedef struct
+{
+    ShmStatusSegment* seg;
+    uint64_t seq;               // 게시 측 seq 사본
+    ShmStatusData data;         // 게시 측 작업 버퍼
+} ShmPublisher;
+
+/* ===== 세그먼트 생성 / 연결 (name : "/" 로 시작) : 성공 1, 실패 0 ===== */
+int ShmStatus_Create(ShmPublisher* p, const char* name);
+
+/* ===== 진단 직후 1 Cycle 게시 (대기 없음) ===== */
+void ShmStatus_Publish(ShmPublisher* p, const InputSnapshot* in, const FaultContext* ctx);
+
+/* ===== running = 0 게시 후 연결 해제 (세그먼트는 유지) ===== */
+void ShmStatus_Close(ShmPublisher* p);
+
+/* ===== 일관된 사본 읽기 : 성공 1, 세그먼트 없음 / 형식 불일치 / 재시도 초과 0 (retries : 재시도 수, NULL 가능) ===== */
+int ShmStatus_Read(const char* name, ShmStatusData* out, uint32_t* retries);
+
+/* ===== 명령행 진입점 : fault_engine --status [name] [--watch=ms] [--count=N], 성공 0 ===== */
+int ShmStatus_Main(int argc, char* argv[]);
+
+#endif /* SHM_STATUS_H */
@@ -0,0 +1,713 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "sim.h"
+#include "input.h"
+#include "osal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* 사용자 단계 */
+enum
+{
+    SIM_USER_AWAY,              // 플러그 미연결
+    SIM_USER_PAYING,            // 플러그 연결, 결제 전
+    SIM_USER_PLUGGED            // 결제 완료, 충전 대기 / 충전 중
+};
+
+#define SIM_CHARGE_LIMIT    3600    // example.c 충전 시간 초과 기준 (ChargingTime > 3600)
+#define SIM_EVENT_AFTER     25      // 충전 안정 후 외란 시작 (Charg_Cnt)
+#define SIM_PATIENCE        60      // 결제 후 충전이 시작되지 않을 때 사용자 대기 Cycle
+#define SIM_TRACE_BUFFER    (1u << 20)
+
+/* 이벤트 길이(Cycle) / 선택 가중치 (synth.c 와 같은 구성) */
+static const int eventLength[SIM_EVENT_COUNT] = { 0, 12, 12, 1, 2, 12, 12, 7, 12, 4, 1 };
+static const int eventWeight[SIM_EVENT_COUNT] = { 0, 10, 10, 1, 4, 10, 2, 10, 6, 4, 4 };
+
+static const char* const eventNames[SIM_EVENT_COUNT] =
+{
+    "none", "overcurrent", "undercurrent", "plug_pull", "relay", "bms",
+    "over_temp", "can_loss", "iso", "temp_sensor", "wdt"
+};
+
+/* splitmix64 */
+static uint64_t Sim_Rand(SimWorld* w)
+{
+    uint64_t z = (w->rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int Sim_Below(SimWorld* w, int n)
+{
+    return (int)(Sim_Rand(w) % (uint64_t)n);
+}
+
+static double Sim_Unit(SimWorld* w)
+{
+    return (double)(Sim_Rand(w) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void Sim_DefaultConfig(SimConfig* cfg)
+{
+    cfg->event_rate = 1.0 / 400.0;
+    cfg->unpaid_rate = 1.0 / 20.0;
+    cfg->ramp_cycles = 10;
+    cfg->reset_limit = Fault_DefaultCalibration.SEQ_FaultTime - 1;
+    cfg->service_limit = 100;
+    cfg->demand_min = 200;
+    cfg->demand_max = 3399;                     // SEQ_ChargTime 이내
+    cfg->sessions_max = 0;
+}
+
+const char* Sim_EventName(SimEvent event)
+{
+    return (event >= 0 && event < SIM_EVENT_COUNT) ? eventNames[event] : "unknown";
+}
+
+/* ------------------------------
+ * 플랜트 : 사용자
+ * ------------------------------ */
+
+static void User_Away(SimWorld* w)
+{
+    SimPlant* p = &w->plant;
+
+    p->user = SIM_USER_AWAY;
+    p->user_cnt = 0;
+    p->user_len = 3 + Sim_Below(w, 18);
+    p->plug = PLUG_UNPLUGGED;
+}
+
+static void User_Step(SimWorld* w)
+{
+    SimPlant* p = &w->plant;
+    int seq = w->ctrl.seq;
+
+    p->user_cnt++;
+
+    switch (p->user)
+    {
+    case SIM_USER_AWAY:
+        if (p->user_cnt >= p->user_len &&
+            (w->cfg.sessions_max <= 0 || w->stats.sessions < (uint64_t)w->cfg.sessions_max))
+        {
+            /* 새 세션 : 플러그 연결 */
+            p->user = SIM_USER_PAYING;
+            p->user_cnt = 0;
+            p->paid = Sim_Unit(w) >= w->cfg.unpaid_rate;
+            p->user_len = p->paid ? 1 + Sim_Below(w, 4) : 6 + Sim_Below(w, 25);
+            p->plug = PLUG_CONNECTED_NO_PAY;
+            p->target_i = 16 + Sim_Below(w, 6);        // OC_Inormal 미만
+            p->demand = w->cfg.demand_min + Sim_Below(w, w->cfg.demand_max - w->cfg.demand_min + 1);
+            p->charged = 0;
+            w->stats.sessions++;
+        }
+        break;
+
+    case SIM_USER_PAYING:
+        if (p->user_cnt >= p->user_len)
+        {
+            if (p->paid)
+            {
+                p->user = SIM_USER_PLUGGED;
+                p->user_cnt = 0;
+                p->plug = PLUG_CONNECTED_PAID;
+            }
+            else
+            {
+                User_Away(w);   // 미결제 : 포기 후 분리
+            }
+        }
+        break;
+
+    default:
+        /* 충전 중에는 대기, 종료 후 / 충전이 시작되지 않으면 분리 */
+        if (seq == SEQ_CHARGING)
+            p->user_cnt = 0;
+        else if ((seq == SEQ_SHUTDOWN && p->user_cnt >= 2) || p->user_cnt >= SIM_PATIENCE)
+            User_Away(w);
+        break;
+    }
+}
+
+/* ------------------------------
+ * 플랜트 : 외란 이벤트
+ * ------------------------------ */
+
+void Sim_StartEvent(SimWorld* w, SimEvent event)
+{
+    SimPlant* p = &w->plant;
+
+    if (event <= SIM_EVENT_NONE || event >= SIM_EVENT_COUNT)
+    {
+        p->event = SIM_EVENT_NONE;
+        return;
+    }
+
+    p->event = event;
+    p->event_pos = 0;
+    p->event_len = eventLength[event];
+    w->stats.events[event]++;
+
+    switch (p->event)
+    {
+    case SIM_EVENT_OVERCURRENT:
+        p->event_value = 33 + Sim_Below(w, 4);
+        break;
+    case SIM_EVENT_BMS:
+        p->event_value = 15 + Sim_Below(w, 12);
+        break;
+    case SIM_EVENT_WDT:
+        p->event_value = 1 + Sim_Below(w, 12);     // WDT_MaxGap 전후
+        break;
+    case SIM_EVENT_PLUG_PULL:
+        User_Away(w);
+        break;
+    default:
+        p->event_value = 0;
+        break;
+    }
+}
+
+static void Event_Start(SimWorld* w)
+{
+    int total = 0;
+    int pick;
+    int e;
+
+    for (e = 1; e < SIM_EVENT_COUNT; e++)
+        total += eventWeight[e];
+
+    pick = Sim_Below(w, total);
+    for (e = 1; pick >= eventWeight[e]; e++)
+        pick -= eventWeight[e];
+
+    Sim_StartEvent(w, (SimEvent)e);
+}
+
+/* ------------------------------
+ * 플랜트 : 측정값
+ * ------------------------------ */
+
+static void Plant_Measure(SimWorld* w, InputSnapshot* out)
+{
+    SimPlant* p = &w->plant;
+    const SimController* c = &w->ctrl;
+    int relay = c->relay_cmd;
+    int k = p->event_pos;
+    double i_avg;
+
+    if (p->event == SIM_EVENT_NONE && c->seq == SEQ_CHARGING &&
+        c->charging_time > SIM_EVENT_AFTER && Sim_Unit(w) < w->cfg.event_rate)
+        Event_Start(w);
+
+    if (p->event == SIM_EVENT_RELAY)
+        relay = 0;
+
+    /* 3상 전류 : 릴레이 ON 시 ramp-up 설정값 추종 (±1 A) */
+    if (relay)
+    {
+        int ramp = w->cfg.ramp_cycles > 0 ? w->cfg.ramp_cycles : 1;
+        int sp = (int)floor(p->target_i * (c->rampup < ramp ? c->rampup : ramp) / ramp + 0.5);
+
+        if (sp < 1)
+            sp = 1;
+        out->Ia = INPUT_CURRENT(sp - 1 + Sim_Below(w, 3));
+        out->Ib = INPUT_CURRENT(sp - 1 + Sim_Below(w, 3));
+        out->Ic = INPUT_CURRENT(sp - 1 + Sim_Below(w, 3));
+
+        if (p->event == SIM_EVENT_OVERCURRENT)
+        {
+            out->Ia = INPUT_CURRENT(p->event_value + k % 4);
+            out->Ib = out->Ia - INPUT_CURRENT(1);
+            out->Ic = out->Ia + INPUT_CURRENT(1);
+        }
+        else if (p->event == SIM_EVENT_UNDERCURRENT)
+        {
+            int ia = 4 - k / 4 > 1 ? 4 - k / 4 : 1;
+            out->Ia = out->Ic = INPUT_CURRENT(ia);
+            out->Ib = INPUT_CURRENT(ia + 1);
+        }
+
+        if (c->seq == SEQ_CHARGING)
+            p->charged++;
+    }
+    else
+    {
+        out->Ia = out->Ib = out->Ic = INPUT_CURRENT(0);
+    }
+
+    /* 온도 : 주위 온도 + 전류 발열, 1차 지연 (냉각 이상 시 상승) */
+    i_avg = (Input_CurrentToDouble(out->Ia) + Input_CurrentToDouble(out->Ib) + Input_CurrentToDouble(out->Ic)) / 3.0;
+    if (p->event == SIM_EVENT_OVER_TEMP)
+        p->temp += 2.5;
+    else
+        p->temp += (p->ambient + 1.2 * i_avg - p->temp) / 40.0;
+
+    out->H = (int)floor(p->temp + 0.5);
+    if (p->event == SIM_EVENT_TEMP_SENSOR)
+        out->H = 122 + k * 3;
+
+    /* 배터리 전압 : 충전량에 따라 상승 */
+    out->Exp_V = 360 + (p->demand > 0 ? 40 * (p->charged < p->demand ? p->charged : p->demand) / p->demand : 0);
+    out->Real_V = out->Exp_V - 2 + Sim_Below(w, 5);
+    if (p->event == SIM_EVENT_BMS)
+        out->Real_V += p->event_value + k;
+
+    out->CanMsg = p->event == SIM_EVENT_CAN_LOSS ? 0 : 1;
+    out->IsoR = p->event == SIM_EVENT_ISO ? (450 - k * 40 > 50 ? 450 - k * 40 : 50) : 800000;
+    out->PlugInfo = p->plug;
+
+    /* 제어기 출력 (FaultState : 이전 Cycle 진단 결과 종합) */
+    out->SeqState = c->seq;
+    out->FLAG_Stop = c->flag_stop;
+    out->FLAG_Relay = relay;
+    out->Charg_Cnt = c->charging_time;
+}
+
+/* ------------------------------
+ * 제어기 : example.c OBC_Sequence
+ *  - 전이 조건은 example.c 와 동일, 상태 동작(출력)은 전이 직후 실행하여 다음 Cycle 입력에 반영
+ *  - Protection() 대신 진단 엔진 종합 상태 사용
+ *  - RESET 은 고장 해제까지 대기하되 reset_limit 초과 시 INIT 복귀
+ *    (INIT 에서만 회복되는 고장이 있어 무한 대기 시 0x0B 타임아웃 발생)
+ * ------------------------------ */
+
+static FaultStatus Fault_Summary(const FaultContext* ctx)
+{
+    FaultStatus st = FAULT_NORMAL;
+
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if (ctx->state[code] == FAULT_CONFIRM)
+            return FAULT_CONFIRM;
+        if (ctx->state[code] == FAULT_DETECT)
+            st = FAULT_DETECT;
+    }
+    return st;
+}
+
+static void Ctrl_Enter(SimController* c, int seq)
+{
+    if (seq != c->seq)
+        c->reset_cnt = 0;
+    c->seq = seq;
+}
+
+static void Ctrl_Step(SimWorld* w, FaultStatus fault)
+{
+    SimController* c = &w->ctrl;
+    const SimPlant* p = &w->plant;
+    int plug = p->plug;
+
+    switch (c->seq)
+    {
+    case SEQ_INIT:
+        if (plug > PLUG_UNPLUGGED)
+            Ctrl_Enter(c, SEQ_WAIT);
+        break;
+
+    case SEQ_WAIT:
+        if (plug == PLUG_UNPLUGGED)
+            Ctrl_Enter(c, SEQ_INIT);
+        else if (plug == PLUG_CONNECTED_PAID && fault == FAULT_NORMAL)
+        {
+            Ctrl_Enter(c, SEQ_CHARGING);
+            c->rampup = 0;
+            w->stats.charges++;
+        }
+        break;
+
+    case SEQ_CHARGING:
+        if (plug == PLUG_UNPLUGGED)
+        {
+            Ctrl_Enter(c, SEQ_SHUTDOWN);
+            w->stats.unplugged++;
+        }
+        else if (c->charging_time > SIM_CHARGE_LIMIT || p->charged >= p->demand)
+        {
+            Ctrl_Enter(c, SEQ_SHUTDOWN);
+            w->stats.completed++;
+        }
+        else if (fault == FAULT_CONFIRM)
+        {
+            Ctrl_Enter(c, SEQ_FAULT);
+            w->stats.fault_stops++;
+        }
+        break;
+
+    case SEQ_FAULT:
+        Ctrl_Enter(c, SEQ_RESET);
+        break;
+
+    case SEQ_RESET:
+        if (fault == FAULT_NORMAL || ++c->reset_cnt >= w->cfg.reset_limit)
+            Ctrl_Enter(c, SEQ_INIT);
+        break;
+
+    case SEQ_SHUTDOWN:
+        if (plug == PLUG_UNPLUGGED)
+            Ctrl_Enter(c, SEQ_INIT);
+        break;
+
+    default:
+        Ctrl_Enter(c, SEQ_INIT);
+        break;
+    }
+
+    /* 상태 동작 */
+    c->flag_stop = 1;
+    c->relay_cmd = 0;
+    switch (c->seq)
+    {
+    case SEQ_INIT:
+        c->charging_time = 0;
+        c->rampup = 0;
+        break;
+
+    case SEQ_CHARGING:
+        c->flag_stop = 0;
+        c->relay_cmd = 1;
+        if (c->rampup < w->cfg.ramp_cycles)
+            c->rampup++;
+        c->charging_time++;
+        break;
+
+    case SEQ_SHUTDOWN:
+        c->rampup = 0;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* ------------------------------
+ * 시뮬레이터
+ * ------------------------------ */
+
+void Sim_Init(SimWorld* w, const SimConfig* cfg, uint64_t seed)
+{
+    memset(w, 0, sizeof(*w));
+    w->cfg = *cfg;
+    w->rng = seed;
+    Fault_InitContext(&w->engine);
+
+    w->ctrl.seq = SEQ_INIT;
+    w->ctrl.flag_stop = 1;
+
+    w->plant.ambient = 10 + Sim_Below(w, 21);
+    w->plant.temp = w->plant.ambient;
+    User_Away(w);
+}
+
+int Sim_Step(SimWorld* w, InputSnapshot* out)
+{
+    SimPlant* p = &w->plant;
+    FaultStatus fault;
+
+    /* 1. 플랜트 → 입력 */
+    User_Step(w);
+    Plant_Measure(w, out);
+    out->FaultState = Fault_Summary(&w->engine);
+    out->Cycle = ++w->cycle;
+
+    /* 2. 진단 */
+    Fault_DiagnoseContext(&w->engine, out);
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+    {
+        if (w->engine.state[code] == FAULT_CONFIRM && w->prev[code] != FAULT_CONFIRM)
+            w->stats.confirms[code]++;
+        w->prev[code] = w->engine.state[code];
+    }
+    w->stats.cycles++;
+    w->stats.state_cycles[out->SeqState]++;
+
+    /* 3. 이벤트 진행 (Watchdog 지연 : 다음 Cycle 번호 건너뜀) */
+    if (p->event != SIM_EVENT_NONE)
+    {
+        if (p->event == SIM_EVENT_WDT && p->event_pos == 0)
+            w->cycle += p->event_value;
+        if (++p->event_pos >= p->event_len)
+            p->event = SIM_EVENT_NONE;
+    }
+
+    /* 4. 제어기 */
+    fault = Fault_Summary(&w->engine);
+    Ctrl_Step(w, fault);
+
+    /* 5. 충전 불가 지속 → 서비스 리셋 (래치 해제) */
+    w->blocked = (fault == FAULT_CONFIRM && w->ctrl.seq != SEQ_CHARGING) ? w->blocked + 1 : 0;
+    if (w->cfg.service_limit > 0 && w->blocked >= w->cfg.service_limit)
+    {
+        Fault_InitContext(&w->engine);
+        memset(w->prev, 0, sizeof(w->prev));
+        memset(&w->ctrl, 0, sizeof(w->ctrl));
+        w->ctrl.seq = SEQ_INIT;
+        w->ctrl.flag_stop = 1;
+        p->event = SIM_EVENT_NONE;
+        p->temp = p->ambient;
+        User_Away(w);
+        w->blocked = 0;
+        w->stats.service_resets++;
+        return 1;
+    }
+    return 0;
+}
+
+void Sim_StatsMerge(SimStats* dst, const SimStats* src)
+{
+    dst->cycles += src->cycles;
+    dst->sessions += src->sessions;
+    dst->charges += src->charges;
+    dst->completed += src->completed;
+    dst->unplugged += src->unplugged;
+    dst->fault_stops += src->fault_stops;
+    dst->service_resets += src->service_resets;
+    for (int e = 0; e < SIM_EVENT_COUNT; e++)
+        dst->events[e] += src->events[e];
+    for (int code = 0; code < FAULT_MAX; code++)
+        dst->confirms[code] += src->confirms[code];
+    for (int s = 0; s < 6; s++)
+        dst->state_cycles[s] += src->state_cycles[s];
+}
+
+/* ------------------------------
+ * 병렬 실행 : lane 단위 분배
+ * ------------------------------ */
+
+typedef struct
+{
+    const SimOptions* opt;
+    int index;
+    int count;
+    uint64_t lanes;
+    FILE* trace;                // 워커 0 만 사용
+    int trace_error;
+    SimStats stats;
+} SimWorker;
+
+uint64_t Sim_DeriveSeed(uint64_t seed, uint64_t index)
+{
+    uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static void Sim_Worker(void* arg)
+{
+    SimWorker* wk = (SimWorker*)arg;
+    const SimOptions* opt = wk->opt;
+    SimWorld* w = (SimWorld*)malloc(sizeof(*w));
+    char* buf = NULL;
+    size_t len = 0;
+    InputSnapshot in;
+
+    if (!w)
+    {
+        wk->trace_error = 1;
+        return;
+    }
+    if (wk->trace)
+        buf = (char*)malloc(SIM_TRACE_BUFFER);
+
+    for (uint64_t lane = (uint64_t)wk->index; lane < wk->lanes; lane += (uint64_t)wk->count)
+    {
+        uint64_t first = lane * SIM_LANE_CYCLES;
+        uint64_t n = opt->cycles - first < SIM_LANE_CYCLES ? opt->cycles - first : SIM_LANE_CYCLES;
+        int tracing = lane == 0 && wk->trace && buf;
+
+        Sim_Init(w, &opt->cfg, Sim_DeriveSeed(opt->seed, lane));
+
+        for (uint64_t i = 0; i < n; i++)
+        {
+            int reset = Sim_Step(w, &in);
+
+            if (!tracing)
+                continue;
+
+            /* 서비스 리셋 이후는 엔진 재초기화로 재생 결과가 달라지므로 기록 중단 */
+            if (reset)
+            {
+                tracing = 0;
+                continue;
+            }
+            len += (size_t)Input_FormatLine(buf + len, &in);
+            if (SIM_TRACE_BUFFER - len < INPUT_LINE_MAX)
+            {
+                if (fwrite(buf, 1, len, wk->trace) != len)
+                    wk->trace_error = 1;
+                len = 0;
+            }
+        }
+        Sim_StatsMerge(&wk->stats, &w->stats);
+    }
+
+    if (len > 0 && fwrite(buf, 1, len, wk->trace) != len)
+        wk->trace_error = 1;
+    if (wk->trace && !buf)
+        wk->trace_error = 1;
+    free(buf);
+    free(w);
+}
+
+int Sim_Run(const SimOptions* opt, SimStats* stats, uint64_t* elapsed_ns)
+{
+    uint64_t lanes = (opt->cycles + SIM_LANE_CYCLES - 1) / SIM_LANE_CYCLES;
+    int count = opt->workers > 0 ? opt->workers : Osal_CpuCount();
+    SimWorker* workers;
+    OsalThread* threads;
+    int* started;
+    FILE* trace = NULL;
+    int rc = 0;
+
+    memset(stats, 0, sizeof(*stats));
+    *elapsed_ns = 0;
+
+    if (count < 1)
+        count = 1;
+    if ((uint64_t)count > lanes)
+        count = lanes > 0 ? (int)lanes : 1;
+
+    if (opt->trace)
+    {
+        trace = fopen(opt->trace, "wb");
+        if (!trace)
+        {
+            printf("ERROR: Failed to open trace CSV : %s\n", opt->trace);
+            return 1;
+        }
+        Input_WriteHeader(trace);
+    }
+
+    workers = (SimWorker*)calloc((size_t)count, sizeof(*workers));
+    threads = (OsalThread*)calloc((size_t)count, sizeof(*threads));
+    started = (int*)calloc((size_t)count, sizeof(*started));
+    if (!workers || !threads || !started)
+    {
+        printf("ERROR: Out of memory while starting simulation\n");
+        rc = 1;
+        goto done;
+    }
+
+    for (int k = 0; k < count; k++)
+    {
+        workers[k].opt = opt;
+        workers[k].index = k;
+        workers[k].count = count;
+        workers[k].lanes = lanes;
+        workers[k].trace = k == 0 ? trace : NULL;
+    }
+
+    uint64_t t0 = Osal_NowNs();
+    for (int k = 1; k < count; k++)
+        started[k] = Osal_ThreadCreate(&threads[k], Sim_Worker, &workers[k]);
+
+    Sim_Worker(&workers[0]);
+
+    for (int k = 1; k < count; k++)
+    {
+        if (started[k])
+            Osal_ThreadJoin(threads[k]);
+        else
+            Sim_Worker(&workers[k]);
+    }
+    *elapsed_ns = Osal_NowNs() - t0;
+
+    for (int k = 0; k < count; k++)
+        Sim_StatsMerge(stats, &workers[k].stats);
+
+    if (workers[0].trace_error)
+    {
+        printf("ERROR: Failed to write trace CSV : %s\n", opt->trace);
+        rc = 1;
+    }
+
+done:
+    if (trace && fclose(trace) != 0 && rc == 0)
+    {
+        printf("ERROR: Failed to write trace CSV : %s\n", opt->trace);
+        rc = 1;
+    }
+    free(started);
+    free(threads);
+    free(workers);
+    return rc;
+}
+
+void Sim_PrintSummary(FILE* out, const SimOptions* opt, const SimStats* s, uint64_t elapsed_ns)
+{
+    static const char* const seqNames[6] = { "INIT", "WAIT", "CHARGING", "FAULT", "RESET", "SHUTDOWN" };
+    double sec = elapsed_ns / 1e9;
+    double cycles = s->cycles ? (double)s->cycles : 1.0;
+
+    fprintf(out, "Simulation : %llu cycles, seed %llu, %.3f s (%.2f M cycles/s)\n",
+        (unsigned long long)s->cycles, (unsigned long long)opt->seed, sec,
+        sec > 0 ? (double)s->cycles / sec / 1e6 : 0.0);
+    fprintf(out, "  sessions %llu, charges %llu, completed %llu, unplugged %llu, fault stops %llu, service resets %llu\n",
+        (unsigned long long)s->sessions, (unsigned long long)s->charges,
+        (unsigned long long)s->completed, (unsigned long long)s->unplugged,
+        (unsigned long long)s->fault_stops, (unsigned long long)s->service_resets);
+
+    fprintf(out, "  state :");
+    for (int k = 0; k < 6; k++)
+        fprintf(out, " %s %.1f %%", seqNames[k], (double)s->state_cycles[k] / cycles * 100.0);
+    fputc('\n', out);
+
+    fprintf(out, "  events :");
+    for (int e = 1; e < SIM_EVENT_COUNT; e++)
+        fprintf(out, " %s %llu", eventNames[e], (unsigned long long)s->events[e]);
+    fputc('\n', out);
+
+    fprintf(out, "  confirms :");
+    for (int code = FAULT_INPUT_OVERCURRENT; code < FAULT_MAX; code++)
+        fprintf(out, " 0x%02X %llu", code, (unsigned long long)s->confirms[code]);
+    fputc('\n', out);
+}
+
+int Sim_Main(int argc, char* argv[])
+{
+    SimOptions opt;
+    SimStats stats;
+    uint64_t elapsed;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.cycles = 10000000;
+    opt.seed = 1;
+    Sim_DefaultConfig(&opt.cfg);
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--cycles=", 9) == 0)
+            opt.cycles = strtoull(argv[i] + 9, NULL, 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            opt.seed = strtoull(argv[i] + 7, NULL, 0);
+        else if (strncmp(argv[i], "--workers=", 10) == 0)
+            opt.workers = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--event-rate=", 13) == 0)
+            opt.cfg.event_rate = atof(argv[i] + 13);
+        else if (strncmp(argv[i], "--trace=", 8) == 0)
+            opt.trace = argv[i] + 8;
+        else
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (opt.workers < 0 || opt.cfg.event_rate < 0 || opt.cfg.event_rate > 1)
+    {
+        printf("ERROR: Invalid simulation option value\n");
+        return 1;
+    }
+
+    if (Sim_Run(&opt, &stats, &elapsed) != 0)
+        return 1;
+
+    Sim_PrintSummary(stdout, &opt, &stats, elapsed);
+    if (opt.trace)
+        printf("Trace File : %s\n", opt.trace);
+    return 0;
+}
@@ -0,0 +1,145 @@
+#ifndef SIM_H
+#define SIM_H
+#include <stdio.h>
+#include <stdint.h>
+#include "fault.h"
+
+/*
+ * 폐루프 충전기 시뮬레이터 (fault_engine --sim)
+ *  - 제어기 : example.c OBC_Sequence 상태머신(INIT → WAIT → CHARGING → FAULT → RESET, SHUTDOWN)을
+ *    Context 기반으로 옮긴 것 (전역 변수 / printf 없음), Protection() 대신 진단 엔진 고장 상태 사용
+ *  - 플랜트 : 사용자(플러그 / 결제 / 분리), 3상 전류(릴레이 + ramp-up 설정값), 온도(1차 지연), 배터리 전압,
+ *    CAN, 절연 저항, heartbeat + 충전 중 외란 이벤트를 seed 기반 확률로 주입
+ *  - Cycle 순서 : 플랜트 → InputSnapshot → Fault_DiagnoseContext → 제어기 전이 (다음 Cycle 출력 결정)
+ *  - 재기동 금지(래치) 등으로 충전 불가 상태가 지속되면 서비스 리셋(엔진 재초기화) 후 계속
+ *  - 작업을 SIM_LANE_CYCLES 단위 lane 으로 나누고 lane 별 seed 파생 → 워커 수와 무관하게 같은 결과
+ */
+
+#define SIM_LANE_CYCLES     (1u << 20)
+
+/* 충전 중 외란 이벤트 */
+typedef enum
+{
+    SIM_EVENT_NONE = 0,
+    SIM_EVENT_OVERCURRENT,      // 전류 서지
+    SIM_EVENT_UNDERCURRENT,     // 전류 저하
+    SIM_EVENT_PLUG_PULL,        // 충전 중 플러그 분리
+    SIM_EVENT_RELAY,            // 릴레이 접점 개방 (피드백 불일치)
+    SIM_EVENT_BMS,              // BMS 전압 편차
+    SIM_EVENT_OVER_TEMP,        // 냉각 이상 → 과온
+    SIM_EVENT_CAN_LOSS,
+    SIM_EVENT_ISO,              // 절연 저항 저하
+    SIM_EVENT_TEMP_SENSOR,      // 온도 센서 이상값
+    SIM_EVENT_WDT,              // heartbeat 지연 (Cycle 건너뜀)
+    SIM_EVENT_COUNT
+} SimEvent;
+
+typedef struct
+{
+    double event_rate;          // 충전 Cycle 당 외란 이벤트 시작 확률
+    double unpaid_rate;         // 미결제 세션 확률
+    int ramp_cycles;            // 충전 전류 ramp-up Cycle (example.c RAMPUP_MAX)
+    int reset_limit;            // RESET 최대 체류 Cycle (초과 시 INIT 복귀, SEQ_FaultTime 이내)
+    int service_limit;          // 충전 불가(고장 확정 + 비충전) 지속 시 서비스 리셋 Cycle (0 : 리셋 없음)
+    int demand_min;             // 세션 만충까지 충전 Cycle 범위
+    int demand_max;
+    int sessions_max;           // 0 : 무제한, N : N 세션 후 재연결 없음
+} SimConfig;
+
+/* 제어기 (example.c OBC_Sequence 변수) */
+typedef struct
+{
+    int seq;                    // SeqState
+    int flag_stop;              // FLAG_Stop
+    int relay_cmd;              // FLAG_relay
+    int charging_time;          // ChargingTime (Charg_Cnt)
+    int rampup;                 // RampupCounter
+    int reset_cnt;              // RESET 체류 Cycle
+} SimController;
+
+/* 플랜트 (사용자 + 충전기 / 배터리 물리량) */
+typedef struct
+{
+    int user;                   // 사용자 단계 (sim.c SIM_USER_*)
+    int user_cnt;               // 단계 내 Cycle
+    int user_len;               // 단계 길이
+    int paid;                   // 결제할 세션
+    int plug;                   // PlugInfo
+
+    double target_i;            // 세션 충전 전류 목표값
+    double temp;                // 충전기 온도 (degC)
+    double ambient;
+    int demand;                 // 배터리 만충까지 충전 Cycle
+    int charged;                // 충전 Cycle 누적
+
+    int event;                  // 진행 중인 외란 (SimEvent)
+    int event_pos;
+    int event_len;
+    int event_value;            // 이벤트별 크기 (서지 전류 / 전압 편차 / 건너뛸 Cycle)
+} SimPlant;
+
+/* 시뮬레이션 통계 (lane / 워커 간 합산) */
+typedef struct
+{
+    uint64_t cycles;
+    uint64_t sessions;          // 플러그 연결 횟수
+    uint64_t charges;           // CHARGING 진입
+    uint64_t completed;         // 만충 / 시간 초과로 정상 종료
+    uint64_t unplugged;         // 충전 중 플러그 분리로 종료
+    uint64_t fault_stops;       // CHARGING → FAULT
+    uint64_t service_resets;    // 충전 불가 지속 → 엔진 재초기화
+    uint64_t events[SIM_EVENT_COUNT];
+    uint64_t confirms[FAULT_MAX];       // 고장별 CONFIRM 진입 횟수
+    uint64_t state_cycles[6];           // SeqState 별 체류 Cycle
+} SimStats;
+
+/* 시뮬레이터 1개 (lane) */
+typedef struct
+{
+    SimConfig cfg;
+    uint64_t rng;               // splitmix64 상태
+    int cycle;
+    FaultContext engine;
+    SimController ctrl;
+    SimPlant plant;
+    int blocked;                // 충전 불가 지속 Cycle
+    FaultStatus prev[FAULT_MAX];
+    SimStats stats;
+} SimWorld;
+
+/* ===== 기본 설정 ===== */
+void Sim_DefaultConfig(SimConfig* cfg);
+
+/* ===== seed 로 시뮬레이터 초기화 ===== */
+void Sim_Init(SimWorld* w, const SimConfig* cfg, uint64_t seed);
+
+/* ===== 1 Cycle 진행 : 진단에 사용한 입력을 out 에 기록, 서비스 리셋 Cycle 이면 1 반환 ===== */
+int Sim_Step(SimWorld* w, InputSnapshot* out);
+
+/* ===== 외란 이벤트 즉시 시작 (다음 Sim_Step 입력부터 적용, 진행 중인 이벤트는 대체) ===== */
+void Sim_StartEvent(SimWorld* w, SimEvent event);
+
+/* ===== seed 와 번호로 독립 seed 파생 (lane / 세션별 seed stream) ===== */
+uint64_t Sim_DeriveSeed(uint64_t seed, uint64_t index);
+
+void Sim_StatsMerge(SimStats* dst, const SimStats* src);
+const char* Sim_EventName(SimEvent event);
+
+typedef struct
+{
+    uint64_t cycles;            // 전체 시뮬레이션 Cycle
+    uint64_t seed;
+    int workers;                // 0 : CPU 개수
+    const char* trace;          // lane 0 입력 CSV 기록 경로 (첫 서비스 리셋 전까지, NULL : 없음)
+    SimConfig cfg;
+} SimOptions;
+
+/* ===== 병렬 시뮬레이션 실행 : 성공 0, 실패 1 ===== */
+int Sim_Run(const SimOptions* opt, SimStats* stats, uint64_t* elapsed_ns);
+
+void Sim_PrintSummary(FILE* out, const SimOptions* opt, const SimStats* stats, uint64_t elapsed_ns);
+
+/* ===== 명령행 진입점 : fault_engine --sim [options] ===== */
+int Sim_Main(int argc, char* argv[]);
+
+#endif /* SIM_H */
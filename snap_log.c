@@ -0,0 +1,163 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "snap_log.h"
+#include "fault.h"
+#include "output.h"
+#include <string.h>
+
+#define SNAP_LOG_BLOCK  4096    // SnapLog_Run 1회 읽기 레코드 수
+
+#ifdef OBC_FIXED_POINT
+#define SNAP_LOG_FLAGS  SNAP_LOG_FLAG_FIXED_CURRENT
+#else
+#define SNAP_LOG_FLAGS  0u
+#endif
+
+static int Header_Write(SnapLog* s)
+{
+    SnapLogHeader h;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SNAP_LOG_MAGIC, sizeof(h.magic));
+    h.version = SNAP_LOG_VERSION;
+    h.record_size = (uint32_t)sizeof(InputSnapshot);
+    h.field_count = INPUT_FIELD_COUNT;
+    h.flags = SNAP_LOG_FLAGS;
+    h.rows = s->rows;
+
+    return fseek(s->fp, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, s->fp) == 1;
+}
+
+int SnapLog_Detect(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    char magic[8];
+    int found;
+
+    if (!fp)
+        return 0;
+
+    found = fread(magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+        memcmp(magic, SNAP_LOG_MAGIC, sizeof(magic)) == 0;
+    fclose(fp);
+    return found;
+}
+
+int SnapLog_Open(SnapLog* s, const char* path)
+{
+    SnapLogHeader h;
+
+    memset(s, 0, sizeof(*s));
+    s->fp = fopen(path, "rb");
+    if (!s->fp)
+    {
+        printf("ERROR: Failed to open snapshot log : %s\n", path);
+        return 0;
+    }
+
+    if (fread(&h, sizeof(h), 1, s->fp) != 1 ||
+        memcmp(h.magic, SNAP_LOG_MAGIC, sizeof(h.magic)) != 0)
+    {
+        printf("ERROR: Not a snapshot log : %s\n", path);
+        fclose(s->fp);
+        s->fp = NULL;
+        return 0;
+    }
+
+    /* 다른 빌드(필드 추가, 전류 표현 등)에서 기록한 파일은 거부 */
+    if (h.version != SNAP_LOG_VERSION || h.record_size != sizeof(InputSnapshot) ||
+        h.field_count != INPUT_FIELD_COUNT || h.flags != SNAP_LOG_FLAGS)
+    {
+        printf("ERROR: Unsupported snapshot log layout (version %u, record %u bytes, %u fields, flags 0x%x) : %s\n",
+            (unsigned)h.version, (unsigned)h.record_size, (unsigned)h.field_count, (unsigned)h.flags, path);
+        fclose(s->fp);
+        s->fp = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+int SnapLog_Create(SnapLog* s, const char* path)
+{
+    memset(s, 0, sizeof(*s));
+    s->write = 1;
+    s->fp = fopen(path, "wb");
+    if (!s->fp)
+    {
+        printf("ERROR: Failed to open snapshot log : %s\n", path);
+        return 0;
+    }
+
+    /* rows 는 닫을 때 다시 기록 */
+    if (!Header_Write(s))
+    {
+        printf("ERROR: Failed to write snapshot log : %s\n", path);
+        fclose(s->fp);
+        s->fp = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+size_t SnapLog_Read(SnapLog* s, InputSnapshot* rows, size_t n)
+{
+    size_t got = fread(rows, sizeof(*rows), n, s->fp);
+
+    s->rows += got;
+    return got;
+}
+
+int SnapLog_Write(SnapLog* s, const InputSnapshot* rows, size_t n)
+{
+    if (fwrite(rows, sizeof(*rows), n, s->fp) != n)
+        return 0;
+    s->rows += n;
+    return 1;
+}
+
+int SnapLog_Close(SnapLog* s)
+{
+    int ok = 1;
+
+    if (!s->fp)
+        return 0;
+
+    if (s->write)
+        ok = fflush(s->fp) == 0 && Header_Write(s);
+    if (fclose(s->fp) != 0)
+        ok = 0;
+    s->fp = NULL;
+    return ok;
+}
+
+int SnapLog_Run(const char* path, FILE* out, uint64_t* cycles)
+{
+    static InputSnapshot block[SNAP_LOG_BLOCK];
+    SnapLog s;
+    size_t n;
+    int rc = 0;
+
+    *cycles = 0;
+    if (!SnapLog_Open(&s, path))
+        return 1;
+
+    Fault_Init();
+
+    while ((n = SnapLog_Read(&s, block, SNAP_LOG_BLOCK)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            Fault_Diagnose(&block[i]);
+            Output_WriteRow(out, block[i].Cycle, Fault_GetContext());
+        }
+    }
+
+    if (ferror(s.fp))
+    {
+        printf("ERROR: Failed to read snapshot log : %s\n", path);
+        rc = 1;
+    }
+
+    *cycles = s.rows;
+    SnapLog_Close(&s);
+    return rc;
+}
@@ -0,0 +1,57 @@
+#ifndef SNAP_LOG_H
+#define SNAP_LOG_H
+#include <stdio.h>
+#include <stdint.h>
+#include "input.h"
+
+/*
+ * 이진 Snapshot 로그 (.snap) : CSV 파싱 없이 InputSnapshot 을 그대로 읽고 쓰는 입력 형식
+ *  - 헤더 32 byte : magic "OBCSNAP1", version, record_size, field_count, flags, rows (닫을 때 기록)
+ *  - 레코드 : InputSnapshot 메모리 배치 그대로 (Input_Fields 순서 int32/float32 15개 = 60 byte, 리틀 엔디언)
+ *    전류는 빌드의 InputCurrent 표현 (OBC_FIXED_POINT : int32 0.5 mA, flags 로 구분 → 다른 표현 빌드에서는 거부)
+ *  - 파일 형식은 확장자가 아닌 magic 으로 판별 → 일반 입력 자리(argv[1])에 바로 사용
+ *  - rows 가 0 인 파일(기록 중 중단)은 파일 끝까지 읽음
+ */
+
+#define SNAP_LOG_MAGIC      "OBCSNAP1"
+#define SNAP_LOG_VERSION    1u
+
+#define SNAP_LOG_FLAG_FIXED_CURRENT     0x1u    // 전류 필드가 고정소수점(OBC_FIXED_POINT)
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;       // sizeof(InputSnapshot)
+    uint32_t field_count;       // INPUT_FIELD_COUNT
+    uint32_t flags;             // SNAP_LOG_FLAG_*
+    uint64_t rows;              // 레코드 수 (0 : 미기록)
+} SnapLogHeader;
+
+typedef struct
+{
+    FILE* fp;
+    uint64_t rows;              // 기록(읽은) 레코드 수
+    int write;
+} SnapLog;
+
+/* 파일 앞부분이 SNAP_LOG_MAGIC 이면 1 */
+int SnapLog_Detect(const char* path);
+
+/* 읽기 / 쓰기 열기 : 성공 1, 실패 0 (오류 내용 출력) */
+int SnapLog_Open(SnapLog* s, const char* path);
+int SnapLog_Create(SnapLog* s, const char* path);
+
+/* 레코드 n개 읽기 : 읽은 개수 반환 (0 : 파일 끝, 불완전한 마지막 레코드는 무시) */
+size_t SnapLog_Read(SnapLog* s, InputSnapshot* rows, size_t n);
+
+/* 레코드 n개 쓰기 : 성공 1, 실패 0 */
+int SnapLog_Write(SnapLog* s, const InputSnapshot* rows, size_t n);
+
+/* 닫기 (쓰기 모드는 헤더 rows 기록) : 성공 1, 실패 0 */
+int SnapLog_Close(SnapLog* s);
+
+/* ===== Snapshot 로그 진단 (직렬 진단 루프와 같은 결과) : 성공 0, 실패 1 ===== */
+int SnapLog_Run(const char* path, FILE* out, uint64_t* cycles);
+
+#endif /* SNAP_LOG_H */
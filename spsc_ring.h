@@ -0,0 +1,133 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+#include <stdint.h>
+#include <stdlib.h>
+#include "osal.h"
+
+/*
+ * 단일 생산자 / 단일 소비자(SPSC) lock-free 링 버퍼
+ *  - 고정 크기 원소 capacity(2^n)개, 생산자만 head, 소비자만 tail 갱신
+ *  - 원소 단위가 아니라 연속 구간 단위로 예약/반영하여 원자 연산 횟수를 줄임
+ *      생산 : Spsc_WriteBegin → 슬롯에 직접 기록 → Spsc_WriteEnd
+ *      소비 : Spsc_ReadBegin  → 슬롯에서 직접 사용 → Spsc_ReadEnd
+ *  - 상대편 인덱스는 캐시해 두고 부족할 때만 다시 읽음
+ */
+
+typedef struct
+{
+    uint8_t* slots;
+    size_t elem_size;
+    uint64_t capacity;
+    uint64_t mask;
+
+    char pad0[OSAL_CACHE_LINE];
+    uint64_t head;              // 생산자 : 다음 기록 위치
+    uint64_t tail_cache;
+
+    char pad1[OSAL_CACHE_LINE];
+    uint64_t tail;              // 소비자 : 다음 읽기 위치
+    uint64_t head_cache;
+
+    char pad2[OSAL_CACHE_LINE];
+    uint64_t closed;            // 생산자 종료 (더 이상 기록 없음)
+} SpscRing;
+
+/* capacity는 2의 거듭제곱으로 올림 : 성공 1, 실패 0 */
+static inline int Spsc_Init(SpscRing* r, size_t elem_size, uint64_t capacity)
+{
+    uint64_t cap = 2;
+
+    while (cap < capacity)
+        cap *= 2;
+
+    r->slots = (uint8_t*)malloc((size_t)cap * elem_size);
+    r->elem_size = elem_size;
+    r->capacity = cap;
+    r->mask = cap - 1;
+    r->head = r->tail_cache = 0;
+    r->tail = r->head_cache = 0;
+    r->closed = 0;
+    return r->slots != NULL;
+}
+
+static inline void Spsc_Free(SpscRing* r)
+{
+    free(r->slots);
+    r->slots = NULL;
+}
+
+/* 연속된 빈 슬롯 최대 *n개 예약 : 없으면 NULL */
+static inline void* Spsc_WriteBegin(SpscRing* r, size_t* n)
+{
+    uint64_t free_slots = r->capacity - (r->head - r->tail_cache);
+
+    if (free_slots < *n)
+    {
+        r->tail_cache = OSAL_LOAD_ACQUIRE(&r->tail);
+        free_slots = r->capacity - (r->head - r->tail_cache);
+        if (free_slots == 0)
+            return NULL;
+    }
+
+    uint64_t pos = r->head & r->mask;
+    uint64_t contiguous = r->capacity - pos;
+
+    if (*n > free_slots)
+        *n = (size_t)free_slots;
+    if (*n > contiguous)
+        *n = (size_t)contiguous;
+    return r->slots + pos * r->elem_size;
+}
+
+/* 예약한 슬롯 중 앞 n개 반영 */
+static inline void Spsc_WriteEnd(SpscRing* r, size_t n)
+{
+    OSAL_STORE_RELEASE(&r->head, r->head + n);
+}
+
+/* 연속된 기록 완료 슬롯 최대 *n개 : 없으면 NULL */
+static inline const void* Spsc_ReadBegin(SpscRing* r, size_t* n)
+{
+    uint64_t ready = r->head_cache - r->tail;
+
+    if (ready < *n)
+    {
+        r->head_cache = OSAL_LOAD_ACQUIRE(&r->head);
+        ready = r->head_cache - r->tail;
+        if (ready == 0)
+            return NULL;
+    }
+
+    uint64_t pos = r->tail & r->mask;
+    uint64_t contiguous = r->capacity - pos;
+
+    if (*n > ready)
+        *n = (size_t)ready;
+    if (*n > contiguous)
+        *n = (size_t)contiguous;
+    return r->slots + pos * r->elem_size;
+}
+
+static inline void Spsc_ReadEnd(SpscRing* r, size_t n)
+{
+    OSAL_STORE_RELEASE(&r->tail, r->tail + n);
+}
+
+static inline void Spsc_Close(SpscRing* r)
+{
+    OSAL_STORE_RELEASE(&r->closed, (uint64_t)1);
+}
+
+/* 소비자 측 : 마지막으로 확인한 대기 원소 수 (원자 연산 없음, 실제 값 이하) */
+static inline uint64_t Spsc_ReadyHint(const SpscRing* r)
+{
+    return r->head_cache - r->tail;
+}
+
+/* 생산자 종료 후 모든 원소를 소비했으면 1 */
+static inline int Spsc_Drained(SpscRing* r)
+{
+    return OSAL_LOAD_ACQUIRE(&r->closed) && OSAL_LOAD_ACQUIRE(&r->head) == r->tail;
+}
+
+#endif /* SPSC_RING_H */
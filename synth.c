@@ -0,0 +1,305 @@
+﻿#include "synth.h"
+#include "fault.h"
+#include <string.h>
+
+/* 세션 단계 */
+enum
+{
+    SYNTH_PHASE_INIT,           // INIT, 플러그 미연결
+    SYNTH_PHASE_PLUG,           // INIT, 플러그 연결 (미결제)
+    SYNTH_PHASE_WAIT,           // WAIT, 결제 → 릴레이 ON
+    SYNTH_PHASE_CHARGING,
+    SYNTH_PHASE_SHUTDOWN,       // 정상 종료
+    SYNTH_PHASE_FAULT,          // 고장 이벤트 후 FAULT 체류
+    SYNTH_PHASE_RESET,
+    SYNTH_PHASE_COOLDOWN        // INIT 냉각 후 다음 세션
+};
+
+/* 충전 중 고장 이벤트 */
+enum
+{
+    SYNTH_EVENT_NONE,
+    SYNTH_EVENT_OVERCURRENT,
+    SYNTH_EVENT_UNDERCURRENT,
+    SYNTH_EVENT_PLUG_PULL,
+    SYNTH_EVENT_RELAY,
+    SYNTH_EVENT_BMS,
+    SYNTH_EVENT_OVER_TEMP,
+    SYNTH_EVENT_CAN_LOSS,
+    SYNTH_EVENT_ISO,
+    SYNTH_EVENT_TEMP_SENSOR,
+    SYNTH_EVENT_WDT,
+    SYNTH_EVENT_COUNT
+};
+
+/* 이벤트 길이(Cycle) / 충전 종료 여부 (gen_data1 ~ 3 의 고장 구간 길이) */
+static const int eventLength[SYNTH_EVENT_COUNT] = { 0, 12, 12, 2, 2, 12, 12, 7, 12, 4, 1 };
+static const int eventFatal[SYNTH_EVENT_COUNT] = { 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0 };
+
+/* 이벤트 선택 가중치 : 재기동 금지(래치)로 이어지는 플러그 분리 / 과온은 드물게 */
+static const int eventWeight[SYNTH_EVENT_COUNT] = { 0, 10, 10, 1, 4, 10, 2, 10, 6, 4, 4 };
+
+#define SYNTH_EVENT_RATE    400     // 충전 Cycle 당 이벤트 시작 확률 1/N
+#define SYNTH_UNPAID_RATE   20      // 미결제 세션 확률 1/N
+
+/* splitmix64 */
+static uint64_t Synth_Rand(SynthSession* s)
+{
+    uint64_t z = (s->rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int Synth_Below(SynthSession* s, int n)
+{
+    return (int)(Synth_Rand(s) % (uint64_t)n);
+}
+
+static void Synth_Phase(SynthSession* s, int phase, int len)
+{
+    s->phase = phase;
+    s->phase_pos = 0;
+    s->phase_len = len;
+}
+
+static void Synth_NewSession(SynthSession* s)
+{
+    s->paid = Synth_Below(s, SYNTH_UNPAID_RATE) != 0;
+    s->faulted = 0;
+    s->charg_cnt = 0;
+    s->charge_len = 200 + Synth_Below(s, 3200);    // SEQ_ChargTime(3600) 이내
+    s->target_i = 16 + Synth_Below(s, 6);          // OC_Inormal(24) 미만
+    s->event = SYNTH_EVENT_NONE;
+    Synth_Phase(s, SYNTH_PHASE_INIT, 5);
+}
+
+void Synth_Init(SynthSession* s, uint64_t seed)
+{
+    memset(s, 0, sizeof(*s));
+    s->rng = seed;
+    s->h = 15;
+    Synth_NewSession(s);
+}
+
+/* 정지 상태 공통 값 (릴레이 OFF, 전류 0) */
+static void Synth_Idle(SynthSession* s, InputSnapshot* out, int seq, int plug)
+{
+    out->SeqState = seq;
+    out->PlugInfo = plug;
+    out->FLAG_Stop = 1;
+    out->FLAG_Relay = 0;
+    out->Ia = out->Ib = out->Ic = INPUT_CURRENT(0);
+    out->FaultState = 0;
+    out->Charg_Cnt = 0;
+    out->Real_V = 398 + Synth_Below(s, 3);
+    out->Exp_V = 400;
+    out->H = s->h;
+    out->CanMsg = 1;
+    out->IsoR = 800000;
+}
+
+static void Synth_Charging(SynthSession* s, InputSnapshot* out)
+{
+    int cc = ++s->charg_cnt;
+    int ia = 10 + cc < s->target_i ? 10 + cc : s->target_i;
+    int k;
+
+    out->SeqState = SEQ_CHARGING;
+    out->PlugInfo = PLUG_CONNECTED_PAID;
+    out->FLAG_Stop = 0;
+    out->FLAG_Relay = 1;
+    out->Ia = INPUT_CURRENT(ia);
+    out->Ib = INPUT_CURRENT(ia - 1 + Synth_Below(s, 3));
+    out->Ic = INPUT_CURRENT(ia - 1 + Synth_Below(s, 3));
+    out->FaultState = 0;
+    out->Charg_Cnt = cc;
+    out->Real_V = 397 + Synth_Below(s, 7);
+    out->Exp_V = 400;
+    s->h = 15 + (cc / 3 < 20 ? cc / 3 : 20);
+    out->CanMsg = 1;
+    out->IsoR = 800000;
+
+    /* 이벤트 시작 (충전 안정 후) */
+    if (s->event == SYNTH_EVENT_NONE && cc > 25 && Synth_Below(s, SYNTH_EVENT_RATE) == 0)
+    {
+        int total = 0;
+        int pick;
+
+        for (int e = 1; e < SYNTH_EVENT_COUNT; e++)
+            total += eventWeight[e];
+
+        pick = Synth_Below(s, total);
+        for (s->event = 1; pick >= eventWeight[s->event]; s->event++)
+            pick -= eventWeight[s->event];
+
+        s->event_pos = 0;
+        s->events++;
+    }
+
+    k = s->event_pos;
+    switch (s->event)
+    {
+    case SYNTH_EVENT_OVERCURRENT:
+        out->Ia = INPUT_CURRENT(33 + k % 4);
+        out->Ib = out->Ia - INPUT_CURRENT(1);
+        out->Ic = out->Ia + INPUT_CURRENT(1);
+        out->FaultState = 1;
+        break;
+
+    case SYNTH_EVENT_UNDERCURRENT:
+        ia = 4 - k / 4 > 1 ? 4 - k / 4 : 1;
+        out->Ia = INPUT_CURRENT(ia);
+        out->Ib = INPUT_CURRENT(ia + 1);
+        out->Ic = INPUT_CURRENT(ia);
+        break;
+
+    case SYNTH_EVENT_PLUG_PULL:
+        out->PlugInfo = PLUG_UNPLUGGED;
+        out->Ia = out->Ic = INPUT_CURRENT(3 - k);
+        out->Ib = INPUT_CURRENT(4 - k);
+        break;
+
+    case SYNTH_EVENT_RELAY:
+        out->FLAG_Relay = 0;
+        out->FaultState = 1;
+        break;
+
+    case SYNTH_EVENT_BMS:
+        out->Real_V = 415 + k;
+        break;
+
+    case SYNTH_EVENT_OVER_TEMP:
+        s->h = 62 + k * 2;
+        break;
+
+    case SYNTH_EVENT_CAN_LOSS:
+        out->CanMsg = 0;
+        break;
+
+    case SYNTH_EVENT_ISO:
+        out->IsoR = 450 - k * 40 > 50 ? 450 - k * 40 : 50;
+        break;
+
+    case SYNTH_EVENT_TEMP_SENSOR:
+        s->h = 122 + k * 3;
+        break;
+
+    case SYNTH_EVENT_WDT:
+        /* heartbeat 지연 : 1 Cycle 건너뜀 (누적 지연, 다음 정상 heartbeat 에서 해소) */
+        s->cycle++;
+        break;
+
+    default:
+        break;
+    }
+    out->H = s->h;
+
+    if (s->event != SYNTH_EVENT_NONE && ++s->event_pos >= eventLength[s->event])
+    {
+        if (eventFatal[s->event])
+            s->faulted = 1;
+        s->event = SYNTH_EVENT_NONE;
+    }
+
+    if (s->faulted)
+        Synth_Phase(s, SYNTH_PHASE_FAULT, 8);
+    else if (cc >= s->charge_len)
+        Synth_Phase(s, SYNTH_PHASE_SHUTDOWN, 2);
+}
+
+void Synth_Next(SynthSession* s, InputSnapshot* out)
+{
+    int pos = s->phase_pos++;
+
+    out->Cycle = ++s->cycle;
+
+    switch (s->phase)
+    {
+    case SYNTH_PHASE_INIT:
+        Synth_Idle(s, out, SEQ_INIT, PLUG_UNPLUGGED);
+        if (s->phase_pos >= s->phase_len)
+            Synth_Phase(s, SYNTH_PHASE_PLUG, 2);
+        break;
+
+    case SYNTH_PHASE_PLUG:
+        Synth_Idle(s, out, SEQ_INIT, PLUG_CONNECTED_NO_PAY);
+        if (s->phase_pos >= s->phase_len)
+            Synth_Phase(s, SYNTH_PHASE_WAIT, s->paid ? 5 : 8);
+        break;
+
+    case SYNTH_PHASE_WAIT:
+        /* 미결제 세션은 결제 오류(0x09) 확정 후 냉각 (SEQ_WaitTime 이내) */
+        Synth_Idle(s, out, SEQ_WAIT,
+            (s->paid && pos >= 2) ? PLUG_CONNECTED_PAID : PLUG_CONNECTED_NO_PAY);
+        if (s->paid && pos == s->phase_len - 1)
+        {
+            out->FLAG_Stop = 0;
+            out->FLAG_Relay = 1;
+            out->Ia = INPUT_CURRENT(4);
+            out->Ib = INPUT_CURRENT(5);
+            out->Ic = INPUT_CURRENT(4);
+        }
+        if (s->phase_pos >= s->phase_len)
+            Synth_Phase(s, s->paid ? SYNTH_PHASE_CHARGING : SYNTH_PHASE_COOLDOWN, s->paid ? 0 : 9);
+        break;
+
+    case SYNTH_PHASE_CHARGING:
+        Synth_Charging(s, out);
+        break;
+
+    case SYNTH_PHASE_SHUTDOWN:
+        Synth_Idle(s, out, SEQ_SHUTDOWN, PLUG_CONNECTED_PAID);
+        out->Charg_Cnt = s->charg_cnt;
+        if (s->phase_pos >= s->phase_len)
+            Synth_Phase(s, SYNTH_PHASE_COOLDOWN, 9);
+        break;
+
+    case SYNTH_PHASE_FAULT:
+        /* FAULT 체류는 SEQ_FaultTime 이내 (RESET 첫 Cycle 포함) */
+        Synth_Idle(s, out, SEQ_FAULT, PLUG_CONNECTED_PAID);
+        out->FaultState = 2;
+        out->Charg_Cnt = s->charg_cnt;
+        out->Real_V = 420 - pos;
+        if (s->h > 20)
+            s->h -= 3;
+        if (s->phase_pos >= s->phase_len)
+            Synth_Phase(s, SYNTH_PHASE_RESET, 2);
+        break;
+
+    case SYNTH_PHASE_RESET:
+        Synth_Idle(s, out, pos == 0 ? SEQ_FAULT : SEQ_RESET, PLUG_CONNECTED_PAID);
+        out->FLAG_Stop = 0;
+        out->FLAG_Relay = 1;
+        out->Charg_Cnt = pos == 0 ? s->charg_cnt : 0;
+        if (s->phase_pos >= s->phase_len)
+            Synth_Phase(s, SYNTH_PHASE_COOLDOWN, 9);
+        break;
+
+    default:
+        if (s->h > 15)
+            s->h = s->h - 3 > 15 ? s->h - 3 : 15;
+        Synth_Idle(s, out, SEQ_INIT, PLUG_UNPLUGGED);
+        if (s->phase_pos >= s->phase_len)
+        {
+            s->sessions++;
+            Synth_NewSession(s);
+        }
+        break;
+    }
+
+    s->rows++;
+}
+
+size_t Synth_Fill(SynthSession* s, char* buf, size_t size)
+{
+    size_t len = 0;
+    InputSnapshot in;
+
+    while (size - len >= INPUT_LINE_MAX)
+    {
+        Synth_Next(s, &in);
+        len += (size_t)Input_FormatLine(buf + len, &in);
+    }
+    return len;
+}
@@ -0,0 +1,47 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+#include <stddef.h>
+#include <stdint.h>
+#include "input.h"
+
+/*
+ * 합성 충전 세션 생성기 (generate_rawdata.py gen_data1 ~ 3 과 같은 세션 흐름)
+ *  - 세션 : INIT → 플러그 연결 → WAIT → CHARGING(전류 상승/유지) → SHUTDOWN 또는 FAULT → RESET → INIT 냉각
+ *  - 충전 중 고장 이벤트(과전류 / 저전류 / 플러그 분리 / 릴레이 / BMS 전압 / 과온 / CAN 단절 /
+ *    절연 / 온도 센서 / Watchdog 지연)와 미결제 세션을 seed 기반 확률로 주입
+ *  - 할당 없이 1 Cycle씩 생성하므로 GB 단위 입력도 메모리에서 바로 생성 가능
+ */
+
+typedef struct
+{
+    uint64_t rng;               // splitmix64 상태
+    int cycle;                  // 마지막 생성 Cycle 번호
+    int phase;                  // 세션 단계 (synth.c SYNTH_PHASE_*)
+    int phase_pos;              // 단계 내 위치 (Cycle)
+    int phase_len;              // 단계 길이 (Cycle)
+
+    int charge_len;             // 이번 세션 충전 Cycle 수
+    int charg_cnt;              // 충전 시작 후 Cycle (Charg_Cnt)
+    int target_i;               // 충전 전류 목표값
+    int h;                      // 현재 온도
+    int paid;                   // 결제 완료 세션
+    int faulted;                // 고장 이벤트 발생 → FAULT 경유 종료
+
+    int event;                  // 진행 중인 충전 이벤트 (0 : 없음)
+    int event_pos;
+
+    uint64_t rows;              // 생성한 행 수
+    uint64_t sessions;          // 완료된 세션 수
+    uint64_t events;            // 주입한 고장 이벤트 수
+} SynthSession;
+
+/* ===== seed 로 생성기 초기화 (같은 seed → 같은 입력) ===== */
+void Synth_Init(SynthSession* s, uint64_t seed);
+
+/* ===== 다음 Cycle 입력 1행 생성 ===== */
+void Synth_Next(SynthSession* s, InputSnapshot* out);
+
+/* ===== buf 에 입력 CSV 데이터 줄(헤더 제외)을 size byte 이내로 채우고 기록 길이 반환 ===== */
+size_t Synth_Fill(SynthSession* s, char* buf, size_t size);
+
+#endif /* SYNTH_H */
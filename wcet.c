@@ -0,0 +1,870 @@
+﻿#define _CRT_SECURE_NO_WARNINGS
+#include "wcet.h"
+#include "fault.h"
+#include "input.h"
+#include "hist.h"
+#include "osal.h"
+#include "prof.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WCET_SEQ_MAX    8192        // 입력 시퀀스 최대 길이 (SEQ_ChargTime 초과 체류 포함)
+#define WCET_POOL       16          // 변형용 보관 시퀀스 수
+#define WCET_PATH_MAX   65536       // 경로 테이블 크기 (2의 거듭제곱)
+#define WCET_SEEN_MAX   8192        // 고장별 분기 조합 집합 크기 (2의 거듭제곱)
+#define WCET_REPEAT     3           // 측정 반복 횟수 (최소값 사용)
+#define WCET_TOP        10          // 출력 경로 수
+#define WCET_LIST_MAX   64
+
+/* ===== 입력 생성 필드 (값 + 유지 Cycle 수) ===== */
+enum
+{
+    GEN_SEQ, GEN_PLUG, GEN_STOP, GEN_RELAY, GEN_IA, GEN_IB, GEN_IC,
+    GEN_FSTATE, GEN_CHARG, GEN_DV, GEN_H, GEN_CAN, GEN_ISO, GEN_CYCLE,
+    GEN_COUNT
+};
+
+typedef struct
+{
+    int n;
+    float v[WCET_LIST_MAX];
+} ValueList;
+
+/* Calibration 에서 유도한 경계값 모델 */
+typedef struct
+{
+    ValueList values[GEN_COUNT];
+    ValueList dwell;            // 값 유지 Cycle 수 (카운터 시간 기준 T-1, T, T+1)
+} WcetModel;
+
+typedef struct
+{
+    float value[GEN_COUNT];
+    int dwell[GEN_COUNT];
+} GenState;
+
+/* 입력 시퀀스 : Cycle 필드는 이전 행 대비 증가량으로 저장 (변형 후에도 Watchdog 패턴 유지) */
+typedef struct
+{
+    InputSnapshot* row;
+    int len;
+} WcetSeq;
+
+/* 경로(1 Cycle 진단의 분기 조합)별 측정 결과 */
+typedef struct
+{
+    int used;
+    uint64_t key;
+    uint64_t count;
+    uint64_t warm_max;          // warm 최대값 (ticks)
+    uint64_t cold;              // cold 측정값 (ticks, 0 : 측정 안 함)
+    uint32_t packed_before;
+    uint32_t packed_after;
+    uint32_t branch[FAULT_MAX]; // 실행 분기 bitmask (OBC_BRANCH_COVERAGE)
+    FaultContext before;        // warm 최대값 발생 시점 진단 전 상태
+    InputSnapshot in;
+} WcetPath;
+
+typedef struct
+{
+    WcetModel model;
+    uint64_t rng;
+
+    WcetSeq cur;
+    WcetSeq pool[WCET_POOL];
+    int pool_len;
+
+    WcetPath* paths;
+    int path_count;
+    uint64_t path_dropped;      // 테이블 초과로 기록하지 못한 새 경로 수
+
+    uint64_t* seen;             // 관측된 고장별 분기 조합 (변형 대상 선정 기준)
+    int seen_count;
+
+    Histogram warm;             // 전체 Cycle warm 실행 시간 (ticks)
+    uint64_t steps;
+
+    /* 최악 입력 (warm 기준) */
+    uint64_t worst_ticks;
+    uint64_t worst_cold;
+    int worst_seq;
+    int worst_step;
+    WcetSeq worst;              // 시퀀스 시작 ~ 최악 Cycle
+    FaultContext worst_before;
+    InputSnapshot worst_in;
+    uint32_t worst_branch[FAULT_MAX];
+
+    /* cold 측정 */
+    unsigned char* evict;
+    size_t evict_size;
+    FaultContext cold_ctx;
+    InputSnapshot cold_in;
+} WcetState;
+
+/* splitmix64 */
+static uint64_t Rng_Next(uint64_t* s)
+{
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int Rng_Below(uint64_t* s, int n)
+{
+    return (int)(Rng_Next(s) % (uint64_t)n);
+}
+
+static void List_Add(ValueList* l, float v)
+{
+    if (l->n < WCET_LIST_MAX)
+        l->v[l->n++] = v;
+}
+
+/* 임계값 t 의 경계 (t-1, t, t+1) */
+static void List_Around(ValueList* l, float t)
+{
+    List_Add(l, t - 1);
+    List_Add(l, t);
+    List_Add(l, t + 1);
+}
+
+static void Model_Build(WcetModel* m, const FaultCalibration* cal)
+{
+    memset(m, 0, sizeof(*m));
+
+    for (int v = SEQ_INIT; v <= SEQ_SHUTDOWN; v++)
+        List_Add(&m->values[GEN_SEQ], (float)v);
+
+    for (int v = 0; v <= 2; v++)
+    {
+        List_Add(&m->values[GEN_PLUG], (float)v);
+        List_Add(&m->values[GEN_STOP], (float)v);
+        List_Add(&m->values[GEN_RELAY], (float)v);
+        List_Add(&m->values[GEN_FSTATE], (float)v);
+    }
+
+    /* 상전류 : 과전류 / 저전류 검출·회복 임계값, 0 이하(플러그 0x03) */
+    for (int f = GEN_IA; f <= GEN_IC; f++)
+    {
+        ValueList* l = &m->values[f];
+        List_Add(l, -1.0f);
+        List_Add(l, 0.0f);
+        List_Add(l, 0.5f);
+        List_Around(l, (float)cal->UC_Imin);
+        List_Around(l, (float)cal->UC_Inormal);
+        List_Around(l, (float)cal->OC_Inormal);
+        List_Around(l, (float)cal->OC_Imax);
+        List_Add(l, (float)cal->OC_Imax + 0.5f);
+    }
+
+    List_Add(&m->values[GEN_CHARG], 0.0f);
+    List_Around(&m->values[GEN_CHARG], (float)cal->UC_ChargCnt);
+    List_Around(&m->values[GEN_CHARG], (float)cal->BMS_ChargCnt);
+    List_Add(&m->values[GEN_CHARG], 1000.0f);
+
+    /* 배터리 전압 편차 (Real_V - Exp_V) */
+    List_Add(&m->values[GEN_DV], 0.0f);
+    List_Around(&m->values[GEN_DV], (float)cal->BMS_DiffNormal);
+    List_Around(&m->values[GEN_DV], (float)cal->BMS_DiffMax);
+    List_Around(&m->values[GEN_DV], (float)-cal->BMS_DiffMax);
+
+    List_Add(&m->values[GEN_H], 25.0f);
+    List_Around(&m->values[GEN_H], (float)cal->TS_Hmin);
+    List_Around(&m->values[GEN_H], (float)cal->TS_Hmax);
+    List_Around(&m->values[GEN_H], (float)cal->OT_Hnormal);
+    List_Around(&m->values[GEN_H], (float)cal->OT_Hmax);
+
+    List_Add(&m->values[GEN_CAN], 0.0f);
+    List_Add(&m->values[GEN_CAN], 1.0f);
+
+    List_Add(&m->values[GEN_ISO], 1000.0f);
+    List_Around(&m->values[GEN_ISO], (float)cal->ISO_Rmin);
+    List_Around(&m->values[GEN_ISO], (float)cal->ISO_Rnormal);
+
+    /* Cycle 증가량 : 정상 heartbeat 위주, 정지/역행/지연/치명적 지연 */
+    for (int k = 0; k < 6; k++)
+        List_Add(&m->values[GEN_CYCLE], 1.0f);
+    List_Add(&m->values[GEN_CYCLE], 0.0f);
+    List_Add(&m->values[GEN_CYCLE], -1.0f);
+    List_Add(&m->values[GEN_CYCLE], 2.0f);
+    List_Add(&m->values[GEN_CYCLE], (float)cal->WDT_MaxGap);
+    List_Add(&m->values[GEN_CYCLE], (float)cal->WDT_MaxGap + 1.0f);
+
+    /* 유지 Cycle 수 : 카운터 시간 기준 경계 */
+    List_Add(&m->dwell, 1.0f);
+    List_Add(&m->dwell, 2.0f);
+    List_Add(&m->dwell, 3.0f);
+    List_Around(&m->dwell, (float)cal->OC_Time);
+    List_Around(&m->dwell, (float)cal->UC_Time);
+    List_Around(&m->dwell, (float)cal->BMS_Time);
+    List_Around(&m->dwell, (float)cal->BMS_RecTime);
+    List_Around(&m->dwell, (float)cal->OT_Time);
+    List_Around(&m->dwell, (float)cal->OT_RecTime);
+    List_Around(&m->dwell, (float)cal->CAN_Time);
+    List_Around(&m->dwell, (float)cal->CAN_RecTime);
+    List_Around(&m->dwell, (float)cal->ISO_Time);
+    List_Around(&m->dwell, (float)cal->ISO_RecTime);
+    List_Around(&m->dwell, (float)cal->PAY_Time);
+    List_Around(&m->dwell, (float)cal->WDT_AccMax);
+    List_Around(&m->dwell, (float)cal->SEQ_WaitTime);
+    List_Around(&m->dwell, (float)cal->SEQ_FaultTime);
+    List_Around(&m->dwell, (float)cal->SEQ_ChargTime + 1.0f);
+    List_Around(&m->dwell, (float)cal->TS_Time);
+}
+
+static void Gen_Pick(const WcetModel* m, GenState* g, int f, uint64_t* rng)
+{
+    const ValueList* l = &m->values[f];
+    int dwell;
+
+    g->value[f] = l->v[Rng_Below(rng, l->n)];
+
+    /* 비정상 Cycle 증가량은 짧게 (길게 유지하면 Watchdog 래치 후 탐색 불가) */
+    if (f == GEN_CYCLE && g->value[f] != 1.0f)
+        dwell = 1 + Rng_Below(rng, 3);
+    else
+        dwell = (int)m->dwell.v[Rng_Below(rng, m->dwell.n)];
+
+    g->dwell[f] = dwell < 1 ? 1 : dwell;
+}
+
+static void Gen_Reset(GenState* g)
+{
+    memset(g, 0, sizeof(*g));
+}
+
+/* 1 Cycle 입력 생성 : 유지 시간이 끝난 필드만 새 경계값 선택 */
+static void Gen_Step(const WcetModel* m, GenState* g, uint64_t* rng, InputSnapshot* out)
+{
+    for (int f = 0; f < GEN_COUNT; f++)
+    {
+        if (--g->dwell[f] > 0)
+            continue;
+
+        Gen_Pick(m, g, f, rng);
+
+        /* 3상 전류는 대부분 함께 변화 (모든 상 조건 분기 도달용) */
+        if (f == GEN_IA && Rng_Below(rng, 4) != 0)
+        {
+            g->value[GEN_IB] = g->value[GEN_IC] = g->value[GEN_IA];
+            g->dwell[GEN_IB] = g->dwell[GEN_IC] = g->dwell[GEN_IA] + 1;
+        }
+    }
+
+    out->Cycle = (int)g->value[GEN_CYCLE];
+    out->SeqState = (int)g->value[GEN_SEQ];
+    out->PlugInfo = (int)g->value[GEN_PLUG];
+    out->FLAG_Stop = (int)g->value[GEN_STOP];
+    out->FLAG_Relay = (int)g->value[GEN_RELAY];
+    out->Ia = Input_CurrentFromDouble(g->value[GEN_IA]);
+    out->Ib = Input_CurrentFromDouble(g->value[GEN_IB]);
+    out->Ic = Input_CurrentFromDouble(g->value[GEN_IC]);
+    out->FaultState = (int)g->value[GEN_FSTATE];
+    out->Charg_Cnt = (int)g->value[GEN_CHARG];
+    out->Exp_V = 400;
+    out->Real_V = 400 + (int)g->value[GEN_DV];
+    out->H = (int)g->value[GEN_H];
+    out->CanMsg = (int)g->value[GEN_CAN];
+    out->IsoR = (int)g->value[GEN_ISO];
+}
+
+static void Seq_Generate(WcetState* w, WcetSeq* s)
+{
+    static const int lengths[] = { 32, 256, 2048, WCET_SEQ_MAX };
+    GenState g;
+
+    Gen_Reset(&g);
+    s->len = lengths[Rng_Below(&w->rng, 4)];
+    for (int i = 0; i < s->len; i++)
+        Gen_Step(&w->model, &g, &w->rng, &s->row[i]);
+}
+
+static void Seq_Copy(WcetSeq* dst, const WcetSeq* src, int len)
+{
+    memcpy(dst->row, src->row, (size_t)len * sizeof(*dst->row));
+    dst->len = len;
+}
+
+/* 보관 시퀀스 변형 : 구간 재생성 / 구간 반복(체류 연장) / 구간 삭제 */
+static void Seq_Mutate(WcetState* w, WcetSeq* s)
+{
+    const WcetModel* m = &w->model;
+    int ops = 1 + Rng_Below(&w->rng, 3);
+
+    for (int k = 0; k < ops; k++)
+    {
+        int a = Rng_Below(&w->rng, s->len);
+        int n = (int)m->dwell.v[Rng_Below(&w->rng, m->dwell.n)];
+
+        if (n < 1)
+            n = 1;
+        if (n > s->len - a)
+            n = s->len - a;
+
+        switch (Rng_Below(&w->rng, 3))
+        {
+        case 0:
+        {
+            GenState g;
+            Gen_Reset(&g);
+            for (int i = a; i < a + n; i++)
+                Gen_Step(m, &g, &w->rng, &s->row[i]);
+            break;
+        }
+
+        case 1:
+            if (n > WCET_SEQ_MAX - s->len)
+                n = WCET_SEQ_MAX - s->len;
+            memmove(&s->row[a + n], &s->row[a], (size_t)(s->len - a) * sizeof(*s->row));
+            s->len += n;
+            break;
+
+        default:
+            if (s->len - n < 1)
+                break;
+            memmove(&s->row[a], &s->row[a + n], (size_t)(s->len - a - n) * sizeof(*s->row));
+            s->len -= n;
+            break;
+        }
+    }
+}
+
+static uint64_t Mix64(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/* 경로 식별값 : 분기 bitmask (커버리지 빌드) 또는 진단 전/후 고장 상태 */
+static uint64_t Path_Key(uint32_t before, uint32_t after)
+{
+#ifdef OBC_BRANCH_COVERAGE
+    uint64_t h = 0;
+
+    (void)before;
+    (void)after;
+    for (int c = FAULT_INPUT_OVERCURRENT; c < FAULT_MAX; c++)
+        h = Mix64(h ^ Fault_BranchPath[c] ^ ((uint64_t)c << 32));
+    return h;
+#else
+    return ((uint64_t)before << 32) | after;
+#endif
+}
+
+/* 고장별 분기 조합 : 커버리지 빌드는 분기 bitmask, 그 외는 고장 상태 전이 */
+static uint32_t Fault_Mask(const FaultContext* before, const FaultContext* after, int code)
+{
+#ifdef OBC_BRANCH_COVERAGE
+    (void)before;
+    (void)after;
+    return Fault_BranchPath[code];
+#else
+    return ((uint32_t)before->state[code] << 2) | (uint32_t)after->state[code];
+#endif
+}
+
+/* 처음 관측된 고장별 분기 조합 수 (시퀀스 보관 기준) */
+static int Seen_Update(WcetState* w, const FaultContext* before, const FaultContext* after)
+{
+    int added = 0;
+
+    for (int c = FAULT_INPUT_OVERCURRENT; c < FAULT_MAX; c++)
+    {
+        uint64_t key = ((uint64_t)c << 32) | Fault_Mask(before, after, c);
+        uint32_t i = (uint32_t)Mix64(key) & (WCET_SEEN_MAX - 1);
+
+        while (w->seen[i] && w->seen[i] != key)
+            i = (i + 1) & (WCET_SEEN_MAX - 1);
+
+        if (!w->seen[i] && w->seen_count < WCET_SEEN_MAX / 2)
+        {
+            w->seen[i] = key;
+            w->seen_count++;
+            added++;
+        }
+    }
+    return added;
+}
+
+/* 경로 테이블 갱신 */
+static void Path_Update(WcetState* w, uint64_t key, uint64_t ticks,
+    const FaultContext* before, const FaultContext* after, const InputSnapshot* in)
+{
+    uint32_t i = (uint32_t)Mix64(key) & (WCET_PATH_MAX - 1);
+    WcetPath* p;
+
+    while (w->paths[i].used && w->paths[i].key != key)
+        i = (i + 1) & (WCET_PATH_MAX - 1);
+
+    p = &w->paths[i];
+    if (!p->used)
+    {
+        if (w->path_count >= WCET_PATH_MAX * 3 / 4)
+        {
+            w->path_dropped++;
+            return;
+        }
+
+        p->used = 1;
+        p->key = key;
+        w->path_count++;
+    }
+
+    if (p->count++ == 0 || ticks > p->warm_max)
+    {
+        p->warm_max = ticks;
+        p->packed_before = Fault_PackStatus(before);
+        p->packed_after = Fault_PackStatus(after);
+#ifdef OBC_BRANCH_COVERAGE
+        memcpy(p->branch, Fault_BranchPath, sizeof(p->branch));
+#endif
+        p->before = *before;
+        p->in = *in;
+    }
+}
+
+/* 시퀀스 1개 실행 : Cycle마다 warm 측정 + 경로 기록, 새 고장별 분기 조합 발견 시 1 반환 */
+static int Seq_Run(WcetState* w, const WcetSeq* s, int seq_index)
+{
+    FaultContext ctx;
+    FaultContext before;
+    InputSnapshot in;
+    int cycle = 0;
+    int novel = 0;
+
+    Fault_InitContext(&ctx);
+
+    for (int i = 0; i < s->len; i++)
+    {
+        uint64_t best = UINT64_MAX;
+
+        in = s->row[i];
+        cycle += in.Cycle;
+        in.Cycle = cycle;
+        before = ctx;
+
+#ifdef OBC_BRANCH_COVERAGE
+        memset(Fault_BranchPath, 0, sizeof(Fault_BranchPath));
+#endif
+        for (int r = 0; r < WCET_REPEAT; r++)
+        {
+            uint64_t t0, t1;
+
+            ctx = before;
+            t0 = Prof_Ticks();
+            Fault_DiagnoseContext(&ctx, &in);
+            t1 = Prof_Ticks();
+
+            if (t1 - t0 < best)
+                best = t1 - t0;
+        }
+
+        Hist_Record(&w->warm, best);
+        w->steps++;
+
+        Path_Update(w, Path_Key(Fault_PackStatus(&before), Fault_PackStatus(&ctx)),
+            best, &before, &ctx, &in);
+        novel |= (Seen_Update(w, &before, &ctx) > 0);
+
+        if (best > w->worst_ticks)
+        {
+            w->worst_ticks = best;
+            w->worst_seq = seq_index;
+            w->worst_step = i;
+            w->worst_before = before;
+            w->worst_in = in;
+            Seq_Copy(&w->worst, s, i + 1);
+#ifdef OBC_BRANCH_COVERAGE
+            memcpy(w->worst_branch, Fault_BranchPath, sizeof(w->worst_branch));
+#endif
+        }
+    }
+    return novel;
+}
+
+static void Pool_Add(WcetState* w, const WcetSeq* s)
+{
+    int slot = (w->pool_len < WCET_POOL) ? w->pool_len++ : Rng_Below(&w->rng, WCET_POOL);
+
+    Seq_Copy(&w->pool[slot], s, s->len);
+}
+
+/* 캐시 축출 : LLC 보다 큰 버퍼를 cache line 단위로 기록 */
+static void Cache_Evict(WcetState* w)
+{
+    volatile unsigned char* p = w->evict;
+
+    for (size_t i = 0; i < w->evict_size; i += OSAL_CACHE_LINE)
+        p[i]++;
+}
+
+/* cold 측정 : 상태/입력 복사 → 캐시 축출 → 1 Cycle 진단 (반복 중 최소값) */
+static uint64_t Measure_Cold(WcetState* w, const FaultContext* before, const InputSnapshot* in)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (int r = 0; r < WCET_REPEAT; r++)
+    {
+        uint64_t t0, t1;
+
+        w->cold_ctx = *before;
+        w->cold_in = *in;
+        Cache_Evict(w);
+
+        t0 = Prof_Ticks();
+        Fault_DiagnoseContext(&w->cold_ctx, &w->cold_in);
+        t1 = Prof_Ticks();
+
+        if (t1 - t0 < best)
+            best = t1 - t0;
+    }
+    return best;
+}
+
+static int Path_CompareWarm(const void* a, const void* b)
+{
+    const WcetPath* x = *(const WcetPath* const*)a;
+    const WcetPath* y = *(const WcetPath* const*)b;
+
+    return (x->warm_max < y->warm_max) - (x->warm_max > y->warm_max);
+}
+
+static int Path_CompareCold(const void* a, const void* b)
+{
+    const WcetPath* x = *(const WcetPath* const*)a;
+    const WcetPath* y = *(const WcetPath* const*)b;
+    uint64_t xv = x->cold > x->warm_max ? x->cold : x->warm_max;
+    uint64_t yv = y->cold > y->warm_max ? y->cold : y->warm_max;
+
+    return (xv < yv) - (xv > yv);
+}
+
+/* 빈 측정 구간 최소값 (측정값에 포함되는 시계 오버헤드) */
+static uint64_t Timer_Overhead(void)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        uint64_t t0 = Prof_Ticks();
+        uint64_t t1 = Prof_Ticks();
+
+        if (t1 - t0 < best)
+            best = t1 - t0;
+    }
+    return best;
+}
+
+/* 입력 CSV 형식으로 시퀀스 저장 (Cycle 증가량 → 절대값) */
+static int Seq_WriteCsv(const char* path, const WcetSeq* s)
+{
+    FILE* fp = fopen(path, "w");
+    char line[INPUT_LINE_MAX];
+    int cycle = 0;
+
+    if (!fp)
+        return 0;
+
+    Input_WriteHeader(fp);
+    for (int i = 0; i < s->len; i++)
+    {
+        InputSnapshot in = s->row[i];
+
+        cycle += in.Cycle;
+        in.Cycle = cycle;
+        fwrite(line, 1, (size_t)Input_FormatLine(line, &in), fp);
+    }
+
+    return fclose(fp) == 0;
+}
+
+#ifdef OBC_BRANCH_COVERAGE
+/* 분기 bitmask → "0x01:1,5,9 0x02:..." */
+static void Branch_Format(char* buf, size_t size, const uint32_t* branch)
+{
+    size_t len = 0;
+
+    buf[0] = '\0';
+    for (int c = FAULT_INPUT_OVERCURRENT; c < FAULT_MAX && len + 8 < size; c++)
+    {
+        len += (size_t)snprintf(buf + len, size - len, "%s0x%02X:", len ? " " : "", c);
+        for (int id = 0, first = 1; id < Fault_BranchCount[c] && len + 4 < size; id++)
+        {
+            if (!(branch[c] & (1u << id)))
+                continue;
+            len += (size_t)snprintf(buf + len, size - len, first ? "%d" : ",%d", id);
+            first = 0;
+        }
+    }
+}
+#endif
+
+static void Report_Coverage(FILE* report)
+{
+#ifdef OBC_BRANCH_COVERAGE
+    int total = 0;
+    int hit = 0;
+
+    for (int c = FAULT_INPUT_OVERCURRENT; c < FAULT_MAX; c++)
+    {
+        total += Fault_BranchCount[c];
+        for (int id = 0; id < Fault_BranchCount[c]; id++)
+            hit += (Fault_BranchHits[c][id] != 0);
+    }
+
+    fprintf(report, "  branch coverage : %d / %d (%.1f%%)\n", hit, total, 100.0 * hit / total);
+
+    for (int c = FAULT_INPUT_OVERCURRENT; c < FAULT_MAX; c++)
+    {
+        int covered = 0;
+
+        for (int id = 0; id < Fault_BranchCount[c]; id++)
+            covered += (Fault_BranchHits[c][id] != 0);
+
+        fprintf(report, "    0x%02X : %2d / %2d", c, covered, Fault_BranchCount[c]);
+        if (covered < Fault_BranchCount[c])
+        {
+            fprintf(report, "  missed :");
+            for (int id = 0; id < Fault_BranchCount[c]; id++)
+                if (Fault_BranchHits[c][id] == 0)
+                    fprintf(report, " #%d", id);
+        }
+        fputc('\n', report);
+    }
+#else
+    fprintf(report, "  branch coverage : not measured (build with OBC_BRANCH_COVERAGE)\n");
+#endif
+}
+
+static void Report(WcetState* w, const WcetOptions* opt, WcetPath** order, int measured,
+    double ns_per_tick, uint64_t overhead, double elapsed_s, int saved, FILE* report)
+{
+    uint64_t cold_max = w->worst_cold;
+
+    for (int k = 0; k < measured; k++)
+        if (order[k]->cold > cold_max)
+            cold_max = order[k]->cold;
+
+    fprintf(report, "WCET exploration : %d sequences, %llu cycles, seed %llu (%.1f s)\n",
+        opt->sequences, (unsigned long long)w->steps, (unsigned long long)opt->seed, elapsed_s);
+    fprintf(report, "  timer           : %s, %.3f ns/tick, overhead %llu ticks included\n",
+        PROF_TSC ? "TSC" : "monotonic clock", ns_per_tick, (unsigned long long)overhead);
+    fprintf(report, "  paths           : %d distinct, %d per-fault combinations%s", w->path_count,
+        w->seen_count, w->path_dropped ? "" : "\n");
+    if (w->path_dropped)
+        fprintf(report, " (%llu new paths over table limit)\n", (unsigned long long)w->path_dropped);
+
+    fprintf(report, "  warm            : p50 %llu  p99 %llu  max %llu ticks (max %.1f ns)\n",
+        (unsigned long long)Hist_Percentile(&w->warm, 50.0),
+        (unsigned long long)Hist_Percentile(&w->warm, 99.0),
+        (unsigned long long)w->warm.max, w->warm.max * ns_per_tick);
+    fprintf(report, "  cold            : max %llu ticks (%.1f ns), %d slowest paths, evict %d MB\n",
+        (unsigned long long)cold_max, cold_max * ns_per_tick, measured, opt->evict_mb);
+
+    Report_Coverage(report);
+
+    fprintf(report, "  slowest cycle   : sequence %d, row %d, Cycle %d : warm %llu / cold %llu ticks\n",
+        w->worst_seq, w->worst_step + 1, w->worst_in.Cycle,
+        (unsigned long long)w->worst_ticks, (unsigned long long)w->worst_cold);
+    fprintf(report, "                    status 0x%06X -> replay %s\n",
+        (unsigned)Fault_PackStatus(&w->worst_before),
+        saved ? opt->worst_csv : "(not saved)");
+#ifdef OBC_BRANCH_COVERAGE
+    {
+        char buf[512];
+        Branch_Format(buf, sizeof(buf), w->worst_branch);
+        fprintf(report, "                    branches %s\n", buf);
+    }
+#endif
+
+    qsort(order, (size_t)w->path_count, sizeof(*order), Path_CompareCold);
+
+    fprintf(report, "  %-4s %10s %10s %10s  %-8s -> %-8s\n",
+        "rank", "warm", "cold", "count", "before", "after");
+    for (int k = 0; k < w->path_count && k < WCET_TOP; k++)
+    {
+        const WcetPath* p = order[k];
+
+        fprintf(report, "  %-4d %10llu %10llu %10llu  0x%06X -> 0x%06X\n", k + 1,
+            (unsigned long long)p->warm_max, (unsigned long long)p->cold,
+            (unsigned long long)p->count, (unsigned)p->packed_before, (unsigned)p->packed_after);
+#ifdef OBC_BRANCH_COVERAGE
+        {
+            char buf[512];
+            Branch_Format(buf, sizeof(buf), p->branch);
+            fprintf(report, "       %s\n", buf);
+        }
+#endif
+    }
+}
+
+static int Seq_Alloc(WcetSeq* s)
+{
+    s->row = (InputSnapshot*)malloc(WCET_SEQ_MAX * sizeof(*s->row));
+    s->len = 0;
+    return s->row != NULL;
+}
+
+static void State_Free(WcetState* w)
+{
+    free(w->cur.row);
+    free(w->worst.row);
+    for (int k = 0; k < WCET_POOL; k++)
+        free(w->pool[k].row);
+    free(w->paths);
+    free(w->seen);
+    free(w->evict);
+    free(w);
+}
+
+int Wcet_Run(const WcetOptions* opt, FILE* report)
+{
+    WcetState* w = (WcetState*)calloc(1, sizeof(*w));
+    FaultContext init;
+    WcetPath** order = NULL;
+    uint64_t ticks0, ns0, overhead;
+    double ns_per_tick = 1.0;
+    int measured = 0;
+    int saved = 0;
+    int ok;
+
+    if (!w)
+    {
+        printf("ERROR: WCET harness out of memory\n");
+        return 1;
+    }
+
+    w->evict_size = (size_t)opt->evict_mb << 20;
+    w->paths = (WcetPath*)calloc(WCET_PATH_MAX, sizeof(*w->paths));
+    w->seen = (uint64_t*)calloc(WCET_SEEN_MAX, sizeof(*w->seen));
+    w->evict = (unsigned char*)calloc(w->evict_size ? w->evict_size : 1, 1);
+    ok = w->paths && w->seen && w->evict && Seq_Alloc(&w->cur) && Seq_Alloc(&w->worst);
+    for (int k = 0; k < WCET_POOL && ok; k++)
+        ok = Seq_Alloc(&w->pool[k]);
+
+    if (!ok)
+    {
+        printf("ERROR: WCET harness out of memory\n");
+        State_Free(w);
+        return 1;
+    }
+
+    Fault_InitContext(&init);
+    Model_Build(&w->model, &init.cal);
+    Hist_Init(&w->warm);
+    w->rng = opt->seed;
+
+    overhead = Timer_Overhead();
+    ticks0 = Prof_Ticks();
+    ns0 = Osal_NowNs();
+
+    /* ------------------------------
+     * 탐색 : 새 시퀀스 생성 또는 새 경로를 만든 시퀀스 변형
+     * ------------------------------ */
+    for (int s = 0; s < opt->sequences; s++)
+    {
+        if (w->pool_len > 0 && Rng_Below(&w->rng, 2))
+        {
+            const WcetSeq* parent = &w->pool[Rng_Below(&w->rng, w->pool_len)];
+
+            Seq_Copy(&w->cur, parent, parent->len);
+            Seq_Mutate(w, &w->cur);
+        }
+        else
+        {
+            Seq_Generate(w, &w->cur);
+        }
+
+        if (Seq_Run(w, &w->cur, s))
+            Pool_Add(w, &w->cur);
+    }
+
+    /* ------------------------------
+     * cold 측정 : warm 최대값 상위 경로 + 최악 Cycle
+     * ------------------------------ */
+    order = (WcetPath**)malloc((size_t)(w->path_count ? w->path_count : 1) * sizeof(*order));
+    if (!order)
+    {
+        printf("ERROR: WCET harness out of memory\n");
+        State_Free(w);
+        return 1;
+    }
+
+    for (int i = 0, k = 0; i < WCET_PATH_MAX; i++)
+        if (w->paths[i].used)
+            order[k++] = &w->paths[i];
+
+    qsort(order, (size_t)w->path_count, sizeof(*order), Path_CompareWarm);
+
+    measured = opt->cold_paths < w->path_count ? opt->cold_paths : w->path_count;
+    for (int k = 0; k < measured; k++)
+        order[k]->cold = Measure_Cold(w, &order[k]->before, &order[k]->in);
+
+    if (w->steps > 0)
+        w->worst_cold = Measure_Cold(w, &w->worst_before, &w->worst_in);
+
+#if PROF_TSC
+    {
+        uint64_t ticks = Prof_Ticks() - ticks0;
+        uint64_t ns = Osal_NowNs() - ns0;
+
+        if (ticks > 0)
+            ns_per_tick = (double)ns / (double)ticks;
+    }
+#endif
+
+    if (opt->worst_csv && w->steps > 0)
+    {
+        saved = Seq_WriteCsv(opt->worst_csv, &w->worst);
+        if (!saved)
+            printf("WARNING: Failed to write WCET input CSV : %s\n", opt->worst_csv);
+    }
+
+    Report(w, opt, order, measured, ns_per_tick, overhead,
+        (double)(Osal_NowNs() - ns0) / 1e9, saved, report);
+
+    free(order);
+    State_Free(w);
+    return 0;
+}
+
+int Wcet_Main(int argc, char* argv[])
+{
+    WcetOptions opt;
+
+    opt.sequences = 2000;
+    opt.seed = 1;
+    opt.cold_paths = 32;
+    opt.evict_mb = 32;
+    opt.worst_csv = "wcet_worst.csv";
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--seqs=", 7) == 0)
+            opt.sequences = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            opt.seed = strtoull(argv[i] + 7, NULL, 0);
+        else if (strncmp(argv[i], "--cold=", 7) == 0)
+            opt.cold_paths = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--evict=", 8) == 0)
+            opt.evict_mb = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--out=", 6) == 0)
+            opt.worst_csv = argv[i][6] ? argv[i] + 6 : NULL;
+        else
+        {
+            printf("ERROR: Unknown option : %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (opt.sequences < 1 || opt.cold_paths < 0 || opt.evict_mb < 0)
+    {
+        printf("ERROR: Invalid WCET option value\n");
+        return 1;
+    }
+
+    return Wcet_Run(&opt, stdout);
+}
@@ -0,0 +1,31 @@
+#ifndef WCET_H
+#define WCET_H
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * WCET(최악 실행 시간) 탐색 하네스 (fault_engine --wcet)
+ *  - Calibration 임계값 경계값 / 카운터 시간 경계값(T-1, T, T+1) 기반 입력 시퀀스 생성
+ *    → 고장별 검출/회복/래치 분기 조합 탐색 (0x03 / 0x06 / 0x0B 동시 래치 등)
+ *  - 새 경로(분기 조합)를 만든 시퀀스는 보관 후 구간 재생성/반복/삭제로 변형하여 재탐색
+ *  - Fault_DiagnoseContext 1 Cycle 실행 시간을 warm(동일 상태 3회 중 최소) / cold(캐시 축출 후)로 측정
+ *  - 결과 : 경로별 최대 실행 시간, 최악 입력 시퀀스(입력 CSV 형식, 재생 가능), 분기 커버리지
+ *    (분기 커버리지는 OBC_BRANCH_COVERAGE 빌드에서만 측정, 계측 코드가 실행 시간에 포함됨)
+ */
+
+typedef struct
+{
+    int sequences;              // 생성 입력 시퀀스 수
+    uint64_t seed;              // 난수 seed (같은 seed → 같은 탐색)
+    int cold_paths;             // cold 측정 경로 수 (warm 최대값 상위)
+    int evict_mb;               // cold 측정 전 캐시 축출 버퍼 크기 (MB)
+    const char* worst_csv;      // 최악 입력 시퀀스 CSV 경로 (NULL : 저장 안 함)
+} WcetOptions;
+
+/* ===== WCET 탐색 실행 후 report 에 결과 출력 : 성공 0, 실패 1 ===== */
+int Wcet_Run(const WcetOptions* opt, FILE* report);
+
+/* ===== 명령행 진입점 : fault_engine --wcet [options] ===== */
+int Wcet_Main(int argc, char* argv[]);
+
+#endif /* WCET_H */